@@ -0,0 +1,203 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <string.h>
+#include "BCDS_Basics.h"
+
+/* user includes */
+#include "ABIDecoder.h"
+#include "ABIEncoder.h"
+#include "HexCodec.h"
+
+/* hex characters of one ABI word */
+#define ABI_WORD_HEX_LENGTH			(ABI_WORD_SIZE * 2)
+
+/* hex characters of an address - right aligned in its word */
+#define ABI_ADDRESS_HEX_LENGTH		40
+
+/**
+ * This function reads one word as unsigned number. Only
+ * values which fit into size_t are accepted - offsets and
+ * lengths of a valid result are always small.
+ *
+ * @param[in] result_ptr
+ * This reference holds the result data
+ *
+ * @param[in] position
+ * Position of the word in hex characters
+ *
+ * @param[out] oValue_ptr
+ * This reference holds the decoded value
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T readUintWord(ABIResult_T const *result_ptr, size_t position, size_t *oValue_ptr)
+{
+	uint8_t digit = 0;
+	size_t value = 0;
+
+	if( (position > result_ptr->length) || (ABI_WORD_HEX_LENGTH > (result_ptr->length - position)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	for(size_t i = 0; i < ABI_WORD_HEX_LENGTH; ++i) {
+		digit = HexDecodeDigit(result_ptr->data_ptr[position + i]);
+		if(HEX_INVALID_DIGIT == digit) {
+			return RETCODE_FAILURE;
+		}
+		/* value does not fit */
+		if( (0 != digit) && (i < (ABI_WORD_HEX_LENGTH - (sizeof(size_t) * 2))) ) {
+			return RETCODE_FAILURE;
+		}
+		value = (value << 4) | digit;
+	}
+
+	*oValue_ptr = value;
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function initializes the result from the hex
+ * string of a json rpc result
+ *
+ * @param[out] result_ptr
+ * This reference holds the result which is initialized
+ *
+ * @param[in] hex_ptr
+ * This reference holds the hex string with or without
+ * 0x prefix. It does not have to be null terminated.
+ *
+ * @param[in] iLength
+ * Length of the hex string
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T ABIDecoderInit(ABIResult_T *result_ptr, uint8_t const *hex_ptr, size_t iLength)
+{
+	if( (NULL == result_ptr) || (NULL == hex_ptr) ) {
+		return RETCODE_FAILURE;
+	}
+
+	if( (2 <= iLength) && ('0' == hex_ptr[0]) && (('x' == hex_ptr[1]) || ('X' == hex_ptr[1])) ) {
+		hex_ptr += 2;
+		iLength -= 2;
+	}
+
+	/* return data always consists of complete words */
+	if(0 != (iLength % ABI_WORD_HEX_LENGTH)) {
+		return RETCODE_FAILURE;
+	}
+
+	result_ptr->data_ptr = hex_ptr;
+	result_ptr->length = iLength;
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function decodes a dynamic bytes return value.
+ * The offset in the head word and the length in the tail
+ * are checked against the result, the data is decoded
+ * in one pass into the output buffer.
+ *
+ * @param[in] result_ptr
+ * This reference holds the result data
+ *
+ * @param[in] index
+ * Index of the return value in the function signature
+ *
+ * @param[out] oBuff
+ * Output buffer for the binary data
+ *
+ * @param[in] iBuffSize
+ * Size of the output buffer
+ *
+ * @param[out] oLength_ptr
+ * This reference holds the number of decoded bytes. Can be NULL.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T ABIDecodeBytes(ABIResult_T const *result_ptr, uint8_t index, uint8_t *oBuff, size_t iBuffSize, size_t *oLength_ptr)
+{
+	size_t offset = 0;
+	size_t length = 0;
+
+	if( (NULL == result_ptr) || (NULL == oBuff) ) {
+		return RETCODE_FAILURE;
+	}
+
+	/* head holds the byte offset of the length word */
+	if(RETCODE_SUCCESS != readUintWord(result_ptr, (size_t) index * ABI_WORD_HEX_LENGTH, &offset)) {
+		return RETCODE_FAILURE;
+	}
+	if( (offset > (result_ptr->length / 2)) || (RETCODE_SUCCESS != readUintWord(result_ptr, offset * 2, &length)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	/* data has to be inside of the result and fit into the buffer */
+	offset = (offset * 2) + ABI_WORD_HEX_LENGTH;
+	if( (length > iBuffSize) || (length > ((result_ptr->length - offset) / 2)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	if(RETCODE_SUCCESS != HexDecode(&result_ptr->data_ptr[offset], length * 2, oBuff)) {
+		return RETCODE_FAILURE;
+	}
+
+	if(NULL != oLength_ptr) {
+		*oLength_ptr = length;
+	}
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function copies an address return value as 40
+ * hex characters. The padding of the word must be zero.
+ *
+ * @param[in] result_ptr
+ * This reference holds the result data
+ *
+ * @param[in] index
+ * Index of the return value in the function signature
+ *
+ * @param[out] oAddress_ptr
+ * Output buffer for the 40 hex characters - it is not
+ * null terminated and does not get a 0x prefix
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T ABIDecodeAddress(ABIResult_T const *result_ptr, uint8_t index, uint8_t *oAddress_ptr)
+{
+	size_t position = (size_t) index * ABI_WORD_HEX_LENGTH;
+	uint8_t const *word_ptr = NULL;
+
+	if( (NULL == result_ptr) || (NULL == oAddress_ptr) || (position >= result_ptr->length) ) {
+		return RETCODE_FAILURE;
+	}
+
+	word_ptr = &result_ptr->data_ptr[position];
+	for(size_t i = 0; i < ABI_WORD_HEX_LENGTH; ++i) {
+		if( (HEX_INVALID_DIGIT == HexDecodeDigit(word_ptr[i])) || ((i < (ABI_WORD_HEX_LENGTH - ABI_ADDRESS_HEX_LENGTH)) && ('0' != word_ptr[i])) ) {
+			return RETCODE_FAILURE;
+		}
+	}
+
+	memcpy(oAddress_ptr, &word_ptr[ABI_WORD_HEX_LENGTH - ABI_ADDRESS_HEX_LENGTH], ABI_ADDRESS_HEX_LENGTH);
+
+	return RETCODE_SUCCESS;
+}
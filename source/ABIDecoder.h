@@ -0,0 +1,27 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_ABIDECODER_H_
+#define SOURCE_ABIDECODER_H_
+
+/**
+ * Hex encoded return data of a contract call without the 0x prefix.
+ * Return values are read by the index of their head word, dynamic
+ * values are found by following the offset in the head.
+ */
+typedef struct ABIResult_S {
+	uint8_t const *data_ptr;
+	size_t length;		/* number of hex characters */
+} ABIResult_T;
+
+/* global interface function declarations */
+Retcode_T ABIDecoderInit(ABIResult_T *result_ptr, uint8_t const *hex_ptr, size_t iLength);
+Retcode_T ABIDecodeBytes(ABIResult_T const *result_ptr, uint8_t index, uint8_t *oBuff, size_t iBuffSize, size_t *oLength_ptr);
+Retcode_T ABIDecodeAddress(ABIResult_T const *result_ptr, uint8_t index, uint8_t *oAddress_ptr);
+
+#endif /* SOURCE_ABIDECODER_H_ */
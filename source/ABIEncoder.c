@@ -0,0 +1,306 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <string.h>
+#include "BCDS_Basics.h"
+
+/* user includes */
+#include "ABIEncoder.h"
+#include "HexCodec.h"
+
+/* hex characters of an address */
+#define ABI_ADDRESS_HEX_LENGTH	40
+
+/* size of an address in bytes - right aligned in its word */
+#define ABI_ADDRESS_SIZE		20
+
+/* output buffer of the binary call data */
+typedef struct abiBuffer_S {
+	uint8_t *buff_ptr;
+	size_t buffSize;
+	size_t length;
+	bool overflow;
+} abiBuffer_T;
+
+/**
+ * This function reserves space in the output buffer
+ *
+ * @param[in] buffer_ptr
+ * This reference holds the output buffer
+ *
+ * @param[in] iLength
+ * Number of bytes which are written
+ *
+ * @return
+ * reference of the reserved space, NULL if it does not fit
+ */
+static uint8_t *reserveBytes(abiBuffer_T *buffer_ptr, size_t iLength)
+{
+	uint8_t *out_ptr = NULL;
+
+	if( (false == buffer_ptr->overflow) && (iLength <= (buffer_ptr->buffSize - buffer_ptr->length)) ) {
+		out_ptr = &buffer_ptr->buff_ptr[buffer_ptr->length];
+		buffer_ptr->length += iLength;
+	} else {
+		buffer_ptr->overflow = true;
+	}
+
+	return out_ptr;
+}
+
+/**
+ * This function appends zero bytes
+ *
+ * @param[in] buffer_ptr
+ * This reference holds the output buffer
+ *
+ * @param[in] count
+ * Number of zero bytes to append
+ *
+ * @return
+ * void
+ */
+static void writeZeros(abiBuffer_T *buffer_ptr, size_t count)
+{
+	uint8_t *out_ptr = reserveBytes(buffer_ptr, count);
+
+	if(NULL != out_ptr) {
+		memset(out_ptr, 0, count);
+	}
+}
+
+/**
+ * This function appends an unsigned number as one
+ * big endian ABI word
+ *
+ * @param[in] buffer_ptr
+ * This reference holds the output buffer
+ *
+ * @param[in] value
+ * Value to encode
+ *
+ * @return
+ * void
+ */
+static void writeUintWord(abiBuffer_T *buffer_ptr, uint32_t value)
+{
+	uint8_t *out_ptr = reserveBytes(buffer_ptr, ABI_WORD_SIZE);
+
+	if(NULL != out_ptr) {
+		memset(out_ptr, 0, ABI_WORD_SIZE - sizeof(value));
+		out_ptr[ABI_WORD_SIZE - 4] = (uint8_t) (value >> 24);
+		out_ptr[ABI_WORD_SIZE - 3] = (uint8_t) (value >> 16);
+		out_ptr[ABI_WORD_SIZE - 2] = (uint8_t) (value >> 8);
+		out_ptr[ABI_WORD_SIZE - 1] = (uint8_t) value;
+	}
+}
+
+/**
+ * This function returns the number of bytes a dynamic
+ * argument occupies in the tail of the call data
+ *
+ * @param[in] arg_ptr
+ * This reference holds the argument
+ *
+ * @return
+ * size of the length word and the padded data, 0 for static types
+ */
+static size_t getTailSize(ABIArgument_T const *arg_ptr)
+{
+	if(ABI_TYPE_BYTES != arg_ptr->type) {
+		return 0;
+	}
+
+	return ABI_WORD_SIZE + ((arg_ptr->length + ABI_WORD_SIZE - 1) / ABI_WORD_SIZE) * ABI_WORD_SIZE;
+}
+
+/**
+ * This function appends the head word of one argument.
+ * Static types are encoded in place, dynamic types get
+ * the offset of their data in the tail.
+ *
+ * @param[in] buffer_ptr
+ * This reference holds the output buffer
+ *
+ * @param[in] arg_ptr
+ * This reference holds the argument
+ *
+ * @param[in] tailOffset
+ * Offset of the dynamic data from the start of the arguments
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T writeHead(abiBuffer_T *buffer_ptr, ABIArgument_T const *arg_ptr, size_t tailOffset)
+{
+	uint8_t const *address_ptr = arg_ptr->data_ptr;
+	uint8_t *out_ptr = NULL;
+
+	switch (arg_ptr->type) {
+		case ABI_TYPE_BYTES:
+			if( (NULL == arg_ptr->data_ptr) && (0 != arg_ptr->length) ) {
+				return RETCODE_FAILURE;
+			}
+			writeUintWord(buffer_ptr, (uint32_t) tailOffset);
+		break;
+		case ABI_TYPE_BYTES32:
+			if( (NULL == arg_ptr->data_ptr) || (ABI_WORD_SIZE < arg_ptr->length) ) {
+				return RETCODE_FAILURE;
+			}
+			/* fixed size bytes are left aligned */
+			out_ptr = reserveBytes(buffer_ptr, arg_ptr->length);
+			if(NULL != out_ptr) {
+				memcpy(out_ptr, arg_ptr->data_ptr, arg_ptr->length);
+			}
+			writeZeros(buffer_ptr, ABI_WORD_SIZE - arg_ptr->length);
+		break;
+		case ABI_TYPE_BOOL:
+			writeUintWord(buffer_ptr, (0 != arg_ptr->length) ? 1 : 0);
+		break;
+		case ABI_TYPE_ADDRESS:
+			if(NULL == address_ptr) {
+				return RETCODE_FAILURE;
+			}
+			if( ('0' == address_ptr[0]) && (('x' == address_ptr[1]) || ('X' == address_ptr[1])) ) {
+				address_ptr += 2;
+			}
+			/* the 40 hex characters are followed by the terminating zero */
+			if((address_ptr + ABI_ADDRESS_HEX_LENGTH) != memchr(address_ptr, '\0', ABI_ADDRESS_HEX_LENGTH + 1)) {
+				return RETCODE_FAILURE;
+			}
+			/* 20 byte address is right aligned */
+			writeZeros(buffer_ptr, ABI_WORD_SIZE - ABI_ADDRESS_SIZE);
+			out_ptr = reserveBytes(buffer_ptr, ABI_ADDRESS_SIZE);
+			if( (NULL != out_ptr) && (RETCODE_SUCCESS != HexDecode(address_ptr, ABI_ADDRESS_HEX_LENGTH, out_ptr)) ) {
+				return RETCODE_FAILURE;
+			}
+		break;
+		default:
+			return RETCODE_FAILURE;
+		break;
+	}
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function writes the binary call data of a contract
+ * function call - selector followed by the ABI encoded
+ * arguments.
+ *
+ * @param[in] selector
+ * Function selector e.g. ABI_SELECTOR_WRITE_DATA_HASH
+ *
+ * @param[in] args_ptr
+ * This reference holds the arguments in the order of the
+ * function signature. Can be NULL if argCount is 0.
+ *
+ * @param[in] argCount
+ * Number of arguments
+ *
+ * @param[out] oBuff
+ * Output buffer for the call data
+ *
+ * @param[in] iBuffSize
+ * Size of the output buffer
+ *
+ * @param[out] oLength_ptr
+ * This reference will hold the length of the call data
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T ABIEncodeCallData(uint32_t selector, ABIArgument_T const *args_ptr, uint8_t argCount, uint8_t *oBuff, size_t iBuffSize, size_t *oLength_ptr)
+{
+	abiBuffer_T buffer = { oBuff, iBuffSize, 0, false };
+	size_t tailOffset = argCount * ABI_WORD_SIZE;
+	uint8_t *out_ptr = NULL;
+
+	if( (NULL == oBuff) || (NULL == oLength_ptr) || (ABI_ARGUMENT_MAX < argCount) || ((NULL == args_ptr) && (0 != argCount)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	out_ptr = reserveBytes(&buffer, ABI_SELECTOR_SIZE);
+	if(NULL != out_ptr) {
+		out_ptr[0] = (uint8_t) (selector >> 24);
+		out_ptr[1] = (uint8_t) (selector >> 16);
+		out_ptr[2] = (uint8_t) (selector >> 8);
+		out_ptr[3] = (uint8_t) selector;
+	}
+
+	/* head - static values and offsets of the dynamic values */
+	for(uint8_t arg = 0; arg < argCount; ++arg) {
+		if(RETCODE_SUCCESS != writeHead(&buffer, &args_ptr[arg], tailOffset)) {
+			return RETCODE_FAILURE;
+		}
+		tailOffset += getTailSize(&args_ptr[arg]);
+	}
+
+	/* tail - length and right padded data of the dynamic values */
+	for(uint8_t arg = 0; arg < argCount; ++arg) {
+		if(ABI_TYPE_BYTES == args_ptr[arg].type) {
+			writeUintWord(&buffer, (uint32_t) args_ptr[arg].length);
+			out_ptr = reserveBytes(&buffer, args_ptr[arg].length);
+			if(NULL != out_ptr) {
+				memcpy(out_ptr, args_ptr[arg].data_ptr, args_ptr[arg].length);
+			}
+			writeZeros(&buffer, getTailSize(&args_ptr[arg]) - ABI_WORD_SIZE - args_ptr[arg].length);
+		}
+	}
+
+	*oLength_ptr = buffer.length;
+	return (false == buffer.overflow) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function appends the hex encoded call data of a
+ * contract function call. The binary call data is encoded
+ * straight into the buffer of the writer and converted to
+ * hex in place. It must be called inside a string opened
+ * with JSONWriterBeginString.
+ *
+ * @param[in] writer_ptr
+ * This reference holds the JSON writer context
+ *
+ * @param[in] selector
+ * Function selector e.g. ABI_SELECTOR_WRITE_DATA_HASH
+ *
+ * @param[in] args_ptr
+ * This reference holds the arguments in the order of the
+ * function signature. Can be NULL if argCount is 0.
+ *
+ * @param[in] argCount
+ * Number of arguments
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T ABIEncodeCall(JSONWriter_T *writer_ptr, uint32_t selector, ABIArgument_T const *args_ptr, uint8_t argCount)
+{
+	uint8_t *callData_ptr = NULL;
+	size_t maxLength = 0;
+	size_t length = 0;
+
+	if(NULL == writer_ptr) {
+		return RETCODE_FAILURE;
+	}
+
+	JSONWriterAppendRaw(writer_ptr, "0x", 2);
+	callData_ptr = JSONWriterReserveHex(writer_ptr, &maxLength);
+	if( (NULL == callData_ptr) || (RETCODE_SUCCESS != ABIEncodeCallData(selector, args_ptr, argCount, callData_ptr, maxLength, &length)) ) {
+		writer_ptr->overflow = true;
+		return RETCODE_FAILURE;
+	}
+	JSONWriterCommitHex(writer_ptr, length);
+
+	return (false == writer_ptr->overflow) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
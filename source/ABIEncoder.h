@@ -0,0 +1,44 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_ABIENCODER_H_
+#define SOURCE_ABIENCODER_H_
+
+#include "JSONWriter.h"
+#include "ContractABI.h"
+
+/* size of one ABI word in bytes */
+#define ABI_WORD_SIZE		32
+
+/* size of the function selector in bytes */
+#define ABI_SELECTOR_SIZE	4
+
+/* maximum number of arguments of one contract call */
+#define ABI_ARGUMENT_MAX	4
+
+/* solidity types which can be encoded as function argument */
+typedef enum ABIType_E {
+	ABI_TYPE_NONE = 0,
+	ABI_TYPE_BYTES,		/* dynamic bytes - data_ptr/length hold the binary data */
+	ABI_TYPE_BYTES32,	/* bytes32 - data_ptr/length hold up to 32 bytes, right padded */
+	ABI_TYPE_BOOL,		/* bool - length holds the value */
+	ABI_TYPE_ADDRESS	/* address - data_ptr holds 40 hex characters with or without 0x */
+} ABIType_T;
+
+/* one argument of a contract call */
+typedef struct ABIArgument_S {
+	ABIType_T type;
+	uint8_t const *data_ptr;
+	size_t length;
+} ABIArgument_T;
+
+/* global interface function declarations */
+Retcode_T ABIEncodeCallData(uint32_t selector, ABIArgument_T const *args_ptr, uint8_t argCount, uint8_t *oBuff, size_t iBuffSize, size_t *oLength_ptr);
+Retcode_T ABIEncodeCall(JSONWriter_T *writer_ptr, uint32_t selector, ABIArgument_T const *args_ptr, uint8_t argCount);
+
+#endif /* SOURCE_ABIENCODER_H_ */
@@ -0,0 +1,854 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "em_device.h"
+
+/* user includes */
+#include "Benchmark.h"
+#include "UserConfig.h"
+#include "SystemConfig.h"
+#include "Http.h"
+#include "HexCodec.h"
+#include "ABIEncoder.h"
+#include "TransactionSigner.h"
+#include "HttpTransport.h"
+#include "WebSocketTransport.h"
+#include "PipelineTransport.h"
+#include "LoopbackTransport.h"
+#include "Encryption.h"
+#include "CoAPServer.h"
+#include "cJSON.h"
+
+#ifdef ENABLE_BENCHMARK
+
+/* payload size which is used in the producer/consumer flow */
+#define BENCHMARK_PUB_KEY_LENGTH		READ_PUB_KEY_RESULT_LENGTH
+
+/* example transaction hash for receipt requests */
+#define BENCHMARK_TRANSACTION_HASH		"0x01ccbb06aab710540482f7a93fcd581bd3f3542e161638ddeb447ed9182cbadc"
+#define BENCHMARK_ACCOUNT_ADDRESS		"0x275b4EFC07BB4A8eb56fAF050Cf6436C2c06250E"
+#define BENCHMARK_CONTRACT_ADDRESS		"0xC47E575b2cACDC22545dA4C0FE7aeaD9ce90A9f2"
+
+/* number of heap allocations done by cJSON */
+static uint32_t BenchmarkMallocCounter = 0;
+
+/* output buffer of the JSON writer benchmark */
+static uint8_t BenchmarkJSONBuff[HTTP_REQUEST_PAYLOAD_SIZE];
+
+#ifdef ENABLE_ENCRYPTION
+#ifdef ENABLE_HYBRID_ENCRYPTION
+/* largest benchmarked sensor batch and the buffers of its messages */
+#define BENCHMARK_HYBRID_BATCH_MAX		96
+static uint8_t BenchmarkEncryptedBuff[BENCHMARK_HYBRID_BATCH_MAX + ENCRYPTION_HYBRID_OVERHEAD_MAX];
+static uint8_t BenchmarkHybridKeyBuff[BENCHMARK_HYBRID_BATCH_MAX + ENCRYPTION_HYBRID_OVERHEAD_MAX];
+#else
+/* output buffer of the encryption benchmark - one 1024 bit RSA block */
+static uint8_t BenchmarkEncryptedBuff[128];
+#endif
+#ifdef ENABLE_ECIES_ENCRYPTION
+/* the benchmarks encrypt for the elliptic curve key of the consumer */
+#define BENCHMARK_ENCRYPTION_SCHEME		"ECIES"
+static uint8_t BenchmarkPublicKey[ENCRYPTION_ECIES_SECP256R1_KEY_SIZE];
+#else
+#define BENCHMARK_ENCRYPTION_SCHEME		"RSA"
+#endif
+#endif
+
+/* buffers of the hex codec benchmark */
+static uint8_t BenchmarkHexBuff[BENCHMARK_PUB_KEY_LENGTH * 2 + 1];
+static uint8_t BenchmarkDataBuff[BENCHMARK_PUB_KEY_LENGTH];
+
+#ifdef ENABLE_LOCAL_SIGNING
+/* one signature takes far more cycles than the other benchmarks */
+#define BENCHMARK_SIGN_ITERATIONS		4
+#endif
+
+/**
+ * This function starts the cycle counter of the
+ * Cortex-M3 data watchpoint and trace unit
+ *
+ * @return
+ * void
+ */
+static void cycleCounterStart(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * This function reads the current cycle counter value
+ *
+ * @return
+ * number of cpu cycles since cycleCounterStart
+ */
+static uint32_t cycleCounterRead(void)
+{
+	return DWT->CYCCNT;
+}
+
+/**
+ * malloc wrapper which is installed as cJSON hook
+ * to count the heap allocations of the cJSON path
+ *
+ * @param[in] size
+ * Number of bytes to allocate
+ *
+ * @return
+ * allocated memory or NULL
+ */
+static void *countingMalloc(size_t size)
+{
+	BenchmarkMallocCounter++;
+	return malloc(size);
+}
+
+/**
+ * Reference implementation of the previous request
+ * generation: cJSON tree, per nibble snprintf and
+ * cJSON_Print into a heap string.
+ *
+ * @param[in] etherMethod
+ * ethereum function which is benchmarked
+ *
+ * @param[in] payload_ptr
+ * payload of the request
+ *
+ * @param[in] iPayloadLength
+ * length of the payload
+ *
+ * @param[out] oLength_ptr
+ * This reference will hold the length of the JSON string
+ *
+ * @return
+ * void
+ */
+static void genCJSONRequest(etherFuncCalls etherMethod, uint8_t const *payload_ptr, size_t iPayloadLength, size_t *oLength_ptr)
+{
+	uint8_t dataBuff[1024] = {0};
+	uint8_t const *ethMethod_ptr = "eth_sendTransaction";
+	uint8_t *JSONstring = NULL;
+	cJSON *params_ptr = NULL;
+	cJSON *call_ptr = cJSON_CreateObject();
+
+	if(GET_TRANSACTION_RECEIPT == etherMethod) {
+		ethMethod_ptr = "eth_getTransactionReceipt";
+	} else if(READ_DATA_HASH == etherMethod) {
+		ethMethod_ptr = "eth_call";
+		strcpy(dataBuff, "0x0546bedb00000000000000000000000000000000000000000000000000000000");
+	} else {
+		strcpy(dataBuff, "0x2ea8dff500000000000000000000000000000000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000000000110");
+		for(size_t i = strlen(dataBuff), u = 0; (u < iPayloadLength) && ((i + 2) < sizeof(dataBuff)); i += 2, ++u) {
+			snprintf(&dataBuff[i], 2, "%01x", (payload_ptr[u] >> 4 & 0x0F));
+			snprintf(&dataBuff[i+1], 2, "%01x", (payload_ptr[u] & 0x0F));
+		}
+	}
+
+	cJSON_AddStringToObject(call_ptr, "jsonrpc", "2.0");
+	cJSON_AddStringToObject(call_ptr, "method", ethMethod_ptr);
+	params_ptr = cJSON_AddArrayToObject(call_ptr, "params");
+	if(GET_TRANSACTION_RECEIPT != etherMethod) {
+		cJSON *object_ptr = cJSON_CreateObject();
+		cJSON_AddStringToObject(object_ptr, "from", BENCHMARK_ACCOUNT_ADDRESS);
+		cJSON_AddStringToObject(object_ptr, "to", BENCHMARK_CONTRACT_ADDRESS);
+		cJSON_AddStringToObject(object_ptr, "gas", "0x47E7C0");
+		if(WRITE_PUBLIC_KEY == etherMethod) {
+			cJSON_AddStringToObject(object_ptr, "value", "0x1BC16D674EC80000");
+		}
+		cJSON_AddStringToObject(object_ptr, "data", dataBuff);
+		cJSON_AddItemToArray(params_ptr, object_ptr);
+	} else {
+		cJSON_AddItemToArray(params_ptr, cJSON_CreateString(payload_ptr));
+	}
+	if(READ_DATA_HASH == etherMethod) {
+		cJSON_AddStringToObject(params_ptr, "NULL", "latest");
+	}
+	cJSON_AddNumberToObject(call_ptr, "id", etherMethod);
+
+	JSONstring = cJSON_Print(call_ptr);
+	*oLength_ptr = (NULL != JSONstring) ? strlen(JSONstring) : 0;
+
+	free(JSONstring);
+	cJSON_Delete(call_ptr);
+}
+
+/**
+ * Reference implementation of the previous hex encoding:
+ * one snprintf per nibble
+ *
+ * @param[in] data_ptr
+ * binary data
+ *
+ * @param[in] iLength
+ * number of bytes
+ *
+ * @param[out] oHex_ptr
+ * output buffer - holds iLength * 2 + 1 characters
+ *
+ * @return
+ * void
+ */
+static void referenceHexEncode(uint8_t const *data_ptr, size_t iLength, uint8_t *oHex_ptr)
+{
+	for(size_t i = 0; i < iLength; ++i) {
+		snprintf(&oHex_ptr[2 * i], 2, "%01x", (data_ptr[i] >> 4 & 0x0F));
+		snprintf(&oHex_ptr[2 * i + 1], 2, "%01x", (data_ptr[i] & 0x0F));
+	}
+}
+
+/**
+ * Reference implementation of the previous hex decoding:
+ * branches per character and no validation
+ *
+ * @param[in] hex_ptr
+ * hex characters
+ *
+ * @param[in] iHexLength
+ * number of hex characters
+ *
+ * @param[out] oData_ptr
+ * output buffer - holds iHexLength / 2 bytes
+ *
+ * @return
+ * void
+ */
+static void referenceHexDecode(uint8_t const *hex_ptr, size_t iHexLength, uint8_t *oData_ptr)
+{
+	uint8_t digit[2];
+
+	for(size_t i = 0; (2 * i + 1) < iHexLength; ++i) {
+		for(uint8_t u = 0; u < 2; ++u) {
+			digit[u] = hex_ptr[2 * i + u];
+			if( ('a' <= digit[u]) && ('f' >= digit[u]) ) {
+				digit[u] -= 87;
+			} else if( ('A' <= digit[u]) && ('F' >= digit[u]) ) {
+				digit[u] -= 55;
+			} else {
+				digit[u] -= '0';
+			}
+		}
+		oData_ptr[i] = (digit[0] << 4) | digit[1];
+	}
+}
+
+/**
+ * This function compares the previous per nibble hex
+ * conversion with the table driven HexCodec for encoding,
+ * decoding and lower case normalisation. Reports cpu
+ * cycles per conversion.
+ *
+ * @param[in] name_ptr
+ * name of the benchmarked data
+ *
+ * @param[in] data_ptr
+ * binary data which is converted
+ *
+ * @param[in] iLength
+ * number of bytes - at most BENCHMARK_PUB_KEY_LENGTH
+ *
+ * @return
+ * void
+ */
+static void benchmarkHexCodec(uint8_t const *name_ptr, uint8_t const *data_ptr, size_t iLength)
+{
+	uint32_t cycles[5] = {0};
+	uint32_t startCycles = 0;
+	Retcode_T ret = RETCODE_SUCCESS;
+
+	for(uint8_t i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+		startCycles = cycleCounterRead();
+		referenceHexEncode(data_ptr, iLength, BenchmarkHexBuff);
+		cycles[0] += cycleCounterRead() - startCycles;
+
+		startCycles = cycleCounterRead();
+		HexEncode(data_ptr, iLength, BenchmarkHexBuff);
+		cycles[1] += cycleCounterRead() - startCycles;
+
+		startCycles = cycleCounterRead();
+		referenceHexDecode(BenchmarkHexBuff, iLength * 2, BenchmarkDataBuff);
+		cycles[2] += cycleCounterRead() - startCycles;
+
+		startCycles = cycleCounterRead();
+		ret |= HexDecode(BenchmarkHexBuff, iLength * 2, BenchmarkDataBuff);
+		cycles[3] += cycleCounterRead() - startCycles;
+
+		startCycles = cycleCounterRead();
+		ret |= HexNormalize(BenchmarkHexBuff, iLength * 2);
+		cycles[4] += cycleCounterRead() - startCycles;
+	}
+
+	if(0 != memcmp(data_ptr, BenchmarkDataBuff, iLength)) {
+		ret = RETCODE_FAILURE;
+	}
+
+	printf("Benchmark hex %s (%u bytes): encode snprintf %lu | table %lu, decode branch %lu | table %lu, normalize %lu cycles%s\n\r",
+			name_ptr, (unsigned int) iLength,
+			(unsigned long) (cycles[0] / BENCHMARK_ITERATIONS), (unsigned long) (cycles[1] / BENCHMARK_ITERATIONS),
+			(unsigned long) (cycles[2] / BENCHMARK_ITERATIONS), (unsigned long) (cycles[3] / BENCHMARK_ITERATIONS),
+			(unsigned long) (cycles[4] / BENCHMARK_ITERATIONS),
+			(RETCODE_SUCCESS == ret) ? "" : " (codec failed)");
+}
+
+#ifdef ENABLE_LOCAL_SIGNING
+/**
+ * This function measures the local signing of a
+ * WRITE_DATA_HASH transaction and the keccak256 hash
+ * of a public key. Reports cpu cycles per operation.
+ *
+ * @param[in] dataHash_ptr
+ * data hash which is written by the transaction
+ *
+ * @return
+ * void
+ */
+static void benchmarkTransactionSigning(uint8_t const *dataHash_ptr)
+{
+	TransactionSignerTx_T tx;
+	ABIArgument_T argument = { ABI_TYPE_BYTES, dataHash_ptr, READ_DATA_HASH_RESULT_LENGTH };
+	uint8_t hash[KECCAK256_HASH_SIZE];
+	uint32_t signCycles = 0;
+	uint32_t keccakCycles = 0;
+	uint32_t startCycles = 0;
+	size_t rawLength = 0;
+	Retcode_T ret = RETCODE_SUCCESS;
+
+	memset(tx.to, 0xC4, sizeof(tx.to));
+	tx.value = 0;
+	tx.gasLimit = UINT32_C(0x47E7C0);
+	ret |= ABIEncodeCallData(ABI_SELECTOR_WRITE_DATA_HASH, &argument, 1, &BenchmarkJSONBuff[TRANSACTION_SIGNER_DATA_OFFSET],
+			sizeof(BenchmarkJSONBuff) - TRANSACTION_SIGNER_DATA_OFFSET - TRANSACTION_SIGNER_SIGNATURE_MAX, &tx.dataLength);
+
+	for(uint8_t i = 0; (i < BENCHMARK_SIGN_ITERATIONS) && (RETCODE_SUCCESS == ret); ++i) {
+		/* the signer moves the transaction to the start of the buffer */
+		if(0 < i) {
+			ret |= ABIEncodeCallData(ABI_SELECTOR_WRITE_DATA_HASH, &argument, 1, &BenchmarkJSONBuff[TRANSACTION_SIGNER_DATA_OFFSET],
+					sizeof(BenchmarkJSONBuff) - TRANSACTION_SIGNER_DATA_OFFSET - TRANSACTION_SIGNER_SIGNATURE_MAX, &tx.dataLength);
+		}
+		startCycles = cycleCounterRead();
+		ret |= TransactionSignerSign(&tx, BenchmarkJSONBuff, sizeof(BenchmarkJSONBuff), &rawLength, hash);
+		signCycles += cycleCounterRead() - startCycles;
+	}
+
+	for(uint8_t i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+		startCycles = cycleCounterRead();
+		Keccak256(BenchmarkDataBuff, sizeof(BenchmarkDataBuff), hash);
+		keccakCycles += cycleCounterRead() - startCycles;
+	}
+
+	printf("Benchmark signing: sign %lu cycles, %u bytes | keccak256 (%u bytes) %lu cycles%s\n\r",
+			(unsigned long) (signCycles / BENCHMARK_SIGN_ITERATIONS), (unsigned int) rawLength,
+			(unsigned int) sizeof(BenchmarkDataBuff), (unsigned long) (keccakCycles / BENCHMARK_ITERATIONS),
+			(RETCODE_SUCCESS == ret) ? "" : " (signing failed)");
+}
+#endif /* ENABLE_LOCAL_SIGNING */
+
+#ifdef ENABLE_ENCRYPTION
+/**
+ * This function returns the public consumer key the encryption
+ * benchmarks encrypt with - PublicRSAKeyConsumer1024 or, with
+ * ENABLE_ECIES_ENCRYPTION, the public key of CONSUMER_ECIES_PRIVATE_KEY
+ *
+ * @param[out] oKey_ptr
+ * reference to the public key
+ *
+ * @param[out] oLength_ptr
+ * length of the public key
+ *
+ * @param[in] keyPair
+ * true, if the private key is needed as well
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T benchmarkConsumerKey(uint8_t const **oKey_ptr, size_t *oLength_ptr, bool keyPair)
+{
+#ifdef ENABLE_ECIES_ENCRYPTION
+	/* the public key is computed from the private key */
+	(void) keyPair;
+	*oKey_ptr = BenchmarkPublicKey;
+	return EncryptionGetPublicKey(BenchmarkPublicKey, sizeof(BenchmarkPublicKey), oLength_ptr);
+#else
+	*oKey_ptr = PublicRSAKeyConsumer1024;
+	*oLength_ptr = strlen((const char*)PublicRSAKeyConsumer1024);
+#ifdef ENABLE_COMPILED_KEYS
+	/* the private key is checked by EncryptionLoadPrivateKey */
+	keyPair = false;
+#endif
+	if( (0 == *oLength_ptr) || ( (true == keyPair) && (0 == strlen((const char*)PrivateRSAKeyConsumer1024)) ) ) {
+		return RETCODE_FAILURE;
+	}
+	return RETCODE_SUCCESS;
+#endif
+}
+
+/**
+ * This function measures the encryption of one sensor
+ * reading. Before, the PEM public key of the consumer was
+ * parsed for every reading - now it is parsed once when it
+ * is read from the blockchain. Reports cpu cycles per reading.
+ * Needs the public consumer key in UserConfig.h.
+ *
+ * @return
+ * void
+ */
+static void benchmarkEncryption(void)
+{
+	uint32_t reading = 0x2D;
+	uint32_t parseCycles = 0;
+	uint32_t cachedCycles = 0;
+	uint32_t startCycles = 0;
+	size_t encryptedLength = 0;
+	uint8_t const *publicKey_ptr = NULL;
+	size_t publicKeyLength = 0;
+	Retcode_T ret = RETCODE_SUCCESS;
+
+	if(RETCODE_SUCCESS != benchmarkConsumerKey(&publicKey_ptr, &publicKeyLength, false)) {
+		printf("Benchmark encryption: no public consumer key\n\r");
+		return;
+	}
+
+	/* previous path - parse the key for every reading */
+	for(uint8_t i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+		startCycles = cycleCounterRead();
+		ret |= EncryptionStoreConsumerKey(NULL, publicKey_ptr, publicKeyLength);
+		AuthenticatedConsumerTable[0].activeConsumer = true;
+		ret |= encryptData((uint8_t const*)&reading, sizeof(reading), BenchmarkEncryptedBuff, sizeof(BenchmarkEncryptedBuff), &encryptedLength);
+		parseCycles += cycleCounterRead() - startCycles;
+	}
+
+	/* cached key */
+	for(uint8_t i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+		startCycles = cycleCounterRead();
+		AuthenticatedConsumerTable[0].activeConsumer = true;
+		ret |= encryptData((uint8_t const*)&reading, sizeof(reading), BenchmarkEncryptedBuff, sizeof(BenchmarkEncryptedBuff), &encryptedLength);
+		cachedCycles += cycleCounterRead() - startCycles;
+	}
+
+	/* release the benchmark keys - no consumer is authenticated yet */
+	for(uint8_t i = 0; i < CONSUMER_NUMBER_MAX; ++i) {
+		(void) EncryptionStoreConsumerKey(NULL, NULL, 0);
+	}
+
+	printf("Benchmark encryption (%s): parse+encrypt %lu cycles | cached key %lu cycles, %u bytes%s\n\r", BENCHMARK_ENCRYPTION_SCHEME,
+			(unsigned long) (parseCycles / BENCHMARK_ITERATIONS), (unsigned long) (cachedCycles / BENCHMARK_ITERATIONS),
+			(unsigned int) encryptedLength, (RETCODE_SUCCESS == ret) ? "" : " (encryption failed)");
+}
+
+/**
+ * This function measures the startup cost of the private
+ * consumer key - parsing the PEM string or copying the
+ * limbs of RSAKeys.h with ENABLE_COMPILED_KEYS. With
+ * ENABLE_ECIES_ENCRYPTION the scalar is imported and the
+ * public key computed, the cost of a key generation.
+ * Reports cpu cycles per load.
+ *
+ * @return
+ * void
+ */
+static void benchmarkKeyLoad(void)
+{
+	uint32_t loadCycles = 0;
+	uint32_t startCycles = 0;
+	Retcode_T ret = RETCODE_SUCCESS;
+
+	for(uint8_t i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+		startCycles = cycleCounterRead();
+		ret |= EncryptionLoadPrivateKey();
+		loadCycles += cycleCounterRead() - startCycles;
+	}
+
+#if defined(ENABLE_ECIES_ENCRYPTION)
+	printf("Benchmark key load: elliptic curve key and public key %lu cycles%s\n\r",
+#elif defined(ENABLE_COMPILED_KEYS)
+	printf("Benchmark key load: compiled limbs %lu cycles%s\n\r",
+#else
+	printf("Benchmark key load: PEM parser %lu cycles%s\n\r",
+#endif
+			(unsigned long) (loadCycles / BENCHMARK_ITERATIONS), (RETCODE_SUCCESS == ret) ? "" : " (no private key)");
+}
+
+/**
+ * This function measures the decryption of one encrypted
+ * sensor reading. Before, the PEM private key was parsed for
+ * every payload - now it is parsed once by InitMbedCrypto and
+ * the RSA context stays resident. Reports cpu cycles per
+ * payload. Needs the consumer key pair in UserConfig.h.
+ *
+ * @return
+ * void
+ */
+static void benchmarkDecryption(void)
+{
+	uint32_t reading = 0x2D;
+	uint32_t decryptedReading = 0;
+	uint32_t parseCycles = 0;
+	uint32_t residentCycles = 0;
+	uint32_t startCycles = 0;
+	size_t encryptedLength = 0;
+	size_t decryptedLength = 0;
+	uint8_t const *publicKey_ptr = NULL;
+	size_t publicKeyLength = 0;
+	Retcode_T ret = RETCODE_SUCCESS;
+
+	if(RETCODE_SUCCESS != benchmarkConsumerKey(&publicKey_ptr, &publicKeyLength, true)) {
+		printf("Benchmark decryption: no consumer key pair\n\r");
+		return;
+	}
+
+	/* encrypt one reading with the public key of the pair */
+	ret |= EncryptionStoreConsumerKey(NULL, publicKey_ptr, publicKeyLength);
+	AuthenticatedConsumerTable[0].activeConsumer = true;
+	ret |= encryptData((uint8_t const*)&reading, sizeof(reading), BenchmarkEncryptedBuff, sizeof(BenchmarkEncryptedBuff), &encryptedLength);
+	(void) EncryptionStoreConsumerKey(NULL, NULL, 0);
+
+	/* previous path - parse the key for every payload */
+	for(uint8_t i = 0; (i < BENCHMARK_ITERATIONS) && (RETCODE_SUCCESS == ret); ++i) {
+		startCycles = cycleCounterRead();
+		ret |= EncryptionLoadPrivateKey();
+		ret |= decryptData(BenchmarkEncryptedBuff, encryptedLength, (uint8_t*)&decryptedReading, sizeof(decryptedReading), &decryptedLength);
+		parseCycles += cycleCounterRead() - startCycles;
+	}
+
+	/* resident key */
+	for(uint8_t i = 0; (i < BENCHMARK_ITERATIONS) && (RETCODE_SUCCESS == ret); ++i) {
+		startCycles = cycleCounterRead();
+		ret |= decryptData(BenchmarkEncryptedBuff, encryptedLength, (uint8_t*)&decryptedReading, sizeof(decryptedReading), &decryptedLength);
+		residentCycles += cycleCounterRead() - startCycles;
+	}
+
+	printf("Benchmark decryption (%s): parse+decrypt %lu cycles | resident key %lu cycles%s\n\r", BENCHMARK_ENCRYPTION_SCHEME,
+			(unsigned long) (parseCycles / BENCHMARK_ITERATIONS), (unsigned long) (residentCycles / BENCHMARK_ITERATIONS),
+			( (RETCODE_SUCCESS == ret) && (reading == decryptedReading) ) ? "" : " (decryption failed)");
+}
+
+#ifdef ENABLE_HYBRID_ENCRYPTION
+/**
+ * This function measures the hybrid mode for growing sensor
+ * batches: the first message of a session with the wrapped
+ * key and a following message of the session. Reports message
+ * bytes and cpu cycles of encryption and decryption - without
+ * the wrapped key both scale with the batch, not with the public key.
+ *
+ * @return
+ * void
+ */
+static void benchmarkHybridEncryption(void)
+{
+	size_t const batchSizes[] = { 1, 32, BENCHMARK_HYBRID_BATCH_MAX };
+	uint8_t batch[BENCHMARK_HYBRID_BATCH_MAX];
+	uint8_t decrypted[BENCHMARK_HYBRID_BATCH_MAX];
+	uint32_t cycles[4] = { 0 };
+	uint32_t startCycles = 0;
+	size_t keyLength = 0;
+	size_t dataLength = 0;
+	size_t decryptedLength = 0;
+	uint8_t const *publicKey_ptr = NULL;
+	size_t publicKeyLength = 0;
+	Retcode_T ret = RETCODE_SUCCESS;
+
+	if(RETCODE_SUCCESS != benchmarkConsumerKey(&publicKey_ptr, &publicKeyLength, true)) {
+		printf("Benchmark hybrid encryption: no consumer key pair\n\r");
+		return;
+	}
+
+	for(size_t i = 0; i < sizeof(batch); ++i) {
+		batch[i] = (uint8_t) (i * 7 + 0x2D);
+	}
+
+	for(uint8_t size = 0; size < sizeof(batchSizes) / sizeof(batchSizes[0]); ++size) {
+		/* a new consumer key starts a new session */
+		ret = EncryptionStoreConsumerKey(NULL, publicKey_ptr, publicKeyLength);
+
+		/* first message - wraps the session key */
+		startCycles = cycleCounterRead();
+		AuthenticatedConsumerTable[0].activeConsumer = true;
+		ret |= encryptDataHybrid(batch, batchSizes[size], BenchmarkHybridKeyBuff, sizeof(BenchmarkHybridKeyBuff), &keyLength);
+		cycles[0] = cycleCounterRead() - startCycles;
+
+		/* following message of the session */
+		startCycles = cycleCounterRead();
+		AuthenticatedConsumerTable[0].activeConsumer = true;
+		ret |= encryptDataHybrid(batch, batchSizes[size], BenchmarkEncryptedBuff, sizeof(BenchmarkEncryptedBuff), &dataLength);
+		cycles[1] = cycleCounterRead() - startCycles;
+
+		startCycles = cycleCounterRead();
+		ret |= decryptDataHybrid(BenchmarkHybridKeyBuff, keyLength, decrypted, sizeof(decrypted), &decryptedLength);
+		cycles[2] = cycleCounterRead() - startCycles;
+
+		startCycles = cycleCounterRead();
+		ret |= decryptDataHybrid(BenchmarkEncryptedBuff, dataLength, decrypted, sizeof(decrypted), &decryptedLength);
+		cycles[3] = cycleCounterRead() - startCycles;
+
+		if( (RETCODE_SUCCESS == ret) && (0 != memcmp(batch, decrypted, batchSizes[size])) ) {
+			ret = RETCODE_FAILURE;
+		}
+
+		printf("Benchmark hybrid %u bytes: key message %u bytes enc %lu dec %lu cycles | data message %u bytes enc %lu dec %lu cycles%s\n\r",
+				(unsigned int) batchSizes[size], (unsigned int) keyLength, (unsigned long) cycles[0], (unsigned long) cycles[2],
+				(unsigned int) dataLength, (unsigned long) cycles[1], (unsigned long) cycles[3], (RETCODE_SUCCESS == ret) ? "" : " (failed)");
+	}
+
+	/* release the benchmark keys - no consumer is authenticated yet */
+	for(uint8_t i = 0; i < CONSUMER_NUMBER_MAX; ++i) {
+		(void) EncryptionStoreConsumerKey(NULL, NULL, 0);
+	}
+}
+#endif /* ENABLE_HYBRID_ENCRYPTION */
+#endif /* ENABLE_ENCRYPTION */
+
+/**
+ * This function compares the cJSON based request
+ * generation with the streaming JSON writer in
+ * genJSONRequest. Reports cpu cycles, JSON string
+ * length and heap allocations per request.
+ *
+ * @param[in] name_ptr
+ * name of the benchmarked request
+ *
+ * @param[in] etherMethod
+ * ethereum function which is benchmarked
+ *
+ * @param[in] payload_ptr
+ * payload of the request
+ *
+ * @param[in] iPayloadLength
+ * length of the payload
+ *
+ * @return
+ * void
+ */
+static void benchmarkJSONRequest(uint8_t const *name_ptr, etherFuncCalls etherMethod, uint8_t const *payload_ptr, size_t iPayloadLength)
+{
+	cJSON_Hooks hooks = { countingMalloc, free };
+	uint32_t cJSONCycles = 0;
+	uint32_t writerCycles = 0;
+	uint32_t startCycles = 0;
+	size_t cJSONLength = 0;
+	size_t writerLength = 0;
+	Retcode_T ret = RETCODE_SUCCESS;
+
+	cJSON_InitHooks(&hooks);
+	BenchmarkMallocCounter = 0;
+	for(uint8_t i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+		startCycles = cycleCounterRead();
+		genCJSONRequest(etherMethod, payload_ptr, iPayloadLength, &cJSONLength);
+		cJSONCycles += cycleCounterRead() - startCycles;
+	}
+	cJSON_InitHooks(NULL);
+
+	for(uint8_t i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+		startCycles = cycleCounterRead();
+		ret |= genJSONRequest(etherMethod, BENCHMARK_ACCOUNT_ADDRESS, BENCHMARK_CONTRACT_ADDRESS, payload_ptr, iPayloadLength, etherMethod, BenchmarkJSONBuff, sizeof(BenchmarkJSONBuff), &writerLength);
+		writerCycles += cycleCounterRead() - startCycles;
+	}
+
+	printf("Benchmark %s: cJSON %lu cycles, %u bytes, %lu mallocs | writer %lu cycles, %u bytes, 0 mallocs%s\n\r",
+			name_ptr,
+			(unsigned long) (cJSONCycles / BENCHMARK_ITERATIONS), (unsigned int) cJSONLength,
+			(unsigned long) (BenchmarkMallocCounter / BENCHMARK_ITERATIONS),
+			(unsigned long) (writerCycles / BENCHMARK_ITERATIONS), (unsigned int) writerLength,
+			(RETCODE_SUCCESS == ret) ? "" : " (writer failed)");
+}
+
+/**
+ * This function sends BENCHMARK_ITERATIONS eth_blockNumber
+ * requests over one transport. Reports the mean and maximum
+ * request latency and the bytes on the wire per request.
+ *
+ * @param[in] transport_ptr
+ * This reference holds the benchmarked transport
+ *
+ * @return
+ * void
+ */
+static void benchmarkTransport(Transport_T const *transport_ptr)
+{
+	TransportStats_T before = {0};
+	TransportStats_T after = {0};
+	HttpRequestID_T requestID = HTTP_REQUEST_ID_INVALID;
+	portTickType startTick = 0;
+	uint32_t latency = 0;
+	uint32_t totalLatency = 0;
+	uint32_t maxLatency = 0;
+	uint8_t failures = 0;
+
+	if(RETCODE_SUCCESS != HttpSetTransport(transport_ptr)) {
+		printf("Benchmark transport %s: not available\n\r", transport_ptr->name_ptr);
+		return;
+	}
+	transport_ptr->getStats(&before);
+
+	for(uint8_t i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+		startTick = xTaskGetTickCount();
+		if( (RETCODE_SUCCESS != HttpRequestSend(BLOCK_NUMBER, "na", "na", NULL, 0, &requestID))
+				|| (RETCODE_SUCCESS != HttpRequestWait(requestID, HTTPRESPONSE_SECONDSTOWAIT * 1000)) ) {
+			failures++;
+		}
+		HttpRequestRelease(requestID);
+		latency = TICKS_TO_MS(xTaskGetTickCount() - startTick);
+		totalLatency += latency;
+		if(latency > maxLatency) {
+			maxLatency = latency;
+		}
+	}
+
+	transport_ptr->getStats(&after);
+	printf("Benchmark transport %s: mean %lu ms, max %lu ms, %lu bytes sent, %lu bytes received per request, %lu connections, %u failed\n\r",
+			transport_ptr->name_ptr, (unsigned long) (totalLatency / BENCHMARK_ITERATIONS), (unsigned long) maxLatency,
+			(unsigned long) ((after.bytesSent - before.bytesSent) / BENCHMARK_ITERATIONS),
+			(unsigned long) ((after.bytesReceived - before.bytesReceived) / BENCHMARK_ITERATIONS),
+			(unsigned long) (after.connectionCounter - before.connectionCounter), (unsigned int) failures);
+}
+
+/**
+ * This function measures the throughput of one transport.
+ * BENCHMARK_ITERATIONS times HTTP_REQUEST_SLOT_MAX
+ * eth_blockNumber requests are sent at once and waited
+ * for. Reports requests per second - point HTTP_IP_ADDRESS
+ * to tools/mock_node.py to compare the transports without
+ * the block processing of a real node.
+ *
+ * @param[in] transport_ptr
+ * This reference holds the benchmarked transport
+ *
+ * @return
+ * void
+ */
+static void benchmarkThroughput(Transport_T const *transport_ptr)
+{
+	HttpRequestID_T requestID[HTTP_REQUEST_SLOT_MAX];
+	portTickType startTick = 0;
+	uint32_t elapsed = 0;
+	uint32_t answered = 0;
+
+	if(RETCODE_SUCCESS != HttpSetTransport(transport_ptr)) {
+		printf("Benchmark throughput %s: not available\n\r", transport_ptr->name_ptr);
+		return;
+	}
+
+	startTick = xTaskGetTickCount();
+	for(uint8_t i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+		for(uint8_t request = 0; request < HTTP_REQUEST_SLOT_MAX; ++request) {
+			if(RETCODE_SUCCESS != HttpRequestSend(BLOCK_NUMBER, "na", "na", NULL, 0, &requestID[request])) {
+				requestID[request] = HTTP_REQUEST_ID_INVALID;
+			}
+		}
+		for(uint8_t request = 0; request < HTTP_REQUEST_SLOT_MAX; ++request) {
+			if( (HTTP_REQUEST_ID_INVALID != requestID[request]) && (RETCODE_SUCCESS == HttpRequestWait(requestID[request], HTTPRESPONSE_SECONDSTOWAIT * 1000)) ) {
+				answered++;
+			}
+			HttpRequestRelease(requestID[request]);
+		}
+	}
+	elapsed = TICKS_TO_MS(xTaskGetTickCount() - startTick);
+
+	printf("Benchmark throughput %s: %lu of %u requests in %lu ms, %lu requests/s\n\r",
+			transport_ptr->name_ptr, (unsigned long) answered, (unsigned int) (BENCHMARK_ITERATIONS * HTTP_REQUEST_SLOT_MAX),
+			(unsigned long) elapsed, (unsigned long) ((0 < elapsed) ? (answered * 1000 / elapsed) : 0));
+}
+
+/**
+ * This function compares the request latency and the
+ * bytes on the wire of the json rpc transports. Must be
+ * called from a task after HttpInit while no other task
+ * sends requests. The configured transport is selected
+ * again afterwards.
+ *
+ * @return
+ * void
+ */
+void RunTransportBenchmark(void)
+{
+	Transport_T const *transport_ptr = HttpGetTransport();
+
+	benchmarkTransport(LoopbackTransportGet());
+	benchmarkTransport(HttpTransportGet());
+	benchmarkTransport(WebSocketTransportGet());
+	benchmarkTransport(PipelineTransportGet());
+
+	benchmarkThroughput(HttpTransportGet());
+	benchmarkThroughput(PipelineTransportGet());
+	printf("Benchmark throughput http-pipeline: depth %u\n\r", (unsigned int) PipelineTransportGetDepth());
+
+	(void) HttpSetTransport(transport_ptr);
+}
+
+/**
+ * This task runs the transport benchmark once after
+ * the startup and deletes itself
+ *
+ * @param[in] pvParameters
+ * Task parameters - not used
+ *
+ * @return
+ * void
+ */
+void TransportBenchmarkCyclic(void* pvParameters)
+{
+	(void) pvParameters;
+
+	RunTransportBenchmark();
+	vTaskDelete(NULL);
+}
+
+/**
+ * This function runs all on-device benchmarks once
+ * and prints the results. Must be called before the
+ * first json-rpc request is sent because the http
+ * payload buffer is used.
+ *
+ * @return
+ * void
+ */
+void RunBenchmarks(void)
+{
+	uint8_t publicKey[BENCHMARK_PUB_KEY_LENGTH];
+
+	/* deterministic example payload */
+	for(size_t i = 0; i < sizeof(publicKey); ++i) {
+		publicKey[i] = (uint8_t) (i * 7 + 0x2D);
+	}
+
+	cycleCounterStart();
+
+#ifdef ENABLE_LOCAL_SIGNING
+	/* sign with a dummy nonce - the nonce of the account is read
+	 * from the node before the first real transaction */
+	TransactionSignerSetNonce(0);
+#endif
+
+	benchmarkJSONRequest("READ_DATA_HASH", READ_DATA_HASH, NULL, 0);
+	benchmarkJSONRequest("WRITE_PUBLIC_KEY", WRITE_PUBLIC_KEY, publicKey, sizeof(publicKey));
+	benchmarkJSONRequest("GET_TRANSACTION_RECEIPT", GET_TRANSACTION_RECEIPT, BENCHMARK_TRANSACTION_HASH, strlen(BENCHMARK_TRANSACTION_HASH));
+
+	benchmarkHexCodec("public key", publicKey, sizeof(publicKey));
+	benchmarkHexCodec("data hash", publicKey, READ_DATA_HASH_RESULT_LENGTH);
+
+#ifdef ENABLE_ENCRYPTION
+	benchmarkEncryption();
+	benchmarkKeyLoad();
+	benchmarkDecryption();
+#ifdef ENABLE_HYBRID_ENCRYPTION
+	benchmarkHybridEncryption();
+#endif
+#endif
+
+#ifdef ENABLE_LOCAL_SIGNING
+	benchmarkTransactionSigning(publicKey);
+	TransactionSignerInvalidateNonce();
+#endif
+}
+
+#endif /* ENABLE_BENCHMARK */
@@ -0,0 +1,23 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_BENCHMARK_H_
+#define SOURCE_BENCHMARK_H_
+
+/* number of runs each benchmark is averaged over */
+#define BENCHMARK_ITERATIONS	10
+
+/* global interface task declarations */
+xTaskHandle TransportBenchmarkTask;
+
+/* global interface function declarations */
+void RunBenchmarks(void);
+void RunTransportBenchmark(void);
+void TransportBenchmarkCyclic(void* pvParameters);
+
+#endif /* SOURCE_BENCHMARK_H_ */
@@ -29,6 +29,7 @@
 #include "Http.h"
 #include "SensorData.h"
 #include "SecureEdgeDevice.h"
+#include "ReadCache.h"
 
 /* locally used defines */
 #define ENCRYPTED_DATA_PAYLOAD_SIZE 	128
@@ -75,6 +76,10 @@ retcode_t CoAPClientResponseCallback(CoapSession_T *coapSession_ptr, Msg_T *msg_
 	BaseType_t queueResult = pdFAIL;
 	CoapPayloadLength_t iEncryptedLength = 0;
 	queueHandler_T queueHandlerCoAPClient = {0};
+#ifdef ENABLE_ECIES_ENCRYPTION
+	uint8_t publicKey[ENCRYPTION_ECIES_SECP256R1_KEY_SIZE] = {0};
+	size_t publicKeyLength = 0;
+#endif
 
 	/* setup CoAP parser */
     CoapParser_setup(&parser, msg_ptr);
@@ -97,7 +102,15 @@ retcode_t CoAPClientResponseCallback(CoapSession_T *coapSession_ptr, Msg_T *msg_
     		/* extract information out of producer response */
     		strncpy(ContractAddressBuffer, &payload_ptr[strlen("ContractAddress_")], sizeof(ContractAddressBuffer));
     		/* write public key into blockchain */
+#ifdef ENABLE_ECIES_ENCRYPTION
+    		/* the elliptic curve key - the producer encrypts with ECIES */
+    		status = RC_SERVAL_ERROR;
+    		if(RETCODE_SUCCESS == EncryptionGetPublicKey(publicKey, sizeof(publicKey), &publicKeyLength)) {
+    			status = sendHttpDLTClientRequest(WRITE_PUBLIC_KEY, CONSUMER_ACCOUNT_ADDRESS, ContractAddressBuffer, publicKey, publicKeyLength);
+    		}
+#else
     		status = sendHttpDLTClientRequest(WRITE_PUBLIC_KEY, CONSUMER_ACCOUNT_ADDRESS, ContractAddressBuffer, PublicRSAKeyConsumer1024, strlen(PublicRSAKeyConsumer1024));
+#endif
 #ifdef ENABLE_DEBUG
     		if(RC_OK != status) {
     			printf("Error while writing public key into blockchain\n\r");
@@ -116,9 +129,22 @@ retcode_t CoAPClientResponseCallback(CoapSession_T *coapSession_ptr, Msg_T *msg_
 #ifdef ENABLE_DEBUG
 			printf("CoAPClient server response: %s; Length: %i\n\r", payload_ptr, iEncryptedLength);
 #endif
+#if defined(ENABLE_HYBRID_ENCRYPTION) || defined(ENABLE_ECIES_ENCRYPTION)
+			/* prepare encrypted data for queue - the hybrid and ECIES message size depends on the data */
+			queueHandlerCoAPClient.queuePayloadLength = (iEncryptedLength > strlen("Data_")) ? (iEncryptedLength - strlen("Data_")) : 0;
+			if(queueHandlerCoAPClient.queuePayloadLength > sizeof(queueHandlerCoAPClient.queuePayload)) {
+				queueHandlerCoAPClient.queuePayloadLength = sizeof(queueHandlerCoAPClient.queuePayload);
+			}
+#else
 			/* prepare encrypted data for queue - encrypted data always padded to ENCRYPTED_DATA_PAYLOAD_SIZE */
 			queueHandlerCoAPClient.queuePayloadLength = ENCRYPTED_DATA_PAYLOAD_SIZE;
-	    	memcpy(queueHandlerCoAPClient.queuePayload, &payload_ptr[strlen("Data_")], ENCRYPTED_DATA_PAYLOAD_SIZE);
+#endif
+	    	memcpy(queueHandlerCoAPClient.queuePayload, &payload_ptr[strlen("Data_")], queueHandlerCoAPClient.queuePayloadLength);
+#ifdef ENABLE_READ_CACHE
+	    	/* the producer stored the hash of the new data - a cached
+	    	 * hash belongs to the previous data */
+	    	ReadCacheInvalidate();
+#endif
 	    	/* push prepared data into queue */
 	    	queueResult = xQueueSend(dataQueue, &queueHandlerCoAPClient, 0);
 
@@ -398,6 +424,10 @@ void processSensorPayloadDataCyclic(void* pvParameters)
 	(void) pvParameters;
 	Retcode_T ret = RETCODE_FAILURE;
 	BaseType_t queueResult = pdFAIL;
+#ifdef ENABLE_HYBRID_ENCRYPTION
+	/* average acceleration followed by its profile */
+	uint8_t decryptedBatch[1 + ACCELERATION_PROFILE_SIZE] = {0};
+#endif
 	uint8_t decryptedData = 0;
 	size_t outputLength = 0;
 	uint8_t dataHashBuffer[DATA_HASH_BUFF_SIZE] = {0};
@@ -425,7 +455,12 @@ void processSensorPayloadDataCyclic(void* pvParameters)
 			}
 			/* decrypt data */
 			if(RETCODE_SUCCESS == ret) {
+#ifdef ENABLE_HYBRID_ENCRYPTION
+				ret = decryptDataHybrid(queueHandlerCoAPClient.queuePayload, queueHandlerCoAPClient.queuePayloadLength, decryptedBatch, sizeof(decryptedBatch), &outputLength);
+				decryptedData = ( (RETCODE_SUCCESS == ret) && (0 < outputLength) ) ? decryptedBatch[0] : 0;
+#else
 				ret = decryptData(queueHandlerCoAPClient.queuePayload, queueHandlerCoAPClient.queuePayloadLength, &decryptedData, sizeof(decryptedData), &outputLength );
+#endif
 				/* switch LEDs dependent on accel value */
 				if(decryptedData >= ACCELEROMETER_VALUE_THRESHHOLD) {
 					BSP_LED_Switch((uint32_t) BSP_XDK_LED_R, (uint32_t) BSP_LED_COMMAND_ON);
@@ -30,6 +30,7 @@
 #include "Http.h"
 #include "SensorData.h"
 #include "SecureEdgeDevice.h"
+#include "HexCodec.h"
 
 /* ethereum account information */
 #define ENCRYPTED_BUFF_SIZE			256
@@ -38,6 +39,14 @@
 #define CLIENT_OPTION_BUFF_SIZE		56
 #define CALLBACK_RESPONSE_BUFF_SIZE	256
 
+#ifdef ENABLE_HYBRID_ENCRYPTION
+/* sensor batch: average acceleration followed by its profile */
+#define SENSOR_BATCH_SIZE			(1 + ACCELERATION_PROFILE_SIZE)
+#if (SENSOR_BATCH_SIZE + ENCRYPTION_HYBRID_OVERHEAD_MAX + 5) > CALLBACK_RESPONSE_BUFF_SIZE
+#error "the hybrid message of the sensor batch does not fit into the Data_ response"
+#endif
+#endif
+
 /* state machine enum */
 typedef enum producerDataProcessingState {
 	DATA_PROCESSING_START = 0,
@@ -60,46 +69,6 @@ static bool ConsumerAuthenticated = false;
 /* authentication table definition - stores consumer account+pubKey information */
 AuthConsumer_T AuthenticatedConsumerTable[CONSUMER_NUMBER_MAX] = { 0 };
 
-/**
- * This function is called to convert capital letters of
- * an incoming ethereum address to lower case letters
- * because the ethereum network is case insensitive.
- *
- * @param[in] stringToConvert_ptr
- * Pointer to the string which should be converted
- * to lower case
- *
- * @param[in] iStringSize
- * This variable holds the size of the incoming
- * string.
- *
- * @param[out] oBuff
- * This buffer will hold the converted input string
- * with only lower case letters
- *
- * @return
- * void
- */
-void convertUppercaseToLowercase(uint8_t *stringToConvert_ptr, size_t iStringSize, uint8_t *oBuff)
-{
-	uint8_t tempBuff[CONTRACT_ADDRESS_LENGTH] = {0};
-
-	/* check for null pointer */
-	if(NULL != stringToConvert_ptr) {
-		/* convert numbers from ascii format to int value (atoi
-		 * does not support hex numbers larger then 9) */
-		for(size_t i = 0; i < iStringSize; ++i) {
-			if( ('A' <= stringToConvert_ptr[i]) && ('F' >= stringToConvert_ptr[i]) ) {
-				tempBuff[i] = stringToConvert_ptr[i] + 32;
-			} else {
-				/* keep numbers and lowercase letters */
-				tempBuff[i] = stringToConvert_ptr[i];
-			}
-		}
-		strncpy(oBuff, tempBuff, CONTRACT_ADDRESS_LENGTH);
-	}
-}
-
 /**
  * This function is called to parse an incoming
  * CoAP request
@@ -293,7 +262,7 @@ static retcode_t CoAPServerReceiveCallback(Msg_T *msg_ptr, retcode_t status)
     BaseType_t queueResult = pdFAIL;
     queueHandler_T queueHandlerCoAP = {0};
     uint8_t consumerEthAccountBuffer[CONTRACT_ADDRESS_LENGTH] = {0};
-    uint8_t consumerEthAccountBufferTemp[CONTRACT_ADDRESS_LENGTH] = {0};
+    uint8_t const *consumerEthAccountEnd_ptr = NULL;
     uint8_t contractAddressBuffer[CONTRACT_ADDRESS_LENGTH * 2] = {0};
 
     /* parse the incoming consumer request */
@@ -309,13 +278,20 @@ static retcode_t CoAPServerReceiveCallback(Msg_T *msg_ptr, retcode_t status)
 #endif
 			/* reset buffers */
 			memset(consumerEthAccountBuffer, 0, sizeof(consumerEthAccountBuffer));
-			memset(consumerEthAccountBufferTemp, 0, sizeof(consumerEthAccountBufferTemp));
-			strncpy(consumerEthAccountBufferTemp, ClientPayload, sizeof(consumerEthAccountBufferTemp));
+			strncpy(consumerEthAccountBuffer, ClientPayload, sizeof(consumerEthAccountBuffer));
 
 			/* convert upper case letters to lower case letters
 			 * because address is stored in lower case letters
 			 * on the ethereum blockchain */
-			convertUppercaseToLowercase(consumerEthAccountBufferTemp, sizeof(consumerEthAccountBufferTemp), consumerEthAccountBuffer);
+			consumerEthAccountEnd_ptr = memchr(consumerEthAccountBuffer, '\0', sizeof(consumerEthAccountBuffer));
+			if(RETCODE_SUCCESS != HexNormalize(consumerEthAccountBuffer, (NULL != consumerEthAccountEnd_ptr) ? (size_t) (consumerEthAccountEnd_ptr - consumerEthAccountBuffer) : sizeof(consumerEthAccountBuffer))) {
+#ifdef ENABLE_DEBUG
+				printf("Consumer account address invalid\n\r");
+#endif
+				/* the address can not be compared with the stored addresses */
+				CoAPServerSendCoAPResponse(msg_ptr, "Error: Invalid account address", strlen("Error: Invalid account address"));
+				return RC_SERVAL_ERROR;
+			}
 
 			/* check if incoming account address is already authenticated */
 			for(uint8_t counter = 0; counter < CONSUMER_NUMBER_MAX; ++counter) {
@@ -465,6 +441,9 @@ void prepareSensorPayloadData(void* pvParameters)
 	 * uint8_t humiditySensorData = 0;
 	*/
 	uint8_t accelerometerSensorData = 0;
+#ifdef ENABLE_HYBRID_ENCRYPTION
+	uint8_t sensorBatch[SENSOR_BATCH_SIZE] = {0};
+#endif
 	uint8_t dataHashBuff[DATA_HASH_BUFF_SIZE] = {0};
 	uint8_t EncryptedBuffLocal[ENCRYPTED_BUFF_SIZE] = {0};
 	size_t oLength = 0;
@@ -527,13 +506,21 @@ void prepareSensorPayloadData(void* pvParameters)
 				accelerometerSensorData = GetAccelerometerSensorData();
 #ifdef ENABLE_DEBUG
 				printf("Accelerometer sensor data: %i\n\r", accelerometerSensorData);
+#endif
+#ifdef ENABLE_HYBRID_ENCRYPTION
+				sensorBatch[0] = accelerometerSensorData;
+				(void) GetAccelerometerSensorProfile(&sensorBatch[1], sizeof(sensorBatch) - 1);
 #endif
 				DataProcessingState = DATA_PROCESSING_ENCRYPT;
 			break;
 
 			case DATA_PROCESSING_ENCRYPT:
 				/* start data encryption */
+#ifdef ENABLE_HYBRID_ENCRYPTION
+				ret = encryptDataHybrid(sensorBatch, sizeof(sensorBatch), EncryptedBuffLocal, sizeof(EncryptedBuffLocal), &oLength);
+#else
 				ret = encryptData(&accelerometerSensorData, sizeof(accelerometerSensorData), EncryptedBuffLocal, sizeof(EncryptedBuffLocal), &oLength);
+#endif
 
 				if(RETCODE_SUCCESS == ret) {
 					/* prepare queue data */
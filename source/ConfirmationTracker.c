@@ -0,0 +1,588 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BCDS_Basics.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* user includes */
+#include "ConfirmationTracker.h"
+#include "UserConfig.h"
+#include "SystemConfig.h"
+#include "Http.h"
+#include "ReadCache.h"
+
+/* marks a tracker entry which is not part of a receipt batch */
+#define CONFIRMATION_TRACKER_NO_BATCH_SLOT	0xFF
+
+/* new block interval samples are weighted with 1/CONFIRMATION_BLOCK_INTERVAL_WEIGHT */
+#define CONFIRMATION_BLOCK_INTERVAL_WEIGHT	4
+
+/* error message of a node which does not know a filter id */
+#define CONFIRMATION_FILTER_NOT_FOUND		"filter not found"
+
+/* upper bound of the filter poll delay in milliseconds */
+#define CONFIRMATION_POLL_MAX_TIME_MS		(CONFIRMATION_TIME_TO_WAIT * 1000)
+
+/* states of a tracker entry */
+typedef enum confirmationEntryState_E {
+	CONFIRMATION_ENTRY_FREE = 0,
+	CONFIRMATION_ENTRY_REGISTERING,	/* entry allocated, waiter copies the hash */
+	CONFIRMATION_ENTRY_PENDING,		/* receipt is checked with every new block */
+	CONFIRMATION_ENTRY_DONE			/* transaction confirmed, waiter is signaled */
+} confirmationEntryState_T;
+
+/**
+ * This struct holds one transaction which a task waits for.
+ * The sequence number tells apart the registrations of an
+ * entry so a late receipt never completes the next waiter.
+ */
+typedef struct confirmationEntry_S {
+	confirmationEntryState_T state;
+	uint8_t sequence;
+	bool newEntry;
+	bool confirmed;
+	portTickType registerTick;
+	uint8_t transactionHash[TRANSACTION_HASH_RESULT_LENGTH];
+	SemaphoreHandle_t confirmationSemaphore;
+} confirmationEntry_T;
+static confirmationEntry_T confirmationTrackerTable[CONFIRMATION_TRACKER_ENTRY_MAX];
+
+/**
+ * This handler struct holds the block filter of the node,
+ * the semaphore which wakes up the tracker task and the
+ * estimated tick of the last block
+ */
+typedef struct confirmationTrackerHandler_S {
+	SemaphoreHandle_t wakeSemaphore;
+	uint8_t filterID[TRANSACTION_HASH_RESULT_LENGTH + 1];
+	bool filterLost;			/* the node reported the filter as unknown - replaced with the next poll */
+	bool blockTickValid;
+	portTickType lastBlockTick;
+	portTickType lastPollTick;
+} confirmationTrackerHandler_T;
+static confirmationTrackerHandler_T confirmationTrackerHandleVar = {0};
+
+/* block interval estimate, poll and latency counters */
+static ConfirmationTrackerStats_T confirmationTrackerStatsVar = {0};
+
+/**
+ * This function sends one json rpc call of the tracker
+ * and waits for its result
+ *
+ * @param[in] ethMethod
+ * This variable holds the method which shall be called
+ *
+ * @param[in] payload_ptr
+ * This reference holds the parameter of the call. Can be
+ * NULL for calls without parameters.
+ *
+ * @param[out] oResult_ptr
+ * This reference will hold the result of the call
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T sendTrackerRequest(etherFuncCalls ethMethod, uint8_t const *payload_ptr, HttpCallResult_T *oResult_ptr)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	HttpRequestID_T requestID = HTTP_REQUEST_ID_INVALID;
+
+	memset(oResult_ptr, 0, sizeof(*oResult_ptr));
+	ret = HttpRequestSend(ethMethod, "na", "na", payload_ptr, (NULL != payload_ptr) ? strlen(payload_ptr) : 0, &requestID);
+	if(RETCODE_SUCCESS == ret) {
+		ret = HttpRequestWait(requestID, HTTP_REQUEST_DEADLINE_DEFAULT);
+		if(RETCODE_SUCCESS == ret) {
+			ret = HttpRequestGetResult(requestID, 0, oResult_ptr);
+		}
+		HttpRequestRelease(requestID);
+	}
+
+	return ret;
+}
+
+/**
+ * This function installs a new block filter on the node.
+ * Its id is used for all following filter polls. A filter
+ * which is replaced is uninstalled first so the node does
+ * not keep collecting blocks for it.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T createBlockFilter(void)
+{
+	HttpCallResult_T result;
+	Retcode_T ret = RETCODE_FAILURE;
+
+	if(0 != confirmationTrackerHandleVar.filterID[0]) {
+		/* best effort - the filter may already be gone */
+		(void) sendTrackerRequest(UNINSTALL_FILTER, confirmationTrackerHandleVar.filterID, &result);
+		confirmationTrackerHandleVar.filterID[0] = 0;
+		confirmationTrackerHandleVar.filterLost = false;
+	}
+
+	ret = sendTrackerRequest(NEW_BLOCK_FILTER, NULL, &result);
+	if( (RETCODE_SUCCESS == ret) && (0 != result.result[0]) ) {
+		memcpy(confirmationTrackerHandleVar.filterID, result.result, sizeof(confirmationTrackerHandleVar.filterID));
+		/* the filter reports blocks from now on */
+		confirmationTrackerHandleVar.lastPollTick = xTaskGetTickCount();
+		confirmationTrackerHandleVar.blockTickValid = false;
+#ifdef ENABLE_DEBUG
+		printf("Block filter installed: %s\n\r", confirmationTrackerHandleVar.filterID);
+#endif
+	} else {
+		ret = RETCODE_FAILURE;
+	}
+
+	return ret;
+}
+
+/**
+ * This function updates the block interval estimate with
+ * the result of a filter poll. The exact tick of a block
+ * is unknown, only that it lies between the previous and
+ * the current poll. The predicted tick - 1/8 block interval
+ * early - is moved into this window. Predicting early lets
+ * an occasional empty poll pin the phase, so the polls do
+ * not drift behind the blocks.
+ *
+ * @param[in] newBlocks
+ * Number of blocks reported by the filter poll
+ *
+ * @param[in] pollTick
+ * Tick count when the filter poll was answered
+ *
+ * @return
+ * void
+ */
+static void observeBlocks(uint16_t newBlocks, portTickType pollTick)
+{
+	confirmationTrackerHandler_T *handle_ptr = &confirmationTrackerHandleVar;
+	ConfirmationTrackerStats_T *stats_ptr = &confirmationTrackerStatsVar;
+	portTickType window = pollTick - handle_ptr->lastPollTick;
+	portTickType blockTick = pollTick;
+	int32_t predicted = 0;
+	uint32_t sample = 0;
+
+	stats_ptr->filterPollCounter++;
+	if(0 == newBlocks) {
+		stats_ptr->wastedFilterPollCounter++;
+		handle_ptr->lastPollTick = pollTick;
+		return;
+	}
+	stats_ptr->blockCounter += newBlocks;
+
+	if(true == handle_ptr->blockTickValid) {
+		/* early predicted tick of the last new block relative to the previous poll */
+		predicted = (int32_t) (handle_ptr->lastBlockTick + (newBlocks * stats_ptr->blockIntervalEstimate - stats_ptr->blockIntervalEstimate / 8) / portTICK_RATE_MS - handle_ptr->lastPollTick);
+		if(0 > predicted) {
+			predicted = 0;
+		} else if(window < (portTickType) predicted) {
+			predicted = (int32_t) window;
+		}
+		blockTick = handle_ptr->lastPollTick + (portTickType) predicted;
+
+		sample = TICKS_TO_MS(blockTick - handle_ptr->lastBlockTick) / newBlocks;
+		stats_ptr->blockIntervalEstimate = (uint32_t) ((int32_t) stats_ptr->blockIntervalEstimate
+				+ ((int32_t) sample - (int32_t) stats_ptr->blockIntervalEstimate) / CONFIRMATION_BLOCK_INTERVAL_WEIGHT);
+	}
+	handle_ptr->lastBlockTick = blockTick;
+	handle_ptr->lastPollTick = pollTick;
+	handle_ptr->blockTickValid = true;
+}
+
+/**
+ * This function returns the delay until the next filter
+ * poll. With ENABLE_ADAPTIVE_CONFIRMATION_POLLING the poll
+ * is scheduled shortly after the expected next block. A
+ * random jitter of up to 1/8 block interval keeps several
+ * devices on the same node apart.
+ *
+ * @return
+ * delay in milliseconds
+ */
+static uint32_t getNextPollDelay(void)
+{
+#ifdef ENABLE_ADAPTIVE_CONFIRMATION_POLLING
+	uint32_t estimate = confirmationTrackerStatsVar.blockIntervalEstimate;
+	uint32_t sinceBlock = 0;
+	/* search the first block with several polls per block interval - also
+	 * used if the expected block is overdue */
+	uint32_t delay = estimate / 8;
+
+	if(true == confirmationTrackerHandleVar.blockTickValid) {
+		sinceBlock = TICKS_TO_MS(xTaskGetTickCount() - confirmationTrackerHandleVar.lastBlockTick);
+		if(sinceBlock < estimate) {
+			delay = estimate - sinceBlock;
+		}
+	}
+	delay += CONFIRMATION_POLL_MARGIN_TIME_MS + ((uint32_t) rand() % (estimate / 8 + 1));
+
+	if(CONFIRMATION_POLL_MIN_TIME_MS > delay) {
+		delay = CONFIRMATION_POLL_MIN_TIME_MS;
+	} else if(CONFIRMATION_POLL_MAX_TIME_MS < delay) {
+		delay = CONFIRMATION_POLL_MAX_TIME_MS;
+	}
+
+	return delay;
+#else
+	return CONFIRMATION_FILTER_POLL_TIME_MS;
+#endif
+}
+
+/**
+ * This function polls the block filter. A filter which the
+ * node reports as unknown e.g. after a node restart or a
+ * filter timeout is replaced with the next poll. After any
+ * other failure e.g. a transport timeout the filter is kept
+ * and polled again.
+ *
+ * @param[out] oNewBlocks_ptr
+ * This reference will hold the number of blocks which were
+ * mined since the last poll
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T pollBlockFilter(uint16_t *oNewBlocks_ptr)
+{
+	HttpCallResult_T result;
+	Retcode_T ret = sendTrackerRequest(GET_FILTER_CHANGES, confirmationTrackerHandleVar.filterID, &result);
+
+	if(RETCODE_SUCCESS == ret) {
+		*oNewBlocks_ptr = result.resultElementCounter;
+		observeBlocks(result.resultElementCounter, xTaskGetTickCount());
+#ifdef ENABLE_READ_CACHE
+		/* keeps the block number of the read cache current */
+		ReadCacheAddBlocks(result.resultElementCounter);
+#endif
+	} else if( (true == result.errorReceived) && (NULL != strstr(result.result, CONFIRMATION_FILTER_NOT_FOUND)) ) {
+		confirmationTrackerHandleVar.filterLost = true;
+	}
+
+	return ret;
+}
+
+/**
+ * This function completes a tracker entry and wakes up
+ * its waiter. Nothing is done if the waiter gave up in
+ * the meantime.
+ *
+ * @param[in] entry_ptr
+ * This reference holds the tracker entry
+ *
+ * @param[in] sequence
+ * Sequence number of the entry when the receipt was requested
+ *
+ * @return
+ * true, if the waiter was signaled<br>
+ * false, otherwise.
+ */
+static bool completeTrackerEntry(confirmationEntry_T *entry_ptr, uint8_t sequence)
+{
+	bool signal = false;
+	ConfirmationTrackerStats_T *stats_ptr = &confirmationTrackerStatsVar;
+
+	taskENTER_CRITICAL();
+	if( (CONFIRMATION_ENTRY_PENDING == entry_ptr->state) && (sequence == entry_ptr->sequence) ) {
+		entry_ptr->confirmed = true;
+		entry_ptr->state = CONFIRMATION_ENTRY_DONE;
+		signal = true;
+	}
+	taskEXIT_CRITICAL();
+
+	if(true == signal) {
+		stats_ptr->confirmationCounter++;
+		stats_ptr->lastInclusionLatency = TICKS_TO_MS(xTaskGetTickCount() - entry_ptr->registerTick);
+		stats_ptr->totalInclusionLatency += stats_ptr->lastInclusionLatency;
+		if(stats_ptr->lastInclusionLatency > stats_ptr->maxInclusionLatency) {
+			stats_ptr->maxInclusionLatency = stats_ptr->lastInclusionLatency;
+		}
+#ifdef ENABLE_DEBUG
+		printf("Confirmation after %lu ms, block interval %lu ms, wasted polls %lu/%lu, wasted receipt checks %lu/%lu\n\r",
+				(unsigned long) stats_ptr->lastInclusionLatency, (unsigned long) stats_ptr->blockIntervalEstimate,
+				(unsigned long) stats_ptr->wastedFilterPollCounter, (unsigned long) stats_ptr->filterPollCounter,
+				(unsigned long) stats_ptr->wastedReceiptCheckCounter, (unsigned long) stats_ptr->receiptCheckCounter);
+#endif
+		xSemaphoreGive(entry_ptr->confirmationSemaphore);
+	}
+
+	return signal;
+}
+
+/**
+ * This function requests the receipts of all pending
+ * transactions in one batch request and completes every
+ * transaction which is mined with status 0x1. Failed
+ * transactions stay unconfirmed until their waiter times out.
+ *
+ * @return
+ * void
+ */
+static void checkPendingReceipts(void)
+{
+	HttpRequestID_T requestID = HTTP_REQUEST_ID_INVALID;
+	HttpCallResult_T receipt;
+	uint8_t batchSlot[CONFIRMATION_TRACKER_ENTRY_MAX];
+	uint8_t sequence[CONFIRMATION_TRACKER_ENTRY_MAX];
+	bool callAdded = false;
+	bool confirmed = false;
+
+	if(RETCODE_SUCCESS != HttpBatchBegin(&requestID)) {
+		return;
+	}
+
+	for(uint8_t entry = 0; entry < CONFIRMATION_TRACKER_ENTRY_MAX; ++entry) {
+		confirmationEntry_T *entry_ptr = &confirmationTrackerTable[entry];
+		batchSlot[entry] = CONFIRMATION_TRACKER_NO_BATCH_SLOT;
+		sequence[entry] = entry_ptr->sequence;
+		if( (CONFIRMATION_ENTRY_PENDING == entry_ptr->state)
+				&& (RETCODE_SUCCESS == HttpBatchAdd(requestID, GET_TRANSACTION_RECEIPT, "na", "na", entry_ptr->transactionHash, sizeof(entry_ptr->transactionHash), &batchSlot[entry])) ) {
+			callAdded = true;
+		}
+	}
+	if(false == callAdded) {
+		HttpRequestRelease(requestID);
+		return;
+	}
+
+	if( (RETCODE_SUCCESS == HttpBatchSend(requestID)) && (RETCODE_SUCCESS == HttpRequestWait(requestID, HTTP_REQUEST_DEADLINE_DEFAULT)) ) {
+		for(uint8_t entry = 0; entry < CONFIRMATION_TRACKER_ENTRY_MAX; ++entry) {
+			if( (CONFIRMATION_TRACKER_NO_BATCH_SLOT != batchSlot[entry])
+					&& (RETCODE_SUCCESS == HttpRequestGetResult(requestID, batchSlot[entry], &receipt)) && (true == receipt.transactionConfirmed) ) {
+				confirmed |= completeTrackerEntry(&confirmationTrackerTable[entry], sequence[entry]);
+			}
+		}
+	}
+	HttpRequestRelease(requestID);
+
+	confirmationTrackerStatsVar.receiptCheckCounter++;
+	if(false == confirmed) {
+		confirmationTrackerStatsVar.wastedReceiptCheckCounter++;
+	}
+}
+
+/**
+ * This function checks if transactions are waiting for
+ * their confirmation and clears the new entry flags
+ *
+ * @param[out] oNewEntry_ptr
+ * This reference will hold true if a transaction was
+ * registered since the last call
+ *
+ * @return
+ * true, if at least one transaction is pending<br>
+ * false, otherwise.
+ */
+static bool takePendingEntries(bool *oNewEntry_ptr)
+{
+	bool pending = false;
+
+	*oNewEntry_ptr = false;
+	taskENTER_CRITICAL();
+	for(uint8_t entry = 0; entry < CONFIRMATION_TRACKER_ENTRY_MAX; ++entry) {
+		if(CONFIRMATION_ENTRY_PENDING == confirmationTrackerTable[entry].state) {
+			pending = true;
+			if(true == confirmationTrackerTable[entry].newEntry) {
+				confirmationTrackerTable[entry].newEntry = false;
+				*oNewEntry_ptr = true;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return pending;
+}
+
+/**
+ * This function creates the semaphores of the
+ * confirmation tracker. Must be called once before
+ * the tracker task is started.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T ConfirmationTrackerInit(void)
+{
+	/* start with the configured confirmation delay until blocks are observed */
+	confirmationTrackerStatsVar.blockIntervalEstimate = CONFIRMATION_POLL_MAX_TIME_MS;
+	srand((unsigned int) xTaskGetTickCount());
+
+	if(NULL == confirmationTrackerHandleVar.wakeSemaphore) {
+		confirmationTrackerHandleVar.wakeSemaphore = xSemaphoreCreateBinary();
+	}
+	if(NULL == confirmationTrackerHandleVar.wakeSemaphore) {
+		return RETCODE_FAILURE;
+	}
+
+	for(uint8_t entry = 0; entry < CONFIRMATION_TRACKER_ENTRY_MAX; ++entry) {
+		if(NULL == confirmationTrackerTable[entry].confirmationSemaphore) {
+			confirmationTrackerTable[entry].confirmationSemaphore = xSemaphoreCreateBinary();
+		}
+		if(NULL == confirmationTrackerTable[entry].confirmationSemaphore) {
+			return RETCODE_FAILURE;
+		}
+	}
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function registers a transaction at the tracker and
+ * blocks until it is confirmed or until the deadline expires.
+ * The calling task is woken up by the tracker task.
+ *
+ * @param[in] transactionHash_ptr
+ * This reference holds the hex encoded transaction hash
+ * with TRANSACTION_HASH_RESULT_LENGTH characters
+ *
+ * @param[in] timeoutMs
+ * Maximum time to wait for the confirmation in milliseconds
+ *
+ * @return
+ * true, if the transaction is confirmed<br>
+ * false, otherwise.
+ */
+bool ConfirmationTrackerWait(uint8_t const *transactionHash_ptr, uint32_t timeoutMs)
+{
+	bool confirmed = false;
+	confirmationEntry_T *entry_ptr = NULL;
+
+	if( (NULL == transactionHash_ptr) || (NULL == confirmationTrackerHandleVar.wakeSemaphore) ) {
+		return confirmed;
+	}
+
+	taskENTER_CRITICAL();
+	for(uint8_t entry = 0; entry < CONFIRMATION_TRACKER_ENTRY_MAX; ++entry) {
+		if(CONFIRMATION_ENTRY_FREE == confirmationTrackerTable[entry].state) {
+			entry_ptr = &confirmationTrackerTable[entry];
+			entry_ptr->state = CONFIRMATION_ENTRY_REGISTERING;
+			entry_ptr->sequence++;
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if(NULL == entry_ptr) {
+#ifdef ENABLE_DEBUG
+		printf("No free confirmation tracker entry\n\r");
+#endif
+		return confirmed;
+	}
+
+	memcpy(entry_ptr->transactionHash, transactionHash_ptr, sizeof(entry_ptr->transactionHash));
+	entry_ptr->confirmed = false;
+	entry_ptr->registerTick = xTaskGetTickCount();
+	/* drop a confirmation which was signaled after the last waiter timed out */
+	(void) xSemaphoreTake(entry_ptr->confirmationSemaphore, 0);
+
+	/* the receipt is checked once right away - the transaction
+	 * may be mined before the tracker sees the next block */
+	taskENTER_CRITICAL();
+	entry_ptr->newEntry = true;
+	entry_ptr->state = CONFIRMATION_ENTRY_PENDING;
+	taskEXIT_CRITICAL();
+	xSemaphoreGive(confirmationTrackerHandleVar.wakeSemaphore);
+
+	(void) xSemaphoreTake(entry_ptr->confirmationSemaphore, (portTickType) (timeoutMs / portTICK_RATE_MS));
+
+	taskENTER_CRITICAL();
+	confirmed = entry_ptr->confirmed;
+	entry_ptr->state = CONFIRMATION_ENTRY_FREE;
+	taskEXIT_CRITICAL();
+
+#ifdef ENABLE_DEBUG
+	printf("Transaction %.*s %s\n\r", TRANSACTION_HASH_RESULT_LENGTH, transactionHash_ptr, (true == confirmed) ? "confirmed" : "not confirmed");
+#endif
+
+	return confirmed;
+}
+
+/**
+ * This function is the task of the confirmation tracker.
+ * While transactions are pending it polls a block filter
+ * of the node and requests the receipts of all pending
+ * transactions once per new block. If the node does not
+ * support filters, the receipts are polled every
+ * CONFIRMATION_TIME_TO_WAIT seconds instead.
+ *
+ * @param[in] pvParameters
+ * Task parameters - not used
+ *
+ * @return
+ * void
+ */
+void ConfirmationTrackerCyclic(void* pvParameters)
+{
+	(void) pvParameters;
+	Retcode_T filterRet = RETCODE_FAILURE;
+	bool newEntry = false;
+	bool checkReceipts = false;
+	uint16_t newBlocks = 0;
+
+	for(;;) {
+		/* sleep until a transaction is registered - the block phase is
+		 * acquired again afterwards so the idle time is no block interval sample */
+		if(false == takePendingEntries(&newEntry)) {
+			confirmationTrackerHandleVar.blockTickValid = false;
+			(void) xSemaphoreTake(confirmationTrackerHandleVar.wakeSemaphore, portMAX_DELAY);
+			continue;
+		}
+		checkReceipts = newEntry;
+
+		if( (0 == confirmationTrackerHandleVar.filterID[0]) || (true == confirmationTrackerHandleVar.filterLost) ) {
+			/* blocks before the filter was installed are unknown */
+			filterRet = createBlockFilter();
+			checkReceipts = true;
+		} else {
+			newBlocks = 0;
+			filterRet = pollBlockFilter(&newBlocks);
+			if( (RETCODE_SUCCESS != filterRet) || (0 < newBlocks) ) {
+				checkReceipts = true;
+			}
+		}
+
+		if(true == checkReceipts) {
+			checkPendingReceipts();
+		}
+
+		/* a new registration ends the delay early */
+		if(RETCODE_SUCCESS == filterRet) {
+			(void) xSemaphoreTake(confirmationTrackerHandleVar.wakeSemaphore, (portTickType) (getNextPollDelay() / portTICK_RATE_MS));
+		} else {
+			(void) xSemaphoreTake(confirmationTrackerHandleVar.wakeSemaphore, SECONDS(CONFIRMATION_TIME_TO_WAIT));
+		}
+	}
+}
+
+/**
+ * This function copies the current block interval
+ * estimate and the poll counters of the tracker
+ *
+ * @param[out] oStats_ptr
+ * This reference will hold the counter values
+ *
+ * @return
+ * void
+ */
+void ConfirmationTrackerGetStats(ConfirmationTrackerStats_T *oStats_ptr)
+{
+	if(NULL != oStats_ptr) {
+		*oStats_ptr = confirmationTrackerStatsVar;
+	}
+}
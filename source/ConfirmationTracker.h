@@ -0,0 +1,41 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_CONFIRMATIONTRACKER_H_
+#define SOURCE_CONFIRMATIONTRACKER_H_
+
+#include "Http.h"
+
+/* maximum number of transactions which are tracked at the same time.
+ * All pending receipts are requested in one batch request */
+#define CONFIRMATION_TRACKER_ENTRY_MAX	HTTP_BATCH_REQUEST_MAX
+
+/* counters of the confirmation tracker - all times in milliseconds */
+typedef struct ConfirmationTrackerStats_S {
+	uint32_t blockIntervalEstimate;
+	uint32_t blockCounter;
+	uint32_t filterPollCounter;
+	uint32_t wastedFilterPollCounter;	/* filter polls without a new block */
+	uint32_t receiptCheckCounter;
+	uint32_t wastedReceiptCheckCounter;	/* receipt checks without a confirmation */
+	uint32_t confirmationCounter;
+	uint32_t lastInclusionLatency;		/* registration until confirmation */
+	uint32_t maxInclusionLatency;
+	uint32_t totalInclusionLatency;
+} ConfirmationTrackerStats_T;
+
+/* global interface task declarations */
+xTaskHandle ConfirmationTrackerTask;
+
+/* global interface function declarations */
+Retcode_T ConfirmationTrackerInit(void);
+bool ConfirmationTrackerWait(uint8_t const *transactionHash_ptr, uint32_t timeoutMs);
+void ConfirmationTrackerCyclic(void* pvParameters);
+void ConfirmationTrackerGetStats(ConfirmationTrackerStats_T *oStats_ptr);
+
+#endif /* SOURCE_CONFIRMATIONTRACKER_H_ */
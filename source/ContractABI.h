@@ -0,0 +1,23 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* generated by tools/gen_abi.py from SmartContract/SecureEdgeDevice.sol - do not edit */
+
+#ifndef SOURCE_CONTRACTABI_H_
+#define SOURCE_CONTRACTABI_H_
+
+/* function selectors - first four bytes of keccak256 of the function signature */
+#define ABI_SELECTOR_KILL                    UINT32_C(0x41c0e1b5)	/* kill() */
+#define ABI_SELECTOR_WRITE_PUBLIC_KEY        UINT32_C(0x2ea8dff5)	/* WritePublicKey(bytes) */
+#define ABI_SELECTOR_READ_PUBLIC_KEY         UINT32_C(0xfcc01d51)	/* ReadPublicKey() */
+#define ABI_SELECTOR_WRITE_DATA_HASH         UINT32_C(0x0ef81269)	/* WriteDataHash(bytes) */
+#define ABI_SELECTOR_READ_DATA_HASH          UINT32_C(0x0546bedb)	/* ReadDataHash() */
+#define ABI_SELECTOR_RATE_PRODUCER           UINT32_C(0xf18aeab6)	/* rateProducer(bool) */
+#define ABI_SELECTOR_READ_PRODUCER_RATING    UINT32_C(0xeab7840e)	/* readProducerRating() */
+
+#endif /* SOURCE_CONTRACTABI_H_ */
@@ -10,22 +10,75 @@
 #include <stdio.h>
 #include "FreeRTOS.h"
 #include "timers.h"
+#include "semphr.h"
 #include "XdkSensorHandle.h"
 #include "queue.h"
 
+/* the mbedTLS includes below depend on the configuration */
+#include "UserConfig.h"
+
 /* mbedTLS system includes */
 #include "mbedtls/pk.h"
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/entropy.h"
 #include "mbedtls/sha256.h"
+#if defined(ENABLE_HYBRID_ENCRYPTION) || defined(ENABLE_ECIES_ENCRYPTION)
+#include "mbedtls/ccm.h"
+#endif
+#ifdef ENABLE_ECIES_ENCRYPTION
+#include "mbedtls/ecp.h"
+#endif
 
 /* user includes */
 #include "Encryption.h"
-#include "UserConfig.h"
 #include "SystemConfig.h"
 #include "SensorData.h"
 #include "Http.h"
 #include "CoAPServer.h"
+#if defined(ENABLE_COMPILED_KEYS) && !defined(ENABLE_ECIES_ENCRYPTION)
+#include "RSAKeys.h"
+#endif
+#ifdef ENABLE_ECIES_ENCRYPTION
+#include "HexCodec.h"
+#endif
+
+#ifdef ENABLE_ECIES_ENCRYPTION
+/* the KDF output is the AES-128 key followed by the CCM nonce */
+#define ECIES_KEY_SIZE			16
+#define ECIES_NONCE_SIZE		12
+/* size of the scalars and of the shared secret of both curves */
+#define ECIES_SECRET_SIZE		32
+/* one SHA-256 block of the KDF */
+#define ECIES_KDF_SIZE			32
+
+#if (ECIES_CONSUMER_CURVE == ECIES_CURVE_CURVE25519)
+#define ECIES_CONSUMER_GROUP	MBEDTLS_ECP_DP_CURVE25519
+#else
+#define ECIES_CONSUMER_GROUP	MBEDTLS_ECP_DP_SECP256R1
+#endif
+#endif /* ENABLE_ECIES_ENCRYPTION */
+
+#ifdef ENABLE_HYBRID_ENCRYPTION
+/* message types of the hybrid mode - the first message of
+ * a session carries the wrapped session key */
+#define HYBRID_TYPE_KEY			0x01
+#define HYBRID_TYPE_DATA		0x02
+
+/* the wrapped plaintext binds the session key to its session id */
+#define HYBRID_WRAPPED_PLAIN_SIZE	(ENCRYPTION_HYBRID_KEY_SIZE + 4)
+
+/**
+ * AES-CCM session of the hybrid mode. The nonce is the
+ * session id followed by the message counter, both are
+ * sent in the header of every message.
+ */
+typedef struct hybridSession_S {
+	mbedtls_ccm_context ccm;
+	uint32_t sessionId;
+	uint32_t counter;		/* producer: next counter, consumer: lowest accepted counter */
+	bool valid;
+} hybridSession_T;
+#endif /* ENABLE_HYBRID_ENCRYPTION */
 
 /**
  * struct to hold all the crypto contexts which are
@@ -34,8 +87,33 @@
 typedef struct mbedEncryptionHandler_S{
 	mbedtls_sha256_context sha256ctx;
 	mbedtls_ctr_drbg_context ctr_drbg;
-	mbedtls_pk_context pk;
 	mbedtls_entropy_context entropy;
+	bool ctrDrbgSeeded;			/* EncryptionGetRandom can be used */
+	/* resident private key of the consumer - the parsed CRT parameters
+	 * and the blinding values are kept between the decryptions */
+	mbedtls_pk_context privatePk;
+	bool privateKeyValid;		/* privatePk or privateEc is loaded */
+	/* parsed public keys of the AuthenticatedConsumerTable entries */
+	mbedtls_pk_context consumerPk[CONSUMER_NUMBER_MAX];
+	bool consumerPkValid[CONSUMER_NUMBER_MAX];
+	SemaphoreHandle_t consumerPkMutex;
+#ifdef ENABLE_ECIES_ENCRYPTION
+	/* consumer: resident elliptic curve key instead of privatePk,
+	 * producer: elliptic curve keys of the consumers which published one.
+	 * Every group keeps its precomputed multiples of the generator */
+	mbedtls_ecp_keypair privateEc;
+	mbedtls_ecp_keypair consumerEc[CONSUMER_NUMBER_MAX];
+	bool consumerEcValid[CONSUMER_NUMBER_MAX];
+#endif
+#ifdef ENABLE_HYBRID_ENCRYPTION
+	/* producer: AES-CCM session of every consumer, consumer: session of the producer */
+	hybridSession_T consumerSession[CONSUMER_NUMBER_MAX];
+	hybridSession_T producerSession;
+	/* consumer: ids of the last accepted sessions, the oldest is overwritten */
+	uint32_t producerSessionHistory[HYBRID_SESSION_HISTORY];
+	uint8_t producerSessionHistoryCount;
+	uint8_t producerSessionHistoryNext;
+#endif
 } mbedEncryptionHandler_T;
 static mbedEncryptionHandler_T mbedEncryptionHandleVar;
 
@@ -131,7 +209,33 @@ Retcode_T InitMbedCrypto()
 	mbedtls_sha256_init(&mbedEncryptionHandleVar.sha256ctx);
 	mbedtls_entropy_init(&mbedEncryptionHandleVar.entropy);
 	mbedtls_ctr_drbg_init(&mbedEncryptionHandleVar.ctr_drbg);
-	mbedtls_pk_init(&mbedEncryptionHandleVar.pk);
+	mbedtls_pk_init(&mbedEncryptionHandleVar.privatePk);
+	mbedEncryptionHandleVar.privateKeyValid = false;
+#ifdef ENABLE_ECIES_ENCRYPTION
+	mbedtls_ecp_keypair_init(&mbedEncryptionHandleVar.privateEc);
+#endif
+	for(uint8_t counter = 0; counter < CONSUMER_NUMBER_MAX; ++counter) {
+		mbedtls_pk_init(&mbedEncryptionHandleVar.consumerPk[counter]);
+		mbedEncryptionHandleVar.consumerPkValid[counter] = false;
+#ifdef ENABLE_ECIES_ENCRYPTION
+		mbedtls_ecp_keypair_init(&mbedEncryptionHandleVar.consumerEc[counter]);
+		mbedEncryptionHandleVar.consumerEcValid[counter] = false;
+#endif
+#ifdef ENABLE_HYBRID_ENCRYPTION
+		mbedtls_ccm_init(&mbedEncryptionHandleVar.consumerSession[counter].ccm);
+		mbedEncryptionHandleVar.consumerSession[counter].valid = false;
+#endif
+	}
+#ifdef ENABLE_HYBRID_ENCRYPTION
+	mbedtls_ccm_init(&mbedEncryptionHandleVar.producerSession.ccm);
+	mbedEncryptionHandleVar.producerSession.valid = false;
+#endif
+
+	/* the consumer keys are stored by the http task and used by the coap task */
+	if(NULL == mbedEncryptionHandleVar.consumerPkMutex) {
+		mbedEncryptionHandleVar.consumerPkMutex = xSemaphoreCreateMutex();
+	}
+	if(NULL == mbedEncryptionHandleVar.consumerPkMutex) return RETCODE_FAILURE;
 
 	/* Add entropy source */
 	ret = mbedtls_entropy_add_source(&mbedEncryptionHandleVar.entropy, setupEntropySource, &data, 256, MBEDTLS_ENTROPY_SOURCE_STRONG);
@@ -139,52 +243,296 @@ Retcode_T InitMbedCrypto()
 
 	/* setup seed for encryption */
 	ret = setupCryptoSeed();
+	mbedEncryptionHandleVar.ctrDrbgSeeded = (RETCODE_SUCCESS == ret);
+
+#ifdef ENABLE_CONSUMER
+	/* parse the private key once - decryptData fails without it */
+	if(RETCODE_SUCCESS == ret) {
+		(void) EncryptionLoadPrivateKey();
+	}
+#endif
 
 	return ret;
 }
 
+#if defined(ENABLE_COMPILED_KEYS) && !defined(ENABLE_ECIES_ENCRYPTION)
 /**
- * This function is called to calculate the data
- * hash of a specified data buffer
+ * This function copies the limbs of a key parameter
+ * from flash into a bignum of the RSA context
  *
- * @param[in] payload_ptr
- * This reference holds the "unhashed" payload data
+ * @param[out] X_ptr
+ * bignum of the RSA context
  *
- * @param[in] iLength
- * Length of the incoming payload
+ * @param[in] limbs_ptr
+ * 32 bit limbs of the parameter, least significant first
  *
- * @param[out] calculatedHash_ptr
- * This buffer will hold the calculated hash value of
- * the payload data
+ * @param[in] iCount
+ * number of limbs
  *
- * @param[in] iLengthOBuffer
- * Length of the hash buffer -> Must be equal to DATA_HASH_BUFF_SIZE
+ * @return
+ * 0, if successful<br>
+ * mbedtls error code, otherwise.
+ */
+static int importLimbs(mbedtls_mpi *X_ptr, uint32_t const *limbs_ptr, size_t iCount)
+{
+	size_t const wordsPerLimb = sizeof(mbedtls_mpi_uint) / sizeof(uint32_t);
+	int ret = mbedtls_mpi_grow(X_ptr, (iCount + wordsPerLimb - 1) / wordsPerLimb);
+
+	if(0 == ret) {
+		/* grow zeroes the new limbs */
+		for(size_t i = 0; i < iCount; ++i) {
+			X_ptr->p[i / wordsPerLimb] |= ((mbedtls_mpi_uint) limbs_ptr[i]) << (32 * (i % wordsPerLimb));
+		}
+		X_ptr->s = 1;
+	}
+
+	return ret;
+}
+
+/**
+ * This function sets up the RSA context of the private
+ * consumer key from the limbs in RSAKeys.h (make keys).
+ * The CRT parameters are taken as they are, neither the
+ * PEM/ASN.1 parsers nor mbedtls_rsa_complete run.
+ *
+ * @param[out] pk_ptr
+ * initialized pk context which will hold the key
  *
  * @return
  * RETCODE_SUCCESS, if successful<br>
  * RETCODE_FAILURE, otherwise.
  */
-Retcode_T CalculateHash(uint8_t const *payload_ptr, size_t iLength, uint8_t *calculatedHash_ptr, size_t iLengthOBuffer)
+static Retcode_T importCompiledPrivateKey(mbedtls_pk_context *pk_ptr)
 {
-	Retcode_T ret = RETCODE_FAILURE;
+#if RSA_KEY_CONSUMER_AVAILABLE
+	mbedtls_rsa_context *rsa_ptr = NULL;
+	int ret = mbedtls_pk_setup(pk_ptr, mbedtls_pk_info_from_type(MBEDTLS_PK_RSA));
 
-	if( (NULL!= payload_ptr) && (NULL != calculatedHash_ptr) && (0 < iLength) ) {
-		if(iLengthOBuffer == DATA_HASH_BUFF_SIZE) {
-			ret = mbedtls_sha256_starts_ret(&mbedEncryptionHandleVar.sha256ctx, 0);
-			ret = mbedtls_sha256_update_ret(&mbedEncryptionHandleVar.sha256ctx, payload_ptr, iLength);
-			ret = mbedtls_sha256_finish_ret(&mbedEncryptionHandleVar.sha256ctx, calculatedHash_ptr);
-#ifdef ENABLE_DEBUG
-			printf("Calculate hash\n\r");
+	if(0 == ret) {
+		rsa_ptr = mbedtls_pk_rsa(*pk_ptr);
+		ret |= importLimbs(&rsa_ptr->N, RSAKeyConsumerN, sizeof(RSAKeyConsumerN) / sizeof(RSAKeyConsumerN[0]));
+		ret |= importLimbs(&rsa_ptr->E, RSAKeyConsumerE, sizeof(RSAKeyConsumerE) / sizeof(RSAKeyConsumerE[0]));
+		ret |= importLimbs(&rsa_ptr->D, RSAKeyConsumerD, sizeof(RSAKeyConsumerD) / sizeof(RSAKeyConsumerD[0]));
+		ret |= importLimbs(&rsa_ptr->P, RSAKeyConsumerP, sizeof(RSAKeyConsumerP) / sizeof(RSAKeyConsumerP[0]));
+		ret |= importLimbs(&rsa_ptr->Q, RSAKeyConsumerQ, sizeof(RSAKeyConsumerQ) / sizeof(RSAKeyConsumerQ[0]));
+		ret |= importLimbs(&rsa_ptr->DP, RSAKeyConsumerDP, sizeof(RSAKeyConsumerDP) / sizeof(RSAKeyConsumerDP[0]));
+		ret |= importLimbs(&rsa_ptr->DQ, RSAKeyConsumerDQ, sizeof(RSAKeyConsumerDQ) / sizeof(RSAKeyConsumerDQ[0]));
+		ret |= importLimbs(&rsa_ptr->QP, RSAKeyConsumerQP, sizeof(RSAKeyConsumerQP) / sizeof(RSAKeyConsumerQP[0]));
+		rsa_ptr->len = mbedtls_mpi_size(&rsa_ptr->N);
+	}
+	/* cheap plausibility check of the modulus and the exponent */
+	if(0 == ret) {
+		ret = mbedtls_rsa_check_pubkey(rsa_ptr);
+	}
+
+	return (0 == ret) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+#else
+	(void) pk_ptr;
+	/* tools/gen_keys.py found no key in UserConfig.h */
+	return RETCODE_FAILURE;
 #endif
+}
+#endif /* ENABLE_COMPILED_KEYS */
+
+#ifdef ENABLE_ECIES_ENCRYPTION
+/**
+ * This function returns the size of an encoded public key
+ * of the group - the uncompressed secp256r1 point or the
+ * little endian Curve25519 u-coordinate
+ *
+ * @param[in] grp_ptr
+ * loaded group of the key
+ *
+ * @return
+ * size of the public key in bytes
+ */
+static size_t eciesPublicKeySize(mbedtls_ecp_group const *grp_ptr)
+{
+	return (MBEDTLS_ECP_DP_CURVE25519 == grp_ptr->id) ? ENCRYPTION_ECIES_CURVE25519_KEY_SIZE : ENCRYPTION_ECIES_SECP256R1_KEY_SIZE;
+}
+
+/**
+ * This function reverses the byte order of a buffer - Curve25519
+ * keys are little endian, the mbedtls bignums big endian
+ *
+ * @param[in,out] buff_ptr
+ * buffer to reverse
+ *
+ * @param[in] iLength
+ * length of the buffer
+ *
+ * @return
+ * void
+ */
+static void reverseBytes(uint8_t *buff_ptr, size_t iLength)
+{
+	uint8_t tmp = 0;
+
+	for(size_t i = 0; i < iLength / 2; ++i) {
+		tmp = buff_ptr[i];
+		buff_ptr[i] = buff_ptr[iLength - 1 - i];
+		buff_ptr[iLength - 1 - i] = tmp;
+	}
+}
+
+/**
+ * This function encodes a public key of the group
+ *
+ * @param[in] grp_ptr
+ * loaded group of the key
+ *
+ * @param[in] P_ptr
+ * public key
+ *
+ * @param[out] oBuff
+ * This buffer will hold the encoded key
+ *
+ * @param[in] ioBuffLength
+ * Size of the output buffer
+ *
+ * @param[out] oLength_ptr
+ * Length of the encoded key
+ *
+ * @return
+ * 0, if successful<br>
+ * mbedtls error code, otherwise.
+ */
+static int eciesWritePoint(mbedtls_ecp_group const *grp_ptr, mbedtls_ecp_point const *P_ptr, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr)
+{
+	int ret = MBEDTLS_ERR_ECP_BUFFER_TOO_SMALL;
+
+	if(MBEDTLS_ECP_DP_CURVE25519 == grp_ptr->id) {
+		if(ENCRYPTION_ECIES_CURVE25519_KEY_SIZE <= ioBuffLength) {
+			ret = mbedtls_mpi_write_binary(&P_ptr->X, oBuff, ENCRYPTION_ECIES_CURVE25519_KEY_SIZE);
+			reverseBytes(oBuff, ENCRYPTION_ECIES_CURVE25519_KEY_SIZE);
+			*oLength_ptr = ENCRYPTION_ECIES_CURVE25519_KEY_SIZE;
 		}
+	} else {
+		ret = mbedtls_ecp_point_write_binary(grp_ptr, P_ptr, MBEDTLS_ECP_PF_UNCOMPRESSED, oLength_ptr, oBuff, ioBuffLength);
 	}
 
-    return ret;
+	return ret;
 }
 
 /**
- * This function is called to encrypt data with the
- * RSA algorithm
+ * This function decodes and checks a public key of the group
+ *
+ * @param[in] grp_ptr
+ * loaded group of the key
+ *
+ * @param[out] P_ptr
+ * This point will hold the public key
+ *
+ * @param[in] publicKey_ptr
+ * encoded public key
+ *
+ * @param[in] iLength
+ * length of the encoded key
+ *
+ * @return
+ * 0, if successful<br>
+ * mbedtls error code, otherwise.
+ */
+static int eciesReadPoint(mbedtls_ecp_group const *grp_ptr, mbedtls_ecp_point *P_ptr, uint8_t const *publicKey_ptr, size_t iLength)
+{
+	uint8_t u[ENCRYPTION_ECIES_CURVE25519_KEY_SIZE];
+	int ret = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+
+	if(MBEDTLS_ECP_DP_CURVE25519 == grp_ptr->id) {
+		if(sizeof(u) == iLength) {
+			/* RFC 7748 - the most significant bit of the u-coordinate is ignored */
+			memcpy(u, publicKey_ptr, sizeof(u));
+			u[sizeof(u) - 1] &= 0x7F;
+			reverseBytes(u, sizeof(u));
+			ret = mbedtls_mpi_read_binary(&P_ptr->X, u, sizeof(u));
+			if(0 == ret) {
+				ret = mbedtls_mpi_lset(&P_ptr->Z, 1);
+			}
+		}
+	} else {
+		ret = mbedtls_ecp_point_read_binary(grp_ptr, P_ptr, publicKey_ptr, iLength);
+	}
+	if(0 == ret) {
+		ret = mbedtls_ecp_check_pubkey(grp_ptr, P_ptr);
+	}
+
+	return ret;
+}
+
+/**
+ * This function derives the AES key and the CCM nonce of one
+ * message: ECDH of the own scalar and the point of the other
+ * side, then the ANSI X9.63 KDF with SHA-256 over the shared
+ * secret, a counter of 1 and the ephemeral public key.
+ *
+ * @param[in] grp_ptr
+ * loaded group of both keys
+ *
+ * @param[in] d_ptr
+ * own private scalar
+ *
+ * @param[in] Q_ptr
+ * public key of the other side
+ *
+ * @param[in] ephemeral_ptr
+ * encoded ephemeral public key of the message
+ *
+ * @param[in] iEphemeralLength
+ * length of the ephemeral public key
+ *
+ * @param[out] oKeyMaterial_ptr
+ * This buffer will hold ECIES_KDF_SIZE bytes - key and nonce
+ *
+ * @return
+ * 0, if successful<br>
+ * mbedtls error code, otherwise.
+ */
+static int eciesDeriveKey(mbedtls_ecp_group *grp_ptr, mbedtls_mpi const *d_ptr, mbedtls_ecp_point const *Q_ptr, uint8_t const *ephemeral_ptr, size_t iEphemeralLength, uint8_t *oKeyMaterial_ptr)
+{
+	static uint8_t const kdfCounter[4] = { 0x00, 0x00, 0x00, 0x01 };
+	uint8_t secret[ECIES_SECRET_SIZE];
+	mbedtls_sha256_context sha256ctx;
+	mbedtls_ecp_point S;
+	int ret = 0;
+
+	mbedtls_sha256_init(&sha256ctx);
+	mbedtls_ecp_point_init(&S);
+
+	/* shared secret - x-coordinate of d * Q, little endian for Curve25519 */
+	MBEDTLS_MPI_CHK(mbedtls_ecp_mul(grp_ptr, &S, d_ptr, Q_ptr, mbedtls_ctr_drbg_random, &mbedEncryptionHandleVar.ctr_drbg));
+	if( (0 != mbedtls_ecp_is_zero(&S)) || (0 == mbedtls_mpi_cmp_int(&S.X, 0)) ) {
+		/* point of small order */
+		ret = MBEDTLS_ERR_ECP_INVALID_KEY;
+		goto cleanup;
+	}
+	MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(&S.X, secret, sizeof(secret)));
+	if(MBEDTLS_ECP_DP_CURVE25519 == grp_ptr->id) {
+		reverseBytes(secret, sizeof(secret));
+	}
+
+	MBEDTLS_MPI_CHK(mbedtls_sha256_starts_ret(&sha256ctx, 0));
+	MBEDTLS_MPI_CHK(mbedtls_sha256_update_ret(&sha256ctx, secret, sizeof(secret)));
+	MBEDTLS_MPI_CHK(mbedtls_sha256_update_ret(&sha256ctx, kdfCounter, sizeof(kdfCounter)));
+	MBEDTLS_MPI_CHK(mbedtls_sha256_update_ret(&sha256ctx, ephemeral_ptr, iEphemeralLength));
+	MBEDTLS_MPI_CHK(mbedtls_sha256_finish_ret(&sha256ctx, oKeyMaterial_ptr));
+
+cleanup:
+	memset(secret, 0, sizeof(secret));
+	mbedtls_ecp_point_free(&S);
+	mbedtls_sha256_free(&sha256ctx);
+
+	return ret;
+}
+
+/**
+ * This function encrypts a payload for an elliptic curve key.
+ * A fresh ephemeral key pair is drawn for every message - the
+ * comb table of the generator stays in the group of the key.
+ *
+ * Message: ephemeral public key | ciphertext | tag
+ *
+ * @param[in] key_ptr
+ * public key of the consumer
  *
  * @param[in] payload_ptr
  * This reference holds the raw payload data to encrypt
@@ -193,107 +541,663 @@ Retcode_T CalculateHash(uint8_t const *payload_ptr, size_t iLength, uint8_t *cal
  * Length of the incoming payload
  *
  * @param[out] oBuff
- * This buffer will hold the encrypted value of
- * the payload data (always padded to 128 bytes)
+ * This buffer will hold the message
  *
- * @param[out] ioBuffLength
- * Size of the output buffer --> must be at least 128 bytes
+ * @param[in] ioBuffLength
+ * Size of the output buffer --> at least iLength + ENCRYPTION_ECIES_OVERHEAD_MAX
  *
  * @param[out] oLength_ptr
- * Length of the encrypted data (with this algorithm padded to 128 bytes)
+ * Length of the message
  *
  * @return
  * RETCODE_SUCCESS, if successful<br>
  * RETCODE_FAILURE, otherwise.
  */
-Retcode_T encryptData(uint8_t const *payload_ptr, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr)
+static Retcode_T eciesEncrypt(mbedtls_ecp_keypair *key_ptr, uint8_t const *payload_ptr, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr)
 {
-	Retcode_T cryptoRet = RETCODE_FAILURE;
-
-	/* check for NULL pointers */
-	if( (NULL != payload_ptr) && (NULL != oBuff)) {
-		/* free pk context */
-		mbedtls_pk_free(&mbedEncryptionHandleVar.pk);
+	uint8_t keyMaterial[ECIES_KDF_SIZE];
+	size_t publicKeyLength = eciesPublicKeySize(&key_ptr->grp);
+	mbedtls_ccm_context ccm;
+	mbedtls_ecp_point Q;
+	mbedtls_mpi d;
+	int ret = 0;
 
-		/* parse public key */
-		for(uint8_t counter = 0; counter < CONSUMER_NUMBER_MAX; ++counter) {
-			if(AuthenticatedConsumerTable[counter].activeConsumer == true) {
-#ifdef ENABLE_DEBUG
-				printf("Data encryption pubkey:%s\n\r", AuthenticatedConsumerTable[counter].consumerPublicKey);
-#endif
-				cryptoRet = mbedtls_pk_parse_public_key(&mbedEncryptionHandleVar.pk, AuthenticatedConsumerTable[counter].consumerPublicKey, strlen(AuthenticatedConsumerTable[counter].consumerPublicKey) + 1);
-				AuthenticatedConsumerTable[counter].activeConsumer = false;
-			}
-		}
-		if(RETCODE_SUCCESS == cryptoRet) {
-			/* start data encryption */
-			/* default padding type is PKCS#1 v1.5
-			 * so the length of the encrypted message is always the same
-			 * independent of the payload length.
-			 * For 1024 Bit RSA key, padded message is always 128 byte */
-			cryptoRet = mbedtls_pk_encrypt(&mbedEncryptionHandleVar.pk, payload_ptr, iLength, oBuff, oLength_ptr, ioBuffLength, mbedtls_ctr_drbg_random, &mbedEncryptionHandleVar.ctr_drbg);
-			if(RETCODE_SUCCESS == cryptoRet) {
-				printf("Data encryption successful:%s; Length: %i\n\r", oBuff, *oLength_ptr);
-			} else {
-				printf("Failed to encrypt data\n\r");
-			}
-		} else {
-			printf("Failed to read public key\n\r");
-		}
+	if(ioBuffLength < publicKeyLength + iLength + ENCRYPTION_ECIES_TAG_SIZE) {
+		return RETCODE_FAILURE;
 	}
 
-	return cryptoRet;
+	mbedtls_ccm_init(&ccm);
+	mbedtls_ecp_point_init(&Q);
+	mbedtls_mpi_init(&d);
+
+	MBEDTLS_MPI_CHK(mbedtls_ecp_gen_keypair(&key_ptr->grp, &d, &Q, mbedtls_ctr_drbg_random, &mbedEncryptionHandleVar.ctr_drbg));
+	MBEDTLS_MPI_CHK(eciesWritePoint(&key_ptr->grp, &Q, oBuff, ioBuffLength, &publicKeyLength));
+	MBEDTLS_MPI_CHK(eciesDeriveKey(&key_ptr->grp, &d, &key_ptr->Q, oBuff, publicKeyLength, keyMaterial));
+	MBEDTLS_MPI_CHK(mbedtls_ccm_setkey(&ccm, MBEDTLS_CIPHER_ID_AES, keyMaterial, ECIES_KEY_SIZE * 8));
+	MBEDTLS_MPI_CHK(mbedtls_ccm_encrypt_and_tag(&ccm, iLength, &keyMaterial[ECIES_KEY_SIZE], ECIES_NONCE_SIZE, NULL, 0,
+			payload_ptr, &oBuff[publicKeyLength], &oBuff[publicKeyLength + iLength], ENCRYPTION_ECIES_TAG_SIZE));
+	*oLength_ptr = publicKeyLength + iLength + ENCRYPTION_ECIES_TAG_SIZE;
+
+cleanup:
+	memset(keyMaterial, 0, sizeof(keyMaterial));
+	mbedtls_mpi_free(&d);
+	mbedtls_ecp_point_free(&Q);
+	mbedtls_ccm_free(&ccm);
+
+	return (0 == ret) ? RETCODE_SUCCESS : RETCODE_FAILURE;
 }
 
 /**
- * This function is called to decrypt data which
- * was encrypted with the RSA algorithm
+ * This function authenticates and decrypts an ECIES message
+ * with the private elliptic curve key
+ *
+ * @param[in] key_ptr
+ * private key of the consumer
  *
  * @param[in] payload_ptr
- * This reference holds the encrypted payload data
+ * This reference holds the message
  *
  * @param[in] iLength
- * Length of the incoming encrypted payload
+ * Length of the message
  *
- * @param[out] decryptedData_ptr
- * This reference will hold the decrypted value of
- * the payload data
+ * @param[out] oBuff
+ * This buffer will hold the decrypted payload
  *
- * @param[out] ioBuffLength
+ * @param[in] ioBuffLength
  * Size of the output buffer
  *
  * @param[out] oLength_ptr
- * Length of the decrypted data
+ * Length of the decrypted payload
  *
  * @return
  * RETCODE_SUCCESS, if successful<br>
  * RETCODE_FAILURE, otherwise.
  */
-Retcode_T decryptData(uint8_t const *payload_ptr, size_t iLength, uint8_t *decryptedData_ptr, size_t ioBuffLength, size_t *oLength_ptr)
+static Retcode_T eciesDecrypt(mbedtls_ecp_keypair *key_ptr, uint8_t const *payload_ptr, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr)
 {
-	Retcode_T cryptoRet = RETCODE_FAILURE;
+	uint8_t keyMaterial[ECIES_KDF_SIZE];
+	size_t publicKeyLength = eciesPublicKeySize(&key_ptr->grp);
+	size_t dataLength = 0;
+	mbedtls_ccm_context ccm;
+	mbedtls_ecp_point Q;
+	int ret = 0;
 
-	/* check for NULL pointers */
-	if( (NULL != payload_ptr) && (NULL != decryptedData_ptr)) {
-		/* free pk context */
-		mbedtls_pk_free(&mbedEncryptionHandleVar.pk);
+	if(iLength < publicKeyLength + ENCRYPTION_ECIES_TAG_SIZE) {
+		return RETCODE_FAILURE;
+	}
+	dataLength = iLength - publicKeyLength - ENCRYPTION_ECIES_TAG_SIZE;
+	if(ioBuffLength < dataLength) {
+		return RETCODE_FAILURE;
+	}
 
-		/* parse private key */
-		cryptoRet = mbedtls_pk_parse_key( &mbedEncryptionHandleVar.pk, PrivateRSAKeyConsumer1024, strlen((const char*)PrivateRSAKeyConsumer1024) + 1, NULL, 0);
+	mbedtls_ccm_init(&ccm);
+	mbedtls_ecp_point_init(&Q);
 
-		if(RETCODE_SUCCESS == cryptoRet) {
-			/* start data decryption */
-			cryptoRet = mbedtls_pk_decrypt( &mbedEncryptionHandleVar.pk, payload_ptr, iLength, decryptedData_ptr, oLength_ptr, ioBuffLength, mbedtls_ctr_drbg_random, &mbedEncryptionHandleVar.ctr_drbg);
+	MBEDTLS_MPI_CHK(eciesReadPoint(&key_ptr->grp, &Q, payload_ptr, publicKeyLength));
+	MBEDTLS_MPI_CHK(eciesDeriveKey(&key_ptr->grp, &key_ptr->d, &Q, payload_ptr, publicKeyLength, keyMaterial));
+	MBEDTLS_MPI_CHK(mbedtls_ccm_setkey(&ccm, MBEDTLS_CIPHER_ID_AES, keyMaterial, ECIES_KEY_SIZE * 8));
+	MBEDTLS_MPI_CHK(mbedtls_ccm_auth_decrypt(&ccm, dataLength, &keyMaterial[ECIES_KEY_SIZE], ECIES_NONCE_SIZE, NULL, 0,
+			&payload_ptr[publicKeyLength], oBuff, &payload_ptr[publicKeyLength + dataLength], ENCRYPTION_ECIES_TAG_SIZE));
+	*oLength_ptr = dataLength;
 
-#ifdef ENABLE_DEBUG
-			if(RETCODE_SUCCESS == cryptoRet) {
-				printf("Data decryption successful:%i ; Length: %i\n\r", *decryptedData_ptr, *oLength_ptr);
-			} else {
-				printf("Failed to decrypt data\n\r");
-			}
-		} else {
-			printf("Failed to read private key\n\r");
-		}
+cleanup:
+	memset(keyMaterial, 0, sizeof(keyMaterial));
+	mbedtls_ecp_point_free(&Q);
+	mbedtls_ccm_free(&ccm);
+
+	return (0 == ret) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function imports the raw elliptic curve public key of a
+ * consumer - 65 bytes for secp256r1, 32 bytes for Curve25519
+ *
+ * @param[out] key_ptr
+ * initialized key pair which will hold the key
+ *
+ * @param[in] publicKey_ptr
+ * public key read from the blockchain
+ *
+ * @param[in] iLength
+ * length of the public key
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T importEciesPublicKey(mbedtls_ecp_keypair *key_ptr, uint8_t const *publicKey_ptr, size_t iLength)
+{
+	int ret = mbedtls_ecp_group_load(&key_ptr->grp, (ENCRYPTION_ECIES_CURVE25519_KEY_SIZE == iLength) ? MBEDTLS_ECP_DP_CURVE25519 : MBEDTLS_ECP_DP_SECP256R1);
+
+	if(0 == ret) {
+		ret = eciesReadPoint(&key_ptr->grp, &key_ptr->Q, publicKey_ptr, iLength);
+	}
+
+	return (0 == ret) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function imports the private elliptic curve key of the
+ * consumer from CONSUMER_ECIES_PRIVATE_KEY and computes its
+ * public key, which is published with WritePublicKey.
+ *
+ * @param[out] key_ptr
+ * initialized key pair which will hold the key
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T importEciesPrivateKey(mbedtls_ecp_keypair *key_ptr)
+{
+	uint8_t const *keyHex_ptr = CONSUMER_ECIES_PRIVATE_KEY;
+	uint8_t key[ECIES_SECRET_SIZE];
+	int ret = 0;
+
+	if( ('0' == keyHex_ptr[0]) && ('x' == keyHex_ptr[1]) ) {
+		keyHex_ptr += 2;
+	}
+	if( (2 * sizeof(key) != strlen((const char*)keyHex_ptr)) || (RETCODE_SUCCESS != HexDecode(keyHex_ptr, 2 * sizeof(key), key)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	MBEDTLS_MPI_CHK(mbedtls_ecp_group_load(&key_ptr->grp, ECIES_CONSUMER_GROUP));
+	if(MBEDTLS_ECP_DP_CURVE25519 == key_ptr->grp.id) {
+		/* RFC 7748 - clamp the little endian scalar */
+		key[0] &= 0xF8;
+		key[sizeof(key) - 1] &= 0x7F;
+		key[sizeof(key) - 1] |= 0x40;
+		reverseBytes(key, sizeof(key));
+	}
+	MBEDTLS_MPI_CHK(mbedtls_mpi_read_binary(&key_ptr->d, key, sizeof(key)));
+	MBEDTLS_MPI_CHK(mbedtls_ecp_check_privkey(&key_ptr->grp, &key_ptr->d));
+	MBEDTLS_MPI_CHK(mbedtls_ecp_mul(&key_ptr->grp, &key_ptr->Q, &key_ptr->d, &key_ptr->grp.G, mbedtls_ctr_drbg_random, &mbedEncryptionHandleVar.ctr_drbg));
+
+cleanup:
+	memset(key, 0, sizeof(key));
+
+	return (0 == ret) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+#endif /* ENABLE_ECIES_ENCRYPTION */
+
+/**
+ * This function loads the private consumer key into the
+ * resident private key context of decryptData. Called once
+ * by InitMbedCrypto - the key is constant for the life
+ * of the firmware. With ENABLE_COMPILED_KEYS the key is
+ * copied from RSAKeys.h, otherwise PrivateRSAKeyConsumer1024
+ * is parsed. With ENABLE_ECIES_ENCRYPTION the elliptic curve
+ * key CONSUMER_ECIES_PRIVATE_KEY is loaded instead.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T EncryptionLoadPrivateKey(void)
+{
+	Retcode_T cryptoRet = RETCODE_FAILURE;
+
+	/* free pk context */
+	mbedtls_pk_free(&mbedEncryptionHandleVar.privatePk);
+	mbedEncryptionHandleVar.privateKeyValid = false;
+
+#ifdef ENABLE_ECIES_ENCRYPTION
+	mbedtls_ecp_keypair_free(&mbedEncryptionHandleVar.privateEc);
+	cryptoRet = importEciesPrivateKey(&mbedEncryptionHandleVar.privateEc);
+#elif defined(ENABLE_COMPILED_KEYS)
+	cryptoRet = importCompiledPrivateKey(&mbedEncryptionHandleVar.privatePk);
+#else
+	/* parse private key - the PKCS#1 parser completes the CRT parameters */
+	cryptoRet = mbedtls_pk_parse_key(&mbedEncryptionHandleVar.privatePk, PrivateRSAKeyConsumer1024, strlen((const char*)PrivateRSAKeyConsumer1024) + 1, NULL, 0);
+#endif
+	if(RETCODE_SUCCESS == cryptoRet) {
+		mbedEncryptionHandleVar.privateKeyValid = true;
+	} else {
+		mbedtls_pk_free(&mbedEncryptionHandleVar.privatePk);
+#ifdef ENABLE_ECIES_ENCRYPTION
+		mbedtls_ecp_keypair_free(&mbedEncryptionHandleVar.privateEc);
+#endif
+		printf("Failed to read private key\n\r");
+	}
+
+	return cryptoRet;
+}
+
+#ifdef ENABLE_ECIES_ENCRYPTION
+/**
+ * This function returns the public key of the private elliptic
+ * curve key - the consumer publishes it with WritePublicKey
+ * instead of the PEM RSA key
+ *
+ * @param[out] oBuff
+ * This buffer will hold the public key
+ *
+ * @param[in] ioBuffLength
+ * Size of the output buffer --> at least ENCRYPTION_ECIES_SECP256R1_KEY_SIZE
+ *
+ * @param[out] oLength_ptr
+ * Length of the public key
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T EncryptionGetPublicKey(uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr)
+{
+	if( (NULL == oBuff) || (NULL == oLength_ptr) ) {
+		return RETCODE_FAILURE;
+	}
+	/* the private key is loaded once by InitMbedCrypto */
+	if( (true != mbedEncryptionHandleVar.privateKeyValid) && (RETCODE_SUCCESS != EncryptionLoadPrivateKey()) ) {
+		return RETCODE_FAILURE;
+	}
+
+	return (0 == eciesWritePoint(&mbedEncryptionHandleVar.privateEc.grp, &mbedEncryptionHandleVar.privateEc.Q, oBuff, ioBuffLength, oLength_ptr)) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+#endif
+
+/**
+ * This function fills a buffer with random bytes of the
+ * CTR-DRBG, e.g. for the masks of the WebSocket transport.
+ * The generator is shared with the encryption of the
+ * sensor data, so the consumer key mutex is taken.
+ *
+ * @param[out] oBuff
+ * This buffer will hold the random bytes
+ *
+ * @param[in] iLength
+ * Number of random bytes
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T EncryptionGetRandom(uint8_t *oBuff, size_t iLength)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+
+	if( (NULL == oBuff) || (true != mbedEncryptionHandleVar.ctrDrbgSeeded) ) {
+		return ret;
+	}
+	if(pdTRUE != xSemaphoreTake(mbedEncryptionHandleVar.consumerPkMutex, portMAX_DELAY)) {
+		return ret;
+	}
+
+	if(0 == mbedtls_ctr_drbg_random(&mbedEncryptionHandleVar.ctr_drbg, oBuff, iLength)) {
+		ret = RETCODE_SUCCESS;
+	}
+
+	xSemaphoreGive(mbedEncryptionHandleVar.consumerPkMutex);
+
+	return ret;
+}
+
+/**
+ * This function is called to calculate the data
+ * hash of a specified data buffer
+ *
+ * @param[in] payload_ptr
+ * This reference holds the "unhashed" payload data
+ *
+ * @param[in] iLength
+ * Length of the incoming payload
+ *
+ * @param[out] calculatedHash_ptr
+ * This buffer will hold the calculated hash value of
+ * the payload data
+ *
+ * @param[in] iLengthOBuffer
+ * Length of the hash buffer -> Must be equal to DATA_HASH_BUFF_SIZE
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T CalculateHash(uint8_t const *payload_ptr, size_t iLength, uint8_t *calculatedHash_ptr, size_t iLengthOBuffer)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+
+	if( (NULL!= payload_ptr) && (NULL != calculatedHash_ptr) && (0 < iLength) ) {
+		if(iLengthOBuffer == DATA_HASH_BUFF_SIZE) {
+			ret = mbedtls_sha256_starts_ret(&mbedEncryptionHandleVar.sha256ctx, 0);
+			ret = mbedtls_sha256_update_ret(&mbedEncryptionHandleVar.sha256ctx, payload_ptr, iLength);
+			ret = mbedtls_sha256_finish_ret(&mbedEncryptionHandleVar.sha256ctx, calculatedHash_ptr);
+#ifdef ENABLE_DEBUG
+			printf("Calculate hash\n\r");
+#endif
+		}
+	}
+
+    return ret;
+}
+
+/**
+ * This function is called when a consumer public key was
+ * read from the blockchain. The AuthenticatedConsumerTable
+ * and the parsed keys are shifted upwards in one step under
+ * the consumer key mutex, so encryptData never sees an entry
+ * with the key of another consumer. The oldest consumer is
+ * released and the new consumer is stored in the first entry.
+ * Every reading is then encrypted without parsing the PEM
+ * string again. With ENABLE_ECIES_ENCRYPTION the key selects
+ * the scheme of the consumer - a raw elliptic curve key is
+ * used with ECIES, a PEM key with RSA.
+ *
+ * @param[in] accountAddress_ptr
+ * account address of the new consumer - 40 hex characters
+ * without 0x prefix, NULL if the key could not be read
+ *
+ * @param[in] publicKey_ptr
+ * public key of the new consumer - null terminated PEM, a 65 byte
+ * secp256r1 point or a 32 byte Curve25519 key,
+ * NULL if the key could not be read - the first entry stays empty
+ *
+ * @param[in] iLength
+ * Length of the public key
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T EncryptionStoreConsumerKey(uint8_t const *accountAddress_ptr, uint8_t const *publicKey_ptr, size_t iLength)
+{
+	Retcode_T cryptoRet = RETCODE_FAILURE;
+
+	if( (NULL != publicKey_ptr) && ((READ_PUB_KEY_RESULT_LENGTH - 1) < iLength) ) {
+		return RETCODE_FAILURE;
+	}
+
+	/* without InitMbedCrypto e.g. if ENABLE_ENCRYPTION is not set
+	 * only the authentication table is kept */
+	if( (NULL != mbedEncryptionHandleVar.consumerPkMutex) && (pdTRUE != xSemaphoreTake(mbedEncryptionHandleVar.consumerPkMutex, portMAX_DELAY)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	/* push consumer information into authentication array - shift old information upwards */
+	for(uint8_t counter = CONSUMER_NUMBER_MAX - 1; counter > 0; --counter) {
+		AuthenticatedConsumerTable[counter] = AuthenticatedConsumerTable[counter - 1];
+	}
+	/* keep the null termination, a PEM key is parsed as string,
+	 * an elliptic curve key is binary */
+	memset(&AuthenticatedConsumerTable[0], 0, sizeof(AuthenticatedConsumerTable[0]));
+	if(NULL != publicKey_ptr) {
+		memcpy(AuthenticatedConsumerTable[0].consumerPublicKey, publicKey_ptr, iLength);
+		if(NULL != accountAddress_ptr) {
+			memcpy(AuthenticatedConsumerTable[0].accountAddress, "0x", 2);
+			memcpy(&AuthenticatedConsumerTable[0].accountAddress[2], accountAddress_ptr, READ_ETH_ACCOUNT_ADDRESS_RESULT_LENGTH);
+		}
+	}
+	if(NULL == mbedEncryptionHandleVar.consumerPkMutex) {
+		return RETCODE_SUCCESS;
+	}
+
+	/* release the key of the oldest consumer and shift the contexts
+	 * upwards - a context only holds a pointer to the parsed key */
+	mbedtls_pk_free(&mbedEncryptionHandleVar.consumerPk[CONSUMER_NUMBER_MAX - 1]);
+#ifdef ENABLE_ECIES_ENCRYPTION
+	mbedtls_ecp_keypair_free(&mbedEncryptionHandleVar.consumerEc[CONSUMER_NUMBER_MAX - 1]);
+#endif
+#ifdef ENABLE_HYBRID_ENCRYPTION
+	mbedtls_ccm_free(&mbedEncryptionHandleVar.consumerSession[CONSUMER_NUMBER_MAX - 1].ccm);
+#endif
+	for(uint8_t counter = CONSUMER_NUMBER_MAX - 1; counter > 0; --counter) {
+		mbedEncryptionHandleVar.consumerPk[counter] = mbedEncryptionHandleVar.consumerPk[counter - 1];
+		mbedEncryptionHandleVar.consumerPkValid[counter] = mbedEncryptionHandleVar.consumerPkValid[counter - 1];
+#ifdef ENABLE_ECIES_ENCRYPTION
+		mbedEncryptionHandleVar.consumerEc[counter] = mbedEncryptionHandleVar.consumerEc[counter - 1];
+		mbedEncryptionHandleVar.consumerEcValid[counter] = mbedEncryptionHandleVar.consumerEcValid[counter - 1];
+#endif
+#ifdef ENABLE_HYBRID_ENCRYPTION
+		mbedEncryptionHandleVar.consumerSession[counter] = mbedEncryptionHandleVar.consumerSession[counter - 1];
+#endif
+	}
+	mbedtls_pk_init(&mbedEncryptionHandleVar.consumerPk[0]);
+	mbedEncryptionHandleVar.consumerPkValid[0] = false;
+#ifdef ENABLE_ECIES_ENCRYPTION
+	mbedtls_ecp_keypair_init(&mbedEncryptionHandleVar.consumerEc[0]);
+	mbedEncryptionHandleVar.consumerEcValid[0] = false;
+#endif
+#ifdef ENABLE_HYBRID_ENCRYPTION
+	/* the session of a new key starts with the first reading */
+	mbedtls_ccm_init(&mbedEncryptionHandleVar.consumerSession[0].ccm);
+	mbedEncryptionHandleVar.consumerSession[0].valid = false;
+#endif
+
+	/* parse public key */
+#ifdef ENABLE_ECIES_ENCRYPTION
+	/* raw elliptic curve key - a PEM key is longer */
+	if( (NULL != publicKey_ptr) && ( ((ENCRYPTION_ECIES_SECP256R1_KEY_SIZE == iLength) && (0x04 == publicKey_ptr[0])) || (ENCRYPTION_ECIES_CURVE25519_KEY_SIZE == iLength) ) ) {
+		cryptoRet = importEciesPublicKey(&mbedEncryptionHandleVar.consumerEc[0], AuthenticatedConsumerTable[0].consumerPublicKey, iLength);
+		if(RETCODE_SUCCESS == cryptoRet) {
+			mbedEncryptionHandleVar.consumerEcValid[0] = true;
+		} else {
+			mbedtls_ecp_keypair_free(&mbedEncryptionHandleVar.consumerEc[0]);
+#ifdef ENABLE_DEBUG
+			printf("Failed to parse consumer public key\n\r");
+#endif
+		}
+	} else
+#else
+	(void) iLength;
+#endif
+	if(NULL != publicKey_ptr) {
+		cryptoRet = mbedtls_pk_parse_public_key(&mbedEncryptionHandleVar.consumerPk[0], AuthenticatedConsumerTable[0].consumerPublicKey, strlen((const char*)AuthenticatedConsumerTable[0].consumerPublicKey) + 1);
+		if(RETCODE_SUCCESS == cryptoRet) {
+			mbedEncryptionHandleVar.consumerPkValid[0] = true;
+		} else {
+			mbedtls_pk_free(&mbedEncryptionHandleVar.consumerPk[0]);
+#ifdef ENABLE_DEBUG
+			printf("Failed to parse consumer public key\n\r");
+#endif
+		}
+	}
+
+	xSemaphoreGive(mbedEncryptionHandleVar.consumerPkMutex);
+
+	return cryptoRet;
+}
+
+/**
+ * This function encrypts a payload with the stored key of a
+ * consumer slot - ECIES for an elliptic curve key, otherwise
+ * RSA. Must be called with the consumer key mutex taken.
+ *
+ * @param[in] slot
+ * entry of the AuthenticatedConsumerTable
+ *
+ * @param[in] payload_ptr
+ * This reference holds the raw payload data to encrypt
+ *
+ * @param[in] iLength
+ * Length of the incoming payload
+ *
+ * @param[out] oBuff
+ * This buffer will hold the encrypted payload
+ *
+ * @param[in] ioBuffLength
+ * Size of the output buffer
+ *
+ * @param[out] oLength_ptr
+ * Length of the encrypted payload
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T encryptForConsumer(uint8_t slot, uint8_t const *payload_ptr, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr)
+{
+#ifdef ENABLE_ECIES_ENCRYPTION
+	if(true == mbedEncryptionHandleVar.consumerEcValid[slot]) {
+		return eciesEncrypt(&mbedEncryptionHandleVar.consumerEc[slot], payload_ptr, iLength, oBuff, ioBuffLength, oLength_ptr);
+	}
+#endif
+	if(true == mbedEncryptionHandleVar.consumerPkValid[slot]) {
+		/* default padding type is PKCS#1 v1.5
+		 * so the length of the encrypted message is always the same
+		 * independent of the payload length.
+		 * For 1024 Bit RSA key, padded message is always 128 byte */
+		if(0 == mbedtls_pk_encrypt(&mbedEncryptionHandleVar.consumerPk[slot], payload_ptr, iLength, oBuff, oLength_ptr, ioBuffLength, mbedtls_ctr_drbg_random, &mbedEncryptionHandleVar.ctr_drbg)) {
+			return RETCODE_SUCCESS;
+		}
+	}
+
+	return RETCODE_FAILURE;
+}
+
+/**
+ * This function decrypts a payload with the resident private
+ * key of the consumer - ECIES with ENABLE_ECIES_ENCRYPTION,
+ * otherwise RSA. The key must be loaded.
+ *
+ * @param[in] payload_ptr
+ * This reference holds the encrypted payload data
+ *
+ * @param[in] iLength
+ * Length of the incoming encrypted payload
+ *
+ * @param[out] oBuff
+ * This buffer will hold the decrypted payload
+ *
+ * @param[in] ioBuffLength
+ * Size of the output buffer
+ *
+ * @param[out] oLength_ptr
+ * Length of the decrypted payload
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T decryptWithPrivateKey(uint8_t const *payload_ptr, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr)
+{
+#ifdef ENABLE_ECIES_ENCRYPTION
+	return eciesDecrypt(&mbedEncryptionHandleVar.privateEc, payload_ptr, iLength, oBuff, ioBuffLength, oLength_ptr);
+#else
+	return (0 == mbedtls_pk_decrypt(&mbedEncryptionHandleVar.privatePk, payload_ptr, iLength, oBuff, oLength_ptr, ioBuffLength, mbedtls_ctr_drbg_random, &mbedEncryptionHandleVar.ctr_drbg)) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+#endif
+}
+
+/**
+ * This function is called to encrypt data with the
+ * public key of the active consumer, which was parsed
+ * by EncryptionStoreConsumerKey - RSA or, for consumers
+ * with an elliptic curve key, ECIES.
+ *
+ * @param[in] payload_ptr
+ * This reference holds the raw payload data to encrypt
+ *
+ * @param[in] iLength
+ * Length of the incoming payload
+ *
+ * @param[out] oBuff
+ * This buffer will hold the encrypted value of
+ * the payload data (RSA: always padded to 128 bytes,
+ * ECIES: iLength + ENCRYPTION_ECIES_OVERHEAD_MAX at most)
+ *
+ * @param[out] ioBuffLength
+ * Size of the output buffer --> must be at least 128 bytes
+ *
+ * @param[out] oLength_ptr
+ * Length of the encrypted data
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T encryptData(uint8_t const *payload_ptr, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr)
+{
+	Retcode_T cryptoRet = RETCODE_FAILURE;
+	int8_t slot = -1;
+
+	/* check for NULL pointers */
+	if( (NULL != payload_ptr) && (NULL != oBuff)) {
+		if( (NULL == mbedEncryptionHandleVar.consumerPkMutex) || (pdTRUE != xSemaphoreTake(mbedEncryptionHandleVar.consumerPkMutex, portMAX_DELAY)) ) {
+			return RETCODE_FAILURE;
+		}
+
+		/* select public key of the active consumer */
+		for(uint8_t counter = 0; counter < CONSUMER_NUMBER_MAX; ++counter) {
+			if(AuthenticatedConsumerTable[counter].activeConsumer == true) {
+#ifdef ENABLE_DEBUG
+				/* the key is binary for ECIES - it is not printed as string */
+				printf("Data encryption for consumer %u\n\r", (unsigned int) counter);
+#endif
+				slot = counter;
+				AuthenticatedConsumerTable[counter].activeConsumer = false;
+			}
+		}
+		if(0 <= slot) {
+			/* start data encryption */
+			cryptoRet = encryptForConsumer(slot, payload_ptr, iLength, oBuff, ioBuffLength, oLength_ptr);
+			if(RETCODE_SUCCESS == cryptoRet) {
+#ifdef ENABLE_DEBUG
+				printf("Data encryption successful:%s; Length: %i\n\r", oBuff, *oLength_ptr);
+#endif
+			} else {
+				printf("Failed to encrypt data\n\r");
+			}
+		} else {
+			printf("Failed to read public key\n\r");
+		}
+
+		xSemaphoreGive(mbedEncryptionHandleVar.consumerPkMutex);
+	}
+
+	return cryptoRet;
+}
+
+/**
+ * This function is called to decrypt data which
+ * was encrypted with the RSA algorithm or, with
+ * ENABLE_ECIES_ENCRYPTION, with ECIES. The private
+ * key was loaded by EncryptionLoadPrivateKey.
+ *
+ * @param[in] payload_ptr
+ * This reference holds the encrypted payload data
+ *
+ * @param[in] iLength
+ * Length of the incoming encrypted payload
+ *
+ * @param[out] decryptedData_ptr
+ * This reference will hold the decrypted value of
+ * the payload data
+ *
+ * @param[out] ioBuffLength
+ * Size of the output buffer
+ *
+ * @param[out] oLength_ptr
+ * Length of the decrypted data
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T decryptData(uint8_t const *payload_ptr, size_t iLength, uint8_t *decryptedData_ptr, size_t ioBuffLength, size_t *oLength_ptr)
+{
+	Retcode_T cryptoRet = RETCODE_FAILURE;
+
+	/* check for NULL pointers */
+	if( (NULL != payload_ptr) && (NULL != decryptedData_ptr)) {
+		/* the private key is parsed once by InitMbedCrypto */
+		if(true != mbedEncryptionHandleVar.privateKeyValid) {
+			cryptoRet = EncryptionLoadPrivateKey();
+		} else {
+			cryptoRet = RETCODE_SUCCESS;
+		}
+
+		if(RETCODE_SUCCESS == cryptoRet) {
+			/* start data decryption */
+			cryptoRet = decryptWithPrivateKey(payload_ptr, iLength, decryptedData_ptr, ioBuffLength, oLength_ptr);
+
+#ifdef ENABLE_DEBUG
+			if(RETCODE_SUCCESS == cryptoRet) {
+				printf("Data decryption successful:%i ; Length: %i\n\r", *decryptedData_ptr, *oLength_ptr);
+			} else {
+				printf("Failed to decrypt data\n\r");
+			}
+		} else {
+			printf("Failed to read private key\n\r");
+		}
 #endif
 	} else {
 #ifdef ENABLE_DEBUG
@@ -302,3 +1206,361 @@ Retcode_T decryptData(uint8_t const *payload_ptr, size_t iLength, uint8_t *decry
 	}
 	return cryptoRet;
 }
+
+#ifdef ENABLE_HYBRID_ENCRYPTION
+/**
+ * This function writes a 32 bit value big endian
+ *
+ * @param[out] oBuff
+ * four byte output buffer
+ *
+ * @param[in] value
+ * value to write
+ *
+ * @return
+ * void
+ */
+static void writeUint32(uint8_t *oBuff, uint32_t value)
+{
+	oBuff[0] = (uint8_t) (value >> 24);
+	oBuff[1] = (uint8_t) (value >> 16);
+	oBuff[2] = (uint8_t) (value >> 8);
+	oBuff[3] = (uint8_t) value;
+}
+
+/**
+ * This function reads a big endian 32 bit value
+ *
+ * @param[in] buff_ptr
+ * four byte input buffer
+ *
+ * @return
+ * read value
+ */
+static uint32_t readUint32(uint8_t const *buff_ptr)
+{
+	return ((uint32_t) buff_ptr[0] << 24) | ((uint32_t) buff_ptr[1] << 16) | ((uint32_t) buff_ptr[2] << 8) | (uint32_t) buff_ptr[3];
+}
+
+/**
+ * This function starts a new session with a consumer. A fresh
+ * AES-128 key is drawn from the ctr_drbg, set into the CCM context
+ * and wrapped together with the session id by the public key of
+ * the consumer - the only public key operation of the session.
+ *
+ * @param[in] session_ptr
+ * session of the consumer slot
+ *
+ * @param[in] slot
+ * entry of the AuthenticatedConsumerTable
+ *
+ * @param[out] oWrapped_ptr
+ * This buffer will hold the wrapped session key
+ *
+ * @param[in] ioBuffLength
+ * Size of the wrapped key buffer
+ *
+ * @param[out] oLength_ptr
+ * Length of the wrapped key
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T startProducerSession(hybridSession_T *session_ptr, uint8_t slot, uint8_t *oWrapped_ptr, size_t ioBuffLength, size_t *oLength_ptr)
+{
+	uint8_t plain[HYBRID_WRAPPED_PLAIN_SIZE];
+	uint32_t sessionId = 0;
+	int cryptoRet = 0;
+
+	session_ptr->valid = false;
+	mbedtls_ccm_free(&session_ptr->ccm);
+	mbedtls_ccm_init(&session_ptr->ccm);
+
+	cryptoRet = mbedtls_ctr_drbg_random(&mbedEncryptionHandleVar.ctr_drbg, plain, sizeof(plain));
+	if(0 == cryptoRet) {
+		sessionId = readUint32(&plain[ENCRYPTION_HYBRID_KEY_SIZE]);
+		cryptoRet = mbedtls_ccm_setkey(&session_ptr->ccm, MBEDTLS_CIPHER_ID_AES, plain, ENCRYPTION_HYBRID_KEY_SIZE * 8);
+	}
+	if( (0 == cryptoRet) && (RETCODE_SUCCESS != encryptForConsumer(slot, plain, sizeof(plain), oWrapped_ptr, ioBuffLength, oLength_ptr)) ) {
+		cryptoRet = -1;
+	}
+	/* the session key only lives in the CCM context */
+	memset(plain, 0, sizeof(plain));
+
+	if(0 == cryptoRet) {
+		session_ptr->sessionId = sessionId;
+		session_ptr->counter = 0;
+		session_ptr->valid = true;
+#ifdef ENABLE_DEBUG
+		printf("Hybrid session %08lx started\n\r", (unsigned long) sessionId);
+#endif
+		return RETCODE_SUCCESS;
+	}
+
+	return RETCODE_FAILURE;
+}
+
+/**
+ * This function is called to encrypt a batch of sensor data
+ * in the hybrid mode. The batch is encrypted with the AES-CCM
+ * session of the active consumer, the first message of a
+ * session carries its wrapped key. After HYBRID_SESSION_MESSAGES
+ * messages a new session is started.
+ *
+ * Message: type | session id | counter | [wrapped key] | ciphertext | tag
+ *
+ * @param[in] payload_ptr
+ * This reference holds the raw payload data to encrypt
+ *
+ * @param[in] iLength
+ * Length of the incoming payload
+ *
+ * @param[out] oBuff
+ * This buffer will hold the message
+ *
+ * @param[in] ioBuffLength
+ * Size of the output buffer --> at least iLength + ENCRYPTION_HYBRID_OVERHEAD_MAX
+ *
+ * @param[out] oLength_ptr
+ * Length of the message
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T encryptDataHybrid(uint8_t const *payload_ptr, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr)
+{
+	Retcode_T cryptoRet = RETCODE_FAILURE;
+	hybridSession_T *session_ptr = NULL;
+	int8_t slot = -1;
+	size_t headerLength = ENCRYPTION_HYBRID_HEADER_SIZE;
+	size_t wrappedLength = 0;
+
+	/* check for NULL pointers */
+	if( (NULL == payload_ptr) || (NULL == oBuff) || (NULL == oLength_ptr) || (ioBuffLength < ENCRYPTION_HYBRID_HEADER_SIZE + ENCRYPTION_HYBRID_TAG_SIZE) ) {
+		return RETCODE_FAILURE;
+	}
+	if( (NULL == mbedEncryptionHandleVar.consumerPkMutex) || (pdTRUE != xSemaphoreTake(mbedEncryptionHandleVar.consumerPkMutex, portMAX_DELAY)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	/* select public key and session of the active consumer */
+	for(uint8_t counter = 0; counter < CONSUMER_NUMBER_MAX; ++counter) {
+		if(AuthenticatedConsumerTable[counter].activeConsumer == true) {
+			slot = counter;
+			session_ptr = &mbedEncryptionHandleVar.consumerSession[counter];
+			AuthenticatedConsumerTable[counter].activeConsumer = false;
+		}
+	}
+
+	if(0 <= slot) {
+		cryptoRet = RETCODE_SUCCESS;
+		oBuff[0] = HYBRID_TYPE_DATA;
+		/* new session - wrap a fresh key behind the header */
+		if( (true != session_ptr->valid) || (HYBRID_SESSION_MESSAGES <= session_ptr->counter) ) {
+			oBuff[0] = HYBRID_TYPE_KEY;
+			cryptoRet = startProducerSession(session_ptr, slot, &oBuff[ENCRYPTION_HYBRID_HEADER_SIZE], ioBuffLength - ENCRYPTION_HYBRID_HEADER_SIZE, &wrappedLength);
+			headerLength += wrappedLength;
+		}
+		if( (RETCODE_SUCCESS == cryptoRet) && (ioBuffLength < headerLength + iLength + ENCRYPTION_HYBRID_TAG_SIZE) ) {
+			cryptoRet = RETCODE_FAILURE;
+		}
+		if(RETCODE_SUCCESS == cryptoRet) {
+			writeUint32(&oBuff[1], session_ptr->sessionId);
+			writeUint32(&oBuff[5], session_ptr->counter);
+			/* nonce: session id and counter - the header is authenticated */
+			cryptoRet = mbedtls_ccm_encrypt_and_tag(&session_ptr->ccm, iLength, &oBuff[1], ENCRYPTION_HYBRID_HEADER_SIZE - 1, oBuff, headerLength,
+					payload_ptr, &oBuff[headerLength], &oBuff[headerLength + iLength], ENCRYPTION_HYBRID_TAG_SIZE);
+		}
+		if(RETCODE_SUCCESS == cryptoRet) {
+			session_ptr->counter++;
+			*oLength_ptr = headerLength + iLength + ENCRYPTION_HYBRID_TAG_SIZE;
+#ifdef ENABLE_DEBUG
+			printf("Hybrid data encryption successful; Length: %u\n\r", (unsigned int) *oLength_ptr);
+#endif
+		} else {
+			/* start over with a new session */
+			session_ptr->valid = false;
+			printf("Failed to encrypt data\n\r");
+		}
+	} else {
+		printf("Failed to read public key\n\r");
+	}
+
+	xSemaphoreGive(mbedEncryptionHandleVar.consumerPkMutex);
+
+	return cryptoRet;
+}
+
+/**
+ * This function checks if a session of the producer was
+ * accepted before
+ *
+ * @param[in] sessionId
+ * id of the session
+ *
+ * @return
+ * true, if the session is in the history<br>
+ * false, otherwise.
+ */
+static bool isKnownProducerSession(uint32_t sessionId)
+{
+	for(uint8_t entry = 0; entry < mbedEncryptionHandleVar.producerSessionHistoryCount; ++entry) {
+		if(sessionId == mbedEncryptionHandleVar.producerSessionHistory[entry]) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * This function adds an accepted session of the producer
+ * to the history, the oldest session is overwritten
+ *
+ * @param[in] sessionId
+ * id of the session
+ *
+ * @return
+ * void
+ */
+static void recordProducerSession(uint32_t sessionId)
+{
+	mbedEncryptionHandleVar.producerSessionHistory[mbedEncryptionHandleVar.producerSessionHistoryNext] = sessionId;
+	mbedEncryptionHandleVar.producerSessionHistoryNext = (mbedEncryptionHandleVar.producerSessionHistoryNext + 1) % HYBRID_SESSION_HISTORY;
+	if(HYBRID_SESSION_HISTORY > mbedEncryptionHandleVar.producerSessionHistoryCount) {
+		mbedEncryptionHandleVar.producerSessionHistoryCount++;
+	}
+}
+
+/**
+ * This function is called to decrypt a hybrid mode message
+ * of the producer. The session key is unwrapped with the
+ * resident private key once per session, every message is
+ * then authenticated and decrypted with AES-CCM. Replayed
+ * messages of the session are rejected. The wrapped key of
+ * one of the last HYBRID_SESSION_HISTORY sessions is rejected
+ * as well, a recorded session can not replace the current one.
+ *
+ * @param[in] payload_ptr
+ * This reference holds the message
+ *
+ * @param[in] iLength
+ * Length of the message
+ *
+ * @param[out] decryptedData_ptr
+ * This reference will hold the decrypted payload
+ *
+ * @param[in] ioBuffLength
+ * Size of the output buffer
+ *
+ * @param[out] oLength_ptr
+ * Length of the decrypted payload
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T decryptDataHybrid(uint8_t const *payload_ptr, size_t iLength, uint8_t *decryptedData_ptr, size_t ioBuffLength, size_t *oLength_ptr)
+{
+	hybridSession_T *session_ptr = &mbedEncryptionHandleVar.producerSession;
+	mbedtls_ccm_context newCcm;
+	mbedtls_ccm_context *ccm_ptr = &session_ptr->ccm;
+	uint8_t plain[HYBRID_WRAPPED_PLAIN_SIZE];
+	size_t headerLength = ENCRYPTION_HYBRID_HEADER_SIZE;
+	size_t plainLength = 0;
+	size_t dataLength = 0;
+	uint32_t sessionId = 0;
+	uint32_t counter = 0;
+	bool newSession = false;
+	int cryptoRet = -1;
+
+	/* check for NULL pointers */
+	if( (NULL == payload_ptr) || (NULL == decryptedData_ptr) || (NULL == oLength_ptr) || (iLength < ENCRYPTION_HYBRID_HEADER_SIZE + ENCRYPTION_HYBRID_TAG_SIZE) ) {
+		return RETCODE_FAILURE;
+	}
+	/* the private key is parsed once by InitMbedCrypto */
+	if( (true != mbedEncryptionHandleVar.privateKeyValid) && (RETCODE_SUCCESS != EncryptionLoadPrivateKey()) ) {
+		return RETCODE_FAILURE;
+	}
+
+	sessionId = readUint32(&payload_ptr[1]);
+	counter = readUint32(&payload_ptr[5]);
+	mbedtls_ccm_init(&newCcm);
+
+	if(HYBRID_TYPE_KEY == payload_ptr[0]) {
+#ifdef ENABLE_ECIES_ENCRYPTION
+		headerLength += eciesPublicKeySize(&mbedEncryptionHandleVar.privateEc.grp) + HYBRID_WRAPPED_PLAIN_SIZE + ENCRYPTION_ECIES_TAG_SIZE;
+#else
+		headerLength += mbedtls_pk_get_len(&mbedEncryptionHandleVar.privatePk);
+#endif
+		if(iLength < headerLength + ENCRYPTION_HYBRID_TAG_SIZE) {
+			return RETCODE_FAILURE;
+		}
+		if( (true == session_ptr->valid) && (sessionId == session_ptr->sessionId) ) {
+			/* key of the current session again - no public key operation */
+			cryptoRet = 0;
+		} else if(true == isKnownProducerSession(sessionId)) {
+#ifdef ENABLE_DEBUG
+			printf("Hybrid session %08lx replayed\n\r", (unsigned long) sessionId);
+#endif
+		} else {
+			/* unwrap the session key - the only public key operation of the session */
+			cryptoRet = (RETCODE_SUCCESS == decryptWithPrivateKey(&payload_ptr[ENCRYPTION_HYBRID_HEADER_SIZE], headerLength - ENCRYPTION_HYBRID_HEADER_SIZE, plain, sizeof(plain), &plainLength)) ? 0 : -1;
+			if( (0 == cryptoRet) && ( (sizeof(plain) != plainLength) || (sessionId != readUint32(&plain[ENCRYPTION_HYBRID_KEY_SIZE])) ) ) {
+				cryptoRet = -1;
+			}
+			if(0 == cryptoRet) {
+				cryptoRet = mbedtls_ccm_setkey(&newCcm, MBEDTLS_CIPHER_ID_AES, plain, ENCRYPTION_HYBRID_KEY_SIZE * 8);
+			}
+			memset(plain, 0, sizeof(plain));
+			ccm_ptr = &newCcm;
+			newSession = true;
+		}
+	} else if( (HYBRID_TYPE_DATA == payload_ptr[0]) && (true == session_ptr->valid) && (sessionId == session_ptr->sessionId) ) {
+		cryptoRet = 0;
+	} else {
+#ifdef ENABLE_DEBUG
+		printf("Hybrid session %08lx unknown - waiting for its key\n\r", (unsigned long) sessionId);
+#endif
+	}
+
+	/* reject replayed messages of the current session */
+	if( (0 == cryptoRet) && (true != newSession) && (counter < session_ptr->counter) ) {
+		cryptoRet = -1;
+	}
+
+	dataLength = iLength - headerLength - ENCRYPTION_HYBRID_TAG_SIZE;
+	if( (0 == cryptoRet) && (ioBuffLength < dataLength) ) {
+		cryptoRet = -1;
+	}
+	if(0 == cryptoRet) {
+		cryptoRet = mbedtls_ccm_auth_decrypt(ccm_ptr, dataLength, &payload_ptr[1], ENCRYPTION_HYBRID_HEADER_SIZE - 1, payload_ptr, headerLength,
+				&payload_ptr[headerLength], decryptedData_ptr, &payload_ptr[headerLength + dataLength], ENCRYPTION_HYBRID_TAG_SIZE);
+	}
+
+	if(0 == cryptoRet) {
+		/* an authenticated message of a new session replaces the old session */
+		if(true == newSession) {
+			mbedtls_ccm_free(&session_ptr->ccm);
+			session_ptr->ccm = newCcm;
+			session_ptr->sessionId = sessionId;
+			session_ptr->valid = true;
+			recordProducerSession(sessionId);
+		}
+		session_ptr->counter = counter + 1;
+		*oLength_ptr = dataLength;
+#ifdef ENABLE_DEBUG
+		printf("Hybrid data decryption successful; Length: %u\n\r", (unsigned int) dataLength);
+#endif
+		return RETCODE_SUCCESS;
+	}
+
+	mbedtls_ccm_free(&newCcm);
+#ifdef ENABLE_DEBUG
+	printf("Failed to decrypt hybrid data\n\r");
+#endif
+	return RETCODE_FAILURE;
+}
+#endif /* ENABLE_HYBRID_ENCRYPTION */
@@ -9,14 +9,44 @@
 #ifndef SOURCE_ENCRYPTION_H_
 #define SOURCE_ENCRYPTION_H_
 
+/* the declarations depend on the configuration */
+#include "UserConfig.h"
+
+/* hybrid mode: AES-128 session key, message header (type, session id,
+ * counter) and CCM tag, the first message of a session carries the RSA
+ * or ECIES wrapped key in addition */
+#define ENCRYPTION_HYBRID_KEY_SIZE			16
+#define ENCRYPTION_HYBRID_HEADER_SIZE		9
+#define ENCRYPTION_HYBRID_TAG_SIZE			16
+#define ENCRYPTION_HYBRID_OVERHEAD_MAX		(ENCRYPTION_HYBRID_HEADER_SIZE + 128 + ENCRYPTION_HYBRID_TAG_SIZE)
+
+/* ECIES: curves of the consumer keys and the message parts around the
+ * ciphertext - the ephemeral public key in front, the CCM tag behind it */
+#define ECIES_CURVE_SECP256R1					1
+#define ECIES_CURVE_CURVE25519					2
+#define ENCRYPTION_ECIES_SECP256R1_KEY_SIZE		65
+#define ENCRYPTION_ECIES_CURVE25519_KEY_SIZE	32
+#define ENCRYPTION_ECIES_TAG_SIZE				16
+#define ENCRYPTION_ECIES_OVERHEAD_MAX			(ENCRYPTION_ECIES_SECP256R1_KEY_SIZE + ENCRYPTION_ECIES_TAG_SIZE)
+
 /* global interface task declarations */
 xTaskHandle EncryptionTask;
 xTaskHandle DecryptionTask;
 
 /* global interface function declarations */
+Retcode_T EncryptionStoreConsumerKey(uint8_t const *accountAddress_ptr, uint8_t const *publicKey_ptr, size_t iLength);
 Retcode_T encryptData(uint8_t const *payload, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr);
 Retcode_T decryptData(uint8_t const *payload_ptr, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr);
+#ifdef ENABLE_HYBRID_ENCRYPTION
+Retcode_T encryptDataHybrid(uint8_t const *payload_ptr, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr);
+Retcode_T decryptDataHybrid(uint8_t const *payload_ptr, size_t iLength, uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr);
+#endif
 Retcode_T InitMbedCrypto(void);
+Retcode_T EncryptionLoadPrivateKey(void);
+#ifdef ENABLE_ECIES_ENCRYPTION
+Retcode_T EncryptionGetPublicKey(uint8_t *oBuff, size_t ioBuffLength, size_t *oLength_ptr);
+#endif
+Retcode_T EncryptionGetRandom(uint8_t *oBuff, size_t iLength);
 Retcode_T CalculateHash(uint8_t const *payload_ptr, size_t iLength, uint8_t *calculatedHash_ptr, size_t iLengthOBuffer);
 
 #endif /* SOURCE_ENCRYPTION_H_ */
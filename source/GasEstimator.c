@@ -0,0 +1,463 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "BCDS_Basics.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* user includes */
+#include "GasEstimator.h"
+#include "UserConfig.h"
+#include "SystemConfig.h"
+#include "LruTable.h"
+
+/* size of an ABI word in bytes */
+#define GAS_ESTIMATOR_WORD_SIZE		32
+
+/**
+ * This struct holds one gas estimate of the node. It is
+ * renewed after GAS_ESTIMATE_MAX_AGE_MS, but used until
+ * then even if the node can not be reached.
+ */
+typedef struct gasEstimatorEntry_S {
+	LruTableEntry_T lru;
+	GasEstimatorKey_T key;
+	uint32_t estimate;
+	portTickType storeTick;
+} gasEstimatorEntry_T;
+static gasEstimatorEntry_T gasEstimatorTable[GAS_ESTIMATOR_ENTRY_MAX];
+
+/* counters of one contract function */
+typedef struct gasEstimatorFunction_S {
+	bool used;
+	uint32_t selector;
+	GasEstimatorStats_T stats;
+} gasEstimatorFunction_T;
+static gasEstimatorFunction_T gasEstimatorFunctionTable[GAS_ESTIMATOR_FUNCTION_MAX];
+
+/* sent transaction whose receipt reports the used gas */
+typedef struct gasEstimatorPending_S {
+	bool valid;
+	GasEstimatorKey_T key;
+	uint32_t gasLimit;
+	portTickType sentTick;
+	uint8_t hash[GAS_ESTIMATOR_HASH_LENGTH];
+} gasEstimatorPending_T;
+static gasEstimatorPending_T gasEstimatorPendingTable[GAS_ESTIMATOR_PENDING_MAX];
+
+/* mutex of the tables */
+static SemaphoreHandle_t gasEstimatorMutex = NULL;
+
+/**
+ * This function searches the estimate of a key. Must be
+ * called with the mutex.
+ *
+ * @param[in] key_ptr
+ * This reference holds the key of the estimate
+ *
+ * @return
+ * reference of the entry, NULL if there is no estimate
+ */
+static gasEstimatorEntry_T *findEntry(GasEstimatorKey_T const *key_ptr)
+{
+	for(uint8_t entry = 0; entry < GAS_ESTIMATOR_ENTRY_MAX; ++entry) {
+		if( (true == gasEstimatorTable[entry].lru.valid) && (0 == memcmp(&gasEstimatorTable[entry].key, key_ptr, sizeof(GasEstimatorKey_T))) ) {
+			return &gasEstimatorTable[entry];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * This function returns the counters of a contract
+ * function. Must be called with the mutex.
+ *
+ * @param[in] selector
+ * Function selector of the contract function
+ *
+ * @param[in] create
+ * true to add the function if it has no counters yet
+ *
+ * @return
+ * reference of the counters, NULL if the function is unknown
+ * or the table is full
+ */
+static GasEstimatorStats_T *findFunctionStats(uint32_t selector, bool create)
+{
+	gasEstimatorFunction_T *free_ptr = NULL;
+
+	for(uint8_t function = 0; function < GAS_ESTIMATOR_FUNCTION_MAX; ++function) {
+		if(false == gasEstimatorFunctionTable[function].used) {
+			if(NULL == free_ptr) {
+				free_ptr = &gasEstimatorFunctionTable[function];
+			}
+		} else if(selector == gasEstimatorFunctionTable[function].selector) {
+			return &gasEstimatorFunctionTable[function].stats;
+		}
+	}
+
+	if( (false == create) || (NULL == free_ptr) ) {
+		return NULL;
+	}
+	memset(free_ptr, 0, sizeof(gasEstimatorFunction_T));
+	free_ptr->used = true;
+	free_ptr->selector = selector;
+
+	return &free_ptr->stats;
+}
+
+/**
+ * This function creates the mutex of the gas estimator.
+ * Without it every gas limit is the fallback of its function.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T GasEstimatorInit(void)
+{
+	if(NULL == gasEstimatorMutex) {
+		gasEstimatorMutex = xSemaphoreCreateMutex();
+	}
+
+	return (NULL != gasEstimatorMutex) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function creates the key of a gas estimate
+ *
+ * @param[in] selector
+ * Function selector of the contract function
+ *
+ * @param[in] iArgumentLength
+ * Length of the bytes argument, 0 for functions without one
+ *
+ * @param[out] oKey_ptr
+ * This reference will hold the key
+ *
+ * @return
+ * void
+ */
+void GasEstimatorMakeKey(uint32_t selector, size_t iArgumentLength, GasEstimatorKey_T *oKey_ptr)
+{
+	if(NULL != oKey_ptr) {
+		oKey_ptr->selector = selector;
+		oKey_ptr->argumentWords = (uint32_t) ((iArgumentLength + GAS_ESTIMATOR_WORD_SIZE - 1) / GAS_ESTIMATOR_WORD_SIZE);
+	}
+}
+
+/**
+ * This function checks if a current estimate of a key
+ * is cached
+ *
+ * @param[in] key_ptr
+ * This reference holds the key of the estimate
+ *
+ * @return
+ * true, if the estimate is younger than GAS_ESTIMATE_MAX_AGE_MS<br>
+ * false, if it has to be read from the node.
+ */
+bool GasEstimatorLookup(GasEstimatorKey_T const *key_ptr)
+{
+	bool current = false;
+	gasEstimatorEntry_T *entry_ptr = NULL;
+
+	if( (NULL == key_ptr) || (NULL == gasEstimatorMutex) || (pdTRUE != xSemaphoreTake(gasEstimatorMutex, portMAX_DELAY)) ) {
+		return current;
+	}
+
+	entry_ptr = findEntry(key_ptr);
+	if( (NULL != entry_ptr) && (GAS_ESTIMATE_MAX_AGE_MS > TICKS_TO_MS(xTaskGetTickCount() - entry_ptr->storeTick)) ) {
+		current = true;
+	}
+
+	xSemaphoreGive(gasEstimatorMutex);
+
+	return current;
+}
+
+/**
+ * This function stores the result of eth_estimateGas.
+ * The least recently used entry is replaced.
+ *
+ * @param[in] key_ptr
+ * This reference holds the key of the estimate
+ *
+ * @param[in] estimate
+ * Gas the node estimated for the transaction
+ *
+ * @return
+ * void
+ */
+void GasEstimatorStore(GasEstimatorKey_T const *key_ptr, uint64_t estimate)
+{
+	gasEstimatorEntry_T *entry_ptr = NULL;
+	GasEstimatorStats_T *stats_ptr = NULL;
+
+	if( (NULL == key_ptr) || (NULL == gasEstimatorMutex) || (pdTRUE != xSemaphoreTake(gasEstimatorMutex, portMAX_DELAY)) ) {
+		return;
+	}
+
+	entry_ptr = LruTableSelectEntry(gasEstimatorTable, sizeof(gasEstimatorEntry_T), GAS_ESTIMATOR_ENTRY_MAX, offsetof(gasEstimatorEntry_T, key), key_ptr, sizeof(GasEstimatorKey_T));
+
+	entry_ptr->key = *key_ptr;
+	entry_ptr->estimate = (GAS_ESTIMATOR_LIMIT_MAX < estimate) ? GAS_ESTIMATOR_LIMIT_MAX : (uint32_t) estimate;
+	entry_ptr->storeTick = xTaskGetTickCount();
+	entry_ptr->lru.lastUseTick = entry_ptr->storeTick;
+	entry_ptr->lru.valid = true;
+
+	stats_ptr = findFunctionStats(key_ptr->selector, true);
+	if(NULL != stats_ptr) {
+		stats_ptr->estimateCounter++;
+		stats_ptr->lastEstimate = entry_ptr->estimate;
+	}
+
+	xSemaphoreGive(gasEstimatorMutex);
+
+#ifdef ENABLE_DEBUG
+	printf("Gas estimate of 0x%08lx: %lu\n\r", (unsigned long) key_ptr->selector, (unsigned long) entry_ptr->estimate);
+#endif
+}
+
+/**
+ * This function counts an eth_estimateGas call which got
+ * no result, e.g. because the transaction would revert
+ *
+ * @param[in] key_ptr
+ * This reference holds the key of the estimate
+ *
+ * @return
+ * void
+ */
+void GasEstimatorReportFailure(GasEstimatorKey_T const *key_ptr)
+{
+	GasEstimatorStats_T *stats_ptr = NULL;
+
+	if( (NULL == key_ptr) || (NULL == gasEstimatorMutex) || (pdTRUE != xSemaphoreTake(gasEstimatorMutex, portMAX_DELAY)) ) {
+		return;
+	}
+
+	stats_ptr = findFunctionStats(key_ptr->selector, true);
+	if(NULL != stats_ptr) {
+		stats_ptr->estimateFailureCounter++;
+	}
+
+	xSemaphoreGive(gasEstimatorMutex);
+}
+
+/**
+ * This function returns the gas limit of a transaction.
+ * It is the cached estimate plus GAS_ESTIMATE_MARGIN_PERCENT,
+ * without estimate the fallback of the function.
+ *
+ * @param[in] key_ptr
+ * This reference holds the key of the estimate
+ *
+ * @param[in] fallbackGas
+ * Gas limit of the function if there is no estimate
+ *
+ * @return
+ * gas limit, at most GAS_ESTIMATOR_LIMIT_MAX
+ */
+uint32_t GasEstimatorGetLimit(GasEstimatorKey_T const *key_ptr, uint32_t fallbackGas)
+{
+	uint64_t gasLimit = fallbackGas;
+	gasEstimatorEntry_T *entry_ptr = NULL;
+	GasEstimatorStats_T *stats_ptr = NULL;
+
+	if( (NULL == key_ptr) || (NULL == gasEstimatorMutex) || (pdTRUE != xSemaphoreTake(gasEstimatorMutex, portMAX_DELAY)) ) {
+		return fallbackGas;
+	}
+
+	entry_ptr = findEntry(key_ptr);
+	stats_ptr = findFunctionStats(key_ptr->selector, true);
+	if(NULL != entry_ptr) {
+		gasLimit = ((uint64_t) entry_ptr->estimate * (100 + GAS_ESTIMATE_MARGIN_PERCENT)) / 100;
+		if(GAS_ESTIMATOR_LIMIT_MAX < gasLimit) {
+			gasLimit = GAS_ESTIMATOR_LIMIT_MAX;
+		}
+		entry_ptr->lru.lastUseTick = xTaskGetTickCount();
+		if(NULL != stats_ptr) {
+			stats_ptr->hitCounter++;
+		}
+	} else if(NULL != stats_ptr) {
+		stats_ptr->fallbackCounter++;
+	}
+	if(NULL != stats_ptr) {
+		stats_ptr->lastGasLimit = (uint32_t) gasLimit;
+	}
+
+	xSemaphoreGive(gasEstimatorMutex);
+
+	return (uint32_t) gasLimit;
+}
+
+/**
+ * This function remembers a sent transaction so the gas
+ * used by it is recorded when its receipt arrives. The
+ * oldest transaction is dropped if the table is full.
+ *
+ * @param[in] key_ptr
+ * This reference holds the key of the estimate
+ *
+ * @param[in] gasLimit
+ * Gas limit the transaction was sent with
+ *
+ * @param[in] hash_ptr
+ * This reference holds the transaction hash string
+ *
+ * @param[in] iLength
+ * Length of the transaction hash
+ *
+ * @return
+ * void
+ */
+void GasEstimatorTrackTransaction(GasEstimatorKey_T const *key_ptr, uint32_t gasLimit, uint8_t const *hash_ptr, size_t iLength)
+{
+	gasEstimatorPending_T *pending_ptr = NULL;
+
+	if( (NULL == key_ptr) || (NULL == hash_ptr) || (GAS_ESTIMATOR_HASH_LENGTH != iLength) || (NULL == gasEstimatorMutex) ) {
+		return;
+	}
+	if(pdTRUE != xSemaphoreTake(gasEstimatorMutex, portMAX_DELAY)) {
+		return;
+	}
+
+	for(uint8_t pending = 0; pending < GAS_ESTIMATOR_PENDING_MAX; ++pending) {
+		gasEstimatorPending_T *candidate_ptr = &gasEstimatorPendingTable[pending];
+		if(false == candidate_ptr->valid) {
+			pending_ptr = candidate_ptr;
+			break;
+		} else if( (NULL == pending_ptr) || (0 > (int32_t) (candidate_ptr->sentTick - pending_ptr->sentTick)) ) {
+			pending_ptr = candidate_ptr;
+		}
+	}
+
+	pending_ptr->key = *key_ptr;
+	pending_ptr->gasLimit = gasLimit;
+	pending_ptr->sentTick = xTaskGetTickCount();
+	memcpy(pending_ptr->hash, hash_ptr, GAS_ESTIMATOR_HASH_LENGTH);
+	pending_ptr->valid = true;
+
+	xSemaphoreGive(gasEstimatorMutex);
+}
+
+/**
+ * This function records the gas used by a transaction
+ * from its receipt. An estimate is dropped if the
+ * transaction ran out of gas or used more gas than
+ * estimated, so the next transaction is estimated again.
+ *
+ * @param[in] hash_ptr
+ * This reference holds the transaction hash of the receipt
+ *
+ * @param[in] iLength
+ * Length of the transaction hash
+ *
+ * @param[in] gasUsed
+ * Gas used by the transaction
+ *
+ * @param[in] success
+ * true if the status of the receipt is 0x1
+ *
+ * @return
+ * void
+ */
+void GasEstimatorRecordReceipt(uint8_t const *hash_ptr, size_t iLength, uint64_t gasUsed, bool success)
+{
+	gasEstimatorPending_T *pending_ptr = NULL;
+	gasEstimatorEntry_T *entry_ptr = NULL;
+	GasEstimatorStats_T *stats_ptr = NULL;
+	uint32_t used = (GAS_ESTIMATOR_LIMIT_MAX < gasUsed) ? GAS_ESTIMATOR_LIMIT_MAX : (uint32_t) gasUsed;
+
+	if( (NULL == hash_ptr) || (GAS_ESTIMATOR_HASH_LENGTH != iLength) || (NULL == gasEstimatorMutex) ) {
+		return;
+	}
+	if(pdTRUE != xSemaphoreTake(gasEstimatorMutex, portMAX_DELAY)) {
+		return;
+	}
+
+	/* receipts are polled until the transaction is mined - only the first one is recorded */
+	for(uint8_t pending = 0; pending < GAS_ESTIMATOR_PENDING_MAX; ++pending) {
+		if( (true == gasEstimatorPendingTable[pending].valid) && (0 == memcmp(gasEstimatorPendingTable[pending].hash, hash_ptr, GAS_ESTIMATOR_HASH_LENGTH)) ) {
+			pending_ptr = &gasEstimatorPendingTable[pending];
+			break;
+		}
+	}
+
+	if(NULL != pending_ptr) {
+		pending_ptr->valid = false;
+		entry_ptr = findEntry(&pending_ptr->key);
+		stats_ptr = findFunctionStats(pending_ptr->key.selector, true);
+
+		if(NULL != stats_ptr) {
+			stats_ptr->receiptCounter++;
+			stats_ptr->lastGasUsed = used;
+			if(used > stats_ptr->maxGasUsed) {
+				stats_ptr->maxGasUsed = used;
+			}
+		}
+		if( (false == success) && (used >= pending_ptr->gasLimit) ) {
+			if(NULL != stats_ptr) {
+				stats_ptr->outOfGasCounter++;
+			}
+			if(NULL != entry_ptr) {
+				entry_ptr->lru.valid = false;
+			}
+		} else if( (NULL != entry_ptr) && (used > entry_ptr->estimate) ) {
+			/* the margin was used up - the contract state changed since the estimate */
+			entry_ptr->lru.valid = false;
+		}
+
+#ifdef ENABLE_DEBUG
+		printf("Gas of 0x%08lx: limit %lu, used %lu\n\r", (unsigned long) pending_ptr->key.selector, (unsigned long) pending_ptr->gasLimit, (unsigned long) used);
+#endif
+	}
+
+	xSemaphoreGive(gasEstimatorMutex);
+}
+
+/**
+ * This function copies the estimated versus used gas
+ * counters of a contract function
+ *
+ * @param[in] selector
+ * Function selector of the contract function
+ *
+ * @param[out] oStats_ptr
+ * This reference will hold the counter values
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T GasEstimatorGetStats(uint32_t selector, GasEstimatorStats_T *oStats_ptr)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	GasEstimatorStats_T *stats_ptr = NULL;
+
+	if( (NULL == oStats_ptr) || (NULL == gasEstimatorMutex) || (pdTRUE != xSemaphoreTake(gasEstimatorMutex, portMAX_DELAY)) ) {
+		return ret;
+	}
+
+	stats_ptr = findFunctionStats(selector, false);
+	if(NULL != stats_ptr) {
+		*oStats_ptr = *stats_ptr;
+		ret = RETCODE_SUCCESS;
+	}
+
+	xSemaphoreGive(gasEstimatorMutex);
+
+	return ret;
+}
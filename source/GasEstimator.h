@@ -0,0 +1,64 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_GASESTIMATOR_H_
+#define SOURCE_GASESTIMATOR_H_
+
+/* number of cached gas estimates - one per transaction function and argument size */
+#define GAS_ESTIMATOR_ENTRY_MAX			4
+
+/* number of contract functions with own counters */
+#define GAS_ESTIMATOR_FUNCTION_MAX		4
+
+/* number of sent transactions whose receipt is waited for */
+#define GAS_ESTIMATOR_PENDING_MAX		4
+
+/* upper bound of every gas limit - the block gas limit of a
+ * default development chain */
+#define GAS_ESTIMATOR_LIMIT_MAX			UINT32_C(0x47E7C0)
+
+/* length of a "0x" prefixed transaction hash */
+#define GAS_ESTIMATOR_HASH_LENGTH		66
+
+/**
+ * key of a gas estimate. The gas of the contract functions
+ * depends on the size of their bytes argument, so estimates
+ * of arguments with a different number of 32 byte words
+ * are kept separately.
+ */
+typedef struct GasEstimatorKey_S {
+	uint32_t selector;
+	uint32_t argumentWords;
+} GasEstimatorKey_T;
+
+/* estimated versus used gas of one contract function */
+typedef struct GasEstimatorStats_S {
+	uint32_t estimateCounter;		/* estimates read from the node */
+	uint32_t estimateFailureCounter;
+	uint32_t hitCounter;			/* gas limits from a cached estimate */
+	uint32_t fallbackCounter;		/* gas limits from the fallback table */
+	uint32_t receiptCounter;
+	uint32_t outOfGasCounter;		/* failed receipts which used the whole gas limit */
+	uint32_t lastEstimate;
+	uint32_t lastGasLimit;
+	uint32_t lastGasUsed;
+	uint32_t maxGasUsed;
+} GasEstimatorStats_T;
+
+/* global interface function declarations */
+Retcode_T GasEstimatorInit(void);
+void GasEstimatorMakeKey(uint32_t selector, size_t iArgumentLength, GasEstimatorKey_T *oKey_ptr);
+bool GasEstimatorLookup(GasEstimatorKey_T const *key_ptr);
+void GasEstimatorStore(GasEstimatorKey_T const *key_ptr, uint64_t estimate);
+void GasEstimatorReportFailure(GasEstimatorKey_T const *key_ptr);
+uint32_t GasEstimatorGetLimit(GasEstimatorKey_T const *key_ptr, uint32_t fallbackGas);
+void GasEstimatorTrackTransaction(GasEstimatorKey_T const *key_ptr, uint32_t gasLimit, uint8_t const *hash_ptr, size_t iLength);
+void GasEstimatorRecordReceipt(uint8_t const *hash_ptr, size_t iLength, uint64_t gasUsed, bool success);
+Retcode_T GasEstimatorGetStats(uint32_t selector, GasEstimatorStats_T *oStats_ptr);
+
+#endif /* SOURCE_GASESTIMATOR_H_ */
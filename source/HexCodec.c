@@ -0,0 +1,218 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <string.h>
+#include "BCDS_Basics.h"
+
+/* user includes */
+#include "HexCodec.h"
+
+/* bit which turns the hex letters A-F into a-f - digits have it set already */
+#define HEX_LOWERCASE_BIT		0x20
+#define HEX_LOWERCASE_WORD		UINT32_C(0x20202020)
+
+/* two lower case hex characters of every byte value */
+static uint8_t const HexEncodeTable[256][2] = {
+	"00", "01", "02", "03", "04", "05", "06", "07",
+	"08", "09", "0a", "0b", "0c", "0d", "0e", "0f",
+	"10", "11", "12", "13", "14", "15", "16", "17",
+	"18", "19", "1a", "1b", "1c", "1d", "1e", "1f",
+	"20", "21", "22", "23", "24", "25", "26", "27",
+	"28", "29", "2a", "2b", "2c", "2d", "2e", "2f",
+	"30", "31", "32", "33", "34", "35", "36", "37",
+	"38", "39", "3a", "3b", "3c", "3d", "3e", "3f",
+	"40", "41", "42", "43", "44", "45", "46", "47",
+	"48", "49", "4a", "4b", "4c", "4d", "4e", "4f",
+	"50", "51", "52", "53", "54", "55", "56", "57",
+	"58", "59", "5a", "5b", "5c", "5d", "5e", "5f",
+	"60", "61", "62", "63", "64", "65", "66", "67",
+	"68", "69", "6a", "6b", "6c", "6d", "6e", "6f",
+	"70", "71", "72", "73", "74", "75", "76", "77",
+	"78", "79", "7a", "7b", "7c", "7d", "7e", "7f",
+	"80", "81", "82", "83", "84", "85", "86", "87",
+	"88", "89", "8a", "8b", "8c", "8d", "8e", "8f",
+	"90", "91", "92", "93", "94", "95", "96", "97",
+	"98", "99", "9a", "9b", "9c", "9d", "9e", "9f",
+	"a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7",
+	"a8", "a9", "aa", "ab", "ac", "ad", "ae", "af",
+	"b0", "b1", "b2", "b3", "b4", "b5", "b6", "b7",
+	"b8", "b9", "ba", "bb", "bc", "bd", "be", "bf",
+	"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7",
+	"c8", "c9", "ca", "cb", "cc", "cd", "ce", "cf",
+	"d0", "d1", "d2", "d3", "d4", "d5", "d6", "d7",
+	"d8", "d9", "da", "db", "dc", "dd", "de", "df",
+	"e0", "e1", "e2", "e3", "e4", "e5", "e6", "e7",
+	"e8", "e9", "ea", "eb", "ec", "ed", "ee", "ef",
+	"f0", "f1", "f2", "f3", "f4", "f5", "f6", "f7",
+	"f8", "f9", "fa", "fb", "fc", "fd", "fe", "ff"
+};
+
+/* value of every hex character, HEX_INVALID_DIGIT for all others */
+static uint8_t const HexDecodeTable[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+/**
+ * This function encodes binary data as lower case hex
+ * characters without 0x prefix and null termination.
+ * Both characters of a byte are copied from the lookup
+ * table at once. The data is encoded from the end, so
+ * the encoding can be done in place if data_ptr is
+ * equal to oHex_ptr.
+ *
+ * @param[in] data_ptr
+ * This reference holds the binary data
+ *
+ * @param[in] iLength
+ * Number of bytes to encode
+ *
+ * @param[out] oHex_ptr
+ * Output buffer - must hold iLength * 2 characters
+ *
+ * @return
+ * void
+ */
+void HexEncode(uint8_t const *data_ptr, size_t iLength, uint8_t *oHex_ptr)
+{
+	for(size_t i = iLength; 0 < i; --i) {
+		memcpy(&oHex_ptr[(i - 1) * 2], HexEncodeTable[data_ptr[i - 1]], 2);
+	}
+}
+
+/**
+ * This function decodes hex characters into binary data.
+ * Invalid digits are collected while decoding and reported
+ * once at the end, so the loop does not branch per character.
+ * The decoding can be done in place if hex_ptr is equal
+ * to oData_ptr.
+ *
+ * @param[in] hex_ptr
+ * This reference holds the hex characters without 0x prefix.
+ * It does not have to be null terminated.
+ *
+ * @param[in] iHexLength
+ * Number of hex characters - must be even
+ *
+ * @param[out] oData_ptr
+ * Output buffer - must hold iHexLength / 2 bytes. Its
+ * content is undefined if the decoding fails.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T HexDecode(uint8_t const *hex_ptr, size_t iHexLength, uint8_t *oData_ptr)
+{
+	uint8_t high = 0;
+	uint8_t low = 0;
+	uint8_t invalid = 0;
+
+	if(0 != (iHexLength % 2)) {
+		return RETCODE_FAILURE;
+	}
+
+	for(size_t i = 0; i < (iHexLength / 2); ++i) {
+		high = HexDecodeTable[hex_ptr[2 * i]];
+		low = HexDecodeTable[hex_ptr[(2 * i) + 1]];
+		invalid |= high | low;
+		oData_ptr[i] = (uint8_t) ((high << 4) | low);
+	}
+
+	/* only invalid characters set the upper bits */
+	return (0 == (invalid & 0xF0)) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function returns the value of one hex digit
+ *
+ * @param[in] character
+ * hex character
+ *
+ * @return
+ * value of the hex digit, HEX_INVALID_DIGIT for other characters
+ */
+uint8_t HexDecodeDigit(uint8_t character)
+{
+	return HexDecodeTable[character];
+}
+
+/**
+ * This function converts a hex string in place to lower
+ * case e.g. to compare ethereum addresses which are case
+ * insensitive. An optional 0x prefix is kept. The string
+ * is only changed if all characters are hex digits.
+ * Letters are converted a word at a time.
+ *
+ * @param[in,out] hex_ptr
+ * This reference holds the hex string. It does not have
+ * to be null terminated.
+ *
+ * @param[in] iLength
+ * Number of characters to convert
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T HexNormalize(uint8_t *hex_ptr, size_t iLength)
+{
+	uint8_t invalid = 0;
+	uint8_t *prefix_ptr = NULL;
+	uint32_t word = 0;
+	size_t i = 0;
+
+	if(NULL == hex_ptr) {
+		return RETCODE_FAILURE;
+	}
+
+	if( (2 <= iLength) && ('0' == hex_ptr[0]) && (('x' == hex_ptr[1]) || ('X' == hex_ptr[1])) ) {
+		prefix_ptr = &hex_ptr[1];
+		hex_ptr += 2;
+		iLength -= 2;
+	}
+
+	for(i = 0; i < iLength; ++i) {
+		invalid |= HexDecodeTable[hex_ptr[i]];
+	}
+	if(0 != (invalid & 0xF0)) {
+		return RETCODE_FAILURE;
+	}
+
+	/* the prefix is only rewritten once all digits are valid */
+	if(NULL != prefix_ptr) {
+		*prefix_ptr = 'x';
+	}
+
+	/* all characters are hex digits - setting the lower case bit is enough */
+	for(i = 0; (i + sizeof(word)) <= iLength; i += sizeof(word)) {
+		memcpy(&word, &hex_ptr[i], sizeof(word));
+		word |= HEX_LOWERCASE_WORD;
+		memcpy(&hex_ptr[i], &word, sizeof(word));
+	}
+	for(; i < iLength; ++i) {
+		hex_ptr[i] |= HEX_LOWERCASE_BIT;
+	}
+
+	return RETCODE_SUCCESS;
+}
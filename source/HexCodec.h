@@ -0,0 +1,21 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_HEXCODEC_H_
+#define SOURCE_HEXCODEC_H_
+
+/* value of HexDecodeDigit for characters which are no hex digit */
+#define HEX_INVALID_DIGIT	0xFF
+
+/* global interface function declarations */
+void HexEncode(uint8_t const *data_ptr, size_t iLength, uint8_t *oHex_ptr);
+Retcode_T HexDecode(uint8_t const *hex_ptr, size_t iHexLength, uint8_t *oData_ptr);
+uint8_t HexDecodeDigit(uint8_t character);
+Retcode_T HexNormalize(uint8_t *hex_ptr, size_t iLength);
+
+#endif /* SOURCE_HEXCODEC_H_ */
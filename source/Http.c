@@ -14,754 +14,2970 @@
 #include "Serval_HttpClient.h"
 #include "Serval_Network.h"
 #include "PIp.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
 
 /* user includes */
 #include "Http.h"
 #include "UserConfig.h"
 #include "SystemConfig.h"
 #include "Encryption.h"
-#include "cJSON.h"
+#include "JSONWriter.h"
+#include "ABIEncoder.h"
+#include "ABIDecoder.h"
+#include "JSONReader.h"
 #include "CoAPServer.h"
+#include "ConfirmationTracker.h"
+#include "HexCodec.h"
+#include "TransactionSigner.h"
+#include "ReadCache.h"
+#include "GasEstimator.h"
+#include "RequestTemplate.h"
+#include "NodePool.h"
+#include "HttpTransport.h"
+#include "WebSocketTransport.h"
+#include "PipelineTransport.h"
 
-/* post command is used to invoke blockchain functions via json-rpc */
-#define DESTINATION_POST_PATH "/post"
-
-/* Example of how a json string is put together */
-/**
- * JSON string contains the following hex encoded data information
- * hex representation of data offset - here: 0x20 = 32 Bytes
- * hex representation of Payload size - here: 0x20 = 32 Bytes
- * hex representation of Payload - always padded to 32 byte blocks (left aligned)
- *
- * message format for dynamic input parameter data like bytes, string, array:
- *    4 bytes - first four bytes of sha256 function hash (web3.sha3("WritePublicKey(bytes)") to generate function hash)
- * + 32 bytes - offset to the start of payload data (e.g. 0000000000000000000000000000000000000000000000000000000000000020 --> 32 byte offset)
- * + 32 bytes - number of payload data in bytes (e.g. 0000000000000000000000000000000000000000000000000000000000000020 --> 32 bytes payload)
- * + xx bytes - payload right padded (e.g. 2121000000000000000000000000000000000000000000000000000000000000)
- * */
-/* function headers hard coded until parameter values */
-#define READ_DATA_HASH_HEADER   		"0x0546bedb00000000000000000000000000000000000000000000000000000000"
-										/* Func hash															 Offset												Payload length*/
-#define WRITE_DATA_HASH_HEADER  		"0x0ef8126900000000000000000000000000000000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000000000020"
-#define WRITE_DATA_HASH_HEADER_LEN  	strlen(WRITE_DATA_HASH_HEADER)
-
-#define READ_PUBLIC_KEY_HEADER  		"0xfcc01d5100000000000000000000000000000000000000000000000000000000"
-										/* Func hash															 Offset												Payload length*/
-#define WRITE_PUBLIC_KEY_HEADER 		"0x2ea8dff500000000000000000000000000000000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000000000110"
-#define WRITE_PUBLIC_KEY_HEADER_LEN 	strlen(WRITE_PUBLIC_KEY_HEADER)
-
-#define RATE_PRODUCER_POSITIVE_DATA		"0xf18aeab60000000000000000000000000000000000000000000000000000000000000001"
-#define RATE_PRODUCER_NEGATIVE_DATA		"0xf18aeab60000000000000000000000000000000000000000000000000000000000000000"
-#define RATE_PRODUCER_HEADER_LEN		strlen(RATE_PRODUCER_POSITIVE_DATA)
-
-#define TRANSACTION_EXECUTION_GAS 		"0x47E7C0"
 #define JSON_RPC_VERSION 				"2.0"
-#define DATA_ETHER_EXCHANGE_RATE		"0x1BC16D674EC80000" /* 2 ether in wei */
+#define DATA_ETHER_EXCHANGE_RATE		UINT64_C(2000000000000000000) /* 2 ether in wei */
 
-#define JSON_STRING_BUFF_SIZE 							2048
+/* position of the return values of the contract read functions -
+ * ReadDataHash() returns (bytes), ReadPublicKey() returns (bytes, address) */
+#define READ_DATA_HASH_RESULT_INDEX						0
+#define READ_PUBLIC_KEY_RESULT_INDEX					0
+#define READ_ETH_ACCOUNT_ADDR_RESULT_INDEX				1
 
-#define READ_DATA_HASH_JSON_RESULT_OFFSET				130
-#define READ_DATA_HASH_JSON_RESPONSE_LENGTH 			230
+/**
+ * This struct describes how one ethereum function is called
+ * on the smart contract. The data of the call is ABI encoded
+ * by ABIEncodeCall - the selectors are generated from the
+ * contract by tools/gen_abi.py. Function calls with payload
+ * pass it as the only argument of type argType, a bool
+ * argument gets the constant boolValue. Transactions are
+ * sent with eth_sendTransaction or signed on the XDK and
+ * sent with eth_sendRawTransaction, the other functions
+ * are read with eth_call.
+ * Transactions are sent with the gas limit of their
+ * eth_estimateGas result plus a margin, fallbackGas is
+ * used while there is no estimate. It leaves room for a
+ * 1024 bit public key and a sha256 data hash.
+ */
+typedef struct contractFunction_S {
+	etherFuncCalls ethMethod;
+	bool transaction;
+	uint32_t selector;
+	ABIType_T argType;
+	bool boolValue;
+	uint64_t value;		/* wei sent along with the transaction */
+	uint32_t fallbackGas;
+} contractFunction_T;
+
+static const contractFunction_T ContractFunctionTable[] = {
+	{ WRITE_DATA_HASH,			true,	ABI_SELECTOR_WRITE_DATA_HASH,	ABI_TYPE_BYTES,	false,	0,							UINT32_C(200000) },
+	{ READ_DATA_HASH,			false,	ABI_SELECTOR_READ_DATA_HASH,	ABI_TYPE_NONE,	false,	0,							0 },
+	{ WRITE_PUBLIC_KEY,			true,	ABI_SELECTOR_WRITE_PUBLIC_KEY,	ABI_TYPE_BYTES,	false,	DATA_ETHER_EXCHANGE_RATE,	UINT32_C(600000) },
+	{ READ_PUBLIC_KEY,			false,	ABI_SELECTOR_READ_PUBLIC_KEY,	ABI_TYPE_NONE,	false,	0,							0 },
+	{ RATE_PRODUCER_POSITIVE,	true,	ABI_SELECTOR_RATE_PRODUCER,		ABI_TYPE_BOOL,	true,	0,							UINT32_C(150000) },
+	{ RATE_PRODUCER_NEGATIVE,	true,	ABI_SELECTOR_RATE_PRODUCER,		ABI_TYPE_BOOL,	false,	0,							UINT32_C(150000) },
+};
+
+/**
+ * This function searches the contract function of an
+ * ethereum function
+ *
+ * @param[in] etherMethod
+ * This parameter holds the ethereum function
+ *
+ * @return
+ * reference of the table entry, NULL for node functions
+ */
+static contractFunction_T const *findContractFunction(etherFuncCalls etherMethod)
+{
+	for(uint8_t function = 0; function < (sizeof(ContractFunctionTable) / sizeof(ContractFunctionTable[0])); ++function) {
+		if(etherMethod == ContractFunctionTable[function].ethMethod) {
+			return &ContractFunctionTable[function];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * This struct describes how long the response of an
+ * ethereum function is waited for and if the call is
+ * sent again when its response is lost. Only calls which
+ * do not change the state of the node are retried - a
+ * transaction is sent once so it can not be executed
+ * twice.
+ */
+typedef struct httpMethodPolicy_S {
+	etherFuncCalls ethMethod;
+	uint32_t deadlineMs;		/* time until the request fails */
+	uint32_t attemptTimeoutMs;	/* time one attempt may take before it is retried */
+	uint8_t retryMax;
+} httpMethodPolicy_T;
+
+static const httpMethodPolicy_T HttpMethodPolicyTable[] = {
+	{ WRITE_DATA_HASH,			HTTP_TRANSACTION_DEADLINE_MS,	HTTP_TRANSACTION_DEADLINE_MS,	0 },
+	{ READ_DATA_HASH,			HTTP_READ_DEADLINE_MS,			HTTP_READ_ATTEMPT_TIMEOUT_MS,	HTTP_READ_RETRY_MAX },
+	{ WRITE_PUBLIC_KEY,			HTTP_TRANSACTION_DEADLINE_MS,	HTTP_TRANSACTION_DEADLINE_MS,	0 },
+	{ READ_PUBLIC_KEY,			HTTP_READ_DEADLINE_MS,			HTTP_READ_ATTEMPT_TIMEOUT_MS,	HTTP_READ_RETRY_MAX },
+	{ RATE_PRODUCER_POSITIVE,	HTTP_TRANSACTION_DEADLINE_MS,	HTTP_TRANSACTION_DEADLINE_MS,	0 },
+	{ RATE_PRODUCER_NEGATIVE,	HTTP_TRANSACTION_DEADLINE_MS,	HTTP_TRANSACTION_DEADLINE_MS,	0 },
+	{ GET_TRANSACTION_RECEIPT,	HTTP_READ_DEADLINE_MS,			HTTP_READ_ATTEMPT_TIMEOUT_MS,	HTTP_READ_RETRY_MAX },
+	/* a second filter of a retry expires unused on the node */
+	{ NEW_BLOCK_FILTER,			HTTP_READ_DEADLINE_MS,			HTTP_READ_ATTEMPT_TIMEOUT_MS,	HTTP_READ_RETRY_MAX },
+	/* the node forgets the changes it answered - a retry would lose them */
+	{ GET_FILTER_CHANGES,		HTTP_READ_DEADLINE_MS,			HTTP_READ_DEADLINE_MS,			0 },
+	{ GET_TRANSACTION_COUNT,	HTTP_READ_DEADLINE_MS,			HTTP_READ_ATTEMPT_TIMEOUT_MS,	HTTP_READ_RETRY_MAX },
+	{ BLOCK_NUMBER,				HTTP_READ_DEADLINE_MS,			HTTP_READ_ATTEMPT_TIMEOUT_MS,	HTTP_READ_RETRY_MAX },
+	/* a second subscription would push every notification twice */
+	{ SUBSCRIBE,				HTTP_READ_DEADLINE_MS,			HTTP_READ_DEADLINE_MS,			0 },
+	{ ESTIMATE_GAS,				HTTP_READ_DEADLINE_MS,			HTTP_READ_ATTEMPT_TIMEOUT_MS,	HTTP_READ_RETRY_MAX },
+	/* a second uninstall of the same filter answers false */
+	{ UNINSTALL_FILTER,			HTTP_READ_DEADLINE_MS,			HTTP_READ_ATTEMPT_TIMEOUT_MS,	HTTP_READ_RETRY_MAX },
+};
+
+/* policy of unknown functions - handled like a transaction */
+static const httpMethodPolicy_T HttpDefaultMethodPolicy = { UNDEFINED, HTTP_TRANSACTION_DEADLINE_MS, HTTP_TRANSACTION_DEADLINE_MS, 0 };
+
+/**
+ * This function searches the deadline and retry policy
+ * of an ethereum function
+ *
+ * @param[in] etherMethod
+ * This parameter holds the ethereum function
+ *
+ * @return
+ * reference of the table entry
+ */
+static httpMethodPolicy_T const *findMethodPolicy(etherFuncCalls etherMethod)
+{
+	for(uint8_t function = 0; function < (sizeof(HttpMethodPolicyTable) / sizeof(HttpMethodPolicyTable[0])); ++function) {
+		if(etherMethod == HttpMethodPolicyTable[function].ethMethod) {
+			return &HttpMethodPolicyTable[function];
+		}
+	}
+
+	return &HttpDefaultMethodPolicy;
+}
 
-#define READ_PUBLIC_KEY_JSON_RESULT_OFFSET				194
-#define READ_PUBLIC_KEY_JSON_RESPONSE_LENGTH 			742
+#ifdef ENABLE_NODE_POOL
+/* how the node of a request is selected - a request with several
+ * calls uses the strictest route of its calls */
+typedef enum httpNodeRoute_E {
+	HTTP_NODE_ROUTE_FASTEST = 0,	/* fastest healthy node, failover to the next one */
+	HTTP_NODE_ROUTE_PRIMARY_FIRST,	/* primary node while it is healthy, failover */
+	HTTP_NODE_ROUTE_PRIMARY_ONCE,	/* primary node while it is healthy, no failover */
+	HTTP_NODE_ROUTE_PRIMARY			/* always the primary node */
+} httpNodeRoute_T;
 
-#define READ_ETH_ACCOUNT_ADDR_JSON_RESULT_OFFSET 		90
-#define READ_ETH_ACCOUNT_ADDR_JSON_RESPONSE_LENGTH 		102
+/**
+ * This function returns how the node of a call is
+ * selected. Reads can be answered by every node of the
+ * chain, state which lives on one node is kept there.
+ *
+ * @param[in] ethMethod
+ * This variable holds the ethereum function of the call
+ *
+ * @return
+ * route of the call
+ */
+static httpNodeRoute_T getNodeRoute(etherFuncCalls ethMethod)
+{
+	contractFunction_T const *function_ptr = findContractFunction(ethMethod);
+
+	switch(ethMethod) {
+		case NEW_BLOCK_FILTER:
+		case GET_FILTER_CHANGES:
+		case UNINSTALL_FILTER:
+		case SUBSCRIBE:
+			/* filters and subscriptions only exist on the node which created them */
+			return HTTP_NODE_ROUTE_PRIMARY;
+		case GET_TRANSACTION_COUNT:
+		case ESTIMATE_GAS:
+			/* pending nonce and gas - the primary knows the transactions of the device first */
+			return HTTP_NODE_ROUTE_PRIMARY_FIRST;
+		default:
+		break;
+	}
 
-#define READ_PUB_KEY_JSON_RESULT_DATA_LENGTH 			READ_PUB_KEY_RESULT_LENGTH * 2
+	if( (NULL != function_ptr) && (true == function_ptr->transaction) ) {
+#ifdef ENABLE_LOCAL_SIGNING
+		/* every node accepts a signed transaction - it is not sent twice
+		 * since a second node would reject it as already known */
+		return HTTP_NODE_ROUTE_PRIMARY_ONCE;
+#else
+		/* the node signs with its unlocked account */
+		return HTTP_NODE_ROUTE_PRIMARY;
+#endif
+	}
 
-#define READ_DATA_HASH_JSON_RESULT_DATA_LENGTH 			READ_DATA_HASH_RESULT_LENGTH * 2
+	return HTTP_NODE_ROUTE_FASTEST;
+}
+#endif /* ENABLE_NODE_POOL */
+
+/* states of a request slot */
+typedef enum httpRequestState_E {
+	HTTP_REQUEST_FREE = 0,
+	HTTP_REQUEST_PREPARING,		/* slot allocated, calls are being added */
+	HTTP_REQUEST_PENDING,		/* request pushed, waiting for the response */
+	HTTP_REQUEST_RESPONDING,	/* response callback is storing the results */
+	HTTP_REQUEST_DONE,			/* completion signaled, results can be read */
+	HTTP_REQUEST_ORPHANED		/* released while responding - freed by the callback */
+} httpRequestState_T;
 
 /**
- * This handler struct holds all the information which
- * is required for data exchange via http
+ * This struct holds one entry of the request table.
+ * Every in-flight request has its own payload buffer,
+ * its own call results and its own completion semaphore.
  */
-typedef struct httpIpHandler_S{
-	uint8_t payload[JSON_STRING_BUFF_SIZE];
+typedef struct httpRequestSlot_S{
+	httpRequestState_T state;
+	HttpRequestID_T requestID;
+	uint8_t callCounter;
+	xTaskHandle ownerTask;
+	portTickType requestStartTick;
+	portTickType requestSentTick;
+	uint8_t node;				/* node of the node pool the request is sent to */
+	uint32_t deadlineMs;		/* policy of the calls - see HttpMethodPolicyTable */
+	uint32_t attemptTimeoutMs;
+	uint8_t retryMax;
+	uint8_t retryCounter;
+	bool cancelled;				/* HttpRequestCancel was called - no retry */
+#ifdef ENABLE_NODE_POOL
+	bool failover;				/* the request may be sent to another node */
+	uint32_t triedNodes;		/* NODE_POOL_NODE_BIT of the nodes which failed */
+#endif
+	SemaphoreHandle_t completionSemaphore;
+	Retcode_T responseStatus;
+	JSONWriter_T writer;
+	uint8_t payload[HTTP_REQUEST_PAYLOAD_SIZE];
 	size_t payload_len;
-} httpIpHandler_T;
-static httpIpHandler_T httpIpHandleVar_T = {0};
+	HttpCallResult_T results[HTTP_BATCH_REQUEST_MAX];
+#ifdef ENABLE_READ_CACHE
+	bool readCacheStore;		/* the result of the single call is cached */
+	bool readCacheBlockCall;	/* eth_blockNumber is call 1 of the request */
+	ReadCacheKey_T readCacheKey;
+	uint64_t readCacheBlock;	/* latest block when the call was sent */
+#endif
+#ifdef ENABLE_GAS_ESTIMATION
+	GasEstimatorKey_T gasKey[HTTP_BATCH_REQUEST_MAX];	/* estimate of the transaction or of eth_estimateGas */
+	uint32_t gasLimit[HTTP_BATCH_REQUEST_MAX];		/* 0 for calls which are no transaction */
+#endif
+} httpRequestSlot_T;
+static httpRequestSlot_T httpRequestTable[HTTP_REQUEST_SLOT_MAX];
+
+/* JSON RPC id of the next call - 0 is never used */
+static HttpRequestID_T httpNextRequestID = 1;
+
+/**
+ * This handler struct holds the transport which carries
+ * the json rpc requests to the node and the callback of
+ * the subscription notifications the node pushes
+ */
+typedef struct httpClientHandler_S{
+	Transport_T const *transport_ptr;
+	HttpSubscriptionCallback_T subscriptionCallback;
+} httpClientHandler_T;
+static httpClientHandler_T httpClientHandleVar = {0};
+
+/* connect time and time to first byte counters */
+static HttpRequestStats_T httpRequestStatsVar = {0};
+
+/* upper bounds of the latency histogram buckets in milliseconds */
+static const uint32_t HttpLatencyBucketLimits[HTTP_LATENCY_BUCKET_COUNT - 1] = { 10, 20, 50, 100, 200, 500, 1000, 2000 };
+
+/* response latency histograms indexed by the ethereum function */
+static HttpLatencyHistogram_T httpLatencyHistogramVar[ETHER_FUNC_CALLS_MAX + 1] = {0};
 
 /* external buffer to hold blockchain information */
 uint8_t SEEDConsumerDataHashBuffer[READ_DATA_HASH_RESULT_LENGTH] = { 0 };
 
 /* local buffers to hold blockchain information */
-static uint8_t SEEDCroducerPublicKeyBuffer[READ_PUB_KEY_RESULT_LENGTH] = { 0 };
-static uint8_t SEEDEtherAccountAddressBuffer[READ_ETH_ACCOUNT_ADDRESS_RESULT_DATA_LENGTH] = { 0 };
 static uint8_t SEEDTransactionHashBuffer[TRANSACTION_HASH_RESULT_LENGTH] = { 0 };
-
-/* flag to indicate that http callback is received */
-static bool HttpResponseCallbackReceivedFlag = false;
-
-/* flag to check if transaction is already confirmed */
-static bool TransactionConfirmed = false;
+static uint8_t SEEDConsumerPublicKeyBuffer[READ_PUB_KEY_RESULT_LENGTH] = { 0 };
 
 /**
- * This function decodes the payload data from
- * the blockchain. It converts numbers in ascii
- * format into int numbers and combines the two
- * 4 bit values in one byte stored in oBuff
- *
- * @param[in] stringToConvert_ptr
- * This reference holds the data string which
- * should be converted
+ * This function copies the current connect time and
+ * time to first byte counters of the http client
  *
- * @param[in] iStringSize
- * Size of the string which should be converted
- *
- * @param[out] oBuff
- * Output buffer which holds the converted and
- * combined input data
+ * @param[out] oStats_ptr
+ * This reference will hold the counter values
  *
  * @return
  * void
  */
-void convertCharToHex(uint8_t *stringToConvert_ptr, size_t iStringSize, uint8_t *oBuff)
+void HttpGetRequestStats(HttpRequestStats_T *oStats_ptr)
 {
-	uint8_t tempBuff[READ_PUB_KEY_JSON_RESULT_DATA_LENGTH] = {0};
+	TransportStats_T transportStats = {0};
 
-	/* check for null pointer */
-	if(NULL != stringToConvert_ptr) {
-		/* convert numbers from ascii format to int value (atoi
-		 * does not support hex numbers larger then 9) */
-		for(size_t i = 0; i < iStringSize; ++i) {
-			if( ('a' <= stringToConvert_ptr[i]) && ('f' >= stringToConvert_ptr[i]) ) {
-				tempBuff[i] = stringToConvert_ptr[i] - 87;
-			} else if( ('A' <= stringToConvert_ptr[i]) && ('F' >= stringToConvert_ptr[i]) ) {
-				tempBuff[i] = stringToConvert_ptr[i] - 55;
-			} else {
-				tempBuff[i] = stringToConvert_ptr[i] - '0';
-			}
+	if(NULL != oStats_ptr) {
+		*oStats_ptr = httpRequestStatsVar;
+		/* connections are opened by the transport */
+		if(NULL != httpClientHandleVar.transport_ptr) {
+			httpClientHandleVar.transport_ptr->getStats(&transportStats);
+		}
+		oStats_ptr->connectionCounter = transportStats.connectionCounter;
+	}
+}
+
+/* callbacks of the transports - defined below */
+static TransportCallbacks_T const HttpTransportCallbacks;
+
+/**
+ * This function initializes the default transport and
+ * creates the completion semaphores of the request table.
+ * Must be called once after the network is up.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T HttpInit(void)
+{
+	/* the transports send the requests to the nodes of the pool */
+	if(RETCODE_SUCCESS != NodePoolInit()) {
+		return RETCODE_FAILURE;
+	}
+
+	for(uint8_t slot = 0; slot < HTTP_REQUEST_SLOT_MAX; ++slot) {
+		if(NULL == httpRequestTable[slot].completionSemaphore) {
+			httpRequestTable[slot].completionSemaphore = xSemaphoreCreateBinary();
 		}
-		/* combine two 4 bit values into one 8 bit value to
-		 * get the original data */
-		for(size_t i = 0, u = 0; u < iStringSize; ++i, u += 2) {
-			oBuff[i] = (tempBuff[u] << 4) | tempBuff[u+1];
+		if(NULL == httpRequestTable[slot].completionSemaphore) {
+			return RETCODE_FAILURE;
 		}
 	}
+
+#if defined(ENABLE_WEBSOCKET_TRANSPORT)
+	return HttpSetTransport(WebSocketTransportGet());
+#elif defined(ENABLE_HTTP_PIPELINING)
+	return HttpSetTransport(PipelineTransportGet());
+#else
+	return HttpSetTransport(HttpTransportGet());
+#endif
 }
 
 /**
- * This function waits for a specified time until
- * a http response is received
+ * This function selects the transport of the json rpc
+ * requests, e.g. to compare the transports. Must be
+ * called while no request is in flight.
+ *
+ * @param[in] transport_ptr
+ * This reference holds the transport
  *
  * @return
  * RETCODE_SUCCESS, if successful<br>
  * RETCODE_FAILURE, otherwise.
  */
-Retcode_T WaitForHttpReceiveCallback()
+Retcode_T HttpSetTransport(Transport_T const *transport_ptr)
 {
 	Retcode_T ret = RETCODE_FAILURE;
-	uint8_t counter = 0;
 
-	/* wait until flag is set */
-	while(true != HttpResponseCallbackReceivedFlag) {
+	if(NULL == transport_ptr) {
+		return ret;
+	}
+
+	ret = transport_ptr->init(&HttpTransportCallbacks);
+	if( (RETCODE_SUCCESS == ret) && (transport_ptr != httpClientHandleVar.transport_ptr) ) {
+		if(NULL != httpClientHandleVar.transport_ptr) {
+			for(uint8_t node = 0; node < NodePoolGetCount(); ++node) {
+				httpClientHandleVar.transport_ptr->disconnect(node);
+			}
+		}
+		httpClientHandleVar.transport_ptr = transport_ptr;
 #ifdef ENABLE_DEBUG
-		vTaskDelay(SECONDS(1));
-		printf("waiting for http response\n\r");
-#else
-		vTaskDelay(SECONDS(1));
+		printf("JSON RPC transport: %s\n\r", transport_ptr->name_ptr);
 #endif
-		counter++;
-		/* break out of loop until maximum waiting time is reached */
-		if(HTTPRESPONSE_SECONDSTOWAIT == counter) {
-			return ret;
-		}
 	}
 
-	/* reset variable and return */
-	HttpResponseCallbackReceivedFlag = false;
-	ret = RETCODE_SUCCESS;
-
 	return ret;
 }
 
 /**
- * This function polls the blockchain until
- * the transaction is confirmed or until
- * the specified time runs out
+ * This function returns the transport of the json
+ * rpc requests
  *
  * @return
- * true, if successful<br>
- * false, otherwise.
+ * reference of the transport, NULL before HttpInit
  */
-bool WaitForTransactionConfirmation()
+Transport_T const *HttpGetTransport(void)
 {
-	bool retTransConfirmed = false;
-	Retcode_T retHttpRequest = RETCODE_FAILURE;
-	uint8_t counter = 0;
+	return httpClientHandleVar.transport_ptr;
+}
 
-	/* while transaction is unconfirmed */
-	while(false == TransactionConfirmed)
-	{
-		counter++;
-		/* call getTransactionReceipt function to check wether transaction is confirmed */
-		retHttpRequest = sendHttpDLTClientRequest(GET_TRANSACTION_RECEIPT, "na", "na", SEEDTransactionHashBuffer, sizeof(SEEDTransactionHashBuffer));
+/**
+ * This function sets the callback of the subscription
+ * notifications (eth_subscription) which the node pushes
+ * after a SUBSCRIBE call. Only transports with a
+ * persistent connection deliver notifications.
+ *
+ * @param[in] callback
+ * This function is called from the transport task for
+ * every notification. NULL drops the notifications.
+ *
+ * @return
+ * void
+ */
+void HttpSetSubscriptionCallback(HttpSubscriptionCallback_T callback)
+{
+	httpClientHandleVar.subscriptionCallback = callback;
+}
 
-		/* if anything goes wrong then return false */
-		if(RETCODE_SUCCESS == retHttpRequest) {
-			retHttpRequest = WaitForHttpReceiveCallback();
-			if(RETCODE_SUCCESS != retHttpRequest) {
-				return retTransConfirmed;
+/**
+ * This function allocates a free slot of the request table
+ * and reserves the JSON RPC ids for its calls. If all slots
+ * are used, a finished request of sendHttpDLTClientRequest
+ * is reused.
+ *
+ * @param[in] callCounter
+ * Number of JSON RPC ids to reserve for the request
+ *
+ * @return
+ * reference of the slot, NULL if all slots are in use
+ */
+static httpRequestSlot_T *allocRequestSlot(uint8_t callCounter)
+{
+	httpRequestSlot_T *slot_ptr = NULL;
+
+	taskENTER_CRITICAL();
+	for(uint8_t slot = 0; slot < HTTP_REQUEST_SLOT_MAX; ++slot) {
+		if(HTTP_REQUEST_FREE == httpRequestTable[slot].state) {
+			slot_ptr = &httpRequestTable[slot];
+			break;
+		}
+	}
+	if(NULL == slot_ptr) {
+		for(uint8_t slot = 0; slot < HTTP_REQUEST_SLOT_MAX; ++slot) {
+			if( (HTTP_REQUEST_DONE == httpRequestTable[slot].state) && (NULL != httpRequestTable[slot].ownerTask) ) {
+				slot_ptr = &httpRequestTable[slot];
+				break;
 			}
 		}
+	}
+	if(NULL != slot_ptr) {
+		slot_ptr->state = HTTP_REQUEST_PREPARING;
+		/* skip id 0 on wrap around */
+		if( (httpNextRequestID + callCounter) < httpNextRequestID ) {
+			httpNextRequestID = 1;
+		}
+		slot_ptr->requestID = httpNextRequestID;
+		httpNextRequestID += callCounter;
+	}
+	taskEXIT_CRITICAL();
+
+	if(NULL != slot_ptr) {
+		slot_ptr->callCounter = 0;
+		slot_ptr->ownerTask = NULL;
+		slot_ptr->node = NODE_POOL_NODE_NONE;
+		slot_ptr->retryCounter = 0;
+		slot_ptr->cancelled = false;
+		slot_ptr->responseStatus = RETCODE_FAILURE;
+		slot_ptr->payload_len = 0;
+		memset(slot_ptr->results, 0, sizeof(slot_ptr->results));
+#ifdef ENABLE_READ_CACHE
+		slot_ptr->readCacheStore = false;
+		slot_ptr->readCacheBlockCall = false;
+#endif
+#ifdef ENABLE_GAS_ESTIMATION
+		memset(slot_ptr->gasLimit, 0, sizeof(slot_ptr->gasLimit));
+#endif
+		/* drop a completion which was signaled after the last owner timed out */
+		(void) xSemaphoreTake(slot_ptr->completionSemaphore, 0);
+	}
 
-		/* wait until transaction is confirmed */
-		if( (RETCODE_SUCCESS == retHttpRequest) && (true == TransactionConfirmed)) {
-			TransactionConfirmed = false;
-			retTransConfirmed = true;
+	return slot_ptr;
+}
 
-			return retTransConfirmed;
-		} else {
-			/* wait for a specific time before the next request */
-			vTaskDelay(SECONDS(CONFIRMATION_TIME_TO_WAIT));
+/**
+ * This function returns the slot of a request
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @return
+ * reference of the slot, NULL if the request is unknown
+ */
+static httpRequestSlot_T *findRequestSlot(HttpRequestID_T requestID)
+{
+	for(uint8_t slot = 0; slot < HTTP_REQUEST_SLOT_MAX; ++slot) {
+		if( (HTTP_REQUEST_FREE != httpRequestTable[slot].state) && (requestID == httpRequestTable[slot].requestID) ) {
+			return &httpRequestTable[slot];
 		}
+	}
 
-		/* if maximum defined counter of request is reached return */
-		if(CONFIRMATION_TRANSACTION_COUNTER == counter) {
-			return retTransConfirmed;
+	return NULL;
+}
+
+/**
+ * This function returns the in-flight request a JSON RPC
+ * response belongs to and marks it as responding so it is
+ * not freed while its results are stored.
+ *
+ * @param[in] messageID
+ * This variable holds the id of the JSON RPC response
+ *
+ * @param[out] oCallIndex_ptr
+ * This reference will hold the index of the call in the request
+ *
+ * @return
+ * reference of the slot, NULL if no request waits for the id
+ */
+static httpRequestSlot_T *findRequestSlotForCall(uint32_t messageID, uint8_t *oCallIndex_ptr)
+{
+	httpRequestSlot_T *slot_ptr = NULL;
+
+	taskENTER_CRITICAL();
+	for(uint8_t slot = 0; slot < HTTP_REQUEST_SLOT_MAX; ++slot) {
+		httpRequestSlot_T *candidate_ptr = &httpRequestTable[slot];
+		if( ((HTTP_REQUEST_PENDING == candidate_ptr->state) || (HTTP_REQUEST_RESPONDING == candidate_ptr->state) || (HTTP_REQUEST_ORPHANED == candidate_ptr->state))
+				&& (messageID >= candidate_ptr->requestID) && ((messageID - candidate_ptr->requestID) < candidate_ptr->callCounter) ) {
+			if(HTTP_REQUEST_PENDING == candidate_ptr->state) {
+				candidate_ptr->state = HTTP_REQUEST_RESPONDING;
+			}
+			*oCallIndex_ptr = (uint8_t) (messageID - candidate_ptr->requestID);
+			slot_ptr = candidate_ptr;
+			break;
 		}
 	}
+	taskEXIT_CRITICAL();
 
-	return retTransConfirmed;
+	return slot_ptr;
 }
 
 /**
- * This function is called to create a JSON string
- * to make a JSON RPC call to the ethereum blockchain
+ * This function finishes an in-flight request and wakes up
+ * the task which waits for it. A request which was released
+ * in the meantime is freed.
  *
- * @param[in] etherMethod
- * This parameter holds the method which shall be called.
- * You can choose between four function calls which are
- * supported by the smart contract and passed as an enum
- * value.
- *	1. WRITE_DATA_HASH
- *	2. READ_DATA_HASH
- *	3. WRITE_PUBLIC_KEY
- *	4. READ_PUBLIC_KEY
- *	5. READ_PUBLIC_KEY_SENDER_ADDRESS
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request
  *
- * @param[in] senderAddress_ptr
- * This string holds the ethereum sender address
+ * @param[in] status
+ * RETCODE_SUCCESS if a response was received, RETCODE_FAILURE
+ * if the request could not be sent
  *
- * @param[in] receiverAddress_ptr
- * This string holds the ethereum receiver/contract address
+ * @return
+ * void
+ */
+static void completeRequestSlot(httpRequestSlot_T *slot_ptr, Retcode_T status)
+{
+	bool signal = false;
+
+	taskENTER_CRITICAL();
+	if(HTTP_REQUEST_ORPHANED == slot_ptr->state) {
+		slot_ptr->state = HTTP_REQUEST_FREE;
+	} else if( (HTTP_REQUEST_PENDING == slot_ptr->state) || (HTTP_REQUEST_RESPONDING == slot_ptr->state) ) {
+		slot_ptr->responseStatus = status;
+		slot_ptr->state = HTTP_REQUEST_DONE;
+		signal = true;
+	}
+	taskEXIT_CRITICAL();
+
+	if(true == signal) {
+		xSemaphoreGive(slot_ptr->completionSemaphore);
+	}
+}
+
+/**
+ * This function releases a request slot. The results of
+ * the request can not be read afterwards. A response which
+ * arrives later is dropped. A request which is still in
+ * flight is cancelled in the transport so its connection
+ * is not blocked by it anymore.
  *
- * @param[in] payload_ptr
- * This reference holds the payload of which will be send
- * to the smart contract e.g. data hash or public key.
- * This parameter is only required for function WRITE_DATA_HASH
- * and WRITE_PUBLIC_KEY. Can be NULL for READ functions
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @return
+ * void
+ */
+void HttpRequestRelease(HttpRequestID_T requestID)
+{
+	uint8_t pendingNode = NODE_POOL_NODE_NONE;
+
+	taskENTER_CRITICAL();
+	httpRequestSlot_T *slot_ptr = findRequestSlot(requestID);
+	if(NULL != slot_ptr) {
+		if(HTTP_REQUEST_PENDING == slot_ptr->state) {
+			pendingNode = slot_ptr->node;
+		}
+#ifdef ENABLE_LOCAL_SIGNING
+		/* a signed transaction without response may not have reached
+		 * the node - read the nonce again before the next one is signed */
+		for(uint8_t call = 0; call < slot_ptr->callCounter; ++call) {
+			contractFunction_T const *function_ptr = findContractFunction(slot_ptr->results[call].ethMethod);
+			if( (false == slot_ptr->results[call].responseReceived) && (NULL != function_ptr) && (true == function_ptr->transaction) ) {
+				TransactionSignerInvalidateNonce();
+			}
+		}
+#endif
+		if(HTTP_REQUEST_RESPONDING == slot_ptr->state) {
+			/* the response callback frees the slot when it is finished */
+			slot_ptr->state = HTTP_REQUEST_ORPHANED;
+		} else if(HTTP_REQUEST_ORPHANED != slot_ptr->state) {
+			slot_ptr->state = HTTP_REQUEST_FREE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	/* the payload buffer of the slot must not be read by the transport anymore */
+	if(NODE_POOL_NODE_NONE != pendingNode) {
+		httpClientHandleVar.transport_ptr->cancel(pendingNode, requestID);
+	}
+}
+
+/**
+ * This function cancels a request which is in flight, e.g.
+ * if its result is not needed anymore. The transport
+ * forgets the request and drops the connection it stalls
+ * on, the waiting task returns RETCODE_FAILURE from
+ * HttpRequestWait without retrying it. The slot is freed
+ * by HttpRequestRelease as usual.
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, if the request is not in flight.
+ */
+Retcode_T HttpRequestCancel(HttpRequestID_T requestID)
+{
+	bool pending = false;
+	uint8_t node = NODE_POOL_NODE_NONE;
+
+	taskENTER_CRITICAL();
+	httpRequestSlot_T *slot_ptr = findRequestSlot(requestID);
+	if( (NULL != slot_ptr) && (HTTP_REQUEST_PENDING == slot_ptr->state) ) {
+		slot_ptr->cancelled = true;
+		node = slot_ptr->node;
+		pending = true;
+	}
+	taskEXIT_CRITICAL();
+
+	if(false == pending) {
+		return RETCODE_FAILURE;
+	}
+
+	httpClientHandleVar.transport_ptr->cancel(node, requestID);
+	completeRequestSlot(slot_ptr, RETCODE_FAILURE);
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function returns the request of the calling task
+ * which was sent with sendHttpDLTClientRequest
+ *
+ * @return
+ * reference of the slot, NULL if the task has no request
+ */
+static httpRequestSlot_T *findTaskRequestSlot(void)
+{
+	xTaskHandle currentTask = xTaskGetCurrentTaskHandle();
+
+	for(uint8_t slot = 0; slot < HTTP_REQUEST_SLOT_MAX; ++slot) {
+		if( (HTTP_REQUEST_FREE != httpRequestTable[slot].state) && (HTTP_REQUEST_ORPHANED != httpRequestTable[slot].state)
+				&& (currentTask == httpRequestTable[slot].ownerTask) ) {
+			return &httpRequestTable[slot];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * This function adds the latency of one response to the
+ * histogram of its ethereum function
+ *
+ * @param[in] ethMethod
+ * This variable holds the ethereum function of the response
+ *
+ * @param[in] latency
+ * Time from pushing the request until the response was received in ms
+ *
+ * @return
+ * void
+ */
+static void recordHttpLatency(etherFuncCalls ethMethod, uint32_t latency)
+{
+	HttpLatencyHistogram_T *histogram_ptr = NULL;
+	uint8_t bucket = 0;
+
+	if( (WRITE_DATA_HASH > ethMethod) || (ETHER_FUNC_CALLS_MAX < ethMethod) ) {
+		return;
+	}
+	histogram_ptr = &httpLatencyHistogramVar[ethMethod];
+
+	/* search first bucket whose upper bound is above the latency */
+	while( (bucket < (HTTP_LATENCY_BUCKET_COUNT - 1)) && (latency >= HttpLatencyBucketLimits[bucket]) ) {
+		bucket++;
+	}
+	histogram_ptr->bucket[bucket]++;
+	histogram_ptr->responseCounter++;
+	histogram_ptr->totalLatency += latency;
+	if(latency > histogram_ptr->maxLatency) {
+		histogram_ptr->maxLatency = latency;
+	}
+}
+
+/**
+ * This function copies the response latency histogram
+ * of an ethereum function
+ *
+ * @param[in] ethMethod
+ * This variable holds the ethereum function
+ *
+ * @param[out] oHistogram_ptr
+ * This reference will hold the histogram
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T HttpGetLatencyHistogram(etherFuncCalls ethMethod, HttpLatencyHistogram_T *oHistogram_ptr)
+{
+	if( (NULL == oHistogram_ptr) || (WRITE_DATA_HASH > ethMethod) || (ETHER_FUNC_CALLS_MAX < ethMethod) ) {
+		return RETCODE_FAILURE;
+	}
+	*oHistogram_ptr = httpLatencyHistogramVar[ethMethod];
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function sets the deadline and the retries of a
+ * request by the policies of its calls. A request with
+ * several calls gets the longest deadline and is only
+ * retried if all of its calls can be retried.
+ *
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request
+ *
+ * @return
+ * void
+ */
+static void selectRequestPolicy(httpRequestSlot_T *slot_ptr)
+{
+	httpMethodPolicy_T const *policy_ptr = findMethodPolicy(slot_ptr->results[0].ethMethod);
+
+	slot_ptr->deadlineMs = policy_ptr->deadlineMs;
+	slot_ptr->attemptTimeoutMs = policy_ptr->attemptTimeoutMs;
+	slot_ptr->retryMax = policy_ptr->retryMax;
+	for(uint8_t call = 1; call < slot_ptr->callCounter; ++call) {
+		policy_ptr = findMethodPolicy(slot_ptr->results[call].ethMethod);
+		if(policy_ptr->deadlineMs > slot_ptr->deadlineMs) {
+			slot_ptr->deadlineMs = policy_ptr->deadlineMs;
+		}
+		if(policy_ptr->attemptTimeoutMs < slot_ptr->attemptTimeoutMs) {
+			slot_ptr->attemptTimeoutMs = policy_ptr->attemptTimeoutMs;
+		}
+		if(policy_ptr->retryMax < slot_ptr->retryMax) {
+			slot_ptr->retryMax = policy_ptr->retryMax;
+		}
+	}
+	slot_ptr->retryCounter = 0;
+}
+
+/**
+ * This function selects the node of the node pool a
+ * request is sent to by the route of its calls. Without
+ * node pool or with a transport which only talks to one
+ * node it is the primary node.
+ *
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request
+ *
+ * @return
+ * void
+ */
+static void selectRequestNode(httpRequestSlot_T *slot_ptr)
+{
+#ifdef ENABLE_NODE_POOL
+	httpNodeRoute_T route = HTTP_NODE_ROUTE_FASTEST;
+
+	for(uint8_t call = 0; call < slot_ptr->callCounter; ++call) {
+		httpNodeRoute_T callRoute = getNodeRoute(slot_ptr->results[call].ethMethod);
+		if(callRoute > route) {
+			route = callRoute;
+		}
+	}
+	if(false == httpClientHandleVar.transport_ptr->nodePool) {
+		route = HTTP_NODE_ROUTE_PRIMARY;
+	}
+
+	slot_ptr->triedNodes = 0;
+	slot_ptr->failover = (HTTP_NODE_ROUTE_PRIMARY_FIRST >= route);
+	if(HTTP_NODE_ROUTE_PRIMARY == route) {
+		slot_ptr->node = NODE_POOL_PRIMARY;
+	} else {
+		slot_ptr->node = NodePoolSelect(HTTP_NODE_ROUTE_FASTEST != route, 0);
+	}
+#else
+	slot_ptr->node = NODE_POOL_PRIMARY;
+#endif
+}
+
+/**
+ * This function hands the payload of a request slot to
+ * the transport which sends it to the node of the slot
+ *
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T sendRequestSlot(httpRequestSlot_T *slot_ptr)
+{
+	slot_ptr->requestStartTick = xTaskGetTickCount();
+	slot_ptr->requestSentTick = slot_ptr->requestStartTick;
+	NodePoolReportRequest(slot_ptr->node);
+
+	return httpClientHandleVar.transport_ptr->send(slot_ptr->node, slot_ptr->requestID, slot_ptr->payload, slot_ptr->payload_len);
+}
+
+/**
+ * This function prepares a request whose attempt failed
+ * or did not answer in time to be sent again. A request
+ * which was answered or cancelled in the meantime is not
+ * sent again.
+ *
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request
+ *
+ * @param[in] node
+ * This variable holds the node the request is sent to next
+ *
+ * @return
+ * true, if the request can be sent again<br>
+ * false, otherwise.
+ */
+static bool rearmRequestSlot(httpRequestSlot_T *slot_ptr, uint8_t node)
+{
+	bool rearmed = false;
+
+	/* drop the completion of the failed attempt */
+	(void) xSemaphoreTake(slot_ptr->completionSemaphore, 0);
+
+	taskENTER_CRITICAL();
+	rearmed = (false == slot_ptr->cancelled) && ((HTTP_REQUEST_PENDING == slot_ptr->state)
+			|| ((HTTP_REQUEST_DONE == slot_ptr->state) && (RETCODE_SUCCESS != slot_ptr->responseStatus)));
+	if(true == rearmed) {
+		slot_ptr->state = HTTP_REQUEST_PENDING;
+		slot_ptr->node = node;
+	}
+	taskEXIT_CRITICAL();
+
+	return rearmed;
+}
+
+#ifdef ENABLE_NODE_POOL
+/**
+ * This function sends a request again to the next node
+ * of the node pool after its node failed or did not
+ * answer in time. Nodes which can not be reached are
+ * skipped. A failure of a node the request already left
+ * is not reported to the request anymore.
+ *
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request
+ *
+ * @param[in] timedOut
+ * true if the node did not answer in time - the request is
+ * cancelled on it if another node can take over
+ *
+ * @return
+ * RETCODE_SUCCESS, if the request was sent to another node<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T failoverRequest(httpRequestSlot_T *slot_ptr, bool timedOut)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	uint8_t failedNode = slot_ptr->node;
+	uint8_t node = NODE_POOL_NODE_NONE;
+
+	while( (RETCODE_SUCCESS != ret) && (true == slot_ptr->failover) ) {
+		slot_ptr->triedNodes |= NODE_POOL_NODE_BIT(failedNode);
+		node = NodePoolSelect(false, slot_ptr->triedNodes);
+		if(NODE_POOL_NODE_NONE == node) {
+			/* every node failed - the last one may still answer */
+			slot_ptr->failover = false;
+			break;
+		}
+		if(true == timedOut) {
+			/* the request stalls on the node - free its connection */
+			NodePoolReportFailure(failedNode);
+			httpClientHandleVar.transport_ptr->cancel(failedNode, slot_ptr->requestID);
+			timedOut = false;
+		}
+
+		/* the failed node may have answered in the meantime */
+		if(false == rearmRequestSlot(slot_ptr, node)) {
+			break;
+		}
+
+		NodePoolReportFailover(failedNode);
+#ifdef ENABLE_DEBUG
+		printf("Request %lu fails over from node %u to node %u\n\r", (unsigned long) slot_ptr->requestID, (unsigned int) failedNode, (unsigned int) node);
+#endif
+		ret = sendRequestSlot(slot_ptr);
+		if(RETCODE_SUCCESS != ret) {
+			NodePoolReportFailure(node);
+			failedNode = node;
+		}
+	}
+
+	return ret;
+}
+#endif /* ENABLE_NODE_POOL */
+
+/**
+ * This function sends a request again after its attempt
+ * failed or did not answer within the attempt timeout.
+ * With ENABLE_NODE_POOL the next node is tried first
+ * without delay. Otherwise the request is sent again after
+ * a backoff which doubles with every retry, if its policy
+ * allows a retry and the deadline is not reached before.
+ *
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request
+ *
+ * @param[in] timedOut
+ * true if the attempt did not answer in time - it is
+ * cancelled in the transport
+ *
+ * @param[in] remainingMs
+ * Time until the deadline of the request in ms
+ *
+ * @return
+ * RETCODE_SUCCESS, if the request was sent again or answered meanwhile<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T retryRequest(httpRequestSlot_T *slot_ptr, bool timedOut, uint32_t remainingMs)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	uint8_t node = slot_ptr->node;
+	uint32_t backoffMs = 0;
+
+#ifdef ENABLE_NODE_POOL
+	if(RETCODE_SUCCESS == failoverRequest(slot_ptr, timedOut)) {
+		return RETCODE_SUCCESS;
+	}
+#endif
+	if( (slot_ptr->retryCounter >= slot_ptr->retryMax) || (true == slot_ptr->cancelled) ) {
+		return ret;
+	}
+	backoffMs = HTTP_RETRY_BACKOFF_MS << slot_ptr->retryCounter;
+	if(backoffMs >= remainingMs) {
+		return ret;
+	}
+
+	/* the failover may have given up on another node already */
+	if( (true == timedOut) && (node == slot_ptr->node) ) {
+		/* the request stalls - free its connection */
+		NodePoolReportFailure(node);
+		httpClientHandleVar.transport_ptr->cancel(node, slot_ptr->requestID);
+	}
+	vTaskDelay((portTickType) (backoffMs / portTICK_RATE_MS));
+
+	slot_ptr->retryCounter++;
+	for(uint8_t call = 0; call < slot_ptr->callCounter; ++call) {
+		if( (WRITE_DATA_HASH <= slot_ptr->results[call].ethMethod) && (ETHER_FUNC_CALLS_MAX >= slot_ptr->results[call].ethMethod) ) {
+			httpLatencyHistogramVar[slot_ptr->results[call].ethMethod].retryCounter++;
+		}
+	}
+
+	if(false == rearmRequestSlot(slot_ptr, slot_ptr->node)) {
+		/* a late response completed the request during the backoff */
+		return ((HTTP_REQUEST_DONE == slot_ptr->state) && (RETCODE_SUCCESS == slot_ptr->responseStatus)) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+	}
+#ifdef ENABLE_DEBUG
+	printf("Request %lu retry %u after %lu ms\n\r", (unsigned long) slot_ptr->requestID, (unsigned int) slot_ptr->retryCounter, (unsigned long) backoffMs);
+#endif
+	/* every retry starts with the best node again */
+	selectRequestNode(slot_ptr);
+	ret = sendRequestSlot(slot_ptr);
+	if(RETCODE_SUCCESS != ret) {
+		/* the next wait picks up the failure and retries again */
+		NodePoolReportFailure(slot_ptr->node);
+		completeRequestSlot(slot_ptr, RETCODE_FAILURE);
+		ret = RETCODE_SUCCESS;
+	}
+
+	return ret;
+}
+
+/**
+ * This function blocks until the response of a request is
+ * received and parsed or until the deadline expires. The
+ * calling task is woken up by the response callback. A
+ * lost response is retried by the policy of the called
+ * ethereum functions, see HttpMethodPolicyTable. With
+ * ENABLE_NODE_POOL a request whose node fails or does not
+ * answer within NODE_POOL_FAILOVER_TIME_MS is sent to the
+ * next node first.
+ *
+ * @param[in] requestID
+ * This variable holds the id returned by HttpRequestSend
+ *
+ * @param[in] timeoutMs
+ * Deadline of the request in milliseconds,
+ * HTTP_REQUEST_DEADLINE_DEFAULT for the deadline of its policy
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T HttpRequestWait(HttpRequestID_T requestID, uint32_t timeoutMs)
+{
+	httpRequestSlot_T *slot_ptr = findRequestSlot(requestID);
+	portTickType startTick = xTaskGetTickCount();
+	uint32_t elapsedMs = 0;
+	uint32_t waitMs = 0;
+	bool signaled = false;
+
+	if( (NULL == slot_ptr) || (HTTP_REQUEST_PREPARING == slot_ptr->state) ) {
+		return RETCODE_FAILURE;
+	}
+	if(HTTP_REQUEST_DEADLINE_DEFAULT == timeoutMs) {
+		timeoutMs = slot_ptr->deadlineMs;
+	}
+
+	for(;;) {
+		elapsedMs = TICKS_TO_MS(xTaskGetTickCount() - startTick);
+		if(elapsedMs >= timeoutMs) {
+			break;
+		}
+		waitMs = timeoutMs - elapsedMs;
+		/* an attempt which does not answer in time is retried */
+		if( (slot_ptr->retryCounter < slot_ptr->retryMax) && (slot_ptr->attemptTimeoutMs < waitMs) ) {
+			waitMs = slot_ptr->attemptTimeoutMs;
+		}
+#ifdef ENABLE_NODE_POOL
+		/* a node which does not answer in time is replaced by the next one */
+		if( (true == slot_ptr->failover) && (NODE_POOL_FAILOVER_TIME_MS < waitMs) ) {
+			waitMs = NODE_POOL_FAILOVER_TIME_MS;
+		}
+#endif
+		/* the completion may also have been taken by an earlier wait or
+		 * belong to an attempt the request already left - the state decides */
+		signaled = (pdTRUE == xSemaphoreTake(slot_ptr->completionSemaphore, (portTickType) (waitMs / portTICK_RATE_MS)));
+		elapsedMs = TICKS_TO_MS(xTaskGetTickCount() - startTick);
+
+		if(HTTP_REQUEST_DONE == slot_ptr->state) {
+			/* the node could not be reached - try again */
+			if( (RETCODE_SUCCESS != slot_ptr->responseStatus) && (elapsedMs < timeoutMs) && (RETCODE_SUCCESS == retryRequest(slot_ptr, false, timeoutMs - elapsedMs)) ) {
+				continue;
+			}
+			return slot_ptr->responseStatus;
+		}
+		if( (false == signaled) && (elapsedMs < timeoutMs) && (HTTP_REQUEST_PENDING == slot_ptr->state) ) {
+			(void) retryRequest(slot_ptr, true, timeoutMs - elapsedMs);
+		}
+	}
+
+	/* the response may have arrived with the deadline */
+	if(HTTP_REQUEST_DONE == slot_ptr->state) {
+		return slot_ptr->responseStatus;
+	}
+
+#ifdef ENABLE_DEBUG
+	printf("http response timeout\n\r");
+#endif
+	/* the request stalls - free its connection, the next request
+	 * to the node connects again */
+	NodePoolReportFailure(slot_ptr->node);
+	if(HTTP_REQUEST_PENDING == slot_ptr->state) {
+		httpClientHandleVar.transport_ptr->cancel(slot_ptr->node, slot_ptr->requestID);
+	}
+	for(uint8_t call = 0; call < slot_ptr->callCounter; ++call) {
+		if( (WRITE_DATA_HASH <= slot_ptr->results[call].ethMethod) && (ETHER_FUNC_CALLS_MAX >= slot_ptr->results[call].ethMethod) ) {
+			httpLatencyHistogramVar[slot_ptr->results[call].ethMethod].timeoutCounter++;
+		}
+	}
+
+	return RETCODE_FAILURE;
+}
+
+/**
+ * This function is called to read the result of
+ * one call of a finished request
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @param[in] callIndex
+ * This variable holds the index of the call - 0 for single
+ * requests, the slot returned by HttpBatchAdd for batches
+ *
+ * @param[out] oResult_ptr
+ * This reference will hold the result of the call
+ *
+ * @return
+ * RETCODE_SUCCESS, if a response for the call was received<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T HttpRequestGetResult(HttpRequestID_T requestID, uint8_t callIndex, HttpCallResult_T *oResult_ptr)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	httpRequestSlot_T *slot_ptr = findRequestSlot(requestID);
+
+	if( (NULL != slot_ptr) && (NULL != oResult_ptr) && (HTTP_REQUEST_DONE == slot_ptr->state) && (slot_ptr->callCounter > callIndex) ) {
+		*oResult_ptr = slot_ptr->results[callIndex];
+		if(true == oResult_ptr->responseReceived) {
+			ret = RETCODE_SUCCESS;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * This function waits until the response of the last
+ * request which the calling task sent with
+ * sendHttpDLTClientRequest is received or until the
+ * deadline expires.
+ *
+ * @param[in] timeoutMs
+ * Maximum time to wait for the response in milliseconds,
+ * HTTP_REQUEST_DEADLINE_DEFAULT for the deadline of its policy
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T HttpWaitForResponse(uint32_t timeoutMs)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	httpRequestSlot_T *slot_ptr = findTaskRequestSlot();
+
+	if(NULL != slot_ptr) {
+		ret = HttpRequestWait(slot_ptr->requestID, timeoutMs);
+		/* the results are stored in the global buffers - the slot is not needed anymore */
+		HttpRequestRelease(slot_ptr->requestID);
+	}
+
+	return ret;
+}
+
+/**
+ * This function waits until a http response is received
+ * or the deadline of the called ethereum function expires
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T WaitForHttpReceiveCallback()
+{
+	return HttpWaitForResponse(HTTP_REQUEST_DEADLINE_DEFAULT);
+}
+
+/**
+ * This function waits until the last transaction
+ * is confirmed or until the specified time runs out.
+ * With ENABLE_CONFIRMATION_TRACKER the confirmation
+ * tracker checks the transaction once per new block,
+ * otherwise the blockchain is polled.
+ *
+ * @return
+ * true, if successful<br>
+ * false, otherwise.
+ */
+bool WaitForTransactionConfirmation()
+{
+	bool retTransConfirmed = false;
+	uint8_t transactionHash[TRANSACTION_HASH_RESULT_LENGTH] = { 0 };
+
+	/* the global hash may be overwritten by a transaction of another task */
+	memcpy(transactionHash, SEEDTransactionHashBuffer, sizeof(transactionHash));
+
+#ifdef ENABLE_CONFIRMATION_TRACKER
+	retTransConfirmed = ConfirmationTrackerWait(transactionHash, CONFIRMATION_TRANSACTION_COUNTER * CONFIRMATION_TIME_TO_WAIT * 1000);
+#else
+	Retcode_T retHttpRequest = RETCODE_FAILURE;
+	HttpRequestID_T requestID = HTTP_REQUEST_ID_INVALID;
+	HttpCallResult_T receipt;
+	portTickType startTick = xTaskGetTickCount();
+	uint32_t deadlineMs = CONFIRMATION_TRANSACTION_COUNTER * CONFIRMATION_TIME_TO_WAIT * 1000;
+
+	/* while transaction is unconfirmed - a lost receipt response does
+	 * not end the wait, the receipt is requested again with the next poll */
+	while(false == retTransConfirmed)
+	{
+		/* call getTransactionReceipt function to check wether transaction is confirmed */
+		retHttpRequest = HttpRequestSend(GET_TRANSACTION_RECEIPT, "na", "na", transactionHash, sizeof(transactionHash), &requestID);
+		if(RETCODE_SUCCESS == retHttpRequest) {
+			retHttpRequest = HttpRequestWait(requestID, HTTP_REQUEST_DEADLINE_DEFAULT);
+			if(RETCODE_SUCCESS == retHttpRequest) {
+				retHttpRequest = HttpRequestGetResult(requestID, 0, &receipt);
+			}
+			HttpRequestRelease(requestID);
+		}
+
+		/* wait until transaction is confirmed */
+		if( (RETCODE_SUCCESS == retHttpRequest) && (true == receipt.transactionConfirmed)) {
+			retTransConfirmed = true;
+		} else if( (TICKS_TO_MS(xTaskGetTickCount() - startTick) + (CONFIRMATION_TIME_TO_WAIT * 1000)) >= deadlineMs ) {
+			/* the next poll would be after the deadline */
+			break;
+		} else {
+			/* wait for a specific time before the next request */
+			vTaskDelay(SECONDS(CONFIRMATION_TIME_TO_WAIT));
+		}
+	}
+#endif
+
+	return retTransConfirmed;
+}
+
+#ifdef ENABLE_LOCAL_SIGNING
+/**
+ * This function writes a contract transaction which is
+ * signed on the XDK as raw transaction string. The call
+ * data is ABI encoded and signed in the output buffer of
+ * the writer and hex encoded in place afterwards.
+ *
+ * @param[in] writer_ptr
+ * This reference holds the JSON writer context
+ *
+ * @param[in] function_ptr
+ * This reference holds the contract function
+ *
+ * @param[in] receiverAddress_ptr
+ * This string holds the ethereum contract address
+ *
+ * @param[in] argument_ptr
+ * This reference holds the argument of the function
+ *
+ * @param[in] gasLimit
+ * Gas limit of the transaction
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T writeSignedTransaction(JSONWriter_T *writer_ptr, contractFunction_T const *function_ptr, uint8_t const *receiverAddress_ptr, ABIArgument_T const *argument_ptr, uint32_t gasLimit)
+{
+	TransactionSignerTx_T tx;
+	uint8_t *raw_ptr = NULL;
+	size_t rawMaxLength = 0;
+	size_t rawLength = 0;
+
+	if( ('0' == receiverAddress_ptr[0]) && ('x' == receiverAddress_ptr[1]) ) {
+		receiverAddress_ptr += 2;
+	}
+	if( ((TRANSACTION_SIGNER_ADDRESS_SIZE * 2) != strlen(receiverAddress_ptr)) ||
+		(RETCODE_SUCCESS != HexDecode(receiverAddress_ptr, TRANSACTION_SIGNER_ADDRESS_SIZE * 2, tx.to)) ) {
+		return RETCODE_FAILURE;
+	}
+	tx.value = function_ptr->value;
+	tx.gasLimit = gasLimit;
+
+	JSONWriterBeginString(writer_ptr);
+	JSONWriterAppendRaw(writer_ptr, "0x", 2);
+	raw_ptr = JSONWriterReserveHex(writer_ptr, &rawMaxLength);
+	if( (NULL == raw_ptr) || (rawMaxLength < (TRANSACTION_SIGNER_DATA_OFFSET + TRANSACTION_SIGNER_SIGNATURE_MAX)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	/* call data is placed where the signer expects it */
+	if(RETCODE_SUCCESS != ABIEncodeCallData(function_ptr->selector, argument_ptr, (ABI_TYPE_NONE != function_ptr->argType) ? 1 : 0,
+			&raw_ptr[TRANSACTION_SIGNER_DATA_OFFSET], rawMaxLength - TRANSACTION_SIGNER_DATA_OFFSET - TRANSACTION_SIGNER_SIGNATURE_MAX, &tx.dataLength)) {
+		return RETCODE_FAILURE;
+	}
+	if(RETCODE_SUCCESS != TransactionSignerSign(&tx, raw_ptr, rawMaxLength, &rawLength, NULL)) {
+#ifdef ENABLE_DEBUG
+		printf("Transaction signing failed\n\r");
+#endif
+		return RETCODE_FAILURE;
+	}
+	JSONWriterCommitHex(writer_ptr, rawLength);
+	JSONWriterEndString(writer_ptr);
+
+	return RETCODE_SUCCESS;
+}
+#endif /* ENABLE_LOCAL_SIGNING */
+
+/**
+ * This function writes the call object of a contract
+ * function - the parameter of eth_call, eth_sendTransaction
+ * and eth_estimateGas
+ *
+ * @param[in] writer_ptr
+ * This reference holds the JSON writer context
+ *
+ * @param[in] function_ptr
+ * This reference holds the contract function
+ *
+ * @param[in] senderAddress_ptr
+ * This string holds the ethereum sender address
+ *
+ * @param[in] receiverAddress_ptr
+ * This string holds the ethereum contract address
+ *
+ * @param[in] argument_ptr
+ * This reference holds the argument of the function
+ *
+ * @param[in] gasLimit
+ * Gas limit of the call, 0 to leave it to the node
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T writeCallObject(JSONWriter_T *writer_ptr, contractFunction_T const *function_ptr, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, ABIArgument_T const *argument_ptr, uint32_t gasLimit)
+{
+	JSONWriterBeginObject(writer_ptr);
+	JSONWriterKey(writer_ptr, "from");
+	JSONWriterString(writer_ptr, senderAddress_ptr);
+	JSONWriterKey(writer_ptr, "to");
+	JSONWriterString(writer_ptr, receiverAddress_ptr);
+	if(0 != gasLimit) {
+		JSONWriterKey(writer_ptr, "gas");
+		JSONWriterQuantity(writer_ptr, gasLimit);
+	}
+
+	/* provide ether in value parameter e.g. to write public key */
+	if(0 != function_ptr->value) {
+		JSONWriterKey(writer_ptr, "value");
+		JSONWriterQuantity(writer_ptr, function_ptr->value);
+	}
+
+	JSONWriterKey(writer_ptr, "data");
+	JSONWriterBeginString(writer_ptr);
+	if(RETCODE_SUCCESS != ABIEncodeCall(writer_ptr, function_ptr->selector, argument_ptr, (ABI_TYPE_NONE != function_ptr->argType) ? 1 : 0)) {
+		return RETCODE_FAILURE;
+	}
+	JSONWriterEndString(writer_ptr);
+	JSONWriterEndObject(writer_ptr);
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function is called to write the JSON object
+ * of one JSON RPC call to the ethereum blockchain.
+ * The object is emitted in compact form directly
+ * into the output buffer of the writer.
+ *
+ * @param[in] writer_ptr
+ * This reference holds the JSON writer context
+ *
+ * @param[in] etherMethod
+ * This parameter holds the method which shall be called.
+ * You can choose between four function calls which are
+ * supported by the smart contract and passed as an enum
+ * value.
+ *	1. WRITE_DATA_HASH
+ *	2. READ_DATA_HASH
+ *	3. WRITE_PUBLIC_KEY
+ *	4. READ_PUBLIC_KEY
+ *	5. READ_PUBLIC_KEY_SENDER_ADDRESS
+ *
+ * @param[in] senderAddress_ptr
+ * This string holds the ethereum sender address
+ *
+ * @param[in] receiverAddress_ptr
+ * This string holds the ethereum receiver/contract address
+ *
+ * @param[in] payload_ptr
+ * This reference holds the payload of which will be send
+ * to the smart contract e.g. data hash or public key.
+ * This parameter is only required for function WRITE_DATA_HASH
+ * and WRITE_PUBLIC_KEY. Can be NULL for READ functions.
+ * GET_TRANSACTION_COUNT expects the account address.
+ *
+ * @param[in] iPayloadLength
+ * Holds the length of the incoming payload
+ *
+ * @param[in] messageID
+ * JSON RPC id of the call
+ *
+ * @param[in] gasLimit
+ * Gas limit of a transaction - see getTransactionGasLimit
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T writeJSONRequestObject(JSONWriter_T *writer_ptr, etherFuncCalls etherMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength, uint32_t messageID, uint32_t gasLimit)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	uint8_t const *ethMethod_ptr  = NULL;
+	contractFunction_T const *function_ptr = NULL;
+	uint8_t const *payloadEnd_ptr = NULL;
+	ABIArgument_T argument;
+
+	/* check for null pointers - payload_ptr can be null for read functions */
+	if( (NULL != senderAddress_ptr) && (NULL != receiverAddress_ptr) )
+	{
+		/* search the contract function */
+		function_ptr = findContractFunction(etherMethod);
+		if(NULL != function_ptr) {
+#ifdef ENABLE_LOCAL_SIGNING
+			ethMethod_ptr = (true == function_ptr->transaction) ? "eth_sendRawTransaction" : "eth_call";
+#else
+			ethMethod_ptr = (true == function_ptr->transaction) ? "eth_sendTransaction" : "eth_call";
+#endif
+		} else {
+			/* otherwise choose node function */
+			switch (etherMethod) {
+				case GET_TRANSACTION_RECEIPT:
+					ethMethod_ptr = "eth_getTransactionReceipt";
+				break;
+				case NEW_BLOCK_FILTER:
+					/* filter for new blocks - no parameters */
+					ethMethod_ptr = "eth_newBlockFilter";
+				break;
+				case GET_FILTER_CHANGES:
+					/* block hashes since the last poll of the filter id in the payload */
+					ethMethod_ptr = "eth_getFilterChanges";
+				break;
+				case UNINSTALL_FILTER:
+					/* removes the filter id in the payload from the node */
+					ethMethod_ptr = "eth_uninstallFilter";
+				break;
+				case GET_TRANSACTION_COUNT:
+					/* nonce of the next transaction of the account in the payload */
+					ethMethod_ptr = "eth_getTransactionCount";
+				break;
+				case BLOCK_NUMBER:
+					/* number of the latest block - no parameters */
+					ethMethod_ptr = "eth_blockNumber";
+				break;
+				case SUBSCRIBE:
+					/* subscription type in the payload e.g. newHeads */
+					ethMethod_ptr = "eth_subscribe";
+				break;
+				default:
+					printf("Create JSON string input error\n\r");
+					return ret;
+				break;
+			}
+		}
+
+		/* payload data is required for state changing functions */
+		if( (NULL != function_ptr) && (ABI_TYPE_NONE != function_ptr->argType) && (ABI_TYPE_BOOL != function_ptr->argType) && (NULL == payload_ptr) ) {
+			return ret;
+		}
+
+		/* main JSON object */
+		JSONWriterBeginObject(writer_ptr);
+		JSONWriterKey(writer_ptr, "jsonrpc");
+		JSONWriterString(writer_ptr, JSON_RPC_VERSION);
+		JSONWriterKey(writer_ptr, "method");
+		JSONWriterString(writer_ptr, ethMethod_ptr);
+
+		/* params array */
+		JSONWriterKey(writer_ptr, "params");
+		JSONWriterBeginArray(writer_ptr);
+
+		if(NULL != function_ptr) {
+			/* ABI encoded function selector and arguments */
+			argument.type = function_ptr->argType;
+			argument.data_ptr = payload_ptr;
+			argument.length = (ABI_TYPE_BOOL == function_ptr->argType) ? function_ptr->boolValue : iPayloadLength;
+		}
+
+#ifdef ENABLE_LOCAL_SIGNING
+		if( (NULL != function_ptr) && (true == function_ptr->transaction) ) {
+			/* the signed transaction is the only parameter */
+			if(RETCODE_SUCCESS != writeSignedTransaction(writer_ptr, function_ptr, receiverAddress_ptr, &argument, gasLimit)) {
+				return ret;
+			}
+		} else
+#endif
+		if(NULL != function_ptr) {
+			/* view calls are sent without gas limit */
+			if(RETCODE_SUCCESS != writeCallObject(writer_ptr, function_ptr, senderAddress_ptr, receiverAddress_ptr, &argument, (true == function_ptr->transaction) ? gasLimit : 0)) {
+				return ret;
+			}
+		} else if(NULL != payload_ptr) {
+			/* for function getTransactionReceipt only transaction is required as a parameter,
+			 * getFilterChanges and uninstallFilter require the filter id, getTransactionCount the account,
+			 * eth_subscribe the subscription type.
+			 * The transaction hash buffer is not null terminated */
+			payloadEnd_ptr = memchr(payload_ptr, '\0', iPayloadLength);
+			JSONWriterBeginString(writer_ptr);
+			JSONWriterAppendRaw(writer_ptr, payload_ptr, (NULL != payloadEnd_ptr) ? (size_t) (payloadEnd_ptr - payload_ptr) : iPayloadLength);
+			JSONWriterEndString(writer_ptr);
+		}
+
+		/* add quantity tag only for eth_call
+		 * It is not supported by eth_sendTransaction
+		 * */
+		if( (strncmp(ethMethod_ptr, "eth_call", strlen("eth_call")) == 0) ) {
+			JSONWriterString(writer_ptr, "latest");
+		}
+		/* count transactions which are not mined yet, too */
+		if(GET_TRANSACTION_COUNT == etherMethod) {
+			JSONWriterString(writer_ptr, "pending");
+		}
+		JSONWriterEndArray(writer_ptr);
+
+		/* add id value to main JSON object */
+		JSONWriterKey(writer_ptr, "id");
+		JSONWriterNumber(writer_ptr, messageID);
+		JSONWriterEndObject(writer_ptr);
+
+		if(false == writer_ptr->overflow) {
+			ret = RETCODE_SUCCESS;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * This function returns the gas limit a call is sent
+ * with. With ENABLE_GAS_ESTIMATION it is the cached
+ * estimate of the node plus GAS_ESTIMATE_MARGIN_PERCENT,
+ * otherwise or without estimate the fallback gas of the
+ * contract function.
+ *
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request which
+ * records the gas limit of the call for its receipt. Can
+ * be NULL.
+ *
+ * @param[in] callIndex
+ * This variable holds the index of the call in the request
+ *
+ * @param[in] ethMethod
+ * This variable holds the ethereum function of the call
+ *
+ * @param[in] iPayloadLength
+ * This variable holds the length of the payload
+ *
+ * @return
+ * gas limit, 0 for calls which are no transaction
+ */
+static uint32_t getTransactionGasLimit(httpRequestSlot_T *slot_ptr, uint8_t callIndex, etherFuncCalls ethMethod, size_t iPayloadLength)
+{
+	contractFunction_T const *function_ptr = findContractFunction(ethMethod);
+	uint32_t gasLimit = 0;
+#ifdef ENABLE_GAS_ESTIMATION
+	GasEstimatorKey_T key;
+#endif
+
+	if( (NULL == function_ptr) || (false == function_ptr->transaction) ) {
+		return gasLimit;
+	}
+
+#ifdef ENABLE_GAS_ESTIMATION
+	GasEstimatorMakeKey(function_ptr->selector, (ABI_TYPE_BYTES == function_ptr->argType) ? iPayloadLength : 0, &key);
+	gasLimit = GasEstimatorGetLimit(&key, function_ptr->fallbackGas);
+	if(NULL != slot_ptr) {
+		slot_ptr->gasKey[callIndex] = key;
+		slot_ptr->gasLimit[callIndex] = gasLimit;
+	}
+#else
+	(void) slot_ptr;
+	(void) callIndex;
+	(void) iPayloadLength;
+	gasLimit = function_ptr->fallbackGas;
+#endif
+
+	return gasLimit;
+}
+
+#ifdef ENABLE_REQUEST_TEMPLATES
+/**
+ * This function checks if the JSON of a call only
+ * depends on the function and the addresses, apart from
+ * the id and the gas limit. These calls are written from
+ * a request template after the first one.
+ *
+ * @param[in] etherMethod
+ * This parameter holds the ethereum function
+ *
+ * @return
+ * true, if the call can be written from a template
+ */
+static bool isTemplateCall(etherFuncCalls etherMethod)
+{
+	contractFunction_T const *function_ptr = findContractFunction(etherMethod);
+
+	/* node functions and bytes arguments differ per call */
+	if( (NULL == function_ptr) || ((ABI_TYPE_NONE != function_ptr->argType) && (ABI_TYPE_BOOL != function_ptr->argType)) ) {
+		return false;
+	}
+#ifdef ENABLE_LOCAL_SIGNING
+	/* signed transactions contain the nonce and the signature */
+	if(true == function_ptr->transaction) {
+		return false;
+	}
+#endif
+
+	return true;
+}
+#endif /* ENABLE_REQUEST_TEMPLATES */
+
+/**
+ * This function writes the JSON object of one call. With
+ * ENABLE_REQUEST_TEMPLATES constant calls are copied from
+ * their template and only the id and the gas limit are
+ * written, the first call of a function and addresses
+ * is serialized and stored as template.
+ * See writeJSONRequestObject for the parameters.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T writeRequestCall(JSONWriter_T *writer_ptr, etherFuncCalls etherMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength, uint32_t messageID, uint32_t gasLimit)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+#ifdef ENABLE_REQUEST_TEMPLATES
+	size_t start = writer_ptr->length;
+	bool templateCall = (NULL != senderAddress_ptr) && (NULL != receiverAddress_ptr) && (true == isTemplateCall(etherMethod));
+
+	if( (true == templateCall) && (RETCODE_SUCCESS == RequestTemplateWrite(writer_ptr, (uint8_t) etherMethod, senderAddress_ptr, receiverAddress_ptr, messageID, gasLimit)) ) {
+		return (false == writer_ptr->overflow) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+	}
+#endif
+
+	ret = writeJSONRequestObject(writer_ptr, etherMethod, senderAddress_ptr, receiverAddress_ptr, payload_ptr, iPayloadLength, messageID, gasLimit);
+
+#ifdef ENABLE_REQUEST_TEMPLATES
+	if( (RETCODE_SUCCESS == ret) && (true == templateCall) ) {
+		/* the comma in front of a batch call is not part of the template */
+		if( (start < writer_ptr->length) && (',' == writer_ptr->buff_ptr[start]) ) {
+			start++;
+		}
+		(void) RequestTemplateStore((uint8_t) etherMethod, senderAddress_ptr, receiverAddress_ptr, &writer_ptr->buff_ptr[start], writer_ptr->length - start);
+	}
+#endif
+
+	return ret;
+}
+
+/**
+ * This function is called to create a JSON string
+ * to make a JSON RPC call to the ethereum blockchain.
+ * The string is written directly into the provided
+ * buffer without any heap allocation.
+ *
+ * @param[in] etherMethod
+ * This parameter holds the method which shall be called.
+ *
+ * @param[in] senderAddress_ptr
+ * This string holds the ethereum sender address
+ *
+ * @param[in] receiverAddress_ptr
+ * This string holds the ethereum receiver/contract address
+ *
+ * @param[in] payload_ptr
+ * This reference holds the payload of which will be send
+ * to the smart contract. Can be NULL for READ functions
+ *
+ * @param[in] iPayloadLength
+ * Holds the length of the incoming payload
+ *
+ * @param[in] messageID
+ * JSON RPC id of the call
+ *
+ * @param[out] oBuff
+ * This buffer will hold the null terminated JSON string
+ *
+ * @param[in] buffSize
+ * Size of the output buffer
+ *
+ * @param[out] oLength_ptr
+ * This reference will hold the length of the JSON string
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T genJSONRequest(etherFuncCalls etherMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength, uint32_t messageID, uint8_t *oBuff, size_t buffSize, size_t *oLength_ptr)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	JSONWriter_T writer;
+
+	JSONWriterInit(&writer, oBuff, buffSize);
+
+	ret = writeRequestCall(&writer, etherMethod, senderAddress_ptr, receiverAddress_ptr, payload_ptr, iPayloadLength, messageID, getTransactionGasLimit(NULL, 0, etherMethod, iPayloadLength));
+	if(RETCODE_SUCCESS == ret) {
+		ret = JSONWriterFinish(&writer, oLength_ptr);
+	}
+
+	return ret;
+}
+
+/**
+ * This function is called to parse one incoming json rpc
+ * response object. Batch responses contain one of them per
+ * request. The result is not copied, oResult_ptr references
+ * the result value inside the http content.
+ *
+ * @param[in] response_ptr
+ * This reference holds the token of the JSON response object
+ *
+ * @param[out] oResult_ptr
+ * This reference will hold the token of the result value
+ * e.g. the DataHash or the PublicKey in a get function
+ *
+ * @param[out] oMessageID_ptr
+ * This reference will hold the JSON RPC id of the response
+ * which identifies the request and the call
+ *
+ * @return
+ * RC_OK, if successful<br>
+ * RC_MAX_APP_ERROR, otherwise.
+ */
+retcode_t parseIncomingJSONMessage(JSONToken_T const *response_ptr, JSONToken_T *oResult_ptr, uint32_t *oMessageID_ptr)
+{
+	retcode_t status = RC_MAX_APP_ERROR;
+	JSONToken_T id;
+
+	/* assign message id */
+	if( (RETCODE_SUCCESS == JSONReaderGetMember(response_ptr, "id", &id)) && (RETCODE_SUCCESS == JSONReaderGetUint(&id, oMessageID_ptr)) ) {
+#ifdef ENABLE_DEBUG
+		printf("JSON MessageID is: %lu\n\r", (unsigned long) *oMessageID_ptr);
+#endif
+		/* extract result parameter of incoming json string - error
+		 * responses do not contain a result */
+		if(RETCODE_SUCCESS == JSONReaderGetMember(response_ptr, "result", oResult_ptr)) {
+#ifdef ENABLE_DEBUG
+			printf("Result is: %.*s\n\r", (int) oResult_ptr->length, oResult_ptr->ptr);
+#endif
+			status = RC_OK;
+		}
+	}
+
+	return status;
+}
+
+#if defined(ENABLE_LOCAL_SIGNING) || defined(ENABLE_READ_CACHE) || defined(ENABLE_GAS_ESTIMATION)
+/**
+ * This function reads a json rpc quantity - a hex number
+ * with 0x prefix and without leading zeros
+ *
+ * @param[in] result_ptr
+ * This reference holds the token of the result value
+ *
+ * @param[out] oValue_ptr
+ * This reference will hold the number
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T readQuantity(JSONToken_T const *result_ptr, uint64_t *oValue_ptr)
+{
+	uint8_t digit = 0;
+	uint64_t value = 0;
+
+	if( (3 > result_ptr->length) || ((2 + (sizeof(value) * 2)) < result_ptr->length) || ('0' != result_ptr->ptr[0]) || ('x' != result_ptr->ptr[1]) ) {
+		return RETCODE_FAILURE;
+	}
+
+	for(size_t i = 2; i < result_ptr->length; ++i) {
+		digit = HexDecodeDigit(result_ptr->ptr[i]);
+		if(HEX_INVALID_DIGIT == digit) {
+			return RETCODE_FAILURE;
+		}
+		value = (value << 4) | digit;
+	}
+
+	*oValue_ptr = value;
+	return RETCODE_SUCCESS;
+}
+#endif
+
+/**
+ * This function checks the result of a getTransactionReceipt
+ * call. The result is null as long as the transaction is not
+ * mined, the status of the receipt indicates if the transaction
+ * was successful.
+ *
+ * @param[in] result_ptr
+ * This reference holds the token of the result value
+ *
+ * @return
+ * true, if transaction is confirmed with status 0x1<br>
+ * false, otherwise.
+ */
+static bool isTransactionConfirmed(JSONToken_T const *result_ptr)
+{
+	JSONToken_T status;
+#ifdef ENABLE_READ_CACHE
+	JSONToken_T blockNumber;
+	uint64_t block = 0;
+#endif
+
+	if(RETCODE_SUCCESS != JSONReaderGetMember(result_ptr, "status", &status)) {
+#ifdef ENABLE_DEBUG
+		printf("Transaction not confirmed\n\r");
+#endif
+		return false;
+	}
+#ifdef ENABLE_DEBUG
+	printf("Transaction confirmed with status %.*s\n\r", (int) status.length, status.ptr);
+#endif
+
+#ifdef ENABLE_READ_CACHE
+	/* the transaction changed the contract state - cached results
+	 * are dropped, the block of the transaction is the latest one */
+	ReadCacheInvalidate();
+	if( (RETCODE_SUCCESS == JSONReaderGetMember(result_ptr, "blockNumber", &blockNumber)) && (RETCODE_SUCCESS == readQuantity(&blockNumber, &block)) ) {
+		ReadCacheSetBlockNumber(block);
+	}
+#endif
+
+	/* if transaction was successfull, status is equal to 0x1 */
+	return JSONReaderStringEquals(&status, "0x1");
+}
+
+/**
+ * This function is called to store the result of one
+ * json rpc response in the buffers of the calling module.
+ * The hex encoded results are decoded straight from the
+ * http content into the destination buffers.
+ *
+ * @param[in] ethMessageID
+ * This variable holds the ethereum function the result
+ * belongs to
+ *
+ * @param[in] result_ptr
+ * This reference holds the token of the result value
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, if the result can not be used e.g. a
+ * truncated consumer public key - the buffers are unchanged.
+ */
+static Retcode_T processJSONRPCResult(etherFuncCalls ethMessageID, JSONToken_T const *result_ptr)
+{
+	Retcode_T ret = RETCODE_SUCCESS;
+	ABIResult_T abiResult;
+	uint8_t accountAddress[READ_ETH_ACCOUNT_ADDRESS_RESULT_LENGTH];
+	size_t publicKeyLength = 0;
+#if defined(ENABLE_LOCAL_SIGNING) || defined(ENABLE_READ_CACHE)
+	uint64_t quantity = 0;
+#endif
+
+	/* call function dependent on message id */
+	switch (ethMessageID) {
+		case READ_DATA_HASH:
+			/* read and convert data hash */
+			memset(SEEDConsumerDataHashBuffer, 0, sizeof(SEEDConsumerDataHashBuffer));
+			if( (RETCODE_SUCCESS != ABIDecoderInit(&abiResult, result_ptr->ptr, result_ptr->length)) ||
+				(RETCODE_SUCCESS != ABIDecodeBytes(&abiResult, READ_DATA_HASH_RESULT_INDEX, SEEDConsumerDataHashBuffer, sizeof(SEEDConsumerDataHashBuffer), NULL)) ) {
+				memset(SEEDConsumerDataHashBuffer, 0, sizeof(SEEDConsumerDataHashBuffer));
+			}
+#ifdef ENABLE_DEBUG
+			printf("SEEDConsumerDataHashBuffer result: \n%.*s\n\r", (int) sizeof(SEEDConsumerDataHashBuffer), SEEDConsumerDataHashBuffer);
+#endif
+		break;
+		case READ_PUBLIC_KEY:
+			/* read consumer account address first - it validates the result head */
+			if( (RETCODE_SUCCESS != ABIDecoderInit(&abiResult, result_ptr->ptr, result_ptr->length)) ||
+				(RETCODE_SUCCESS != ABIDecodeAddress(&abiResult, READ_ETH_ACCOUNT_ADDR_RESULT_INDEX, accountAddress)) ) {
+				ret = RETCODE_FAILURE;
+				break;
+			}
+			/* decode public key - the consumer is pushed into the
+			 * authentication table together with its parsed key, an
+			 * invalid answer must not evict a stored consumer */
+			if(RETCODE_SUCCESS != ABIDecodeBytes(&abiResult, READ_PUBLIC_KEY_RESULT_INDEX, SEEDConsumerPublicKeyBuffer, READ_PUB_KEY_RESULT_LENGTH - 1, &publicKeyLength)) {
+				ret = RETCODE_FAILURE;
+#ifdef ENABLE_DEBUG
+				printf("Consumer public key invalid\n\r");
+#endif
+				break;
+			}
+			/* parse the key once - every reading of this consumer is encrypted with it */
+			(void) EncryptionStoreConsumerKey(accountAddress, SEEDConsumerPublicKeyBuffer, publicKeyLength);
+#ifdef ENABLE_DEBUG
+			printf("Consumer public key result: \n%.*s\n\r", (int) publicKeyLength, SEEDConsumerPublicKeyBuffer);
+			printf("Consumer account address: 0x%.*s\n\r", READ_ETH_ACCOUNT_ADDRESS_RESULT_LENGTH, accountAddress);
+#endif
+		break;
+#ifdef ENABLE_LOCAL_SIGNING
+		case GET_TRANSACTION_COUNT:
+			/* nonce of the next transaction of the signing account */
+			if(RETCODE_SUCCESS == readQuantity(result_ptr, &quantity)) {
+				TransactionSignerSetNonce(quantity);
+#ifdef ENABLE_DEBUG
+				printf("Transaction nonce: %lu\n\r", (unsigned long) quantity);
+#endif
+			}
+		break;
+#endif
+#ifdef ENABLE_READ_CACHE
+		case BLOCK_NUMBER:
+			/* latest block - cached results of older blocks are dropped */
+			if(RETCODE_SUCCESS == readQuantity(result_ptr, &quantity)) {
+				ReadCacheSetBlockNumber(quantity);
+			}
+		break;
+#endif
+		case WRITE_DATA_HASH:
+		case WRITE_PUBLIC_KEY:
+			/* for state changing functions store transaction hash so confirmation function can be called */
+			memset(SEEDTransactionHashBuffer, 0, sizeof(SEEDTransactionHashBuffer));
+			memcpy(SEEDTransactionHashBuffer, result_ptr->ptr, (result_ptr->length < TRANSACTION_HASH_RESULT_LENGTH) ? result_ptr->length : TRANSACTION_HASH_RESULT_LENGTH);
+#ifdef ENABLE_DEBUG
+			printf("Transaction hash: %.*s\n\r", TRANSACTION_HASH_RESULT_LENGTH, SEEDTransactionHashBuffer);
+#endif
+		break;
+		default:
+			/* do nothing */
+		break;
+	}
+
+	return ret;
+}
+
+/**
+ * This function copies a string or literal value into the
+ * null terminated result of a call. Longer values are cut.
+ *
+ * @param[out] callResult_ptr
+ * This reference holds the result of the call
+ *
+ * @param[in] value_ptr
+ * This reference holds the token of the value
+ *
+ * @return
+ * void
+ */
+static void copyCallResult(HttpCallResult_T *callResult_ptr, JSONToken_T const *value_ptr)
+{
+	size_t resultLength = (value_ptr->length < (sizeof(callResult_ptr->result) - 1)) ? value_ptr->length : (sizeof(callResult_ptr->result) - 1);
+
+	memcpy(callResult_ptr->result, value_ptr->ptr, resultLength);
+	callResult_ptr->result[resultLength] = 0;
+}
+
+/**
+ * This function stores a string result in the call result
+ * and routes it to the global buffers
+ *
+ * @param[out] callResult_ptr
+ * This reference holds the result of the call
+ *
+ * @param[in] result_ptr
+ * This reference holds the token of the result value
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T storeStringResult(HttpCallResult_T *callResult_ptr, JSONToken_T const *result_ptr)
+{
+	/* call function dependent on ethereum function of the call */
+	Retcode_T ret = processJSONRPCResult(callResult_ptr->ethMethod, result_ptr);
+
+	copyCallResult(callResult_ptr, result_ptr);
+
+	return ret;
+}
+
+#ifdef ENABLE_GAS_ESTIMATION
+/**
+ * This function records the gas used by a transaction of
+ * the device from its receipt
+ *
+ * @param[in] result_ptr
+ * This reference holds the token of the receipt, null while
+ * the transaction is not mined
+ *
+ * @return
+ * void
+ */
+static void recordTransactionGas(JSONToken_T const *result_ptr)
+{
+	JSONToken_T transactionHash;
+	JSONToken_T gasUsed;
+	JSONToken_T status;
+	uint64_t gas = 0;
+
+	if( (RETCODE_SUCCESS == JSONReaderGetMember(result_ptr, "transactionHash", &transactionHash)) &&
+		(RETCODE_SUCCESS == JSONReaderGetMember(result_ptr, "gasUsed", &gasUsed)) && (RETCODE_SUCCESS == readQuantity(&gasUsed, &gas)) &&
+		(RETCODE_SUCCESS == JSONReaderGetMember(result_ptr, "status", &status)) ) {
+		GasEstimatorRecordReceipt(transactionHash.ptr, transactionHash.length, gas, JSONReaderStringEquals(&status, "0x1"));
+	}
+}
+
+/**
+ * This function handles the gas of a string result. The
+ * result of eth_estimateGas is stored in the gas estimator,
+ * the hash of a transaction is tracked until its receipt
+ * reports the used gas.
+ *
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request
+ *
+ * @param[in] callIndex
+ * This variable holds the index of the call in the request
+ *
+ * @param[in] result_ptr
+ * This reference holds the token of the result value
+ *
+ * @return
+ * void
+ */
+static void handleGasResult(httpRequestSlot_T const *slot_ptr, uint8_t callIndex, JSONToken_T const *result_ptr)
+{
+	uint64_t estimate = 0;
+
+	if(ESTIMATE_GAS == slot_ptr->results[callIndex].ethMethod) {
+		if(RETCODE_SUCCESS == readQuantity(result_ptr, &estimate)) {
+			GasEstimatorStore(&slot_ptr->gasKey[callIndex], estimate);
+		}
+	} else if(0 != slot_ptr->gasLimit[callIndex]) {
+		GasEstimatorTrackTransaction(&slot_ptr->gasKey[callIndex], slot_ptr->gasLimit[callIndex], result_ptr->ptr, result_ptr->length);
+	}
+}
+#endif /* ENABLE_GAS_ESTIMATION */
+
+#ifdef ENABLE_READ_CACHE
+/**
+ * This function returns the block a view call result is
+ * cached for. If the block number was read in the same
+ * batch, it is taken from the answer of eth_blockNumber.
+ * It is sent ahead of the view call, so the call was
+ * executed on that block or a later one.
+ *
+ * @param[in,out] slot_ptr
+ * This reference holds the slot of the request. Its
+ * readCacheBlock is set from the batch.
+ *
+ * @return
+ * true, if the block is known<br>
+ * false, if the result can not be cached.
+ */
+static bool getReadCacheBlock(httpRequestSlot_T *slot_ptr)
+{
+	JSONToken_T blockNumber;
+
+	if(false == slot_ptr->readCacheBlockCall) {
+		return true;
+	}
+	/* a node which answers out of order - the block is not known yet */
+	if(false == slot_ptr->results[1].responseReceived) {
+		return false;
+	}
+
+	blockNumber.ptr = slot_ptr->results[1].result;
+	blockNumber.length = strlen((char const *) slot_ptr->results[1].result);
+	blockNumber.end_ptr = &blockNumber.ptr[blockNumber.length];
+	blockNumber.type = JSON_TOKEN_STRING;
+
+	return (RETCODE_SUCCESS == readQuantity(&blockNumber, &slot_ptr->readCacheBlock));
+}
+#endif /* ENABLE_READ_CACHE */
+
+/**
+ * This function is called to handle one json rpc error
+ * object. The message of the node is stored in the call
+ * result so the caller can tell an error answer e.g.
+ * "filter not found" from a lost response. The call is
+ * not answered.
+ *
+ * @param[in] response_ptr
+ * This reference holds the token of the JSON response object
+ *
+ * @param[out] oSlot_ptr
+ * This reference will hold the slot of the request the
+ * error belongs to. Unchanged if no request was found.
+ *
+ * @return
+ * void
+ */
+static void handleJSONRPCError(JSONToken_T const *response_ptr, httpRequestSlot_T **oSlot_ptr)
+{
+	JSONToken_T id;
+	JSONToken_T error;
+	JSONToken_T message;
+	uint32_t messageID = 0;
+	uint8_t callIndex = 0;
+	httpRequestSlot_T *slot_ptr = NULL;
+
+	if( (RETCODE_SUCCESS != JSONReaderGetMember(response_ptr, "id", &id)) || (RETCODE_SUCCESS != JSONReaderGetUint(&id, &messageID))
+			|| (RETCODE_SUCCESS != JSONReaderGetMember(response_ptr, "error", &error)) ) {
+		return;
+	}
+
+	slot_ptr = findRequestSlotForCall(messageID, &callIndex);
+	if(NULL != slot_ptr) {
+		*oSlot_ptr = slot_ptr;
+		slot_ptr->results[callIndex].errorReceived = true;
+		if( (RETCODE_SUCCESS == JSONReaderGetMember(&error, "message", &message)) && (JSON_TOKEN_STRING == message.type) ) {
+			copyCallResult(&slot_ptr->results[callIndex], &message);
+#ifdef ENABLE_DEBUG
+			printf("JSON RPC error of MessageID %lu: %s\n\r", (unsigned long) messageID, slot_ptr->results[callIndex].result);
+#endif
+		}
+	}
+}
+
+/**
+ * This function is called to handle one json rpc response
+ * object. The request and the call are found by the id of
+ * the response. The result is stored in the call result of
+ * the request and routed to the global buffers.
+ *
+ * @param[in] response_ptr
+ * This reference holds the token of the JSON response object
+ *
+ * @param[in] responseTick
+ * Tick count when the response was received
+ *
+ * @param[out] oSlot_ptr
+ * This reference will hold the slot of the request the
+ * response belongs to. Unchanged if no request was found.
+ *
+ * @return
+ * RC_OK, if successful<br>
+ * RC_MAX_APP_ERROR, otherwise.
+ */
+static retcode_t handleJSONRPCResponse(JSONToken_T const *response_ptr, portTickType responseTick, httpRequestSlot_T **oSlot_ptr)
+{
+	retcode_t ret = RC_MAX_APP_ERROR;
+	JSONToken_T result;
+	uint32_t messageID = 0;
+	uint8_t callIndex = 0;
+	httpRequestSlot_T *slot_ptr = NULL;
+	HttpCallResult_T *callResult_ptr = NULL;
+
+	ret = parseIncomingJSONMessage(response_ptr, &result, &messageID);
+	if(RC_OK != ret) {
+		handleJSONRPCError(response_ptr, oSlot_ptr);
+		return ret;
+	}
+
+	/* search the request which waits for this id */
+	slot_ptr = findRequestSlotForCall(messageID, &callIndex);
+	if(NULL == slot_ptr) {
+#ifdef ENABLE_DEBUG
+		printf("No request waits for JSON MessageID %lu\n\r", (unsigned long) messageID);
+#endif
+		return RC_MAX_APP_ERROR;
+	}
+	*oSlot_ptr = slot_ptr;
+	callResult_ptr = &slot_ptr->results[callIndex];
+
+	if(GET_TRANSACTION_RECEIPT == callResult_ptr->ethMethod) {
+		/* check if transaction is mined/confirmed - if status is bad then transaction
+		 * is considered as unconfirmed because we have to send it again
+		 * */
+		callResult_ptr->transactionConfirmed = isTransactionConfirmed(&result);
+#ifdef ENABLE_GAS_ESTIMATION
+		recordTransactionGas(&result);
+#endif
+	} else if(JSON_TOKEN_ARRAY == result.type) {
+		/* e.g. getFilterChanges - only the number of new entries is of interest */
+		JSONToken_T element;
+		element.ptr = NULL;
+		while(RETCODE_SUCCESS == JSONReaderNextElement(&result, &element)) {
+			callResult_ptr->resultElementCounter++;
+		}
+	} else if(JSON_TOKEN_STRING == result.type) {
+		if(RETCODE_SUCCESS != storeStringResult(callResult_ptr, &result)) {
+			/* the result can not be used - the request fails and is
+			 * sent again, the later success of the response is ignored */
+			completeRequestSlot(slot_ptr, RETCODE_FAILURE);
+			return RC_MAX_APP_ERROR;
+		}
+#ifdef ENABLE_READ_CACHE
+		if( (true == slot_ptr->readCacheStore) && (0 == callIndex) && (true == getReadCacheBlock(slot_ptr)) ) {
+			ReadCacheStore(&slot_ptr->readCacheKey, slot_ptr->readCacheBlock, result.ptr, result.length);
+		}
+#endif
+#ifdef ENABLE_GAS_ESTIMATION
+		handleGasResult(slot_ptr, callIndex, &result);
+#endif
+	} else if(JSON_TOKEN_LITERAL == result.type) {
+		/* e.g. uninstallFilter - true or false is not routed to the global buffers */
+		copyCallResult(callResult_ptr, &result);
+	} else {
+		return RC_MAX_APP_ERROR;
+	}
+	callResult_ptr->responseReceived = true;
+	recordHttpLatency(callResult_ptr->ethMethod, TICKS_TO_MS(responseTick - slot_ptr->requestStartTick));
+
+	return RC_OK;
+}
+
+/**
+ * This function forwards a subscription notification
+ * (eth_subscription) of the node to the subscription
+ * callback
+ *
+ * @param[in] message_ptr
+ * This reference holds the token of the JSON message object
+ *
+ * @return
+ * true, if the message is a notification<br>
+ * false, otherwise.
+ */
+static bool handleSubscriptionNotification(JSONToken_T const *message_ptr)
+{
+	JSONToken_T method;
+	JSONToken_T params;
+	JSONToken_T subscription;
+	JSONToken_T result;
+
+	if( (RETCODE_SUCCESS != JSONReaderGetMember(message_ptr, "method", &method)) || (false == JSONReaderStringEquals(&method, "eth_subscription")) ) {
+		return false;
+	}
+
+	if( (RETCODE_SUCCESS == JSONReaderGetMember(message_ptr, "params", &params))
+			&& (RETCODE_SUCCESS == JSONReaderGetMember(&params, "subscription", &subscription))
+			&& (RETCODE_SUCCESS == JSONReaderGetMember(&params, "result", &result))
+			&& (NULL != httpClientHandleVar.subscriptionCallback) ) {
+		httpClientHandleVar.subscriptionCallback(&subscription, &result);
+	}
+
+	return true;
+}
+
+/**
+ * This function is called by the transport when a request
+ * is on the wire or could not be sent.
+ *
+ * @param[in] node
+ * This variable holds the node the request was sent to
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @param[in] status
+ * RETCODE_SUCCESS if the request was sent, RETCODE_FAILURE
+ * if it could not be sent
+ *
+ * @return
+ * void
+ */
+static void transportSentCallback(uint8_t node, uint32_t requestID, Retcode_T status)
+{
+	httpRequestSlot_T *slot_ptr = findRequestSlot(requestID);
+
+	if(RETCODE_SUCCESS != status) {
+		NodePoolReportFailure(node);
+	}
+	/* the request may have failed over to another node already */
+	if( (NULL == slot_ptr) || (node != slot_ptr->node) ) {
+		return;
+	}
+
+	if(RETCODE_SUCCESS != status) {
+		/* no answer will arrive - do not let the caller wait for it */
+		completeRequestSlot(slot_ptr, RETCODE_FAILURE);
+	} else {
+		/* the request is on the wire - update connect time counters */
+		slot_ptr->requestSentTick = xTaskGetTickCount();
+		httpRequestStatsVar.lastConnectTime = TICKS_TO_MS(slot_ptr->requestSentTick - slot_ptr->requestStartTick);
+		httpRequestStatsVar.totalConnectTime += httpRequestStatsVar.lastConnectTime;
+	}
+}
+
+/**
+ * This function is called by the transport when a json
+ * rpc message arrived. Responses are assigned to their
+ * request by the JSON RPC id, notifications are passed to
+ * the subscription callback.
+ *
+ * @param[in] node
+ * This variable holds the node the message came from
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request the message
+ * answers - TRANSPORT_REQUEST_NONE if the transport can not
+ * assign it
+ *
+ * @param[in] content_ptr
+ * This reference holds the message, NULL if the request
+ * failed. It is not null terminated.
+ *
+ * @param[in] iLength
+ * This variable holds the length of the message
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T transportReceivedCallback(uint8_t node, uint32_t requestID, uint8_t const *content_ptr, size_t iLength)
+{
+	retcode_t ret = RC_MAX_APP_ERROR;
+	JSONToken_T response;
+	JSONToken_T element;
+	httpRequestSlot_T *slot_ptr = NULL;
+	Retcode_T responseStatus = RETCODE_FAILURE;
+	portTickType responseTick = xTaskGetTickCount();
+
+	if(NULL != content_ptr) {
+		/* parse incoming JSON response */
+		if(RETCODE_SUCCESS == JSONReaderParse(content_ptr, iLength, &response)) {
+			if(JSON_TOKEN_ARRAY == response.type) {
+				/* batch response - one response object per request */
+				ret = RC_OK;
+				element.ptr = NULL;
+				while(RETCODE_SUCCESS == JSONReaderNextElement(&response, &element)) {
+					if(RC_OK != handleJSONRPCResponse(&element, responseTick, &slot_ptr)) {
+						ret = RC_MAX_APP_ERROR;
+					}
+				}
+			} else if(true == handleSubscriptionNotification(&response)) {
+				return RETCODE_SUCCESS;
+			} else {
+				ret = handleJSONRPCResponse(&response, responseTick, &slot_ptr);
+			}
+		}
+
+		/* answer is available in the buffers */
+		responseStatus = RETCODE_SUCCESS;
+#ifdef ENABLE_DEBUG
+		if(RC_OK != ret) {
+			printf("Failed to parse JSON response\n\r");
+		}
+#endif
+	} else {
+		NodePoolReportFailure(node);
+	}
+
+	/* responses without a known id are assigned by the transport - a
+	 * failure of a node the request already left is dropped */
+	if( (NULL == slot_ptr) && (TRANSPORT_REQUEST_NONE != requestID) ) {
+		taskENTER_CRITICAL();
+		slot_ptr = findRequestSlot(requestID);
+		if( (NULL != slot_ptr) && (((HTTP_REQUEST_PENDING != slot_ptr->state) && (HTTP_REQUEST_ORPHANED != slot_ptr->state))
+				|| ((RETCODE_SUCCESS != responseStatus) && (node != slot_ptr->node))) ) {
+			slot_ptr = NULL;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	/* update time to first byte counters */
+	if(NULL != slot_ptr) {
+		if( (RETCODE_SUCCESS == responseStatus) && (node == slot_ptr->node) ) {
+			NodePoolReportResponse(node, TICKS_TO_MS(responseTick - slot_ptr->requestStartTick));
+		}
+		httpRequestStatsVar.requestCounter++;
+		httpRequestStatsVar.lastTimeToFirstByte = TICKS_TO_MS(responseTick - slot_ptr->requestSentTick);
+		httpRequestStatsVar.totalTimeToFirstByte += httpRequestStatsVar.lastTimeToFirstByte;
+#ifdef ENABLE_DEBUG
+		printf("HTTP connect time: %lu ms, time to first byte: %lu ms\n\r", (unsigned long) httpRequestStatsVar.lastConnectTime, (unsigned long) httpRequestStatsVar.lastTimeToFirstByte);
+#endif
+		/* wake up the task which waits for the answer */
+		completeRequestSlot(slot_ptr, responseStatus);
+	}
+
+	return (RC_OK == ret) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function is called by the transport when the
+ * connection to a node is opened or lost. Requests
+ * which are in flight on a lost connection are failed
+ * instead of waiting for their deadline.
+ *
+ * @param[in] node
+ * This variable holds the node of the connection
+ *
+ * @param[in] state
+ * This variable holds the new connection state
+ *
+ * @return
+ * void
+ */
+static void transportStateCallback(uint8_t node, TransportState_T state)
+{
+#ifdef ENABLE_DEBUG
+	printf("JSON RPC transport state of node %u: %d\n\r", (unsigned int) node, (int) state);
+#endif
+	if(TRANSPORT_DISCONNECTED != state) {
+		return;
+	}
+
+	for(uint8_t slot = 0; slot < HTTP_REQUEST_SLOT_MAX; ++slot) {
+		if( (HTTP_REQUEST_PENDING == httpRequestTable[slot].state) && (node == httpRequestTable[slot].node) ) {
+			completeRequestSlot(&httpRequestTable[slot], RETCODE_FAILURE);
+		}
+	}
+}
+
+static TransportCallbacks_T const HttpTransportCallbacks = {
+	transportSentCallback,
+	transportReceivedCallback,
+	transportStateCallback
+};
+
+/**
+ * This function is called to send the json rpc request
+ * which is stored in the payload buffer of a request slot
+ * with the selected transport. The node is selected by
+ * the calls of the request unless the slot was given one.
+ *
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T pushJSONRPCRequest(httpRequestSlot_T *slot_ptr)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+
+#ifdef ENABLE_DEBUG
+	printf("JSON string: \n%s\n\r", slot_ptr->payload);
+#endif
+
+	if(NULL == httpClientHandleVar.transport_ptr) {
+		return ret;
+	}
+
+	selectRequestPolicy(slot_ptr);
+	if(NODE_POOL_NODE_NONE == slot_ptr->node) {
+		selectRequestNode(slot_ptr);
+	} else {
+		/* e.g. a probe of the node - it is only sent to this node */
+		slot_ptr->retryMax = 0;
+#ifdef ENABLE_NODE_POOL
+		slot_ptr->failover = false;
+		slot_ptr->triedNodes = 0;
+#endif
+	}
+
+	/* the response may arrive before the transport returns */
+	slot_ptr->state = HTTP_REQUEST_PENDING;
+	ret = sendRequestSlot(slot_ptr);
+#ifdef ENABLE_NODE_POOL
+	/* the node can not be reached - try the next one */
+	if(RETCODE_SUCCESS != ret) {
+		NodePoolReportFailure(slot_ptr->node);
+		ret = failoverRequest(slot_ptr, false);
+	}
+#endif
+#ifdef ENABLE_DEBUG
+	if(RETCODE_SUCCESS != ret) printf("send json rpc request error\n\r");
+#endif
+
+	return ret;
+}
+#if defined(ENABLE_LOCAL_SIGNING) || defined(ENABLE_READ_CACHE) || defined(ENABLE_NODE_POOL)
+/**
+ * This function sends a node call whose result is handled
+ * inside of this module e.g. the nonce or the block number
+ * and waits for the response
+ *
+ * @param[in] ethMethod
+ * This variable holds the node function which shall be called
+ *
+ * @param[in] payload_ptr
+ * This string holds the parameter of the call. Can be NULL.
+ *
+ * @param[in] node
+ * This variable holds the node the call is sent to without
+ * failover, NODE_POOL_NODE_NONE to let the node pool select it
+ *
+ * @param[in] timeoutMs
+ * Time to wait for the response in ms
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T sendNodeRequest(etherFuncCalls ethMethod, uint8_t const *payload_ptr, uint8_t node, uint32_t timeoutMs)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	httpRequestSlot_T *slot_ptr = allocRequestSlot(1);
+
+	if(NULL == slot_ptr) {
+		return ret;
+	}
+
+	ret = genJSONRequest(ethMethod, "na", "na", payload_ptr, (NULL != payload_ptr) ? strlen(payload_ptr) : 0, slot_ptr->requestID, slot_ptr->payload, sizeof(slot_ptr->payload), &slot_ptr->payload_len);
+	if(RETCODE_SUCCESS == ret) {
+		slot_ptr->results[0].ethMethod = ethMethod;
+		slot_ptr->callCounter = 1;
+		slot_ptr->node = node;
+		ret = pushJSONRPCRequest(slot_ptr);
+	}
+	if(RETCODE_SUCCESS == ret) {
+		ret = HttpRequestWait(slot_ptr->requestID, timeoutMs);
+	}
+	if( (RETCODE_SUCCESS == ret) && (false == slot_ptr->results[0].responseReceived) ) {
+		ret = RETCODE_FAILURE;
+	}
+	HttpRequestRelease(slot_ptr->requestID);
+
+	return ret;
+}
+#endif
+
+#ifdef ENABLE_READ_CACHE
+/**
+ * This function checks if a call is a contract view call
+ * whose result can be cached. It returns the cache key and
+ * the block the result has to be at least as fresh as. The
+ * block number is read from the node if it is older than
+ * READ_CACHE_BLOCK_NUMBER_MAX_AGE_MS.
+ *
+ * @param[in] ethMethod
+ * This variable holds the method which shall be called
+ *
+ * @param[in] senderAddress_ptr
+ * This reference holds the sender ethereum account address
+ *
+ * @param[in] receiverAddress_ptr
+ * This reference holds the contract address
+ *
+ * @param[in] payload_ptr
+ * This reference holds the payload of the call. Can be NULL.
+ *
+ * @param[in] iPayloadLength
+ * This variable holds the length of the payload
+ *
+ * @param[out] oKey_ptr
+ * This reference will hold the cache key
+ *
+ * @param[out] oBlock_ptr
+ * This reference will hold the latest block number
+ *
+ * @param[out] oBlockCurrent_ptr
+ * This reference will hold false if the block number is
+ * outdated. It is read in the same batch as the call then,
+ * the cache can not answer the call.
+ *
+ * @return
+ * true, if the result can be cached<br>
+ * false, otherwise.
+ */
+static bool prepareReadCache(etherFuncCalls ethMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength, ReadCacheKey_T *oKey_ptr, uint64_t *oBlock_ptr, bool *oBlockCurrent_ptr)
+{
+	contractFunction_T const *function_ptr = findContractFunction(ethMethod);
+
+	if( (NULL == function_ptr) || (true == function_ptr->transaction) ||
+		(RETCODE_SUCCESS != ReadCacheMakeKey(receiverAddress_ptr, function_ptr->selector, senderAddress_ptr, payload_ptr, iPayloadLength, oKey_ptr)) ) {
+		return false;
+	}
+
+	/* no extra round trip - an outdated block number is read with the call */
+	*oBlockCurrent_ptr = ReadCacheGetBlockNumber(oBlock_ptr);
+
+	return true;
+}
+
+/**
+ * This function answers a request with a cached result.
+ * The result is handled like a json rpc response and the
+ * request is completed right away.
+ *
+ * @param[in] slot_ptr
+ * This reference holds the slot of the request - its
+ * payload buffer holds the cached result
+ *
+ * @param[in] ethMethod
+ * This variable holds the method of the call
+ *
+ * @param[in] iLength
+ * Length of the cached result
+ *
+ * @return
+ * void
+ */
+static void completeFromReadCache(httpRequestSlot_T *slot_ptr, etherFuncCalls ethMethod, size_t iLength)
+{
+	Retcode_T status = RETCODE_FAILURE;
+	JSONToken_T result;
+
+	result.ptr = slot_ptr->payload;
+	result.length = iLength;
+	result.end_ptr = &slot_ptr->payload[iLength];
+	result.type = JSON_TOKEN_STRING;
+
+	slot_ptr->results[0].ethMethod = ethMethod;
+	slot_ptr->callCounter = 1;
+	status = storeStringResult(&slot_ptr->results[0], &result);
+	slot_ptr->results[0].responseReceived = true;
+
+	slot_ptr->state = HTTP_REQUEST_PENDING;
+	completeRequestSlot(slot_ptr, status);
+}
+#endif /* ENABLE_READ_CACHE */
+
+#ifdef ENABLE_LOCAL_SIGNING
+/**
+ * This function reads the pending transaction count of the
+ * signing account from the node if the local nonce is not
+ * known yet, e.g. after start up or after a transaction
+ * which got no response. Afterwards the transactions are
+ * signed with the local nonce without asking the node.
  *
- * @param[in] iPayloadLength
- * Holds the length of the incoming payload
+ * @param[in] ethMethod
+ * This variable holds the ethereum function which is sent next
  *
  * @return
  * RETCODE_SUCCESS, if successful<br>
  * RETCODE_FAILURE, otherwise.
  */
-Retcode_T genJSONRequest(etherFuncCalls etherMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength)
+static Retcode_T syncTransactionNonce(etherFuncCalls ethMethod)
 {
 	Retcode_T ret = RETCODE_FAILURE;
-	uint8_t const *ethMethod_ptr  = NULL;
-	uint8_t JSONStringBuff[JSON_STRING_BUFF_SIZE] = {0};
-	uint16_t payloadOffset = 0;
-	size_t JSONStringLength = 0;
-
-	/* check for null pointers - payload_pr can be null
-	 * iPayloadLength*2 because we extract two bytes(higher and lower nipple) out of one char */
-	if( (NULL != senderAddress_ptr) && (NULL != receiverAddress_ptr) && \
-			((iPayloadLength * 2 + WRITE_DATA_HASH_HEADER_LEN) <= sizeof(JSONStringBuff)) )
-	{
-		/* choose ethereum method */
-		switch (etherMethod) {
-			case WRITE_DATA_HASH:
-				/* copy func hash and payload length information */
-				strcpy(JSONStringBuff, WRITE_DATA_HASH_HEADER);
-				/* set offset for payload */
-				payloadOffset = WRITE_DATA_HASH_HEADER_LEN;
-				/* convert input character into single bytes
-				 * data encoding */
-				for(uint16_t i = 0, u = 0; u < iPayloadLength; i=i+2, ++u) {
-					snprintf(&JSONStringBuff[payloadOffset + i], 2, "%01x", (payload_ptr[u] >> 4 & 0x0F));
-					snprintf(&JSONStringBuff[payloadOffset + i+1], 2, "%01x", (payload_ptr[u] & 0x0F));
-				}
-				/* set name of ether function call */
-				ethMethod_ptr = "eth_sendTransaction";
-			break;
-			case READ_DATA_HASH:
-				/* copy func hash */
-				strcpy(JSONStringBuff, READ_DATA_HASH_HEADER);
-				/* set name of ether function call */
-				ethMethod_ptr = "eth_call";
-			break;
-			case WRITE_PUBLIC_KEY:
-				/* copy func hash and payload length information */
-				strcpy(JSONStringBuff, WRITE_PUBLIC_KEY_HEADER);
-				/* set offset for payload */
-				payloadOffset = WRITE_PUBLIC_KEY_HEADER_LEN;
-				/* convert input character into single bytes
-				 * data encoding */
-				for(uint16_t i = 0, u = 0; u < iPayloadLength; i=i+2, ++u) {
-					snprintf(&JSONStringBuff[payloadOffset + i], 2, "%01x", (payload_ptr[u] >> 4 & 0x0F));
-					snprintf(&JSONStringBuff[payloadOffset + i+1], 2, "%01x", (payload_ptr[u] & 0x0F));
-				}
-				/* set name of ether function call */
-				ethMethod_ptr = "eth_sendTransaction";
-			break;
-			case READ_PUBLIC_KEY:
-				/* copy func hash */
-				strcpy(JSONStringBuff, READ_PUBLIC_KEY_HEADER);
-				/* set name of ether function call */
-				ethMethod_ptr = "eth_call";
-			break;
-			case RATE_PRODUCER_POSITIVE:
-				/* copy func hash */
-				strcpy(JSONStringBuff, RATE_PRODUCER_POSITIVE_DATA);
-				/* set name of ether function call */
-				ethMethod_ptr = "eth_sendTransaction";
-			break;
-			case RATE_PRODUCER_NEGATIVE:
-				/* copy func hash */
-				strcpy(JSONStringBuff, RATE_PRODUCER_NEGATIVE_DATA);
-				/* set name of ether function call */
-				ethMethod_ptr = "eth_sendTransaction";
-			break;
-			case GET_TRANSACTION_RECEIPT:
-				ethMethod_ptr = "eth_getTransactionReceipt";
-			break;
-			default:
-				printf("Create JSON string input error\n\r");
-			break;
-		}
-
-		/* two dimensional array to store JSON parameters */
-		uint8_t const * ethereum_parameters[10][2] = {
-				{"jsonrpc", JSON_RPC_VERSION},
-				{"method", 	ethMethod_ptr},
-				{"params", 	NULL},
-				{"from", 	senderAddress_ptr},
-				{"to", 		receiverAddress_ptr},
-				{"gas", 	TRANSACTION_EXECUTION_GAS},
-				{"value",	DATA_ETHER_EXCHANGE_RATE},
-				{"data", 	JSONStringBuff},
-				{"latest",	NULL},
-				{"id", NULL}
-		};
-
-		/*create JSON message */
-		cJSON *ethereumCallParameters = NULL;
-		uint8_t *JSONstring = NULL;
-		cJSON *ethereumCall = cJSON_CreateObject();
-
-		/* add parameters to main JSON tree */
-		cJSON_AddStringToObject(ethereumCall, ethereum_parameters[0][0], ethereum_parameters[0][1]);
-		cJSON_AddStringToObject(ethereumCall, ethereum_parameters[1][0], ethereum_parameters[1][1]);
-
-		/* add parameter-Array to main JSON tree */
-		ethereumCallParameters = cJSON_AddArrayToObject(ethereumCall, ethereum_parameters[2][0]);
-
-		if(GET_TRANSACTION_RECEIPT != etherMethod) {
-			cJSON *params_object = cJSON_CreateObject();
-
-			/* create params-Array parameters */
-			cJSON_AddStringToObject(params_object, ethereum_parameters[3][0], ethereum_parameters[3][1]);
-			cJSON_AddStringToObject(params_object, ethereum_parameters[4][0], ethereum_parameters[4][1]);
-			cJSON_AddStringToObject(params_object, ethereum_parameters[5][0], ethereum_parameters[5][1]);
-
-			/* provide ether in value parameter to write public key */
-			if(WRITE_PUBLIC_KEY == etherMethod) {
-				cJSON_AddStringToObject(params_object, ethereum_parameters[6][0], ethereum_parameters[6][1]);
-			}
-			cJSON_AddStringToObject(params_object, ethereum_parameters[7][0], ethereum_parameters[7][1]);
-			/* add params-Array parameters to main tree params object */
-			cJSON_AddItemToArray(ethereumCallParameters, params_object);
-		} else {
-			/* for function getTransactionReceipt only transaction is required as a parameter */
-			cJSON_AddItemToArray(ethereumCallParameters, cJSON_CreateString(payload_ptr));
-		}
-
-		/* add quantity tag only for eth_call
-		 * It is not supported by eth_sendTransaction
-		 * */
-		if( (strncmp(ethMethod_ptr, "eth_call", strlen("eth_call")) == 0) ) {
-			cJSON_AddStringToObject(ethereumCallParameters, "NULL", ethereum_parameters[8][0]);
-		}
+	contractFunction_T const *function_ptr = findContractFunction(ethMethod);
+	uint8_t const *address_ptr = TransactionSignerGetAddress();
 
-		/* add id value to main JSON tree */
-		if(cJSON_AddNumberToObject(ethereumCall, ethereum_parameters[9][0], etherMethod) != NULL) {
-			/* copy created JSON tree into JSON string */
-			JSONstring = cJSON_Print(ethereumCall);
-			JSONStringLength = strlen(JSONstring);
+	if( (NULL == function_ptr) || (false == function_ptr->transaction) || (true == TransactionSignerIsNonceValid()) ) {
+		return RETCODE_SUCCESS;
+	}
+	if(NULL == address_ptr) {
+		return ret;
+	}
 
-			/* reset httpIpHandler payload buffer */
-			memset(httpIpHandleVar_T.payload, 0, sizeof(httpIpHandleVar_T.payload));
+	ret = sendNodeRequest(GET_TRANSACTION_COUNT, address_ptr, NODE_POOL_NODE_NONE, HTTP_REQUEST_DEADLINE_DEFAULT);
 
-			/* copy content and length information into global handler struct */
-			if(sizeof(httpIpHandleVar_T.payload) >= JSONStringLength) {
-				strcpy(httpIpHandleVar_T.payload, JSONstring);
-				httpIpHandleVar_T.payload_len = JSONStringLength;
+	/* the nonce is set by the response */
+	if( (RETCODE_SUCCESS == ret) && (false == TransactionSignerIsNonceValid()) ) {
+		ret = RETCODE_FAILURE;
+	}
 #ifdef ENABLE_DEBUG
-				printf("JSON string: \n%s\n\r", httpIpHandleVar_T.payload);
-#endif
-				ret = RETCODE_SUCCESS;
-			}
-		}
-
-		/* free allocated memory otherwise a stack heap collision
-		 * will occur. JSONstring has to be freed because cJSON_Print
-		 * assignes an allocated pointer to JSONstring */
-		free(JSONstring);
-		cJSON_Delete(ethereumCall);
+	if(RETCODE_SUCCESS != ret) {
+		printf("Transaction nonce could not be read\n\r");
 	}
+#endif
 
 	return ret;
 }
+#endif /* ENABLE_LOCAL_SIGNING */
 
+#ifdef ENABLE_GAS_ESTIMATION
 /**
- * This function is called to parse an incoming json string
+ * This function calls eth_estimateGas for a transaction
+ * if the gas estimator has no current estimate of its
+ * function and argument size. The estimate is stored by
+ * the response. Without response the transaction is sent
+ * with the fallback gas of its function.
+ *
+ * @param[in] ethMethod
+ * This variable holds the ethereum function which is sent next
  *
- * @param[in] monitor_ptr
- * This reference holds the incoming JSON string
+ * @param[in] senderAddress_ptr
+ * This reference holds the sender ethereum account address
  *
- * @param[out] oJSONData_buff
- * This buffer holds the result of the parsed
- * JSON object. The result contains the payload data
- * e.g. the DataHash or the PublicKey in a get function
+ * @param[in] receiverAddress_ptr
+ * This reference holds the contract address
  *
- * @param[in] JSONBuffLength
- * This buffer holds length of the provided buffer.
- * Must be at least the size of the incoming JSON message.
+ * @param[in] payload_ptr
+ * This reference holds the payload of the transaction
  *
- * @param[out] oEthMessageID_ptr
- * This reference will hold the message id of the incoming
- * response from the blockchain
+ * @param[in] iPayloadLength
+ * This variable holds the length of the payload
  *
  * @return
- * RC_OK, if successful<br>
- * RC_MAX_APP_ERROR, otherwise.
+ * void
  */
-retcode_t parseIncomingJSONMessage(const uint8_t *monitor_ptr, uint8_t *oJSONData_buff, size_t JSONBuffLength, etherFuncCalls *oEthMessageID_ptr)
+static void updateGasEstimate(etherFuncCalls ethMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength)
 {
-	retcode_t status = RC_MAX_APP_ERROR;
-	const cJSON *result_ptr = NULL;
-	const cJSON *id_ptr = NULL;
-	const cJSON *status_ptr = NULL;
-
-	/* parse incoming payload */
-	cJSON *monitor_json = cJSON_Parse(monitor_ptr);
-
-	if(NULL != monitor_json) {
-		/* extract result parameter of incoming json string */
-		result_ptr = cJSON_GetObjectItemCaseSensitive(monitor_json, "result");
-		id_ptr = cJSON_GetObjectItemCaseSensitive(monitor_json, "id");
-
-		/* assign ethereum function message id */
-		if(cJSON_IsNumber(id_ptr) ) {
-#ifdef ENABLE_DEBUG
-			printf("JSON MessageID is: %i\n\r", id_ptr->valueint);
+	Retcode_T ret = RETCODE_FAILURE;
+	contractFunction_T const *function_ptr = findContractFunction(ethMethod);
+	httpRequestSlot_T *slot_ptr = NULL;
+	GasEstimatorKey_T key;
+	ABIArgument_T argument;
+
+	if( (NULL == function_ptr) || (false == function_ptr->transaction) || (NULL == senderAddress_ptr) || (NULL == receiverAddress_ptr) ||
+		((ABI_TYPE_BYTES == function_ptr->argType) && (NULL == payload_ptr)) ) {
+		return;
+	}
+	GasEstimatorMakeKey(function_ptr->selector, (ABI_TYPE_BYTES == function_ptr->argType) ? iPayloadLength : 0, &key);
+	if(true == GasEstimatorLookup(&key)) {
+		return;
+	}
+#ifdef ENABLE_LOCAL_SIGNING
+	/* the transaction is sent from the signing account */
+	senderAddress_ptr = TransactionSignerGetAddress();
+	if(NULL == senderAddress_ptr) {
+		return;
+	}
 #endif
-			*oEthMessageID_ptr = id_ptr->valueint;
-		}
 
-		/* for results without JSON array - all functions but GET_TRANSACTION_RECEIPT */
-		if( (cJSON_IsString(result_ptr)) && (result_ptr->valuestring != NULL) ) {
-#ifdef ENABLE_DEBUG
-			printf("Result is: %s\n\r", result_ptr->valuestring);
-#endif
-			/* check if output buffer is big enough to hold
-			 * result data */
-			if(JSONBuffLength >= strlen(result_ptr->valuestring)) {
-				strcpy(oJSONData_buff, result_ptr->valuestring);
-				status = RC_OK;
-			}
-		}
+	slot_ptr = allocRequestSlot(1);
+	if(NULL == slot_ptr) {
+		return;
+	}
 
-		/* if transaction is not confirmed, result contains no string */
-		if( (GET_TRANSACTION_RECEIPT == *oEthMessageID_ptr) && (!(cJSON_IsString(result_ptr->child))) ) {
-#ifdef ENABLE_DEBUG
-			printf("Transaction not confirmed\n\r");
-#endif
-			/* copy NotConfirmed string into result buff */
-			if(JSONBuffLength >= strlen("NotConfirmed")) {
-				strncpy(oJSONData_buff, "NotConfirmed", strlen("NotConfirmed"));
-				status = RC_OK;
-			}
-		}
+	argument.type = function_ptr->argType;
+	argument.data_ptr = payload_ptr;
+	argument.length = (ABI_TYPE_BOOL == function_ptr->argType) ? function_ptr->boolValue : iPayloadLength;
+
+	JSONWriterInit(&slot_ptr->writer, slot_ptr->payload, sizeof(slot_ptr->payload));
+	JSONWriterBeginObject(&slot_ptr->writer);
+	JSONWriterKey(&slot_ptr->writer, "jsonrpc");
+	JSONWriterString(&slot_ptr->writer, JSON_RPC_VERSION);
+	JSONWriterKey(&slot_ptr->writer, "method");
+	JSONWriterString(&slot_ptr->writer, "eth_estimateGas");
+	JSONWriterKey(&slot_ptr->writer, "params");
+	JSONWriterBeginArray(&slot_ptr->writer);
+	ret = writeCallObject(&slot_ptr->writer, function_ptr, senderAddress_ptr, receiverAddress_ptr, &argument, 0);
+	JSONWriterEndArray(&slot_ptr->writer);
+	JSONWriterKey(&slot_ptr->writer, "id");
+	JSONWriterNumber(&slot_ptr->writer, slot_ptr->requestID);
+	JSONWriterEndObject(&slot_ptr->writer);
+	if(RETCODE_SUCCESS == ret) {
+		ret = JSONWriterFinish(&slot_ptr->writer, &slot_ptr->payload_len);
+	}
 
-		/* if transaction is confirmed, result contains a string - status indicates if transaction was successful */
-		if( (GET_TRANSACTION_RECEIPT == *oEthMessageID_ptr) && (cJSON_IsString(result_ptr->child)) ) {
-			status_ptr = cJSON_GetObjectItemCaseSensitive(result_ptr, "status");
+	if(RETCODE_SUCCESS == ret) {
+		slot_ptr->results[0].ethMethod = ESTIMATE_GAS;
+		slot_ptr->callCounter = 1;
+		slot_ptr->gasKey[0] = key;
+		ret = pushJSONRPCRequest(slot_ptr);
+	}
+	if(RETCODE_SUCCESS == ret) {
+		ret = HttpRequestWait(slot_ptr->requestID, HTTP_REQUEST_DEADLINE_DEFAULT);
+	}
+	/* e.g. the transaction would revert - it is sent anyway like without estimation */
+	if( (RETCODE_SUCCESS != ret) || (false == slot_ptr->results[0].responseReceived) ) {
+		GasEstimatorReportFailure(&key);
 #ifdef ENABLE_DEBUG
-			printf("Transaction confirmed with status %s\n\r",status_ptr->valuestring);
-#endif
-			/* if transaction was successfull, status is equal to 0x1 */
-			if(strncmp(status_ptr->valuestring, "0x1", strlen("0x1")) == 0) {
-				/* copy confirm string and status into result buff */
-				if( JSONBuffLength >= strlen("Confirmed0x1") ) {
-					strncpy(oJSONData_buff, "Confirmed0x1", strlen("Confirmed0x1"));
-					status = RC_OK;
-				}
-			} else {
-				/* copy confirm string and status into result buff */
-				if( JSONBuffLength >= strlen("Confirmed0x0") ) {
-					strncpy(oJSONData_buff, "Confirmed0x0", strlen("Confirmed0x0"));
-					status = RC_OK;
-				}
-			}
-		}
+		printf("Gas could not be estimated\n\r");
+#endif
 	}
-
-	/* free cJSON objects */
-	cJSON_Delete(monitor_json);
-
-	return status;
+	HttpRequestRelease(slot_ptr->requestID);
 }
+#endif /* ENABLE_GAS_ESTIMATION */
 
 /**
- * This function is called when a response to
- * an outgoing request is received.
+ * This function is called to send a json rpc call with
+ * its own request slot. Several requests can be in flight
+ * at the same time, each one is completed separately.
+ *
+ * @param[in] ethMethod
+ * This enum variable holds the method which shall be called.
+ *
+ * @param[in] senderAddress_ptr
+ * This reference holds the sender ethereum account address
  *
- * @param[in] httpSession_ptr
- * This reference holds all the information of
- * the HttpSession. Unused here.
+ * @param[in] receiverAddress_ptr
+ * This reference holds the receiver ethereum account address
  *
- * @param[in] msg_ptr
- * This reference holds all the context information
- * of the current Http message
+ * @param[in] payload_ptr
+ * This reference holds the payload which will be send
+ * to the smart contract e.g. data hash or public key.
  *
- * @param[in] status
- * This variable holds the status of the incoming
- * message.
+ * @param[in] iPayloadLength
+ * This variable holds the length of the incoming payload data
+ *
+ * @param[out] oRequestID_ptr
+ * This reference will hold the id of the request which is
+ * passed to HttpRequestWait, HttpRequestGetResult and
+ * HttpRequestRelease
  *
  * @return
- * RC_OK, if successful<br>
- * RC_MAX_APP_ERROR, otherwise.
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
  */
-static retcode_t httpResponseReceivedCallback(HttpSession_T *httpSession_ptr, Msg_T *msg_ptr, retcode_t status)
+Retcode_T HttpRequestSend(etherFuncCalls ethMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength, HttpRequestID_T *oRequestID_ptr)
 {
-    uint8_t JSONStringBuff[JSON_STRING_BUFF_SIZE] = { 0 };
-    uint8_t JSONPubKeyResultBuff[READ_PUB_KEY_JSON_RESULT_DATA_LENGTH] = { 0 };
-    uint8_t JSONConsumerAccountAddressResultBuff[READ_ETH_ACCOUNT_ADDRESS_RESULT_LENGTH] = { 0 };
-    uint8_t JSONDataHashResultBuff[READ_DATA_HASH_JSON_RESULT_DATA_LENGTH] = { 0 };
-
-    retcode_t ret = RC_MAX_APP_ERROR;
-    etherFuncCalls ethMessageID = UNDEFINED;
-
-    if(RC_OK == status && msg_ptr != NULL) {
-    	/* get http status codes e.g. Http_StatusCode_OK (200) */
-    	Http_StatusCode_T statusCode = HttpMsg_getStatusCode(msg_ptr);
-
-    	/* get http content type e.g. Http_ContentType_Text_Html */
-    	uint8_t const *contentType = HttpMsg_getContentType(msg_ptr);
-
-    	uint8_t const *content_ptr;
-    	unsigned int contentLength = 0;
+	Retcode_T ret = RETCODE_FAILURE;
+	httpRequestSlot_T *slot_ptr = NULL;
+#ifdef ENABLE_READ_CACHE
+	ReadCacheKey_T cacheKey;
+	uint64_t cacheBlock = 0;
+	bool cacheable = false;
+	bool cacheBlockCurrent = false;
+	size_t cacheLength = 0;
+#endif
 
-    	HttpMsg_getContent(msg_ptr, &content_ptr, &contentLength);
-    	/* create array of size content length + 1 */
-    	uint8_t content[contentLength + 1];
-    	memcpy(content, content_ptr, contentLength);
-    	/* add null termination at the end of the content string */
-    	content[contentLength] = 0;
+	if(NULL == oRequestID_ptr) {
+		return ret;
+	}
 
-#ifdef ENABLE_DEBUG
-    	printf("HTTP response: %d [%s]\n\r", statusCode, contentType);
-    	printf("%s\n\r", content);
-    	printf("Content length: %i\n\r", contentLength);
+#ifdef ENABLE_LOCAL_SIGNING
+	if(RETCODE_SUCCESS != syncTransactionNonce(ethMethod)) {
+		return ret;
+	}
 #endif
-    	/* parse incoming JSON request */
-    	ret = parseIncomingJSONMessage(content, JSONStringBuff, sizeof(JSONStringBuff), &ethMessageID);
-
-    	/* call function dependent on message id */
-    	switch (ethMessageID) {
-			case READ_DATA_HASH:
-				/* read and convert data hash */
-				memset(SEEDConsumerDataHashBuffer, 0, sizeof(SEEDConsumerDataHashBuffer));
-				strncpy(JSONDataHashResultBuff, &JSONStringBuff[READ_DATA_HASH_JSON_RESULT_OFFSET], READ_DATA_HASH_JSON_RESULT_DATA_LENGTH);
-				convertCharToHex(JSONDataHashResultBuff, READ_DATA_HASH_JSON_RESULT_DATA_LENGTH, SEEDConsumerDataHashBuffer);
-#ifdef ENABLE_DEBUG
-				printf("SEEDConsumerDataHashBuffer result: \n%s\n\r", SEEDConsumerDataHashBuffer);
+#ifdef ENABLE_GAS_ESTIMATION
+	updateGasEstimate(ethMethod, senderAddress_ptr, receiverAddress_ptr, payload_ptr, iPayloadLength);
 #endif
-			break;
-			case READ_PUBLIC_KEY:
-				/* read and convert public key */
-				/* reset the public key buffer */
-				memset(SEEDCroducerPublicKeyBuffer, 0, sizeof(SEEDCroducerPublicKeyBuffer));
-				/* copy JSON result string into JSON result buff*/
-				strncpy(JSONPubKeyResultBuff, &JSONStringBuff[READ_PUBLIC_KEY_JSON_RESULT_OFFSET], READ_PUB_KEY_JSON_RESULT_DATA_LENGTH);
-				/* decode JSON and write public key into pk-buffer*/
-				convertCharToHex(JSONPubKeyResultBuff, READ_PUB_KEY_JSON_RESULT_DATA_LENGTH, SEEDCroducerPublicKeyBuffer);
-#ifdef ENABLE_DEBUG
-				printf("SEEDCroducerPublicKeyBuffer result: \n%s\n\r", SEEDCroducerPublicKeyBuffer);
-#endif
-				/* read consumer account address */
-				/* reset the account address buffer */
-				memset(SEEDEtherAccountAddressBuffer, 0, sizeof(SEEDEtherAccountAddressBuffer));
-				/* copy JSON result string into JSON result buff*/
-				strncpy(JSONConsumerAccountAddressResultBuff, &JSONStringBuff[READ_ETH_ACCOUNT_ADDR_JSON_RESULT_OFFSET], READ_ETH_ACCOUNT_ADDRESS_RESULT_LENGTH);
-				/* add 0x in front of address */
-				strcpy(SEEDEtherAccountAddressBuffer, "0x");
-				/* copy consumer account address to global buffer */
-				strncat(SEEDEtherAccountAddressBuffer, JSONConsumerAccountAddressResultBuff, READ_ETH_ACCOUNT_ADDRESS_RESULT_LENGTH);
-#ifdef ENABLE_DEBUG
-				printf("SEEDEtherAccountAddressBuffer: %s\n\r", SEEDEtherAccountAddressBuffer);
+#ifdef ENABLE_READ_CACHE
+	cacheable = prepareReadCache(ethMethod, senderAddress_ptr, receiverAddress_ptr, payload_ptr, iPayloadLength, &cacheKey, &cacheBlock, &cacheBlockCurrent);
+	/* the id of eth_blockNumber follows the id of the call */
+	slot_ptr = allocRequestSlot(((true == cacheable) && (false == cacheBlockCurrent)) ? 2 : 1);
+#else
+	slot_ptr = allocRequestSlot(1);
 #endif
-				/* push consumer information into authentication array - shift old information upwards */
-				strncpy(AuthenticatedConsumerTable[2].consumerPublicKey, AuthenticatedConsumerTable[1].consumerPublicKey, READ_PUB_KEY_RESULT_LENGTH);
-				strncpy(AuthenticatedConsumerTable[2].accountAddress, AuthenticatedConsumerTable[1].accountAddress, READ_ETH_ACCOUNT_ADDRESS_RESULT_DATA_LENGTH);
-				AuthenticatedConsumerTable[2].activeConsumer = AuthenticatedConsumerTable[1].activeConsumer;
-
-				strncpy(AuthenticatedConsumerTable[1].consumerPublicKey, AuthenticatedConsumerTable[0].consumerPublicKey, READ_PUB_KEY_RESULT_LENGTH);
-				strncpy(AuthenticatedConsumerTable[1].accountAddress, AuthenticatedConsumerTable[0].accountAddress, READ_ETH_ACCOUNT_ADDRESS_RESULT_DATA_LENGTH);
-				AuthenticatedConsumerTable[1].activeConsumer = AuthenticatedConsumerTable[0].activeConsumer;
-
-				strncpy(AuthenticatedConsumerTable[0].consumerPublicKey, SEEDCroducerPublicKeyBuffer, READ_PUB_KEY_RESULT_LENGTH);
-				strncpy(AuthenticatedConsumerTable[0].accountAddress, SEEDEtherAccountAddressBuffer, READ_ETH_ACCOUNT_ADDRESS_RESULT_DATA_LENGTH);
-			break;
-			case GET_TRANSACTION_RECEIPT:
-				/* check if transaction is mined/confirmed - if status is bad then transaction
-				 * is considered as unconfirmed because we have to send it again
-				 * */
-				if(strncmp(JSONStringBuff, "Confirmed0x1", strlen("Confirmed0x1")) == 0) {
-					TransactionConfirmed = true;
-				} else {
-					TransactionConfirmed = false;
-				}
-			break;
-			case WRITE_DATA_HASH:
-			case WRITE_PUBLIC_KEY:
-				/* for state changing functions store transaction hash so confirmation function can be called */
-				memset(SEEDTransactionHashBuffer, 0, sizeof(SEEDTransactionHashBuffer));
-				strncpy(SEEDTransactionHashBuffer, JSONStringBuff, TRANSACTION_HASH_RESULT_LENGTH);
+	if(NULL == slot_ptr) {
 #ifdef ENABLE_DEBUG
-				printf("Transaction hash: %s\n\r", SEEDTransactionHashBuffer);
+		printf("No free http request slot\n\r");
 #endif
-			break;
-			default:
-				/* do nothing */
-			break;
-    	}
+		return ret;
+	}
 
-    	/* set flag to true if answer is available in buffer */
-    	HttpResponseCallbackReceivedFlag = true;
+#ifdef ENABLE_READ_CACHE
+	if(true == cacheable) {
+		/* the payload buffer is not needed for a cache hit */
+		if( (true == cacheBlockCurrent) && (true == ReadCacheLookup(&cacheKey, cacheBlock, slot_ptr->payload, sizeof(slot_ptr->payload), &cacheLength)) ) {
+			*oRequestID_ptr = slot_ptr->requestID;
+			completeFromReadCache(slot_ptr, ethMethod, cacheLength);
+			return RETCODE_SUCCESS;
+		}
+		slot_ptr->readCacheStore = true;
+		slot_ptr->readCacheBlockCall = !cacheBlockCurrent;
+		slot_ptr->readCacheKey = cacheKey;
+		slot_ptr->readCacheBlock = cacheBlock;
+	}
+#endif
 
-    	/* print received data */
-    	if( (RC_OK == ret) && (Http_StatusCode_OK == statusCode) ) {
-    		//good
-    	}
-#ifdef ENABLE_DEBUG
-    	else {
-    		printf("JSON parser result buffer to small\n\r");
-    	}
+	/* create the outgoing JSON string - the slot keeps the gas limit of a transaction */
+	JSONWriterInit(&slot_ptr->writer, slot_ptr->payload, sizeof(slot_ptr->payload));
+	ret = RETCODE_SUCCESS;
+#ifdef ENABLE_READ_CACHE
+	if(true == slot_ptr->readCacheBlockCall) {
+		/* batch of eth_blockNumber and the view call - the block number
+		 * is sent first so the result is cached for it */
+		JSONWriterBeginArray(&slot_ptr->writer);
+		ret = writeRequestCall(&slot_ptr->writer, BLOCK_NUMBER, "na", "na", NULL, 0, slot_ptr->requestID + 1, 0);
+	}
 #endif
-    }
-#ifdef ENABLE_DEBUG
-    else {
-    	printf("httpResponseReceivedCallback failed!\n\r");
-    }
+	if(RETCODE_SUCCESS == ret) {
+		ret = writeRequestCall(&slot_ptr->writer, ethMethod, senderAddress_ptr, receiverAddress_ptr, payload_ptr, iPayloadLength, slot_ptr->requestID,
+				getTransactionGasLimit(slot_ptr, 0, ethMethod, iPayloadLength));
+	}
+#ifdef ENABLE_READ_CACHE
+	if(true == slot_ptr->readCacheBlockCall) {
+		JSONWriterEndArray(&slot_ptr->writer);
+	}
 #endif
+	if(RETCODE_SUCCESS == ret) {
+		ret = JSONWriterFinish(&slot_ptr->writer, &slot_ptr->payload_len);
+	}
 
-    /* explicitly close the current http session */
-    HttpPool_close(httpSession_ptr);
-    HttpPool_delete(httpSession_ptr);
+	if(RETCODE_SUCCESS == ret) {
+		slot_ptr->results[0].ethMethod = ethMethod;
+		slot_ptr->callCounter = 1;
+#ifdef ENABLE_READ_CACHE
+		if(true == slot_ptr->readCacheBlockCall) {
+			slot_ptr->results[1].ethMethod = BLOCK_NUMBER;
+			slot_ptr->callCounter = 2;
+		}
+#endif
+		*oRequestID_ptr = slot_ptr->requestID;
+		ret = pushJSONRPCRequest(slot_ptr);
+	}
+	if(RETCODE_SUCCESS != ret) {
+		HttpRequestRelease(slot_ptr->requestID);
+	}
 
-    return ret;
+	return ret;
 }
 
 /**
- * This function is called when the request is
- * finished/sent.
+ * This function is called to send a Http request.
+ * It creates the JSON string of the call and sends
+ * it to the json-rpc node. The calling task waits for
+ * it with WaitForHttpReceiveCallback, results are stored
+ * in the global buffers.
  *
- * @param[in] callfunc_ptr
- * This reference holds the Callable context
+ * @param[in] ethMethod
+ * This enum variable holds the method which shall be called.
+ * You can choose between four function calls which are
+ * supported by the smart contract and passed as a string:
+ *	WRITE_DATA_HASH = 0,
+ *	READ_DATA_HASH,
+ *	WRITE_PUBLIC_KEY,
+ *	READ_PUBLIC_KEY,
+ *	RATE_PRODUCER_POSITIVE,
+ *	RATE_PRODUCER_NEGATIVE,
+ *	GET_TRANSACTION_RECEIPT,
  *
- * @param[in] status
- * This variable holds the sent message status of the
- * request.
+ * @param[in] senderAddress_ptr
+ * This reference holds the sender ethereum account address
+ *
+ * @param[in] receiverAddress_ptr
+ * This reference holds the receiver ethereum account address
+ *
+ * @param[in] payload_ptr
+ * This reference holds the payload which will be send
+ * to the smart contract e.g. data hash or public key.
+ *
+ * @param[in] iPayloadLength
+ * This variable holds the length of the incoming payload data
  *
  * @return
- * RC_OK, if successful<br>
- * RC_MAX_APP_ERROR, otherwise.
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
  */
-static retcode_t HttpRequestSentCallback(Callable_T *callfunc_ptr, retcode_t status)
+Retcode_T sendHttpDLTClientRequest(etherFuncCalls ethMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength)
 {
-	/* surpress warning message concerning unused variable */
-    (void) callfunc_ptr;
+	Retcode_T ret = RETCODE_FAILURE;
+	HttpRequestID_T requestID = HTTP_REQUEST_ID_INVALID;
+	httpRequestSlot_T *slot_ptr = findTaskRequestSlot();
 
-#ifdef ENABLE_DEBUG
-    if(RC_OK != status) {
-    	printf("Failed to send HTTP request!\n\r");
-    } else {
-    	printf("HTTP request sent!\n\r");
-    }
-#else
-    (void) status;
-#endif
+	/* a request of this task which was never waited for is dropped */
+	if(NULL != slot_ptr) {
+		HttpRequestRelease(slot_ptr->requestID);
+	}
+
+	ret = HttpRequestSend(ethMethod, senderAddress_ptr, receiverAddress_ptr, payload_ptr, iPayloadLength, &requestID);
+
+	if(RETCODE_SUCCESS == ret) {
+		/* remember the request so WaitForHttpReceiveCallback of this task finds it */
+		slot_ptr = findRequestSlot(requestID);
+		if(NULL != slot_ptr) {
+			slot_ptr->ownerTask = xTaskGetCurrentTaskHandle();
+		}
+	}
 
-    return status;
+	return ret;
 }
 
 /**
- * This function is called for serializing
- * a part of an outgoing message.
+ * This function is called to start collecting a batch
+ * request. All calls added with HttpBatchAdd are sent
+ * as one JSON array in a single http round trip.
  *
- * @param[in] handover_ptr
- * This reference holds the data for the serializer.
- * If the data is too large this function will serialize
- * and append the remaining data to the message.
+ * @param[out] oRequestID_ptr
+ * This reference will hold the id of the batch request
  *
  * @return
- * RC_OK, if successful<br>
- * RC_MAX_APP_ERROR, otherwise.
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
  */
-retcode_t writeNextPartToBuffer(OutMsgSerializationHandover_T* handover_ptr)
+Retcode_T HttpBatchBegin(HttpRequestID_T *oRequestID_ptr)
 {
-	retcode_t ret = RC_MAX_APP_ERROR;
-	size_t payloadLength = httpIpHandleVar_T.payload_len;
-	uint16_t alreadySerialized = handover_ptr->offset;
-	uint16_t remainingLength = payloadLength - alreadySerialized;
-	uint16_t bytesToCopy = 0;
-
-	/* if whole message is serialized */
-	if(remainingLength <= handover_ptr->bufLen) {
-		bytesToCopy = remainingLength;
-		ret = RC_OK;
-	/* if the message is not fully serialized return incomplete
-	 * and serialize the data segment which fits into the buffer
-	 * */
-	} else {
-		bytesToCopy = handover_ptr->bufLen;
-		ret = RC_MSG_FACTORY_INCOMPLETE;
+	httpRequestSlot_T *slot_ptr = NULL;
+
+	if(NULL == oRequestID_ptr) {
+		return RETCODE_FAILURE;
+	}
+
+	/* reserve one id per possible call */
+	slot_ptr = allocRequestSlot(HTTP_BATCH_REQUEST_MAX);
+	if(NULL == slot_ptr) {
+		return RETCODE_FAILURE;
 	}
 
-	memcpy(handover_ptr->buf_ptr, httpIpHandleVar_T.payload + alreadySerialized, bytesToCopy);
-	/* set offset for next data chunk */
-	handover_ptr->offset = alreadySerialized + bytesToCopy;
-	/* set number of written bytes */
-	handover_ptr->len = bytesToCopy;
+	/* the JSON array is written directly into the payload buffer of the slot */
+	JSONWriterInit(&slot_ptr->writer, slot_ptr->payload, sizeof(slot_ptr->payload));
+	JSONWriterBeginArray(&slot_ptr->writer);
+	*oRequestID_ptr = slot_ptr->requestID;
 
-    return ret;
+	return RETCODE_SUCCESS;
 }
 
 /**
- * This function is called to send a Http request.
- * It sets the receiver with Http port and ip address.
- * It sets the request method option e.g. post or get
- * and sends the payload.
+ * This function is called to add one json rpc call
+ * to a batch request. Each call gets its own JSON RPC
+ * id so the response can be routed back to it.
+ *
+ * @param[in] requestID
+ * This variable holds the id returned by HttpBatchBegin
  *
  * @param[in] ethMethod
  * This enum variable holds the method which shall be called.
- * You can choose between four function calls which are
- * supported by the smart contract and passed as a string:
- *	WRITE_DATA_HASH = 0,
- *	READ_DATA_HASH,
- *	WRITE_PUBLIC_KEY,
- *	READ_PUBLIC_KEY,
- *	RATE_PRODUCER_POSITIVE,
- *	RATE_PRODUCER_NEGATIVE,
- *	GET_TRANSACTION_RECEIPT,
  *
  * @param[in] senderAddress_ptr
  * This reference holds the sender ethereum account address
@@ -770,73 +2986,103 @@ retcode_t writeNextPartToBuffer(OutMsgSerializationHandover_T* handover_ptr)
  * This reference holds the receiver ethereum account address
  *
  * @param[in] payload_ptr
- * This reference holds the payload which will be send
- * to the smart contract e.g. data hash or public key.
+ * This reference holds the payload of the call
+ * e.g. the transaction hash for GET_TRANSACTION_RECEIPT
  *
  * @param[in] iPayloadLength
  * This variable holds the length of the incoming payload data
  *
+ * @param[out] oBatchSlot_ptr
+ * This reference will hold the slot of the call which is
+ * passed to HttpRequestGetResult after the response arrived
+ *
  * @return
  * RETCODE_SUCCESS, if successful<br>
  * RETCODE_FAILURE, otherwise.
  */
-Retcode_T sendHttpDLTClientRequest(etherFuncCalls ethMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength)
+Retcode_T HttpBatchAdd(HttpRequestID_T requestID, etherFuncCalls ethMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength, uint8_t *oBatchSlot_ptr)
 {
-	static Callable_T sentCallableHttp;
-	Msg_T *msg_ptr = 0;
 	Retcode_T ret = RETCODE_FAILURE;
-	Ip_Address_T destIPAddr = 0;
-	Ip_Port_T destIPPort = 0;
+	httpRequestSlot_T *slot_ptr = findRequestSlot(requestID);
 
-	/* reset global callback response received flag */
-	HttpResponseCallbackReceivedFlag = false;
+	if( (NULL != slot_ptr) && (HTTP_REQUEST_PREPARING == slot_ptr->state) && (NULL != oBatchSlot_ptr) && (HTTP_BATCH_REQUEST_MAX > slot_ptr->callCounter) ) {
+#ifdef ENABLE_LOCAL_SIGNING
+		if(RETCODE_SUCCESS != syncTransactionNonce(ethMethod)) {
+			return ret;
+		}
+#endif
+#ifdef ENABLE_GAS_ESTIMATION
+		updateGasEstimate(ethMethod, senderAddress_ptr, receiverAddress_ptr, payload_ptr, iPayloadLength);
+#endif
+		ret = writeRequestCall(&slot_ptr->writer, ethMethod, senderAddress_ptr, receiverAddress_ptr, payload_ptr, iPayloadLength, requestID + slot_ptr->callCounter,
+				getTransactionGasLimit(slot_ptr, slot_ptr->callCounter, ethMethod, iPayloadLength));
 
-	/* convert ip address and port */
-	Ip_convertStringToAddr(HTTP_IP_ADDRESS, &destIPAddr);
-	destIPPort = Ip_convertIntToPort(HTTP_PORT);
+		if(RETCODE_SUCCESS == ret) {
+			slot_ptr->results[slot_ptr->callCounter].ethMethod = ethMethod;
+			*oBatchSlot_ptr = slot_ptr->callCounter;
+			slot_ptr->callCounter++;
+		}
+	}
 
-	/* call this function to create the outgoing JSON string */
-	genJSONRequest(ethMethod, senderAddress_ptr, receiverAddress_ptr, payload_ptr, iPayloadLength);
+	return ret;
+}
 
-	ret = HttpClient_initRequest(&destIPAddr, destIPPort, &msg_ptr);
+/**
+ * This function is called to send a collected batch
+ * request. Wait for the response with HttpRequestWait
+ * and read the single results with HttpRequestGetResult.
+ *
+ * @param[in] requestID
+ * This variable holds the id returned by HttpBatchBegin
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T HttpBatchSend(HttpRequestID_T requestID)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	httpRequestSlot_T *slot_ptr = findRequestSlot(requestID);
 
-	if(RETCODE_SUCCESS == ret) {
-		/* prepare http header */
-		HttpMsg_setReqMethod(msg_ptr, Http_Method_Post);
-		HttpMsg_setContentType(msg_ptr, Http_ContentType_App_Json);
-		HttpMsg_setReqUrl(msg_ptr, DESTINATION_POST_PATH);
-		HttpMsg_setHost(msg_ptr, HOST_ADDRESS);
+	if( (NULL == slot_ptr) || (HTTP_REQUEST_PREPARING != slot_ptr->state) ) {
+		return ret;
+	}
 
-		if(RETCODE_SUCCESS == ret) {
-			/* add a function to the message factory which serializes the buffer data
-			 * Here we use the global handle struct to process the payload
-			 * */
-			ret = TcpMsg_prependPartFactory(msg_ptr, &writeNextPartToBuffer);
+	if(0 < slot_ptr->callCounter) {
+		JSONWriterEndArray(&slot_ptr->writer);
+		ret = JSONWriterFinish(&slot_ptr->writer, &slot_ptr->payload_len);
+	}
 
-#ifdef ENABLE_DEBUG
-			printf("TcpMsg_prependPartFactory\n\r");
-#endif
+	if(RETCODE_SUCCESS == ret) {
+		ret = pushJSONRPCRequest(slot_ptr);
+	}
+	if(RETCODE_SUCCESS != ret) {
+		HttpRequestRelease(requestID);
+	}
 
-			if(RETCODE_SUCCESS == ret) {
-				/* start sending the request by assign the function to the callable
-				 * HttpClient_pushRequest expects a callable object as a parameter */
-				Callable_assign(&sentCallableHttp, &HttpRequestSentCallback);
+	return ret;
+}
 
-				/* push the request */
-				ret = HttpClient_pushRequest(msg_ptr, &sentCallableHttp, &httpResponseReceivedCallback);
-#ifdef ENABLE_DEBUG
-				if(RETCODE_SUCCESS == ret) {
-					printf("Send http request successful\n\r");
-				} else {
-					printf("Error during send http request: %i\n\r", ret);
-				}
-#endif
-			}
-		}
+#ifdef ENABLE_NODE_POOL
+/**
+ * This function sends eth_blockNumber to one node without
+ * failover. The node pool uses it to measure the latency
+ * of idle nodes and to find out if an unhealthy node is
+ * back.
+ *
+ * @param[in] node
+ * This variable holds the index of the node
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T HttpProbeNode(uint8_t node)
+{
+	if( (NodePoolGetCount() <= node) || (NULL == httpClientHandleVar.transport_ptr) || (false == httpClientHandleVar.transport_ptr->nodePool) ) {
+		return RETCODE_FAILURE;
 	}
-#ifdef ENABLE_DEBUG
-	if(RETCODE_SUCCESS != ret) printf("send http request error\n\r");
-#endif
 
-	return ret;
+	return sendNodeRequest(BLOCK_NUMBER, NULL, node, NODE_POOL_FAILOVER_TIME_MS);
 }
+#endif
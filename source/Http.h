@@ -10,6 +10,8 @@
 #define SOURCE_HTTP_H_
 
 #include "SystemConfig.h"
+#include "Transport.h"
+#include "JSONReader.h"
 
 /* enum type which represents the blockchain function calls */
 typedef enum {
@@ -20,16 +22,100 @@ typedef enum {
 	RATE_PRODUCER_POSITIVE = 5,
 	RATE_PRODUCER_NEGATIVE = 6,
 	GET_TRANSACTION_RECEIPT = 7,
+	NEW_BLOCK_FILTER = 8,
+	GET_FILTER_CHANGES = 9,
+	GET_TRANSACTION_COUNT = 10,
+	BLOCK_NUMBER = 11,
+	SUBSCRIBE = 12,
+	ESTIMATE_GAS = 13,
+	UNINSTALL_FILTER = 14,
 	UNDEFINED = 0xFF
 } etherFuncCalls;
 
+/* highest valid ethereum function - used to size the per function tables */
+#define ETHER_FUNC_CALLS_MAX	UNINSTALL_FILTER
+
+/* maximum number of json rpc calls which are sent in one batch request */
+#define HTTP_BATCH_REQUEST_MAX	4
+
+/* maximum number of http requests which can be in flight at the same time.
+ * Http.c provides one part factory per request slot */
+#define HTTP_REQUEST_SLOT_MAX	3
+
+/* size of the json rpc payload buffer of one request slot */
+#define HTTP_REQUEST_PAYLOAD_SIZE	2048
+
+/* handle of a request in the request table - equal to the JSON RPC id
+ * of its first call. Ids are increasing and never reused. */
+typedef uint32_t HttpRequestID_T;
+#define HTTP_REQUEST_ID_INVALID	0
+
+/* timeout of HttpRequestWait which selects the deadline of the called
+ * ethereum functions e.g. HTTP_READ_DEADLINE_MS for reads */
+#define HTTP_REQUEST_DEADLINE_DEFAULT	0
+
+/* result of one json rpc call of a request */
+typedef struct HttpCallResult_S {
+	etherFuncCalls ethMethod;
+	bool responseReceived;
+	bool transactionConfirmed;
+	bool errorReceived;				/* the node answered with a json rpc error - result holds its message */
+	uint16_t resultElementCounter;	/* number of elements of an array result e.g. new block hashes */
+	uint8_t result[TRANSACTION_HASH_RESULT_LENGTH + 1];
+} HttpCallResult_T;
+
+/* timing counters of the json-rpc http client - all times in milliseconds */
+typedef struct HttpRequestStats_S {
+	uint32_t requestCounter;
+	uint32_t connectionCounter;
+	uint32_t lastConnectTime;
+	uint32_t lastTimeToFirstByte;
+	uint32_t totalConnectTime;
+	uint32_t totalTimeToFirstByte;
+} HttpRequestStats_T;
+
+/* number of latency histogram buckets - the upper bounds in milliseconds
+ * are 10, 20, 50, 100, 200, 500, 1000, 2000, the last bucket holds all
+ * slower responses */
+#define HTTP_LATENCY_BUCKET_COUNT	9
+
+/* response latency histogram of one ethereum function - all times in milliseconds */
+typedef struct HttpLatencyHistogram_S {
+	uint32_t bucket[HTTP_LATENCY_BUCKET_COUNT];
+	uint32_t responseCounter;
+	uint32_t timeoutCounter;
+	uint32_t retryCounter;		/* attempts which were sent again after a lost response */
+	uint32_t maxLatency;
+	uint32_t totalLatency;
+} HttpLatencyHistogram_T;
+
+/* callback of the subscription notifications - gets the subscription
+ * id and the result e.g. the header of a new block */
+typedef void (*HttpSubscriptionCallback_T)(JSONToken_T const *subscription_ptr, JSONToken_T const *result_ptr);
+
 /* control declaration for external variable */
 extern uint8_t SEEDConsumerDataHashBuffer[READ_DATA_HASH_RESULT_LENGTH];
 
 /* global interface function declarations */
 Retcode_T sendHttpDLTClientRequest(etherFuncCalls ethMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength);
-Retcode_T genJSONRequest(etherFuncCalls etherMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength);
+Retcode_T genJSONRequest(etherFuncCalls etherMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength, uint32_t messageID, uint8_t *oBuff, size_t buffSize, size_t *oLength_ptr);
+Retcode_T HttpInit(void);
+Retcode_T HttpSetTransport(Transport_T const *transport_ptr);
+Transport_T const *HttpGetTransport(void);
+void HttpSetSubscriptionCallback(HttpSubscriptionCallback_T callback);
+Retcode_T HttpWaitForResponse(uint32_t timeoutMs);
 Retcode_T WaitForHttpReceiveCallback(void);
 bool WaitForTransactionConfirmation(void);
+void HttpGetRequestStats(HttpRequestStats_T *oStats_ptr);
+Retcode_T HttpGetLatencyHistogram(etherFuncCalls ethMethod, HttpLatencyHistogram_T *oHistogram_ptr);
+Retcode_T HttpRequestSend(etherFuncCalls ethMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength, HttpRequestID_T *oRequestID_ptr);
+Retcode_T HttpRequestWait(HttpRequestID_T requestID, uint32_t timeoutMs);
+Retcode_T HttpRequestGetResult(HttpRequestID_T requestID, uint8_t callIndex, HttpCallResult_T *oResult_ptr);
+void HttpRequestRelease(HttpRequestID_T requestID);
+Retcode_T HttpRequestCancel(HttpRequestID_T requestID);
+Retcode_T HttpBatchBegin(HttpRequestID_T *oRequestID_ptr);
+Retcode_T HttpBatchAdd(HttpRequestID_T requestID, etherFuncCalls ethMethod, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *payload_ptr, size_t iPayloadLength, uint8_t *oBatchSlot_ptr);
+Retcode_T HttpBatchSend(HttpRequestID_T requestID);
+Retcode_T HttpProbeNode(uint8_t node);
 
 #endif /* SOURCE_COAP_H_ */
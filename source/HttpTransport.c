@@ -0,0 +1,648 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <string.h>
+#include "BCDS_WlanConnect.h"
+#include "BCDS_NetworkConfig.h"
+#include "PAL_initialize_ih.h"
+#include "PAL_socketMonitor_ih.h"
+#include "Serval_HttpClient.h"
+#include "Serval_Network.h"
+#include "PIp.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* user includes */
+#include "HttpTransport.h"
+#include "Http.h"
+#include "NodePool.h"
+#include "UserConfig.h"
+#include "SystemConfig.h"
+
+/* request line and headers of every request with a four digit content
+ * length - without the host name of the node. The response headers are
+ * not visible through the Serval api, only the response content is counted. */
+#define HTTP_TRANSPORT_REQUEST_HEADER	"POST " DESTINATION_POST_PATH " HTTP/1.1\r\nHost: " \
+										"\r\nContent-Type: application/json\r\nContent-Length: 0000\r\n\r\n"
+
+/* a cancelled entry stays used until Serval is done with its message,
+ * so every request slot can have a second entry e.g. for a retry */
+#define HTTP_TRANSPORT_ENTRY_MAX	(2 * HTTP_REQUEST_SLOT_MAX)
+
+/**
+ * This struct holds one request which is handed to the
+ * Serval http client. The payload is serialized from the
+ * buffer of the request slot when the message is sent.
+ * A cancelled entry is freed by the sent or the response
+ * callback - its payload buffer may be reused meanwhile,
+ * so it is not serialized anymore.
+ */
+typedef struct httpTransportEntry_S {
+	bool used;
+	bool cancelled;
+	uint8_t node;
+	uint32_t requestID;
+	uint8_t const *payload_ptr;
+	size_t payload_len;
+	Msg_T *msg_ptr;
+	Callable_T sentCallable;
+} httpTransportEntry_T;
+static httpTransportEntry_T httpTransportTable[HTTP_TRANSPORT_ENTRY_MAX];
+
+/**
+ * This handler struct holds the http sessions to the
+ * json-rpc nodes which are kept open between requests
+ */
+typedef struct httpTransportHandler_S {
+	TransportCallbacks_T const *callbacks_ptr;
+	HttpSession_T *session_ptr[NODE_POOL_ENDPOINT_MAX];
+	bool reconnect[NODE_POOL_ENDPOINT_MAX];
+	bool initialized;
+} httpTransportHandler_T;
+static httpTransportHandler_T httpTransportHandleVar = {0};
+
+/* connection, message and byte counters */
+static TransportStats_T httpTransportStatsVar = {0};
+
+/**
+ * This function closes the given http session and
+ * releases it in the Serval http pool. The next request
+ * will open a new connection to the json-rpc node.
+ *
+ * @param[in] httpSession_ptr
+ * This reference holds the session which should be closed
+ *
+ * @return
+ * void
+ */
+static void closeHttpSession(HttpSession_T *httpSession_ptr)
+{
+	if(NULL != httpSession_ptr) {
+		HttpPool_close(httpSession_ptr);
+		HttpPool_delete(httpSession_ptr);
+	}
+	for(uint8_t node = 0; node < NODE_POOL_ENDPOINT_MAX; ++node) {
+		if(httpSession_ptr == httpTransportHandleVar.session_ptr[node]) {
+			httpTransportHandleVar.session_ptr[node] = NULL;
+		}
+	}
+}
+
+/**
+ * This function returns the entry of a request and
+ * frees it. Used when the request is answered or failed.
+ *
+ * @param[in] msg_ptr
+ * This reference holds the http message of the request
+ *
+ * @param[in] callfunc_ptr
+ * This reference holds the sent callable of the request.
+ * Used if msg_ptr is NULL.
+ *
+ * @param[out] oNode_ptr
+ * This reference will hold the node of the entry
+ *
+ * @param[out] oRequestID_ptr
+ * This reference will hold the request id of the entry
+ *
+ * @return
+ * true, if an entry which was not cancelled was found<br>
+ * false, otherwise.
+ */
+static bool releaseTransportEntry(Msg_T const *msg_ptr, Callable_T const *callfunc_ptr, uint8_t *oNode_ptr, uint32_t *oRequestID_ptr)
+{
+	bool found = false;
+
+	taskENTER_CRITICAL();
+	for(uint8_t entry = 0; entry < HTTP_TRANSPORT_ENTRY_MAX; ++entry) {
+		httpTransportEntry_T *entry_ptr = &httpTransportTable[entry];
+		if( (true == entry_ptr->used) && (((NULL != msg_ptr) && (msg_ptr == entry_ptr->msg_ptr)) || ((NULL == msg_ptr) && (callfunc_ptr == &entry_ptr->sentCallable))) ) {
+			*oNode_ptr = entry_ptr->node;
+			*oRequestID_ptr = entry_ptr->requestID;
+			found = (false == entry_ptr->cancelled);
+			entry_ptr->used = false;
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return found;
+}
+
+/**
+ * This function is called when a response to
+ * an outgoing request is received.
+ *
+ * @param[in] httpSession_ptr
+ * This reference holds all the information of
+ * the HttpSession.
+ *
+ * @param[in] msg_ptr
+ * This reference holds all the context information
+ * of the current Http message
+ *
+ * @param[in] status
+ * This variable holds the status of the incoming
+ * message.
+ *
+ * @return
+ * RC_OK, if successful<br>
+ * RC_MAX_APP_ERROR, otherwise.
+ */
+static retcode_t httpResponseReceivedCallback(HttpSession_T *httpSession_ptr, Msg_T *msg_ptr, retcode_t status)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	bool keepSession = false;
+	uint8_t node = NODE_POOL_NODE_NONE;
+	uint32_t requestID = TRANSPORT_REQUEST_NONE;
+
+	/* a cancelled request is not reported - its entry was freed
+	 * by the sent callback or is freed now */
+	if(false == releaseTransportEntry(msg_ptr, NULL, &node, &requestID)) {
+		closeHttpSession(httpSession_ptr);
+		return RC_OK;
+	}
+
+	if(RC_OK == status && msg_ptr != NULL) {
+		/* get http status codes e.g. Http_StatusCode_OK (200) */
+		Http_StatusCode_T statusCode = HttpMsg_getStatusCode(msg_ptr);
+
+		/* get http content type e.g. Http_ContentType_Text_Html */
+		uint8_t const *contentType = HttpMsg_getContentType(msg_ptr);
+
+		uint8_t const *content_ptr;
+		unsigned int contentLength = 0;
+
+		/* the content is parsed in place - it is not null terminated
+		 * so only the content length is used to read it */
+		HttpMsg_getContent(msg_ptr, &content_ptr, &contentLength);
+
+#ifdef ENABLE_DEBUG
+		printf("HTTP response: %d [%s]\n\r", statusCode, contentType);
+		printf("%.*s\n\r", (int) contentLength, content_ptr);
+		printf("Content length: %i\n\r", contentLength);
+#else
+		(void) contentType;
+#endif
+		httpTransportStatsVar.messageReceivedCounter++;
+		httpTransportStatsVar.bytesReceived += contentLength;
+
+		ret = httpTransportHandleVar.callbacks_ptr->received(node, requestID, content_ptr, contentLength);
+
+		if( (RETCODE_SUCCESS == ret) && (Http_StatusCode_OK == statusCode) ) {
+			/* node answered properly so the session can be used again */
+			keepSession = true;
+		}
+	} else {
+#ifdef ENABLE_DEBUG
+		printf("httpResponseReceivedCallback failed!\n\r");
+#endif
+		/* no answer - do not let the caller wait for it */
+		(void) httpTransportHandleVar.callbacks_ptr->received(node, requestID, NULL, 0);
+	}
+
+#ifdef ENABLE_HTTP_KEEP_ALIVE
+	/* keep the session open for the next request, Serval hands it
+	 * out again for the same destination in HttpClient_initRequest */
+	if( (true == keepSession) && (NODE_POOL_ENDPOINT_MAX > node) ) {
+		httpTransportHandleVar.session_ptr[node] = httpSession_ptr;
+	} else {
+		closeHttpSession(httpSession_ptr);
+	}
+#else
+	/* explicitly close the current http session */
+	(void) keepSession;
+	closeHttpSession(httpSession_ptr);
+#endif
+
+	return (RETCODE_SUCCESS == ret) ? RC_OK : RC_MAX_APP_ERROR;
+}
+
+/**
+ * This function is called when the request is
+ * finished/sent.
+ *
+ * @param[in] callfunc_ptr
+ * This reference holds the Callable context. It is
+ * the sent callable of the transport entry.
+ *
+ * @param[in] status
+ * This variable holds the sent message status of the
+ * request.
+ *
+ * @return
+ * RC_OK, if successful<br>
+ * RC_MAX_APP_ERROR, otherwise.
+ */
+static retcode_t HttpRequestSentCallback(Callable_T *callfunc_ptr, retcode_t status)
+{
+	uint8_t node = NODE_POOL_NODE_NONE;
+	uint32_t requestID = TRANSPORT_REQUEST_NONE;
+	httpTransportEntry_T *entry_ptr = NULL;
+
+	for(uint8_t entry = 0; entry < HTTP_TRANSPORT_ENTRY_MAX; ++entry) {
+		if( (true == httpTransportTable[entry].used) && (callfunc_ptr == &httpTransportTable[entry].sentCallable) ) {
+			entry_ptr = &httpTransportTable[entry];
+			break;
+		}
+	}
+
+	if( (RC_OK != status) || ((NULL != entry_ptr) && (true == entry_ptr->cancelled)) ) {
+		/* no answer will arrive or it is not reported - the payload
+		 * is not serialized anymore, so the entry can be freed */
+		if(true == releaseTransportEntry(NULL, callfunc_ptr, &node, &requestID)) {
+			/* connection could not be used - open a new one next time */
+			httpTransportHandleVar.reconnect[node] = true;
+			httpTransportHandleVar.callbacks_ptr->sent(node, requestID, RETCODE_FAILURE);
+		}
+	} else if(NULL != entry_ptr) {
+		httpTransportHandleVar.callbacks_ptr->sent(entry_ptr->node, entry_ptr->requestID, RETCODE_SUCCESS);
+	}
+
+#ifdef ENABLE_DEBUG
+	if(RC_OK != status) {
+		printf("Failed to send HTTP request!\n\r");
+	} else {
+		printf("HTTP request sent!\n\r");
+	}
+#endif
+
+	return status;
+}
+
+/**
+ * This function is called for serializing
+ * a part of an outgoing message.
+ *
+ * @param[in] entry_ptr
+ * This reference holds the transport entry whose payload
+ * is serialized
+ *
+ * @param[in] handover_ptr
+ * This reference holds the data for the serializer.
+ * If the data is too large this function will serialize
+ * and append the remaining data to the message.
+ *
+ * @return
+ * RC_OK, if successful<br>
+ * RC_MAX_APP_ERROR, otherwise.
+ */
+static retcode_t writeEntryPayloadToBuffer(httpTransportEntry_T const *entry_ptr, OutMsgSerializationHandover_T* handover_ptr)
+{
+	retcode_t ret = RC_MAX_APP_ERROR;
+	size_t payloadLength = entry_ptr->payload_len;
+	uint16_t alreadySerialized = handover_ptr->offset;
+	uint16_t remainingLength = payloadLength - alreadySerialized;
+	uint16_t bytesToCopy = 0;
+
+	/* the payload buffer of a cancelled request may hold the next request */
+	if( (false == entry_ptr->used) || (true == entry_ptr->cancelled) ) {
+		return RC_MAX_APP_ERROR;
+	}
+
+	/* if whole message is serialized */
+	if(remainingLength <= handover_ptr->bufLen) {
+		bytesToCopy = remainingLength;
+		ret = RC_OK;
+	/* if the message is not fully serialized return incomplete
+	 * and serialize the data segment which fits into the buffer
+	 * */
+	} else {
+		bytesToCopy = handover_ptr->bufLen;
+		ret = RC_MSG_FACTORY_INCOMPLETE;
+	}
+
+	memcpy(handover_ptr->buf_ptr, entry_ptr->payload_ptr + alreadySerialized, bytesToCopy);
+	/* set offset for next data chunk */
+	handover_ptr->offset = alreadySerialized + bytesToCopy;
+	/* set number of written bytes */
+	handover_ptr->len = bytesToCopy;
+
+	return ret;
+}
+
+/* the serializer gets no context - one part factory per transport entry */
+#if (HTTP_TRANSPORT_ENTRY_MAX != 6)
+#error "provide one part factory per http transport entry"
+#endif
+static retcode_t writeNextPartToBuffer0(OutMsgSerializationHandover_T* handover_ptr)
+{
+	return writeEntryPayloadToBuffer(&httpTransportTable[0], handover_ptr);
+}
+
+static retcode_t writeNextPartToBuffer1(OutMsgSerializationHandover_T* handover_ptr)
+{
+	return writeEntryPayloadToBuffer(&httpTransportTable[1], handover_ptr);
+}
+
+static retcode_t writeNextPartToBuffer2(OutMsgSerializationHandover_T* handover_ptr)
+{
+	return writeEntryPayloadToBuffer(&httpTransportTable[2], handover_ptr);
+}
+
+static retcode_t writeNextPartToBuffer3(OutMsgSerializationHandover_T* handover_ptr)
+{
+	return writeEntryPayloadToBuffer(&httpTransportTable[3], handover_ptr);
+}
+
+static retcode_t writeNextPartToBuffer4(OutMsgSerializationHandover_T* handover_ptr)
+{
+	return writeEntryPayloadToBuffer(&httpTransportTable[4], handover_ptr);
+}
+
+static retcode_t writeNextPartToBuffer5(OutMsgSerializationHandover_T* handover_ptr)
+{
+	return writeEntryPayloadToBuffer(&httpTransportTable[5], handover_ptr);
+}
+
+/**
+ * This function initializes the Serval http client
+ *
+ * @param[in] callbacks_ptr
+ * This reference holds the callbacks of the json rpc client
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T httpTransportInit(TransportCallbacks_T const *callbacks_ptr)
+{
+	Retcode_T ret = RETCODE_SUCCESS;
+
+	if(NULL == callbacks_ptr) {
+		return RETCODE_FAILURE;
+	}
+	httpTransportHandleVar.callbacks_ptr = callbacks_ptr;
+
+	if(false == httpTransportHandleVar.initialized) {
+		ret = HttpClient_initialize();
+		httpTransportHandleVar.initialized = (RETCODE_SUCCESS == ret);
+	}
+
+	return ret;
+}
+
+/**
+ * This function is called to send a json rpc request.
+ * It sets the receiver with Http port and ip address of
+ * the node, sets the request method option and pushes
+ * the request.
+ *
+ * @param[in] node
+ * This variable holds the node of the node pool
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @param[in] payload_ptr
+ * This reference holds the json rpc request
+ *
+ * @param[in] iLength
+ * This variable holds the length of the request
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T httpTransportSend(uint8_t node, uint32_t requestID, uint8_t const *payload_ptr, size_t iLength)
+{
+	Msg_T *msg_ptr = 0;
+	Retcode_T ret = RETCODE_FAILURE;
+	Ip_Address_T destIPAddr = 0;
+	Ip_Port_T destIPPort = 0;
+	httpTransportEntry_T *entry_ptr = NULL;
+	NodePoolEndpoint_T const *endpoint_ptr = NodePoolGetEndpoint(node);
+
+	if( (NULL == endpoint_ptr) || (NODE_POOL_ENDPOINT_MAX <= node) ) {
+		return ret;
+	}
+
+	taskENTER_CRITICAL();
+	for(uint8_t entry = 0; entry < HTTP_TRANSPORT_ENTRY_MAX; ++entry) {
+		if(false == httpTransportTable[entry].used) {
+			entry_ptr = &httpTransportTable[entry];
+			entry_ptr->used = true;
+			entry_ptr->cancelled = false;
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if(NULL == entry_ptr) {
+		return ret;
+	}
+	entry_ptr->node = node;
+	entry_ptr->requestID = requestID;
+	entry_ptr->payload_ptr = payload_ptr;
+	entry_ptr->payload_len = iLength;
+	entry_ptr->msg_ptr = NULL;
+
+	/* convert ip address and port */
+	Ip_convertStringToAddr(endpoint_ptr->address_ptr, &destIPAddr);
+	destIPPort = Ip_convertIntToPort(endpoint_ptr->port);
+
+	/* drop a session which failed during the last request
+	 * so HttpClient_initRequest connects again */
+	if(true == httpTransportHandleVar.reconnect[node]) {
+		closeHttpSession(httpTransportHandleVar.session_ptr[node]);
+		httpTransportHandleVar.reconnect[node] = false;
+	}
+	/* no open session available - a new connection is established */
+	if(NULL == httpTransportHandleVar.session_ptr[node]) {
+		httpTransportStatsVar.connectionCounter++;
+	}
+
+	ret = HttpClient_initRequest(&destIPAddr, destIPPort, &msg_ptr);
+
+	if(RETCODE_SUCCESS == ret) {
+		/* prepare http header */
+		HttpMsg_setReqMethod(msg_ptr, Http_Method_Post);
+		HttpMsg_setContentType(msg_ptr, Http_ContentType_App_Json);
+		HttpMsg_setReqUrl(msg_ptr, DESTINATION_POST_PATH);
+		HttpMsg_setHost(msg_ptr, endpoint_ptr->host_ptr);
+
+		/* add a function to the message factory which serializes the
+		 * payload buffer of the request */
+		switch (entry_ptr - httpTransportTable) {
+			case 0:
+				ret = TcpMsg_prependPartFactory(msg_ptr, &writeNextPartToBuffer0);
+			break;
+			case 1:
+				ret = TcpMsg_prependPartFactory(msg_ptr, &writeNextPartToBuffer1);
+			break;
+			case 2:
+				ret = TcpMsg_prependPartFactory(msg_ptr, &writeNextPartToBuffer2);
+			break;
+			case 3:
+				ret = TcpMsg_prependPartFactory(msg_ptr, &writeNextPartToBuffer3);
+			break;
+			case 4:
+				ret = TcpMsg_prependPartFactory(msg_ptr, &writeNextPartToBuffer4);
+			break;
+			case 5:
+				ret = TcpMsg_prependPartFactory(msg_ptr, &writeNextPartToBuffer5);
+			break;
+			default:
+				ret = RETCODE_FAILURE;
+			break;
+		}
+
+#ifdef ENABLE_DEBUG
+		printf("TcpMsg_prependPartFactory\n\r");
+#endif
+
+		if(RETCODE_SUCCESS == ret) {
+			/* the response may arrive before HttpClient_pushRequest returns */
+			entry_ptr->msg_ptr = msg_ptr;
+			httpTransportStatsVar.messageSentCounter++;
+			httpTransportStatsVar.bytesSent += iLength + sizeof(HTTP_TRANSPORT_REQUEST_HEADER) - 1 + strlen(endpoint_ptr->host_ptr);
+
+			/* start sending the request by assign the function to the callable
+			 * HttpClient_pushRequest expects a callable object as a parameter */
+			Callable_assign(&entry_ptr->sentCallable, &HttpRequestSentCallback);
+
+			/* push the request */
+			ret = HttpClient_pushRequest(msg_ptr, &entry_ptr->sentCallable, &httpResponseReceivedCallback);
+#ifdef ENABLE_DEBUG
+			if(RETCODE_SUCCESS == ret) {
+				printf("Send http request successful\n\r");
+			} else {
+				printf("Error during send http request: %i\n\r", ret);
+			}
+#endif
+		}
+	}
+	if(RETCODE_SUCCESS != ret) {
+#ifdef ENABLE_DEBUG
+		printf("send http request error\n\r");
+#endif
+		entry_ptr->used = false;
+	}
+
+	return ret;
+}
+
+/**
+ * This function returns the connection state. Without
+ * an open session the next request connects again.
+ *
+ * @return
+ * connected, if a session to any node is open
+ */
+static TransportState_T httpTransportGetState(void)
+{
+	for(uint8_t node = 0; node < NODE_POOL_ENDPOINT_MAX; ++node) {
+		if(NULL != httpTransportHandleVar.session_ptr[node]) {
+			return TRANSPORT_CONNECTED;
+		}
+	}
+
+	return TRANSPORT_DISCONNECTED;
+}
+
+/**
+ * This function marks the session to a node as broken,
+ * e.g. if the node did not answer. The next request to
+ * the node connects again, its requests which were not
+ * answered are cancelled.
+ *
+ * @param[in] node
+ * This variable holds the node of the node pool
+ *
+ * @return
+ * void
+ */
+static void httpTransportDisconnect(uint8_t node)
+{
+	if(NODE_POOL_ENDPOINT_MAX <= node) {
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	httpTransportHandleVar.reconnect[node] = true;
+	for(uint8_t entry = 0; entry < HTTP_TRANSPORT_ENTRY_MAX; ++entry) {
+		if( (true == httpTransportTable[entry].used) && (node == httpTransportTable[entry].node) ) {
+			httpTransportTable[entry].cancelled = true;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * This function forgets one request, e.g. after its
+ * deadline expired. A late answer is not reported and the
+ * session of the node is opened again with the next request
+ * so it is not blocked by the request. The entry is freed
+ * by the Serval callbacks. The other requests to the node
+ * are not affected.
+ *
+ * @param[in] node
+ * This variable holds the node of the node pool
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @return
+ * void
+ */
+static void httpTransportCancel(uint8_t node, uint32_t requestID)
+{
+	if(NODE_POOL_ENDPOINT_MAX <= node) {
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	for(uint8_t entry = 0; entry < HTTP_TRANSPORT_ENTRY_MAX; ++entry) {
+		if( (true == httpTransportTable[entry].used) && (node == httpTransportTable[entry].node) && (requestID == httpTransportTable[entry].requestID) ) {
+			httpTransportTable[entry].cancelled = true;
+			httpTransportHandleVar.reconnect[node] = true;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * This function copies the counters of the transport
+ *
+ * @param[out] oStats_ptr
+ * This reference will hold the counter values
+ *
+ * @return
+ * void
+ */
+static void httpTransportGetStats(TransportStats_T *oStats_ptr)
+{
+	if(NULL != oStats_ptr) {
+		*oStats_ptr = httpTransportStatsVar;
+	}
+}
+
+static const Transport_T HttpTransport = {
+	"http",
+	true,
+	httpTransportInit,
+	httpTransportSend,
+	httpTransportGetState,
+	httpTransportDisconnect,
+	httpTransportCancel,
+	httpTransportGetStats
+};
+
+/**
+ * This function returns the transport which sends every
+ * json rpc request as http post with the Serval http client
+ *
+ * @return
+ * reference of the transport
+ */
+Transport_T const *HttpTransportGet(void)
+{
+	return &HttpTransport;
+}
@@ -0,0 +1,337 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <string.h>
+#include "BCDS_Basics.h"
+
+/* user includes */
+#include "JSONReader.h"
+
+/**
+ * This function skips the whitespace characters in
+ * front of the next JSON token
+ *
+ * @param[in] data_ptr
+ * This reference holds the current read position
+ *
+ * @param[in] end_ptr
+ * This reference points behind the last readable byte
+ *
+ * @return
+ * position of the next non whitespace character
+ */
+static uint8_t const *skipWhitespace(uint8_t const *data_ptr, uint8_t const *end_ptr)
+{
+	while( (data_ptr < end_ptr) && ((' ' == *data_ptr) || ('\t' == *data_ptr) || ('\r' == *data_ptr) || ('\n' == *data_ptr)) ) {
+		data_ptr++;
+	}
+
+	return data_ptr;
+}
+
+/**
+ * This function skips a JSON string. The read position
+ * must point to the opening quote.
+ *
+ * @param[in] data_ptr
+ * This reference holds the position of the opening quote
+ *
+ * @param[in] end_ptr
+ * This reference points behind the last readable byte
+ *
+ * @return
+ * position behind the closing quote, NULL if the string is not terminated
+ */
+static uint8_t const *skipString(uint8_t const *data_ptr, uint8_t const *end_ptr)
+{
+	/* step over opening quote */
+	data_ptr++;
+	while(data_ptr < end_ptr) {
+		if('\\' == *data_ptr) {
+			/* escaped character is never the end of the string */
+			data_ptr += 2;
+		} else if('"' == *data_ptr) {
+			return data_ptr + 1;
+		} else {
+			data_ptr++;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * This function reads the JSON value at the current read
+ * position. Objects and arrays are skipped as a whole by
+ * counting their nesting level.
+ *
+ * @param[in] data_ptr
+ * This reference holds the current read position
+ *
+ * @param[in] end_ptr
+ * This reference points behind the last readable byte
+ *
+ * @param[out] oToken_ptr
+ * This reference will hold the token of the value
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T readValue(uint8_t const *data_ptr, uint8_t const *end_ptr, JSONToken_T *oToken_ptr)
+{
+	uint8_t const *start_ptr = skipWhitespace(data_ptr, end_ptr);
+	uint32_t depth = 0;
+
+	memset(oToken_ptr, 0, sizeof(JSONToken_T));
+	if(start_ptr >= end_ptr) {
+		return RETCODE_FAILURE;
+	}
+	data_ptr = start_ptr;
+
+	switch (*start_ptr) {
+		case '"':
+			data_ptr = skipString(start_ptr, end_ptr);
+			if(NULL == data_ptr) {
+				return RETCODE_FAILURE;
+			}
+			oToken_ptr->type = JSON_TOKEN_STRING;
+			oToken_ptr->ptr = start_ptr + 1;
+			oToken_ptr->length = (size_t) (data_ptr - start_ptr) - 2;
+			oToken_ptr->end_ptr = data_ptr;
+			return RETCODE_SUCCESS;
+		break;
+		case '{':
+		case '[':
+			oToken_ptr->type = ('{' == *start_ptr) ? JSON_TOKEN_OBJECT : JSON_TOKEN_ARRAY;
+			while(data_ptr < end_ptr) {
+				if('"' == *data_ptr) {
+					data_ptr = skipString(data_ptr, end_ptr);
+					if(NULL == data_ptr) {
+						return RETCODE_FAILURE;
+					}
+					continue;
+				}
+				if( ('{' == *data_ptr) || ('[' == *data_ptr) ) {
+					depth++;
+				} else if( ('}' == *data_ptr) || (']' == *data_ptr) ) {
+					depth--;
+				}
+				data_ptr++;
+				if(0 == depth) {
+					break;
+				}
+			}
+			if(0 != depth) {
+				return RETCODE_FAILURE;
+			}
+		break;
+		default:
+			/* numbers and the literals true, false and null */
+			oToken_ptr->type = ( ('-' == *start_ptr) || (('0' <= *start_ptr) && ('9' >= *start_ptr)) ) ? JSON_TOKEN_NUMBER : JSON_TOKEN_LITERAL;
+			while( (data_ptr < end_ptr) && (',' != *data_ptr) && ('}' != *data_ptr) && (']' != *data_ptr)
+					&& (' ' != *data_ptr) && ('\t' != *data_ptr) && ('\r' != *data_ptr) && ('\n' != *data_ptr) ) {
+				data_ptr++;
+			}
+		break;
+	}
+
+	oToken_ptr->ptr = start_ptr;
+	oToken_ptr->length = (size_t) (data_ptr - start_ptr);
+	oToken_ptr->end_ptr = data_ptr;
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function reads the JSON value at the beginning of
+ * a buffer. The buffer does not have to be null terminated.
+ *
+ * @param[in] buff_ptr
+ * This reference holds the JSON data e.g. the content of a
+ * http response
+ *
+ * @param[in] iLength
+ * Length of the JSON data
+ *
+ * @param[out] oToken_ptr
+ * This reference will hold the token of the value
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T JSONReaderParse(uint8_t const *buff_ptr, size_t iLength, JSONToken_T *oToken_ptr)
+{
+	if( (NULL == buff_ptr) || (NULL == oToken_ptr) ) {
+		return RETCODE_FAILURE;
+	}
+
+	return readValue(buff_ptr, buff_ptr + iLength, oToken_ptr);
+}
+
+/**
+ * This function searches the value of a key in a JSON
+ * object. Only the direct members of the object are compared.
+ *
+ * @param[in] object_ptr
+ * This reference holds the token of the object
+ *
+ * @param[in] key_ptr
+ * This string holds the key to search for
+ *
+ * @param[out] oValue_ptr
+ * This reference will hold the token of the value
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T JSONReaderGetMember(JSONToken_T const *object_ptr, uint8_t const *key_ptr, JSONToken_T *oValue_ptr)
+{
+	JSONToken_T key;
+	uint8_t const *data_ptr = NULL;
+	uint8_t const *end_ptr = NULL;
+
+	if( (NULL == object_ptr) || (NULL == key_ptr) || (NULL == oValue_ptr) || (JSON_TOKEN_OBJECT != object_ptr->type) ) {
+		return RETCODE_FAILURE;
+	}
+
+	/* read between the braces of the object */
+	data_ptr = object_ptr->ptr + 1;
+	end_ptr = object_ptr->end_ptr - 1;
+
+	while(data_ptr < end_ptr) {
+		if( (RETCODE_SUCCESS != readValue(data_ptr, end_ptr, &key)) || (JSON_TOKEN_STRING != key.type) ) {
+			break;
+		}
+		data_ptr = skipWhitespace(key.end_ptr, end_ptr);
+		if( (data_ptr >= end_ptr) || (':' != *data_ptr) ) {
+			break;
+		}
+		if(RETCODE_SUCCESS != readValue(data_ptr + 1, end_ptr, oValue_ptr)) {
+			break;
+		}
+		if(true == JSONReaderStringEquals(&key, key_ptr)) {
+			return RETCODE_SUCCESS;
+		}
+		/* continue with the next member */
+		data_ptr = skipWhitespace(oValue_ptr->end_ptr, end_ptr);
+		if( (data_ptr >= end_ptr) || (',' != *data_ptr) ) {
+			break;
+		}
+		data_ptr++;
+	}
+
+	memset(oValue_ptr, 0, sizeof(JSONToken_T));
+
+	return RETCODE_FAILURE;
+}
+
+/**
+ * This function reads the next element of a JSON array.
+ * Set ioElement_ptr->ptr to NULL to read the first element.
+ *
+ * @param[in] array_ptr
+ * This reference holds the token of the array
+ *
+ * @param[in,out] ioElement_ptr
+ * This reference holds the previous element and will hold
+ * the next one
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, if there are no more elements.
+ */
+Retcode_T JSONReaderNextElement(JSONToken_T const *array_ptr, JSONToken_T *ioElement_ptr)
+{
+	uint8_t const *data_ptr = NULL;
+	uint8_t const *end_ptr = NULL;
+
+	if( (NULL == array_ptr) || (NULL == ioElement_ptr) || (JSON_TOKEN_ARRAY != array_ptr->type) ) {
+		return RETCODE_FAILURE;
+	}
+
+	/* read between the brackets of the array */
+	end_ptr = array_ptr->end_ptr - 1;
+	if(NULL == ioElement_ptr->ptr) {
+		data_ptr = array_ptr->ptr + 1;
+	} else {
+		data_ptr = skipWhitespace(ioElement_ptr->end_ptr, end_ptr);
+		if( (data_ptr >= end_ptr) || (',' != *data_ptr) ) {
+			return RETCODE_FAILURE;
+		}
+		data_ptr++;
+	}
+
+	return readValue(data_ptr, end_ptr, ioElement_ptr);
+}
+
+/**
+ * This function converts a JSON number token into
+ * an unsigned integer value. Values which do not fit
+ * into 32 bits are rejected.
+ *
+ * @param[in] token_ptr
+ * This reference holds the token of the number
+ *
+ * @param[out] oValue_ptr
+ * This reference will hold the converted value
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T JSONReaderGetUint(JSONToken_T const *token_ptr, uint32_t *oValue_ptr)
+{
+	uint32_t value = 0;
+	uint32_t digit = 0;
+
+	if( (NULL == token_ptr) || (NULL == oValue_ptr) || (JSON_TOKEN_NUMBER != token_ptr->type) || (0 == token_ptr->length) ) {
+		return RETCODE_FAILURE;
+	}
+
+	for(size_t i = 0; i < token_ptr->length; ++i) {
+		if( ('0' > token_ptr->ptr[i]) || ('9' < token_ptr->ptr[i]) ) {
+			return RETCODE_FAILURE;
+		}
+		digit = token_ptr->ptr[i] - '0';
+		/* values above UINT32_MAX would silently wrap around */
+		if(value > ((UINT32_MAX - digit) / 10)) {
+			return RETCODE_FAILURE;
+		}
+		value = (value * 10) + digit;
+	}
+	*oValue_ptr = value;
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function compares a JSON string token with
+ * a null terminated string
+ *
+ * @param[in] token_ptr
+ * This reference holds the token of the string
+ *
+ * @param[in] string_ptr
+ * This string holds the value to compare with
+ *
+ * @return
+ * true, if the token is a string with the same content<br>
+ * false, otherwise.
+ */
+bool JSONReaderStringEquals(JSONToken_T const *token_ptr, uint8_t const *string_ptr)
+{
+	if( (NULL == token_ptr) || (NULL == string_ptr) || (JSON_TOKEN_STRING != token_ptr->type) ) {
+		return false;
+	}
+
+	return ( (strlen(string_ptr) == token_ptr->length) && (0 == memcmp(token_ptr->ptr, string_ptr, token_ptr->length)) );
+}
@@ -0,0 +1,43 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_JSONREADER_H_
+#define SOURCE_JSONREADER_H_
+
+/* type of a JSON value found by the reader */
+typedef enum JSONTokenType_E {
+	JSON_TOKEN_INVALID = 0,
+	JSON_TOKEN_OBJECT,
+	JSON_TOKEN_ARRAY,
+	JSON_TOKEN_STRING,
+	JSON_TOKEN_NUMBER,
+	JSON_TOKEN_LITERAL,
+} JSONTokenType_T;
+
+/**
+ * token which references one JSON value inside the
+ * parsed buffer. Nothing is copied - ptr and length point
+ * into the input data. For strings ptr/length describe the
+ * content without the quotes, escape sequences are not resolved.
+ * end_ptr points behind the last character of the value.
+ */
+typedef struct JSONToken_S {
+	uint8_t const *ptr;
+	size_t length;
+	uint8_t const *end_ptr;
+	JSONTokenType_T type;
+} JSONToken_T;
+
+/* global interface function declarations */
+Retcode_T JSONReaderParse(uint8_t const *buff_ptr, size_t iLength, JSONToken_T *oToken_ptr);
+Retcode_T JSONReaderGetMember(JSONToken_T const *object_ptr, uint8_t const *key_ptr, JSONToken_T *oValue_ptr);
+Retcode_T JSONReaderNextElement(JSONToken_T const *array_ptr, JSONToken_T *ioElement_ptr);
+Retcode_T JSONReaderGetUint(JSONToken_T const *token_ptr, uint32_t *oValue_ptr);
+bool JSONReaderStringEquals(JSONToken_T const *token_ptr, uint8_t const *string_ptr);
+
+#endif /* SOURCE_JSONREADER_H_ */
@@ -0,0 +1,597 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <string.h>
+#include "BCDS_Basics.h"
+
+/* user includes */
+#include "JSONWriter.h"
+#include "HexCodec.h"
+
+/**
+ * This function copies raw bytes into the output buffer.
+ * One byte is always kept free for the null termination.
+ * If the data does not fit, the writer is marked as
+ * overflowed and all following writes are ignored.
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] data_ptr
+ * This reference holds the bytes to write
+ *
+ * @param[in] iLength
+ * Number of bytes to write
+ *
+ * @return
+ * void
+ */
+static void writeBytes(JSONWriter_T *writer_ptr, uint8_t const *data_ptr, size_t iLength)
+{
+	if(false == writer_ptr->overflow) {
+		if( (writer_ptr->length + iLength) < writer_ptr->buffSize ) {
+			memcpy(&writer_ptr->buff_ptr[writer_ptr->length], data_ptr, iLength);
+			writer_ptr->length += iLength;
+		} else {
+			writer_ptr->overflow = true;
+		}
+	}
+}
+
+/**
+ * This function writes a single character into the output buffer
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] character
+ * Character to write
+ *
+ * @return
+ * void
+ */
+static void writeChar(JSONWriter_T *writer_ptr, uint8_t character)
+{
+	writeBytes(writer_ptr, &character, 1);
+}
+
+/**
+ * This function writes the comma between two elements
+ * of the same object or array. Values which directly
+ * follow a key are written without separator.
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @return
+ * void
+ */
+static void writeSeparator(JSONWriter_T *writer_ptr)
+{
+	if(true == writer_ptr->afterKey) {
+		writer_ptr->afterKey = false;
+	} else {
+		if(0 != (writer_ptr->elementMask & (1 << writer_ptr->depth))) {
+			writeChar(writer_ptr, ',');
+		}
+		writer_ptr->elementMask |= (1 << writer_ptr->depth);
+	}
+}
+
+/**
+ * This function writes the content of a string and
+ * escapes quotes and backslashes
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] string_ptr
+ * This reference holds the null terminated string
+ *
+ * @return
+ * void
+ */
+static void writeEscaped(JSONWriter_T *writer_ptr, uint8_t const *string_ptr)
+{
+	size_t start = 0;
+	size_t i = 0;
+
+	for(i = 0; string_ptr[i] != 0; ++i) {
+		if( ('"' == string_ptr[i]) || ('\\' == string_ptr[i]) ) {
+			writeBytes(writer_ptr, &string_ptr[start], i - start);
+			writeChar(writer_ptr, '\\');
+			start = i;
+		}
+	}
+	writeBytes(writer_ptr, &string_ptr[start], i - start);
+}
+
+/**
+ * This function opens a new object or array level
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] character
+ * Opening character '{' or '['
+ *
+ * @return
+ * void
+ */
+static void beginLevel(JSONWriter_T *writer_ptr, uint8_t character)
+{
+	writeSeparator(writer_ptr);
+	writeChar(writer_ptr, character);
+
+	if( (JSON_WRITER_DEPTH_MAX - 1) > writer_ptr->depth ) {
+		writer_ptr->depth++;
+		writer_ptr->elementMask &= ~(1 << writer_ptr->depth);
+	} else {
+		writer_ptr->overflow = true;
+	}
+}
+
+/**
+ * This function closes the current object or array level
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] character
+ * Closing character '}' or ']'
+ *
+ * @return
+ * void
+ */
+static void endLevel(JSONWriter_T *writer_ptr, uint8_t character)
+{
+	if(0 < writer_ptr->depth) {
+		writer_ptr->depth--;
+	} else {
+		writer_ptr->overflow = true;
+	}
+	writeChar(writer_ptr, character);
+}
+
+/**
+ * This function initializes a writer context
+ *
+ * @param[out] writer_ptr
+ * This reference will hold the writer context
+ *
+ * @param[in] buff_ptr
+ * This buffer will hold the JSON string
+ *
+ * @param[in] buffSize
+ * Size of the output buffer including null termination
+ *
+ * @return
+ * void
+ */
+void JSONWriterInit(JSONWriter_T *writer_ptr, uint8_t *buff_ptr, size_t buffSize)
+{
+	memset(writer_ptr, 0, sizeof(JSONWriter_T));
+	writer_ptr->buff_ptr = buff_ptr;
+	writer_ptr->buffSize = buffSize;
+	/* an unusable buffer is reported by JSONWriterFinish */
+	if( (NULL == buff_ptr) || (0 == buffSize) ) {
+		writer_ptr->overflow = true;
+	}
+}
+
+/**
+ * This function writes the start of a JSON object
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @return
+ * void
+ */
+void JSONWriterBeginObject(JSONWriter_T *writer_ptr)
+{
+	beginLevel(writer_ptr, '{');
+}
+
+/**
+ * This function writes the end of a JSON object
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @return
+ * void
+ */
+void JSONWriterEndObject(JSONWriter_T *writer_ptr)
+{
+	endLevel(writer_ptr, '}');
+}
+
+/**
+ * This function writes the start of a JSON array
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @return
+ * void
+ */
+void JSONWriterBeginArray(JSONWriter_T *writer_ptr)
+{
+	beginLevel(writer_ptr, '[');
+}
+
+/**
+ * This function writes the end of a JSON array
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @return
+ * void
+ */
+void JSONWriterEndArray(JSONWriter_T *writer_ptr)
+{
+	endLevel(writer_ptr, ']');
+}
+
+/**
+ * This function writes the key of an object member.
+ * The next written value belongs to this key.
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] key_ptr
+ * This reference holds the null terminated key
+ *
+ * @return
+ * void
+ */
+void JSONWriterKey(JSONWriter_T *writer_ptr, uint8_t const *key_ptr)
+{
+	writeSeparator(writer_ptr);
+	writeChar(writer_ptr, '"');
+	writeEscaped(writer_ptr, key_ptr);
+	writeBytes(writer_ptr, "\":", 2);
+	writer_ptr->afterKey = true;
+}
+
+/**
+ * This function writes a string value
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] value_ptr
+ * This reference holds the null terminated value
+ *
+ * @return
+ * void
+ */
+void JSONWriterString(JSONWriter_T *writer_ptr, uint8_t const *value_ptr)
+{
+	writeSeparator(writer_ptr);
+	writeChar(writer_ptr, '"');
+	writeEscaped(writer_ptr, value_ptr);
+	writeChar(writer_ptr, '"');
+}
+
+/**
+ * This function writes the decimal digits of an
+ * unsigned number
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] value
+ * Value to write
+ *
+ * @return
+ * void
+ */
+static void writeDecimal(JSONWriter_T *writer_ptr, uint32_t value)
+{
+	/* uint32_t has at most 10 decimal digits */
+	uint8_t digits[10];
+	uint8_t position = sizeof(digits);
+
+	do {
+		digits[--position] = '0' + (value % 10);
+		value /= 10;
+	} while(0 != value);
+
+	writeBytes(writer_ptr, &digits[position], sizeof(digits) - position);
+}
+
+/**
+ * This function writes the hex digits of an unsigned
+ * number without leading zeros, zero is written as "0"
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] value
+ * Value to write
+ *
+ * @return
+ * void
+ */
+static void writeHexDigits(JSONWriter_T *writer_ptr, uint64_t value)
+{
+	/* uint64_t has at most 16 hex digits */
+	uint8_t digits[16];
+	uint8_t position = sizeof(digits);
+
+	do {
+		digits[--position] = "0123456789abcdef"[value & 0x0F];
+		value >>= 4;
+	} while(0 != value);
+
+	writeBytes(writer_ptr, &digits[position], sizeof(digits) - position);
+}
+
+/**
+ * This function writes an unsigned number value
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] value
+ * Value to write in decimal format
+ *
+ * @return
+ * void
+ */
+void JSONWriterNumber(JSONWriter_T *writer_ptr, uint32_t value)
+{
+	writeSeparator(writer_ptr);
+	writeDecimal(writer_ptr, value);
+}
+
+/**
+ * This function writes an unsigned number as hex encoded
+ * json-rpc quantity string e.g. "0x47e7c0" - without
+ * leading zeros, zero is written as "0x0"
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] value
+ * Value to write
+ *
+ * @return
+ * void
+ */
+void JSONWriterQuantity(JSONWriter_T *writer_ptr, uint64_t value)
+{
+	JSONWriterBeginString(writer_ptr);
+	writeBytes(writer_ptr, "0x", 2);
+	writeHexDigits(writer_ptr, value);
+	JSONWriterEndString(writer_ptr);
+}
+
+/**
+ * This function writes a value which was serialized
+ * before, e.g. the first part of a request template.
+ * The value is completed with the JSONWriterAppend
+ * functions.
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] data_ptr
+ * This reference holds the serialized JSON
+ *
+ * @param[in] iLength
+ * Number of characters to write
+ *
+ * @return
+ * void
+ */
+void JSONWriterRawValue(JSONWriter_T *writer_ptr, uint8_t const *data_ptr, size_t iLength)
+{
+	writeSeparator(writer_ptr);
+	writeBytes(writer_ptr, data_ptr, iLength);
+}
+
+/**
+ * This function appends the decimal digits of a number
+ * to a value started with JSONWriterRawValue
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] value
+ * Value to append
+ *
+ * @return
+ * void
+ */
+void JSONWriterAppendNumber(JSONWriter_T *writer_ptr, uint32_t value)
+{
+	writeDecimal(writer_ptr, value);
+}
+
+/**
+ * This function appends the hex digits of a quantity
+ * without "0x" prefix and leading zeros to an opened
+ * string
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] value
+ * Value to append
+ *
+ * @return
+ * void
+ */
+void JSONWriterAppendQuantity(JSONWriter_T *writer_ptr, uint64_t value)
+{
+	writeHexDigits(writer_ptr, value);
+}
+
+/**
+ * This function opens a string value which is put
+ * together from several parts with JSONWriterAppendRaw
+ * and JSONWriterAppendHex
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @return
+ * void
+ */
+void JSONWriterBeginString(JSONWriter_T *writer_ptr)
+{
+	writeSeparator(writer_ptr);
+	writeChar(writer_ptr, '"');
+}
+
+/**
+ * This function appends characters to an opened string
+ * without escaping. Only use it for hex or plain ascii data.
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] data_ptr
+ * This reference holds the characters to append
+ *
+ * @param[in] iLength
+ * Number of characters to append
+ *
+ * @return
+ * void
+ */
+void JSONWriterAppendRaw(JSONWriter_T *writer_ptr, uint8_t const *data_ptr, size_t iLength)
+{
+	writeBytes(writer_ptr, data_ptr, iLength);
+}
+
+/**
+ * This function appends the hex representation of
+ * binary data to an opened string - two lower case
+ * characters per byte
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] data_ptr
+ * This reference holds the binary data
+ *
+ * @param[in] iLength
+ * Number of bytes to encode
+ *
+ * @return
+ * void
+ */
+void JSONWriterAppendHex(JSONWriter_T *writer_ptr, uint8_t const *data_ptr, size_t iLength)
+{
+	if( (false == writer_ptr->overflow) && ((writer_ptr->length + iLength * 2) < writer_ptr->buffSize) ) {
+		HexEncode(data_ptr, iLength, &writer_ptr->buff_ptr[writer_ptr->length]);
+		writer_ptr->length += iLength * 2;
+	} else {
+		writer_ptr->overflow = true;
+	}
+}
+
+/**
+ * This function hands out the free space of the buffer
+ * to write binary data directly at the current position.
+ * The data is hex encoded in place by JSONWriterCommitHex,
+ * so no separate binary buffer is needed.
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[out] oMaxLength_ptr
+ * This reference will hold the maximum number of bytes
+ * which still fit into the buffer after hex encoding
+ *
+ * @return
+ * reference of the current write position, NULL on overflow
+ */
+uint8_t *JSONWriterReserveHex(JSONWriter_T *writer_ptr, size_t *oMaxLength_ptr)
+{
+	*oMaxLength_ptr = 0;
+	if( (true == writer_ptr->overflow) || (writer_ptr->length >= writer_ptr->buffSize) ) {
+		return NULL;
+	}
+
+	/* one byte is always kept for the termination */
+	*oMaxLength_ptr = (writer_ptr->buffSize - writer_ptr->length - 1) / 2;
+	return &writer_ptr->buff_ptr[writer_ptr->length];
+}
+
+/**
+ * This function hex encodes in place the binary data which
+ * was written to the position returned by JSONWriterReserveHex
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[in] iLength
+ * Number of binary bytes which were written
+ *
+ * @return
+ * void
+ */
+void JSONWriterCommitHex(JSONWriter_T *writer_ptr, size_t iLength)
+{
+	JSONWriterAppendHex(writer_ptr, &writer_ptr->buff_ptr[writer_ptr->length], iLength);
+}
+
+/**
+ * This function closes a string opened with
+ * JSONWriterBeginString
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @return
+ * void
+ */
+void JSONWriterEndString(JSONWriter_T *writer_ptr)
+{
+	writeChar(writer_ptr, '"');
+}
+
+/**
+ * This function null terminates the JSON string and
+ * checks that everything fit into the buffer and all
+ * objects and arrays are closed
+ *
+ * @param[in] writer_ptr
+ * This reference holds the writer context
+ *
+ * @param[out] oLength_ptr
+ * This reference will hold the length of the JSON string
+ * without null termination. Can be NULL.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T JSONWriterFinish(JSONWriter_T *writer_ptr, size_t *oLength_ptr)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+
+	if( (false == writer_ptr->overflow) && (0 == writer_ptr->depth) ) {
+		/* writeBytes always keeps one byte for the termination */
+		writer_ptr->buff_ptr[writer_ptr->length] = 0;
+		if(NULL != oLength_ptr) {
+			*oLength_ptr = writer_ptr->length;
+		}
+		ret = RETCODE_SUCCESS;
+	}
+
+	return ret;
+}
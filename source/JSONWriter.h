@@ -0,0 +1,51 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_JSONWRITER_H_
+#define SOURCE_JSONWRITER_H_
+
+/* maximum nesting depth of objects and arrays */
+#define JSON_WRITER_DEPTH_MAX	8
+
+/**
+ * writer context which emits compact JSON into a caller
+ * provided buffer. No heap memory is used, the number of
+ * written bytes is tracked in length.
+ */
+typedef struct JSONWriter_S {
+	uint8_t *buff_ptr;
+	size_t buffSize;
+	size_t length;
+	uint8_t depth;
+	uint16_t elementMask;
+	bool afterKey;
+	bool overflow;
+} JSONWriter_T;
+
+/* global interface function declarations */
+void JSONWriterInit(JSONWriter_T *writer_ptr, uint8_t *buff_ptr, size_t buffSize);
+void JSONWriterBeginObject(JSONWriter_T *writer_ptr);
+void JSONWriterEndObject(JSONWriter_T *writer_ptr);
+void JSONWriterBeginArray(JSONWriter_T *writer_ptr);
+void JSONWriterEndArray(JSONWriter_T *writer_ptr);
+void JSONWriterKey(JSONWriter_T *writer_ptr, uint8_t const *key_ptr);
+void JSONWriterString(JSONWriter_T *writer_ptr, uint8_t const *value_ptr);
+void JSONWriterNumber(JSONWriter_T *writer_ptr, uint32_t value);
+void JSONWriterQuantity(JSONWriter_T *writer_ptr, uint64_t value);
+void JSONWriterRawValue(JSONWriter_T *writer_ptr, uint8_t const *data_ptr, size_t iLength);
+void JSONWriterAppendNumber(JSONWriter_T *writer_ptr, uint32_t value);
+void JSONWriterAppendQuantity(JSONWriter_T *writer_ptr, uint64_t value);
+void JSONWriterBeginString(JSONWriter_T *writer_ptr);
+void JSONWriterAppendRaw(JSONWriter_T *writer_ptr, uint8_t const *data_ptr, size_t iLength);
+void JSONWriterAppendHex(JSONWriter_T *writer_ptr, uint8_t const *data_ptr, size_t iLength);
+uint8_t *JSONWriterReserveHex(JSONWriter_T *writer_ptr, size_t *oMaxLength_ptr);
+void JSONWriterCommitHex(JSONWriter_T *writer_ptr, size_t iLength);
+void JSONWriterEndString(JSONWriter_T *writer_ptr);
+Retcode_T JSONWriterFinish(JSONWriter_T *writer_ptr, size_t *oLength_ptr);
+
+#endif /* SOURCE_JSONWRITER_H_ */
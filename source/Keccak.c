@@ -0,0 +1,200 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <string.h>
+#include "BCDS_Basics.h"
+
+/* user includes */
+#include "Keccak.h"
+
+/* number of rounds of the keccak-f[1600] permutation */
+#define KECCAK_ROUNDS		24
+
+#define ROTL64(value, shift)	(((value) << (shift)) | ((value) >> (64 - (shift))))
+
+/* round constants of the iota step */
+static uint64_t const KeccakRoundConstants[KECCAK_ROUNDS] = {
+	UINT64_C(0x0000000000000001), UINT64_C(0x0000000000008082), UINT64_C(0x800000000000808A), UINT64_C(0x8000000080008000),
+	UINT64_C(0x000000000000808B), UINT64_C(0x0000000080000001), UINT64_C(0x8000000080008081), UINT64_C(0x8000000000008009),
+	UINT64_C(0x000000000000008A), UINT64_C(0x0000000000000088), UINT64_C(0x0000000080008009), UINT64_C(0x000000008000000A),
+	UINT64_C(0x000000008000808B), UINT64_C(0x800000000000008B), UINT64_C(0x8000000000008089), UINT64_C(0x8000000000008003),
+	UINT64_C(0x8000000000008002), UINT64_C(0x8000000000000080), UINT64_C(0x000000000000800A), UINT64_C(0x800000008000000A),
+	UINT64_C(0x8000000080008081), UINT64_C(0x8000000000008080), UINT64_C(0x0000000080000001), UINT64_C(0x8000000080008008)
+};
+
+/* rotation offsets and lane order of the combined rho and pi step */
+static uint8_t const KeccakRotations[24] = {
+	1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44
+};
+static uint8_t const KeccakPiLanes[24] = {
+	10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1
+};
+
+/**
+ * This function applies the keccak-f[1600] permutation
+ * on the state
+ *
+ * @param[in,out] state
+ * 25 lanes of the keccak state
+ *
+ * @return
+ * void
+ */
+static void keccakPermutation(uint64_t state[25])
+{
+	uint64_t column[5];
+	uint64_t lane = 0;
+	uint64_t temp = 0;
+
+	for(uint8_t round = 0; round < KECCAK_ROUNDS; ++round) {
+		/* theta */
+		for(uint8_t x = 0; x < 5; ++x) {
+			column[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
+		}
+		for(uint8_t x = 0; x < 5; ++x) {
+			temp = column[(x + 4) % 5] ^ ROTL64(column[(x + 1) % 5], 1);
+			for(uint8_t y = 0; y < 25; y += 5) {
+				state[y + x] ^= temp;
+			}
+		}
+
+		/* rho and pi */
+		lane = state[1];
+		for(uint8_t i = 0; i < 24; ++i) {
+			temp = state[KeccakPiLanes[i]];
+			state[KeccakPiLanes[i]] = ROTL64(lane, KeccakRotations[i]);
+			lane = temp;
+		}
+
+		/* chi */
+		for(uint8_t y = 0; y < 25; y += 5) {
+			for(uint8_t x = 0; x < 5; ++x) {
+				column[x] = state[y + x];
+			}
+			for(uint8_t x = 0; x < 5; ++x) {
+				state[y + x] = column[x] ^ ((~column[(x + 1) % 5]) & column[(x + 2) % 5]);
+			}
+		}
+
+		/* iota */
+		state[0] ^= KeccakRoundConstants[round];
+	}
+}
+
+/**
+ * This function xors one byte into the state. The lanes
+ * are little endian independent of the target.
+ *
+ * @param[in,out] context_ptr
+ * This reference holds the hash context
+ *
+ * @param[in] value
+ * byte which is absorbed at the current offset
+ *
+ * @return
+ * void
+ */
+static void absorbByte(Keccak256Context_T *context_ptr, uint8_t value)
+{
+	context_ptr->state[context_ptr->offset / 8] ^= ((uint64_t) value) << (8 * (context_ptr->offset % 8));
+}
+
+/**
+ * This function initializes a keccak256 hash context
+ *
+ * @param[out] context_ptr
+ * This reference holds the hash context
+ *
+ * @return
+ * void
+ */
+void Keccak256Init(Keccak256Context_T *context_ptr)
+{
+	memset(context_ptr, 0, sizeof(Keccak256Context_T));
+}
+
+/**
+ * This function absorbs data into the hash. It can
+ * be called several times to hash data which is not
+ * stored in one buffer.
+ *
+ * @param[in,out] context_ptr
+ * This reference holds the hash context
+ *
+ * @param[in] data_ptr
+ * This reference holds the data
+ *
+ * @param[in] iLength
+ * Length of the data
+ *
+ * @return
+ * void
+ */
+void Keccak256Update(Keccak256Context_T *context_ptr, uint8_t const *data_ptr, size_t iLength)
+{
+	for(size_t i = 0; i < iLength; ++i) {
+		absorbByte(context_ptr, data_ptr[i]);
+		if(KECCAK256_RATE == ++context_ptr->offset) {
+			keccakPermutation(context_ptr->state);
+			context_ptr->offset = 0;
+		}
+	}
+}
+
+/**
+ * This function pads the absorbed data and writes
+ * the hash. The context has to be initialized again
+ * before it is reused.
+ *
+ * @param[in,out] context_ptr
+ * This reference holds the hash context
+ *
+ * @param[out] oHash_ptr
+ * Output buffer - holds KECCAK256_HASH_SIZE bytes
+ *
+ * @return
+ * void
+ */
+void Keccak256Finish(Keccak256Context_T *context_ptr, uint8_t *oHash_ptr)
+{
+	/* keccak padding 0x01 ... 0x80 - both can be in the same byte */
+	absorbByte(context_ptr, 0x01);
+	context_ptr->offset = KECCAK256_RATE - 1;
+	absorbByte(context_ptr, 0x80);
+	keccakPermutation(context_ptr->state);
+
+	for(uint8_t i = 0; i < KECCAK256_HASH_SIZE; ++i) {
+		oHash_ptr[i] = (uint8_t) (context_ptr->state[i / 8] >> (8 * (i % 8)));
+	}
+}
+
+/**
+ * This function calculates the keccak256 hash of
+ * one buffer
+ *
+ * @param[in] data_ptr
+ * This reference holds the data
+ *
+ * @param[in] iLength
+ * Length of the data
+ *
+ * @param[out] oHash_ptr
+ * Output buffer - holds KECCAK256_HASH_SIZE bytes
+ *
+ * @return
+ * void
+ */
+void Keccak256(uint8_t const *data_ptr, size_t iLength, uint8_t *oHash_ptr)
+{
+	Keccak256Context_T context;
+
+	Keccak256Init(&context);
+	Keccak256Update(&context, data_ptr, iLength);
+	Keccak256Finish(&context, oHash_ptr);
+}
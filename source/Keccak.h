@@ -0,0 +1,34 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_KECCAK_H_
+#define SOURCE_KECCAK_H_
+
+/* size of a keccak256 hash in bytes */
+#define KECCAK256_HASH_SIZE		32
+
+/* number of bytes which are absorbed per permutation */
+#define KECCAK256_RATE			136
+
+/**
+ * context of an incremental keccak256 hash as used by
+ * ethereum. It uses the original keccak padding, so the
+ * results differ from the standardized SHA3-256.
+ */
+typedef struct Keccak256Context_S {
+	uint64_t state[25];
+	size_t offset;		/* bytes absorbed into the current block */
+} Keccak256Context_T;
+
+/* global interface function declarations */
+void Keccak256Init(Keccak256Context_T *context_ptr);
+void Keccak256Update(Keccak256Context_T *context_ptr, uint8_t const *data_ptr, size_t iLength);
+void Keccak256Finish(Keccak256Context_T *context_ptr, uint8_t *oHash_ptr);
+void Keccak256(uint8_t const *data_ptr, size_t iLength, uint8_t *oHash_ptr);
+
+#endif /* SOURCE_KECCAK_H_ */
@@ -0,0 +1,295 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <string.h>
+#include "BCDS_Basics.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+/* user includes */
+#include "Http.h"
+#include "LoopbackTransport.h"
+#include "JSONReader.h"
+#include "JSONWriter.h"
+
+/* result of every call which the default responder answers */
+#define LOOPBACK_DEFAULT_RESULT		"0x0"
+
+/**
+ * This handler struct holds the responder which answers
+ * the requests on the device and its response buffer
+ */
+typedef struct loopbackHandler_S {
+	TransportCallbacks_T const *callbacks_ptr;
+	LoopbackResponder_T responder;
+	SemaphoreHandle_t mutex;
+	uint8_t responseBuff[LOOPBACK_RESPONSE_SIZE];
+} loopbackHandler_T;
+static loopbackHandler_T loopbackHandleVar = {0};
+
+/* message and byte counters */
+static TransportStats_T loopbackStatsVar = {0};
+
+/**
+ * This function writes the response object of one call
+ *
+ * @param[in] writer_ptr
+ * This reference holds the JSON writer context
+ *
+ * @param[in] call_ptr
+ * This reference holds the token of the request object
+ *
+ * @return
+ * void
+ */
+static void writeDefaultResponse(JSONWriter_T *writer_ptr, JSONToken_T const *call_ptr)
+{
+	JSONToken_T id;
+	uint32_t messageID = 0;
+
+	if( (RETCODE_SUCCESS == JSONReaderGetMember(call_ptr, "id", &id)) && (RETCODE_SUCCESS == JSONReaderGetUint(&id, &messageID)) ) {
+		JSONWriterBeginObject(writer_ptr);
+		JSONWriterKey(writer_ptr, "jsonrpc");
+		JSONWriterString(writer_ptr, "2.0");
+		JSONWriterKey(writer_ptr, "id");
+		JSONWriterNumber(writer_ptr, messageID);
+		JSONWriterKey(writer_ptr, "result");
+		JSONWriterString(writer_ptr, LOOPBACK_DEFAULT_RESULT);
+		JSONWriterEndObject(writer_ptr);
+	}
+}
+
+/**
+ * This function is the default responder. It answers
+ * every call of a single or batch request with the
+ * result LOOPBACK_DEFAULT_RESULT.
+ *
+ * @param[in] node
+ * This variable holds the node the request is sent to
+ *
+ * @param[in] request_ptr
+ * This reference holds the json rpc request
+ *
+ * @param[in] iLength
+ * This variable holds the length of the request
+ *
+ * @param[out] oResponse_ptr
+ * This buffer will hold the response
+ *
+ * @param[in] iBuffSize
+ * Size of the response buffer
+ *
+ * @return
+ * length of the response, 0 if the request is invalid
+ */
+static size_t defaultResponder(uint8_t node, uint8_t const *request_ptr, size_t iLength, uint8_t *oResponse_ptr, size_t iBuffSize)
+{
+	JSONWriter_T writer;
+	JSONToken_T request;
+	JSONToken_T element;
+	size_t length = 0;
+
+	(void) node;
+
+	if(RETCODE_SUCCESS != JSONReaderParse(request_ptr, iLength, &request)) {
+		return 0;
+	}
+
+	JSONWriterInit(&writer, oResponse_ptr, iBuffSize);
+	if(JSON_TOKEN_ARRAY == request.type) {
+		JSONWriterBeginArray(&writer);
+		element.ptr = NULL;
+		while(RETCODE_SUCCESS == JSONReaderNextElement(&request, &element)) {
+			writeDefaultResponse(&writer, &element);
+		}
+		JSONWriterEndArray(&writer);
+	} else {
+		writeDefaultResponse(&writer, &request);
+	}
+
+	return (RETCODE_SUCCESS == JSONWriterFinish(&writer, &length)) ? length : 0;
+}
+
+/**
+ * This function creates the mutex of the response buffer
+ *
+ * @param[in] callbacks_ptr
+ * This reference holds the callbacks of the json rpc client
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T loopbackTransportInit(TransportCallbacks_T const *callbacks_ptr)
+{
+	if(NULL == callbacks_ptr) {
+		return RETCODE_FAILURE;
+	}
+	loopbackHandleVar.callbacks_ptr = callbacks_ptr;
+
+	if(NULL == loopbackHandleVar.mutex) {
+		loopbackHandleVar.mutex = xSemaphoreCreateMutex();
+	}
+	if(NULL == loopbackHandleVar.responder) {
+		loopbackHandleVar.responder = defaultResponder;
+	}
+
+	return (NULL != loopbackHandleVar.mutex) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function answers a request with the responder.
+ * The response is passed to the json rpc client before
+ * this function returns.
+ *
+ * @param[in] node
+ * This variable holds the node the request is sent to -
+ * it is passed to the responder
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @param[in] payload_ptr
+ * This reference holds the json rpc request
+ *
+ * @param[in] iLength
+ * This variable holds the length of the request
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T loopbackTransportSend(uint8_t node, uint32_t requestID, uint8_t const *payload_ptr, size_t iLength)
+{
+	size_t responseLength = 0;
+
+	if(pdTRUE != xSemaphoreTake(loopbackHandleVar.mutex, portMAX_DELAY)) {
+		return RETCODE_FAILURE;
+	}
+
+	loopbackStatsVar.messageSentCounter++;
+	loopbackStatsVar.bytesSent += (uint32_t) iLength;
+	loopbackHandleVar.callbacks_ptr->sent(node, requestID, RETCODE_SUCCESS);
+
+	responseLength = loopbackHandleVar.responder(node, payload_ptr, iLength, loopbackHandleVar.responseBuff, sizeof(loopbackHandleVar.responseBuff));
+	if(0 < responseLength) {
+		loopbackStatsVar.messageReceivedCounter++;
+		loopbackStatsVar.bytesReceived += (uint32_t) responseLength;
+		(void) loopbackHandleVar.callbacks_ptr->received(node, requestID, loopbackHandleVar.responseBuff, responseLength);
+	} else {
+		(void) loopbackHandleVar.callbacks_ptr->received(node, requestID, NULL, 0);
+	}
+
+	xSemaphoreGive(loopbackHandleVar.mutex);
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function returns the connection state - the
+ * loopback transport is always connected
+ *
+ * @return
+ * TRANSPORT_CONNECTED
+ */
+static TransportState_T loopbackTransportGetState(void)
+{
+	return TRANSPORT_CONNECTED;
+}
+
+/**
+ * This function has nothing to close
+ *
+ * @param[in] node
+ * This variable holds the node - not used
+ *
+ * @return
+ * void
+ */
+static void loopbackTransportDisconnect(uint8_t node)
+{
+	(void) node;
+}
+
+/**
+ * This function has nothing to cancel - every request is
+ * answered before send returns
+ *
+ * @param[in] node
+ * This variable holds the node - not used
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request - not used
+ *
+ * @return
+ * void
+ */
+static void loopbackTransportCancel(uint8_t node, uint32_t requestID)
+{
+	(void) node;
+	(void) requestID;
+}
+
+/**
+ * This function copies the counters of the transport
+ *
+ * @param[out] oStats_ptr
+ * This reference will hold the counter values
+ *
+ * @return
+ * void
+ */
+static void loopbackTransportGetStats(TransportStats_T *oStats_ptr)
+{
+	if(NULL != oStats_ptr) {
+		*oStats_ptr = loopbackStatsVar;
+	}
+}
+
+static const Transport_T LoopbackTransport = {
+	"loopback",
+	true,
+	loopbackTransportInit,
+	loopbackTransportSend,
+	loopbackTransportGetState,
+	loopbackTransportDisconnect,
+	loopbackTransportCancel,
+	loopbackTransportGetStats
+};
+
+/**
+ * This function returns the transport which answers the
+ * json rpc requests on the device, e.g. for host tests or
+ * to measure the overhead of the json rpc client without
+ * network
+ *
+ * @return
+ * reference of the transport
+ */
+Transport_T const *LoopbackTransportGet(void)
+{
+	return &LoopbackTransport;
+}
+
+/**
+ * This function sets the responder which answers the
+ * requests of the loopback transport
+ *
+ * @param[in] responder
+ * This function writes the response. NULL restores the
+ * default responder.
+ *
+ * @return
+ * void
+ */
+void LoopbackTransportSetResponder(LoopbackResponder_T responder)
+{
+	loopbackHandleVar.responder = (NULL != responder) ? responder : defaultResponder;
+}
@@ -0,0 +1,25 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_LOOPBACKTRANSPORT_H_
+#define SOURCE_LOOPBACKTRANSPORT_H_
+
+#include "Transport.h"
+
+/* size of the response buffer of the loopback transport */
+#define LOOPBACK_RESPONSE_SIZE	HTTP_REQUEST_PAYLOAD_SIZE
+
+/* answers a json rpc request sent to a node of the node pool - returns
+ * the length of the response, 0 lets the request fail */
+typedef size_t (*LoopbackResponder_T)(uint8_t node, uint8_t const *request_ptr, size_t iLength, uint8_t *oResponse_ptr, size_t iBuffSize);
+
+/* global interface function declarations */
+Transport_T const *LoopbackTransportGet(void);
+void LoopbackTransportSetResponder(LoopbackResponder_T responder);
+
+#endif /* SOURCE_LOOPBACKTRANSPORT_H_ */
@@ -0,0 +1,64 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <string.h>
+#include "BCDS_Basics.h"
+#include "FreeRTOS.h"
+
+/* user includes */
+#include "LruTable.h"
+
+/**
+ * This function selects the entry a new value is stored
+ * in - the valid entry with the same key, otherwise a free
+ * entry, otherwise the least recently used entry. Every
+ * entry of the table starts with an LruTableEntry_T.
+ * Must be called with the mutex of the table.
+ *
+ * @param[in] table_ptr
+ * This reference holds the first entry of the table
+ *
+ * @param[in] entrySize
+ * Size of one entry
+ *
+ * @param[in] entryCount
+ * Number of entries - must not be 0
+ *
+ * @param[in] keyOffset
+ * Offset of the key in an entry
+ *
+ * @param[in] key_ptr
+ * This reference holds the key of the new value
+ *
+ * @param[in] keySize
+ * Size of the key
+ *
+ * @return
+ * selected entry
+ */
+void *LruTableSelectEntry(void *table_ptr, size_t entrySize, uint8_t entryCount, size_t keyOffset, void const *key_ptr, size_t keySize)
+{
+	LruTableEntry_T *entry_ptr = NULL;
+
+	for(uint8_t entry = 0; entry < entryCount; ++entry) {
+		LruTableEntry_T *candidate_ptr = (LruTableEntry_T*) ((uint8_t*) table_ptr + (entry * entrySize));
+		if(false == candidate_ptr->valid) {
+			if( (NULL == entry_ptr) || (true == entry_ptr->valid) ) {
+				entry_ptr = candidate_ptr;
+			}
+		} else if(0 == memcmp((uint8_t const*) candidate_ptr + keyOffset, key_ptr, keySize)) {
+			entry_ptr = candidate_ptr;
+			break;
+		} else if( (NULL == entry_ptr) || ((true == entry_ptr->valid) && (0 > (int32_t) (candidate_ptr->lastUseTick - entry_ptr->lastUseTick))) ) {
+			entry_ptr = candidate_ptr;
+		}
+	}
+
+	return entry_ptr;
+}
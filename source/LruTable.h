@@ -0,0 +1,21 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_LRUTABLE_H_
+#define SOURCE_LRUTABLE_H_
+
+/* first member of every entry of a table with least recently used replacement */
+typedef struct LruTableEntry_S {
+	bool valid;
+	portTickType lastUseTick;
+} LruTableEntry_T;
+
+/* global interface function declarations */
+void *LruTableSelectEntry(void *table_ptr, size_t entrySize, uint8_t entryCount, size_t keyOffset, void const *key_ptr, size_t keySize);
+
+#endif /* SOURCE_LRUTABLE_H_ */
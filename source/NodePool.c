@@ -0,0 +1,326 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <string.h>
+#include "BCDS_Basics.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* user includes */
+#include "NodePool.h"
+#include "Http.h"
+#include "UserConfig.h"
+#include "SystemConfig.h"
+
+/* the average is kept in 1/NODE_POOL_EWMA_SCALE ms so small
+ * latency differences are not rounded away */
+#define NODE_POOL_EWMA_SCALE	16
+
+/* json-rpc nodes - without the node pool only the configured node */
+#ifdef ENABLE_NODE_POOL
+static const NodePoolEndpoint_T NodePoolEndpoints[] = NODE_POOL_ENDPOINTS;
+#else
+static const NodePoolEndpoint_T NodePoolEndpoints[] = { { HTTP_IP_ADDRESS, HOST_ADDRESS, HTTP_PORT } };
+#endif
+
+#define NODE_POOL_ENDPOINT_COUNT	(sizeof(NodePoolEndpoints) / sizeof(NodePoolEndpoints[0]))
+
+/**
+ * This struct holds the state of one node. The stats are
+ * handed out by NodePoolGetStats, the scaled average and
+ * the tick of the last response are internal.
+ */
+typedef struct nodePoolEntry_S {
+	NodePoolStats_T stats;
+	uint32_t ewmaLatencyScaled;
+	portTickType lastResponseTick;
+} nodePoolEntry_T;
+static nodePoolEntry_T nodePoolTable[NODE_POOL_ENDPOINT_MAX];
+
+/**
+ * This function checks the node list and marks all
+ * nodes as healthy until they fail
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T NodePoolInit(void)
+{
+	if( (0 == NODE_POOL_ENDPOINT_COUNT) || (NODE_POOL_ENDPOINT_MAX < NODE_POOL_ENDPOINT_COUNT) ) {
+		return RETCODE_FAILURE;
+	}
+
+	for(uint8_t node = 0; node < NODE_POOL_ENDPOINT_COUNT; ++node) {
+		memset(&nodePoolTable[node], 0, sizeof(nodePoolTable[node]));
+		nodePoolTable[node].stats.healthy = true;
+	}
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function returns the number of configured nodes
+ *
+ * @return
+ * number of nodes
+ */
+uint8_t NodePoolGetCount(void)
+{
+	return (uint8_t) NODE_POOL_ENDPOINT_COUNT;
+}
+
+/**
+ * This function returns the address of a node
+ *
+ * @param[in] node
+ * This variable holds the index of the node
+ *
+ * @return
+ * reference of the endpoint, NULL for an unknown node
+ */
+NodePoolEndpoint_T const *NodePoolGetEndpoint(uint8_t node)
+{
+	return (NODE_POOL_ENDPOINT_COUNT > node) ? &NodePoolEndpoints[node] : NULL;
+}
+
+/**
+ * This function selects the node a request is sent to.
+ * It is the healthy node with the lowest average latency,
+ * nodes without response yet count as fastest so they are
+ * tried once. If no node is healthy, the node with the
+ * fewest failures in a row is used.
+ *
+ * @param[in] preferPrimary
+ * true to select the primary node while it is healthy
+ *
+ * @param[in] excludeMask
+ * NODE_POOL_NODE_BIT of the nodes which must not be used,
+ * e.g. the nodes a request already failed on
+ *
+ * @return
+ * index of the node, NODE_POOL_NODE_NONE if all are excluded
+ */
+uint8_t NodePoolSelect(bool preferPrimary, uint32_t excludeMask)
+{
+	uint8_t selected = NODE_POOL_NODE_NONE;
+	bool selectedHealthy = false;
+
+	taskENTER_CRITICAL();
+	if( (true == preferPrimary) && (0 == (excludeMask & NODE_POOL_NODE_BIT(NODE_POOL_PRIMARY))) && (true == nodePoolTable[NODE_POOL_PRIMARY].stats.healthy) ) {
+		selected = NODE_POOL_PRIMARY;
+	} else {
+		for(uint8_t node = 0; node < NODE_POOL_ENDPOINT_COUNT; ++node) {
+			NodePoolStats_T const *stats_ptr = &nodePoolTable[node].stats;
+			if(0 != (excludeMask & NODE_POOL_NODE_BIT(node))) {
+				continue;
+			}
+			if(NODE_POOL_NODE_NONE == selected) {
+				selected = node;
+				selectedHealthy = stats_ptr->healthy;
+			} else if(true == stats_ptr->healthy) {
+				if( (false == selectedHealthy) || (nodePoolTable[node].ewmaLatencyScaled < nodePoolTable[selected].ewmaLatencyScaled) ) {
+					selected = node;
+					selectedHealthy = true;
+				}
+			} else if( (false == selectedHealthy) && (stats_ptr->failuresInRow < nodePoolTable[selected].stats.failuresInRow) ) {
+				selected = node;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return selected;
+}
+
+/**
+ * This function counts a request which is sent to a node
+ *
+ * @param[in] node
+ * This variable holds the index of the node
+ *
+ * @return
+ * void
+ */
+void NodePoolReportRequest(uint8_t node)
+{
+	if(NODE_POOL_ENDPOINT_COUNT > node) {
+		nodePoolTable[node].stats.requestCounter++;
+	}
+}
+
+/**
+ * This function adds the latency of a response to the
+ * average of its node. A response makes the node healthy
+ * again.
+ *
+ * @param[in] node
+ * This variable holds the index of the node
+ *
+ * @param[in] latency
+ * Time from sending the request until the response was
+ * received in ms
+ *
+ * @return
+ * void
+ */
+void NodePoolReportResponse(uint8_t node, uint32_t latency)
+{
+	nodePoolEntry_T *entry_ptr = NULL;
+	int32_t delta = 0;
+
+	if(NODE_POOL_ENDPOINT_COUNT <= node) {
+		return;
+	}
+	entry_ptr = &nodePoolTable[node];
+
+	taskENTER_CRITICAL();
+	if(0 == entry_ptr->stats.responseCounter) {
+		entry_ptr->ewmaLatencyScaled = latency * NODE_POOL_EWMA_SCALE;
+	} else {
+		delta = (int32_t) (latency * NODE_POOL_EWMA_SCALE) - (int32_t) entry_ptr->ewmaLatencyScaled;
+		entry_ptr->ewmaLatencyScaled = (uint32_t) ((int32_t) entry_ptr->ewmaLatencyScaled + (delta / NODE_POOL_EWMA_WEIGHT));
+	}
+	entry_ptr->stats.ewmaLatency = entry_ptr->ewmaLatencyScaled / NODE_POOL_EWMA_SCALE;
+	entry_ptr->stats.lastLatency = latency;
+	entry_ptr->stats.responseCounter++;
+	entry_ptr->stats.failuresInRow = 0;
+	entry_ptr->stats.healthy = true;
+	entry_ptr->lastResponseTick = xTaskGetTickCount();
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * This function counts a timeout or connection error of
+ * a node. After NODE_POOL_FAILURE_THRESHOLD failures in a
+ * row the node is unhealthy until it answers again.
+ *
+ * @param[in] node
+ * This variable holds the index of the node
+ *
+ * @return
+ * void
+ */
+void NodePoolReportFailure(uint8_t node)
+{
+	NodePoolStats_T *stats_ptr = NULL;
+
+	if(NODE_POOL_ENDPOINT_COUNT <= node) {
+		return;
+	}
+	stats_ptr = &nodePoolTable[node].stats;
+
+	taskENTER_CRITICAL();
+	stats_ptr->failureCounter++;
+	if(UINT8_MAX > stats_ptr->failuresInRow) {
+		stats_ptr->failuresInRow++;
+	}
+	if(NODE_POOL_FAILURE_THRESHOLD <= stats_ptr->failuresInRow) {
+		stats_ptr->healthy = false;
+	}
+	taskEXIT_CRITICAL();
+
+#ifdef ENABLE_DEBUG
+	if(false == stats_ptr->healthy) {
+		printf("Node %u (%s) is unhealthy\n\r", (unsigned int) node, NodePoolEndpoints[node].address_ptr);
+	}
+#endif
+}
+
+/**
+ * This function counts a request which is moved from a
+ * node to another one
+ *
+ * @param[in] node
+ * This variable holds the index of the node which failed
+ *
+ * @return
+ * void
+ */
+void NodePoolReportFailover(uint8_t node)
+{
+	if(NODE_POOL_ENDPOINT_COUNT > node) {
+		nodePoolTable[node].stats.failoverCounter++;
+	}
+}
+
+/**
+ * This function copies the health and the counters of
+ * a node
+ *
+ * @param[in] node
+ * This variable holds the index of the node
+ *
+ * @param[out] oStats_ptr
+ * This reference will hold the counter values
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T NodePoolGetStats(uint8_t node, NodePoolStats_T *oStats_ptr)
+{
+	if( (NODE_POOL_ENDPOINT_COUNT <= node) || (NULL == oStats_ptr) ) {
+		return RETCODE_FAILURE;
+	}
+
+	taskENTER_CRITICAL();
+	*oStats_ptr = nodePoolTable[node].stats;
+	taskEXIT_CRITICAL();
+
+	return RETCODE_SUCCESS;
+}
+
+#ifdef ENABLE_NODE_POOL
+/**
+ * This function is the task of the node pool. Every
+ * NODE_POOL_PROBE_INTERVAL_MS it calls eth_blockNumber on
+ * the nodes which did not answer a request during the last
+ * interval. So the latency of idle nodes stays current and
+ * unhealthy nodes are used again once they answer.
+ *
+ * @param[in] pvParameters
+ * Task parameters - not used
+ *
+ * @return
+ * void
+ */
+void NodePoolProbeCyclic(void* pvParameters)
+{
+	(void) pvParameters;
+	portTickType lastResponseTick = 0;
+	NodePoolStats_T stats;
+
+	for(;;) {
+		vTaskDelay((portTickType) (NODE_POOL_PROBE_INTERVAL_MS / portTICK_RATE_MS));
+
+		for(uint8_t node = 0; node < NODE_POOL_ENDPOINT_COUNT; ++node) {
+			taskENTER_CRITICAL();
+			lastResponseTick = nodePoolTable[node].lastResponseTick;
+			taskEXIT_CRITICAL();
+
+			if( (0 == nodePoolTable[node].stats.responseCounter) || (false == nodePoolTable[node].stats.healthy)
+					|| (NODE_POOL_PROBE_INTERVAL_MS <= TICKS_TO_MS(xTaskGetTickCount() - lastResponseTick)) ) {
+				nodePoolTable[node].stats.probeCounter++;
+				(void) HttpProbeNode(node);
+			}
+
+#ifdef ENABLE_DEBUG
+			(void) NodePoolGetStats(node, &stats);
+			printf("Node %u (%s): %s, latency %lu ms, %lu requests, %lu failures, %lu failovers\n\r", (unsigned int) node, NodePoolEndpoints[node].address_ptr,
+					(true == stats.healthy) ? "healthy" : "unhealthy", (unsigned long) stats.ewmaLatency, (unsigned long) stats.requestCounter,
+					(unsigned long) stats.failureCounter, (unsigned long) stats.failoverCounter);
+#else
+			(void) stats;
+#endif
+		}
+	}
+}
+#endif
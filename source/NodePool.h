@@ -0,0 +1,64 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_NODEPOOL_H_
+#define SOURCE_NODEPOOL_H_
+
+/* maximum number of json-rpc nodes in NODE_POOL_ENDPOINTS */
+#define NODE_POOL_ENDPOINT_MAX	4
+
+/* index of the first node - it holds the unlocked accounts of
+ * eth_sendTransaction and the filters of the confirmation tracker */
+#define NODE_POOL_PRIMARY		0
+
+/* returned by NodePoolSelect if no node is left */
+#define NODE_POOL_NODE_NONE		0xFF
+
+/* bit of a node in the exclude mask of NodePoolSelect */
+#define NODE_POOL_NODE_BIT(node)	(UINT32_C(1) << (node))
+
+/* weight of the latency average - every response moves the
+ * average by 1/NODE_POOL_EWMA_WEIGHT towards its latency */
+#define NODE_POOL_EWMA_WEIGHT	4
+
+/* one json-rpc node */
+typedef struct NodePoolEndpoint_S {
+	uint8_t const *address_ptr;	/* ipv4 address e.g. "192.168.0.10" */
+	uint8_t const *host_ptr;	/* value of the http host header */
+	uint16_t port;
+} NodePoolEndpoint_T;
+
+/* health and counters of one node - all times in milliseconds */
+typedef struct NodePoolStats_S {
+	bool healthy;
+	uint8_t failuresInRow;
+	uint32_t ewmaLatency;		/* moving average of the response latency */
+	uint32_t lastLatency;
+	uint32_t requestCounter;
+	uint32_t responseCounter;
+	uint32_t failureCounter;	/* timeouts and connection errors */
+	uint32_t failoverCounter;	/* requests moved to another node after a failure */
+	uint32_t probeCounter;
+} NodePoolStats_T;
+
+/* global interface task declarations */
+xTaskHandle NodePoolProbeTask;
+
+/* global interface function declarations */
+Retcode_T NodePoolInit(void);
+uint8_t NodePoolGetCount(void);
+NodePoolEndpoint_T const *NodePoolGetEndpoint(uint8_t node);
+uint8_t NodePoolSelect(bool preferPrimary, uint32_t excludeMask);
+void NodePoolReportRequest(uint8_t node);
+void NodePoolReportResponse(uint8_t node, uint32_t latency);
+void NodePoolReportFailure(uint8_t node);
+void NodePoolReportFailover(uint8_t node);
+Retcode_T NodePoolGetStats(uint8_t node, NodePoolStats_T *oStats_ptr);
+void NodePoolProbeCyclic(void* pvParameters);
+
+#endif /* SOURCE_NODEPOOL_H_ */
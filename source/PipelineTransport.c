@@ -0,0 +1,677 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <string.h>
+#include "BCDS_Basics.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "simplelink.h"
+
+/* user includes */
+#include "PipelineTransport.h"
+#include "Http.h"
+#include "NodePool.h"
+#include "UserConfig.h"
+#include "SystemConfig.h"
+
+/* request line and headers of every request */
+#define PIPELINE_REQUEST_HEADER		"POST %s HTTP/1.1\r\nHost: %s\r\nContent-Type: application/json\r\nContent-Length: %u\r\n\r\n"
+#define PIPELINE_REQUEST_HEADER_MAX	160
+
+/* responses of the node - a response must fit into the receive buffer */
+#define PIPELINE_STATUS_PREFIX		"HTTP/1."
+#define PIPELINE_HEADER_END			"\r\n\r\n"
+#define PIPELINE_RECEIVE_BUFFER_SIZE	(HTTP_REQUEST_PAYLOAD_SIZE + PIPELINE_RESPONSE_HEADER_MAX)
+
+/* the receive task parses the responses like the http client task */
+#define PIPELINE_TASK_STACK_SIZE	2048
+#define PIPELINE_TASK_PRIORITY		2
+
+/**
+ * This handler struct holds the socket of the http
+ * connection and the ids of the requests in flight on it.
+ * The node answers the requests in the order they were
+ * sent, so the oldest request gets the next response.
+ * Cancelled requests keep their place with the id
+ * TRANSPORT_REQUEST_NONE, their response is dropped.
+ */
+typedef struct pipelineHandler_S {
+	TransportCallbacks_T const *callbacks_ptr;
+	TransportState_T state;
+	int16_t socket;
+	SemaphoreHandle_t sendMutex;
+	SemaphoreHandle_t connectedSemaphore;
+	SemaphoreHandle_t answeredSemaphore;
+	xTaskHandle receiveTask;
+	uint32_t queue[PIPELINE_QUEUE_SIZE];
+	uint8_t queueHead;
+	uint8_t queueCount;
+	uint8_t depth;			/* requests which may be in flight on the connection */
+	uint8_t maxInFlight;	/* most requests in flight on the connection */
+	bool fallback;			/* the node closed a pipelined connection - one request at a time */
+	uint8_t headerBuff[PIPELINE_REQUEST_HEADER_MAX];
+	uint8_t receiveBuff[PIPELINE_RECEIVE_BUFFER_SIZE];
+	size_t receiveLength;
+} pipelineHandler_T;
+static pipelineHandler_T pipelineHandleVar = { .socket = -1 };
+
+/* connection, message and byte counters */
+static TransportStats_T pipelineStatsVar = {0};
+
+/**
+ * This function closes the connection if it still uses
+ * the given socket and informs the json rpc client, which
+ * fails the requests in flight. If the node closed a
+ * connection with several requests in flight and did not
+ * answer all of them, it does not support pipelining and
+ * the following connections send one request at a time.
+ *
+ * @param[in] socket
+ * This variable holds the socket which failed
+ *
+ * @param[in] byNode
+ * true if the node closed the connection
+ *
+ * @return
+ * void
+ */
+static void closeConnection(int16_t socket, bool byNode)
+{
+	bool closed = false;
+
+	taskENTER_CRITICAL();
+	if( (0 <= socket) && (socket == pipelineHandleVar.socket) ) {
+		if( (true == byNode) && (0 < pipelineHandleVar.queueCount) && (1 < pipelineHandleVar.maxInFlight) ) {
+			pipelineHandleVar.fallback = true;
+		}
+		pipelineHandleVar.socket = -1;
+		pipelineHandleVar.state = TRANSPORT_DISCONNECTED;
+		pipelineHandleVar.queueCount = 0;
+		pipelineHandleVar.receiveLength = 0;
+		closed = true;
+	}
+	taskEXIT_CRITICAL();
+
+	if(true == closed) {
+		(void) sl_Close(socket);
+#ifdef ENABLE_DEBUG
+		printf("HTTP pipeline connection closed%s\n\r", (true == pipelineHandleVar.fallback) ? " - pipelining disabled" : "");
+#endif
+		pipelineHandleVar.callbacks_ptr->stateChanged(NODE_POOL_PRIMARY, TRANSPORT_DISCONNECTED);
+		/* a sender may wait for a free place in the pipeline */
+		xSemaphoreGive(pipelineHandleVar.answeredSemaphore);
+	}
+}
+
+/**
+ * This function connects to the primary node of the node
+ * pool. The caller holds the send mutex.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T openConnection(void)
+{
+	SlSockAddrIn_t address;
+	SlTimeval_t timeout = { HTTPRESPONSE_SECONDSTOWAIT, 0 };
+	uint32_t ipAddress = 0;
+	int16_t socket = -1;
+	NodePoolEndpoint_T const *endpoint_ptr = NodePoolGetEndpoint(NODE_POOL_PRIMARY);
+
+	if( (NULL == endpoint_ptr) || (RETCODE_SUCCESS != TransportParseIPv4Address(endpoint_ptr->address_ptr, &ipAddress)) ) {
+		return RETCODE_FAILURE;
+	}
+	pipelineHandleVar.state = TRANSPORT_CONNECTING;
+	pipelineStatsVar.connectionCounter++;
+
+	socket = sl_Socket(SL_AF_INET, SL_SOCK_STREAM, SL_IPPROTO_TCP);
+	if(0 > socket) {
+		pipelineHandleVar.state = TRANSPORT_DISCONNECTED;
+		return RETCODE_FAILURE;
+	}
+
+	address.sin_family = SL_AF_INET;
+	address.sin_port = sl_Htons(endpoint_ptr->port);
+	address.sin_addr.s_addr = sl_Htonl(ipAddress);
+
+	/* the receive timeout lets the receive task notice a closed connection */
+	if( (0 > sl_SetSockOpt(socket, SL_SOL_SOCKET, SL_SO_RCVTIMEO, &timeout, sizeof(timeout)))
+			|| (0 > sl_Connect(socket, (SlSockAddr_t *) &address, sizeof(SlSockAddrIn_t))) ) {
+#ifdef ENABLE_DEBUG
+		printf("HTTP pipeline connect failed\n\r");
+#endif
+		(void) sl_Close(socket);
+		pipelineHandleVar.state = TRANSPORT_DISCONNECTED;
+		return RETCODE_FAILURE;
+	}
+
+	taskENTER_CRITICAL();
+	pipelineHandleVar.socket = socket;
+	pipelineHandleVar.state = TRANSPORT_CONNECTED;
+	pipelineHandleVar.queueHead = 0;
+	pipelineHandleVar.queueCount = 0;
+	pipelineHandleVar.maxInFlight = 0;
+	pipelineHandleVar.receiveLength = 0;
+	pipelineHandleVar.depth = (true == pipelineHandleVar.fallback) ? 1 : HTTP_PIPELINE_DEPTH;
+	taskEXIT_CRITICAL();
+#ifdef ENABLE_DEBUG
+	printf("HTTP pipeline connected to %s:%u, depth %u\n\r", endpoint_ptr->address_ptr, (unsigned int) endpoint_ptr->port, (unsigned int) pipelineHandleVar.depth);
+#endif
+	pipelineHandleVar.callbacks_ptr->stateChanged(NODE_POOL_PRIMARY, TRANSPORT_CONNECTED);
+
+	/* wake up the receive task */
+	xSemaphoreGive(pipelineHandleVar.connectedSemaphore);
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function compares the name of a header line
+ * case insensitive
+ *
+ * @param[in] line_ptr
+ * This reference holds the header line
+ *
+ * @param[in] lineEnd_ptr
+ * This reference holds the end of the header line
+ *
+ * @param[in] name_ptr
+ * This string holds the lower case header name with colon
+ *
+ * @return
+ * reference of the header value, NULL if the name does not match
+ */
+static uint8_t const *matchHeader(uint8_t const *line_ptr, uint8_t const *lineEnd_ptr, uint8_t const *name_ptr)
+{
+	for(; 0 != *name_ptr; ++line_ptr, ++name_ptr) {
+		if( (line_ptr >= lineEnd_ptr) || (*name_ptr != ((('A' <= *line_ptr) && ('Z' >= *line_ptr)) ? (*line_ptr + ('a' - 'A')) : *line_ptr)) ) {
+			return NULL;
+		}
+	}
+	while( (line_ptr < lineEnd_ptr) && (' ' == *line_ptr) ) {
+		line_ptr++;
+	}
+
+	return line_ptr;
+}
+
+/**
+ * This function parses the status line and the headers
+ * of a response. Responses with chunked transfer encoding
+ * have no content length and are not supported.
+ *
+ * @param[in] header_ptr
+ * This reference holds the response up to the empty line
+ *
+ * @param[in] iLength
+ * This variable holds the length of the headers
+ *
+ * @param[out] oStatus_ptr
+ * This reference will hold the http status code
+ *
+ * @param[out] oContentLength_ptr
+ * This reference will hold the length of the content
+ *
+ * @param[out] oClose_ptr
+ * This reference will be true if the node closes the
+ * connection after the response
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T parseResponseHeader(uint8_t const *header_ptr, size_t iLength, uint16_t *oStatus_ptr, size_t *oContentLength_ptr, bool *oClose_ptr)
+{
+	uint8_t const *end_ptr = header_ptr + iLength;
+	uint8_t const *line_ptr = header_ptr;
+	uint8_t const *lineEnd_ptr = NULL;
+	uint8_t const *value_ptr = NULL;
+	bool contentLength = false;
+
+	*oStatus_ptr = 0;
+	*oContentLength_ptr = 0;
+	*oClose_ptr = false;
+
+	/* status line e.g. HTTP/1.1 200 OK */
+	if( (iLength < (strlen(PIPELINE_STATUS_PREFIX) + 5)) || (0 != memcmp(header_ptr, PIPELINE_STATUS_PREFIX, strlen(PIPELINE_STATUS_PREFIX))) ) {
+		return RETCODE_FAILURE;
+	}
+	/* http/1.0 nodes close the connection after every response */
+	*oClose_ptr = ('0' == header_ptr[strlen(PIPELINE_STATUS_PREFIX)]);
+	for(uint8_t i = 0; i < 3; ++i) {
+		uint8_t digit = header_ptr[strlen(PIPELINE_STATUS_PREFIX) + 2 + i];
+		if( ('0' > digit) || ('9' < digit) ) {
+			return RETCODE_FAILURE;
+		}
+		*oStatus_ptr = *oStatus_ptr * 10 + (digit - '0');
+	}
+
+	while(line_ptr < end_ptr) {
+		for(lineEnd_ptr = line_ptr; (lineEnd_ptr < end_ptr) && ('\r' != *lineEnd_ptr); ++lineEnd_ptr) {
+		}
+		if(NULL != (value_ptr = matchHeader(line_ptr, lineEnd_ptr, "content-length:"))) {
+			for(; (value_ptr < lineEnd_ptr) && ('0' <= *value_ptr) && ('9' >= *value_ptr); ++value_ptr) {
+				*oContentLength_ptr = *oContentLength_ptr * 10 + (*value_ptr - '0');
+				contentLength = true;
+			}
+		} else if(NULL != (value_ptr = matchHeader(line_ptr, lineEnd_ptr, "connection:"))) {
+			*oClose_ptr = (NULL != matchHeader(value_ptr, lineEnd_ptr, "close"));
+		} else if(NULL != matchHeader(line_ptr, lineEnd_ptr, "transfer-encoding:")) {
+			return RETCODE_FAILURE;
+		}
+		line_ptr = lineEnd_ptr + 2;
+	}
+
+	return (true == contentLength) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function searches the end of the headers in the
+ * receive buffer
+ *
+ * @return
+ * length of the headers including the empty line, 0 if
+ * they are not complete yet
+ */
+static size_t findHeaderEnd(void)
+{
+	uint8_t const *buff_ptr = pipelineHandleVar.receiveBuff;
+
+	for(size_t i = 0; (i + strlen(PIPELINE_HEADER_END)) <= pipelineHandleVar.receiveLength; ++i) {
+		if(0 == memcmp(&buff_ptr[i], PIPELINE_HEADER_END, strlen(PIPELINE_HEADER_END))) {
+			return i + strlen(PIPELINE_HEADER_END);
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * This function receives the next response and passes
+ * its content to the json rpc client with the id of the
+ * oldest request in flight. Bytes of the following
+ * responses stay in the receive buffer. Responses which
+ * are no success are reported as failed request.
+ *
+ * @param[in] socket
+ * This variable holds the socket of the connection
+ *
+ * @param[out] oByNode_ptr
+ * This reference will be true if the node closed the
+ * connection or announced to close it
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful or no data arrived<br>
+ * RETCODE_FAILURE, if the connection has to be closed.
+ */
+static Retcode_T receiveResponse(int16_t socket, bool *oByNode_ptr)
+{
+	pipelineHandler_T *handle_ptr = &pipelineHandleVar;
+	int16_t received = 0;
+	size_t headerLength = findHeaderEnd();
+	size_t contentLength = 0;
+	uint16_t status = 0;
+	bool close = false;
+	uint32_t requestID = TRANSPORT_REQUEST_NONE;
+
+	/* the start of the response may have arrived with the one before */
+	if( (0 != headerLength) && (RETCODE_SUCCESS != parseResponseHeader(handle_ptr->receiveBuff, headerLength, &status, &contentLength, &close)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	/* read until the headers and the content are complete */
+	while( (0 == headerLength) || (handle_ptr->receiveLength < (headerLength + contentLength)) ) {
+		if(sizeof(handle_ptr->receiveBuff) <= handle_ptr->receiveLength) {
+#ifdef ENABLE_DEBUG
+			printf("HTTP pipeline response too large\n\r");
+#endif
+			return RETCODE_FAILURE;
+		}
+		received = sl_Recv(socket, &handle_ptr->receiveBuff[handle_ptr->receiveLength], (int16_t) (sizeof(handle_ptr->receiveBuff) - handle_ptr->receiveLength), 0);
+		if(0 < received) {
+			handle_ptr->receiveLength += (size_t) received;
+			pipelineStatsVar.bytesReceived += (uint32_t) received;
+		} else if( (SL_EAGAIN == received) && (socket == handle_ptr->socket) ) {
+			/* let the receive task check the connection between responses */
+			if(0 == handle_ptr->receiveLength) {
+				return RETCODE_SUCCESS;
+			}
+		} else {
+			*oByNode_ptr = (socket == handle_ptr->socket);
+			return RETCODE_FAILURE;
+		}
+
+		if(0 == headerLength) {
+			headerLength = findHeaderEnd();
+			if( (0 != headerLength) && (RETCODE_SUCCESS != parseResponseHeader(handle_ptr->receiveBuff, headerLength, &status, &contentLength, &close)) ) {
+				return RETCODE_FAILURE;
+			}
+		}
+	}
+
+	/* the oldest request gets the response */
+	taskENTER_CRITICAL();
+	if(0 < handle_ptr->queueCount) {
+		requestID = handle_ptr->queue[handle_ptr->queueHead];
+		handle_ptr->queueHead = (handle_ptr->queueHead + 1) % PIPELINE_QUEUE_SIZE;
+		handle_ptr->queueCount--;
+	} else {
+		close = true;
+	}
+	taskEXIT_CRITICAL();
+
+	pipelineStatsVar.messageReceivedCounter++;
+#ifdef ENABLE_DEBUG
+	printf("HTTP pipeline response %u for request %lu: %.*s\n\r", (unsigned int) status, (unsigned long) requestID, (int) contentLength, &handle_ptr->receiveBuff[headerLength]);
+#endif
+	if(TRANSPORT_REQUEST_NONE != requestID) {
+		if( (200 <= status) && (300 > status) ) {
+			(void) handle_ptr->callbacks_ptr->received(NODE_POOL_PRIMARY, requestID, &handle_ptr->receiveBuff[headerLength], contentLength);
+		} else {
+			(void) handle_ptr->callbacks_ptr->received(NODE_POOL_PRIMARY, requestID, NULL, 0);
+		}
+	}
+
+	/* keep the start of the next response */
+	handle_ptr->receiveLength -= headerLength + contentLength;
+	memmove(handle_ptr->receiveBuff, &handle_ptr->receiveBuff[headerLength + contentLength], handle_ptr->receiveLength);
+	xSemaphoreGive(handle_ptr->answeredSemaphore);
+
+	if(true == close) {
+		*oByNode_ptr = true;
+		return RETCODE_FAILURE;
+	}
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This task receives the responses of the node while
+ * the connection is open. It sleeps until the next
+ * connection is opened by a request.
+ *
+ * @param[in] pvParameters
+ * unused
+ *
+ * @return
+ * void
+ */
+static void pipelineReceiveTask(void *pvParameters)
+{
+	int16_t socket = -1;
+	bool byNode = false;
+
+	(void) pvParameters;
+
+	for(;;) {
+		if(TRANSPORT_CONNECTED != pipelineHandleVar.state) {
+			(void) xSemaphoreTake(pipelineHandleVar.connectedSemaphore, portMAX_DELAY);
+			continue;
+		}
+		socket = pipelineHandleVar.socket;
+		byNode = false;
+		if(RETCODE_SUCCESS != receiveResponse(socket, &byNode)) {
+			closeConnection(socket, byNode);
+		}
+	}
+}
+
+/**
+ * This function creates the semaphores and the receive
+ * task. The connection is opened with the first request.
+ *
+ * @param[in] callbacks_ptr
+ * This reference holds the callbacks of the json rpc client
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T pipelineTransportInit(TransportCallbacks_T const *callbacks_ptr)
+{
+	if(NULL == callbacks_ptr) {
+		return RETCODE_FAILURE;
+	}
+	pipelineHandleVar.callbacks_ptr = callbacks_ptr;
+
+	if(NULL == pipelineHandleVar.sendMutex) {
+		pipelineHandleVar.sendMutex = xSemaphoreCreateMutex();
+	}
+	if(NULL == pipelineHandleVar.connectedSemaphore) {
+		pipelineHandleVar.connectedSemaphore = xSemaphoreCreateBinary();
+	}
+	if(NULL == pipelineHandleVar.answeredSemaphore) {
+		pipelineHandleVar.answeredSemaphore = xSemaphoreCreateBinary();
+	}
+	if( (NULL == pipelineHandleVar.sendMutex) || (NULL == pipelineHandleVar.connectedSemaphore) || (NULL == pipelineHandleVar.answeredSemaphore) ) {
+		return RETCODE_FAILURE;
+	}
+
+	if( (NULL == pipelineHandleVar.receiveTask)
+			&& (pdPASS != xTaskCreate(pipelineReceiveTask, (const char * const) "HttpPipeline", PIPELINE_TASK_STACK_SIZE, NULL, PIPELINE_TASK_PRIORITY, &pipelineHandleVar.receiveTask)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function writes a json rpc request to the
+ * connection without waiting for the responses of the
+ * requests before. If the pipeline is full, it waits until
+ * the oldest request is answered. The connection is opened
+ * if necessary.
+ *
+ * @param[in] node
+ * This variable holds the node - the connection always
+ * goes to the primary node
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @param[in] payload_ptr
+ * This reference holds the json rpc request
+ *
+ * @param[in] iLength
+ * This variable holds the length of the request
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T pipelineTransportSend(uint8_t node, uint32_t requestID, uint8_t const *payload_ptr, size_t iLength)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	int16_t socket = -1;
+	int headerLength = 0;
+	NodePoolEndpoint_T const *endpoint_ptr = NodePoolGetEndpoint(NODE_POOL_PRIMARY);
+
+	(void) node;
+
+	if( (NULL == endpoint_ptr) || (pdTRUE != xSemaphoreTake(pipelineHandleVar.sendMutex, SECONDS(HTTPRESPONSE_SECONDSTOWAIT))) ) {
+		return ret;
+	}
+
+	if(TRANSPORT_CONNECTED == pipelineHandleVar.state) {
+		ret = RETCODE_SUCCESS;
+	} else {
+		ret = openConnection();
+	}
+	/* wait for a place in the pipeline */
+	while( (RETCODE_SUCCESS == ret) && (TRANSPORT_CONNECTED == pipelineHandleVar.state) && (pipelineHandleVar.queueCount >= pipelineHandleVar.depth) ) {
+		if(pdTRUE != xSemaphoreTake(pipelineHandleVar.answeredSemaphore, SECONDS(HTTPRESPONSE_SECONDSTOWAIT))) {
+			ret = RETCODE_FAILURE;
+		}
+	}
+	socket = pipelineHandleVar.socket;
+	if( (RETCODE_SUCCESS == ret) && (TRANSPORT_CONNECTED != pipelineHandleVar.state) ) {
+		ret = RETCODE_FAILURE;
+	}
+
+	if(RETCODE_SUCCESS == ret) {
+		headerLength = snprintf((char *) pipelineHandleVar.headerBuff, sizeof(pipelineHandleVar.headerBuff), PIPELINE_REQUEST_HEADER,
+				DESTINATION_POST_PATH, endpoint_ptr->host_ptr, (unsigned int) iLength);
+		if( (0 > headerLength) || (sizeof(pipelineHandleVar.headerBuff) <= (size_t) headerLength) ) {
+			ret = RETCODE_FAILURE;
+		}
+	}
+	if(RETCODE_SUCCESS == ret) {
+		/* the response may arrive before the send returns */
+		taskENTER_CRITICAL();
+		pipelineHandleVar.queue[(pipelineHandleVar.queueHead + pipelineHandleVar.queueCount) % PIPELINE_QUEUE_SIZE] = requestID;
+		pipelineHandleVar.queueCount++;
+		if(pipelineHandleVar.queueCount > pipelineHandleVar.maxInFlight) {
+			pipelineHandleVar.maxInFlight = pipelineHandleVar.queueCount;
+		}
+		taskEXIT_CRITICAL();
+
+		ret = TransportSendAll(socket, pipelineHandleVar.headerBuff, (size_t) headerLength, &pipelineStatsVar);
+		if(RETCODE_SUCCESS == ret) {
+			ret = TransportSendAll(socket, payload_ptr, iLength, &pipelineStatsVar);
+		}
+	}
+	if(RETCODE_SUCCESS == ret) {
+		pipelineStatsVar.messageSentCounter++;
+	}
+
+	xSemaphoreGive(pipelineHandleVar.sendMutex);
+
+	if(RETCODE_SUCCESS == ret) {
+		pipelineHandleVar.callbacks_ptr->sent(NODE_POOL_PRIMARY, requestID, RETCODE_SUCCESS);
+	} else {
+		/* a partly written request breaks the framing of the connection */
+		closeConnection(socket, false);
+	}
+
+	return ret;
+}
+
+/**
+ * This function returns the connection state
+ *
+ * @return
+ * state of the http connection
+ */
+static TransportState_T pipelineTransportGetState(void)
+{
+	return pipelineHandleVar.state;
+}
+
+/**
+ * This function closes the connection. Requests in
+ * flight are failed, the next request connects again.
+ *
+ * @param[in] node
+ * This variable holds the node - there is only the
+ * connection to the primary node
+ *
+ * @return
+ * void
+ */
+static void pipelineTransportDisconnect(uint8_t node)
+{
+	(void) node;
+
+	closeConnection(pipelineHandleVar.socket, false);
+}
+
+/**
+ * This function forgets one request. The response of a
+ * request behind the oldest one is dropped when it arrives.
+ * If the oldest request is cancelled, the node does not
+ * answer it and blocks the pipeline, so the connection is
+ * closed - the other requests in flight are failed and
+ * retried on a new connection.
+ *
+ * @param[in] node
+ * This variable holds the node - there is only the
+ * connection to the primary node
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @return
+ * void
+ */
+static void pipelineTransportCancel(uint8_t node, uint32_t requestID)
+{
+	bool stalled = false;
+
+	(void) node;
+
+	taskENTER_CRITICAL();
+	for(uint8_t i = 0; i < pipelineHandleVar.queueCount; ++i) {
+		uint8_t position = (pipelineHandleVar.queueHead + i) % PIPELINE_QUEUE_SIZE;
+		if(requestID == pipelineHandleVar.queue[position]) {
+			pipelineHandleVar.queue[position] = TRANSPORT_REQUEST_NONE;
+			stalled = (0 == i);
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if(true == stalled) {
+		closeConnection(pipelineHandleVar.socket, false);
+	}
+}
+
+/**
+ * This function copies the counters of the transport
+ *
+ * @param[out] oStats_ptr
+ * This reference will hold the counter values
+ *
+ * @return
+ * void
+ */
+static void pipelineTransportGetStats(TransportStats_T *oStats_ptr)
+{
+	if(NULL != oStats_ptr) {
+		*oStats_ptr = pipelineStatsVar;
+	}
+}
+
+static const Transport_T PipelineTransport = {
+	"http-pipeline",
+	false,
+	pipelineTransportInit,
+	pipelineTransportSend,
+	pipelineTransportGetState,
+	pipelineTransportDisconnect,
+	pipelineTransportCancel,
+	pipelineTransportGetStats
+};
+
+/**
+ * This function returns the transport which writes the
+ * json rpc requests as pipelined http/1.1 posts to one
+ * persistent connection to the primary node
+ *
+ * @return
+ * reference of the transport
+ */
+Transport_T const *PipelineTransportGet(void)
+{
+	return &PipelineTransport;
+}
+
+/**
+ * This function returns how many requests may be in
+ * flight on the next connection
+ *
+ * @return
+ * HTTP_PIPELINE_DEPTH, 1 after the node closed a
+ * pipelined connection
+ */
+uint8_t PipelineTransportGetDepth(void)
+{
+	return (true == pipelineHandleVar.fallback) ? 1 : HTTP_PIPELINE_DEPTH;
+}
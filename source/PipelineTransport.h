@@ -0,0 +1,25 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_PIPELINETRANSPORT_H_
+#define SOURCE_PIPELINETRANSPORT_H_
+
+#include "Transport.h"
+
+/* number of requests which can be in flight on the connection - every
+ * request slot has at most one, cancelled requests keep their place */
+#define PIPELINE_QUEUE_SIZE			(2 * HTTP_REQUEST_SLOT_MAX)
+
+/* room for the status line and the headers of one response */
+#define PIPELINE_RESPONSE_HEADER_MAX	512
+
+/* global interface function declarations */
+Transport_T const *PipelineTransportGet(void);
+uint8_t PipelineTransportGetDepth(void);
+
+#endif /* SOURCE_PIPELINETRANSPORT_H_ */
@@ -0,0 +1,17 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* generated by tools/gen_keys.py from source/UserConfig.h - do not edit */
+
+#ifndef SOURCE_RSAKEYS_H_
+#define SOURCE_RSAKEYS_H_
+
+/* no private consumer key configured */
+#define RSA_KEY_CONSUMER_AVAILABLE	0
+
+#endif /* SOURCE_RSAKEYS_H_ */
@@ -0,0 +1,404 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "BCDS_Basics.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* user includes */
+#include "ReadCache.h"
+#include "UserConfig.h"
+#include "SystemConfig.h"
+#include "LruTable.h"
+#include "HexCodec.h"
+
+/* FNV-1a parameters of the arguments hash */
+#define READ_CACHE_FNV_OFFSET		UINT32_C(2166136261)
+#define READ_CACHE_FNV_PRIME		UINT32_C(16777619)
+
+/**
+ * This struct holds one cached view call result. The
+ * result is the hex string of the json rpc response and
+ * is at least as fresh as the block it is tagged with.
+ */
+typedef struct readCacheEntry_S {
+	LruTableEntry_T lru;
+	ReadCacheKey_T key;
+	uint64_t block;
+	size_t length;
+	uint8_t result[READ_CACHE_RESULT_SIZE];
+} readCacheEntry_T;
+static readCacheEntry_T readCacheTable[READ_CACHE_ENTRY_MAX];
+
+/**
+ * This handler struct holds the latest block number known
+ * from the node and when it was confirmed last
+ */
+typedef struct readCacheHandler_S {
+	SemaphoreHandle_t mutex;
+	bool blockValid;
+	uint64_t block;
+	portTickType blockTick;
+	uint64_t storeMinBlock;		/* results of older blocks were requested before the last invalidation */
+} readCacheHandler_T;
+static readCacheHandler_T readCacheHandleVar = {0};
+
+/* hit and miss counters */
+static ReadCacheStats_T readCacheStatsVar = {0};
+
+/**
+ * This function continues the FNV-1a hash of the
+ * arguments of a view call
+ *
+ * @param[in] hash
+ * hash of the previous data
+ *
+ * @param[in] data_ptr
+ * This reference holds the data
+ *
+ * @param[in] iLength
+ * Length of the data
+ *
+ * @return
+ * hash including the data
+ */
+static uint32_t hashArguments(uint32_t hash, uint8_t const *data_ptr, size_t iLength)
+{
+	for(size_t i = 0; i < iLength; ++i) {
+		hash = (hash ^ data_ptr[i]) * READ_CACHE_FNV_PRIME;
+	}
+
+	return hash;
+}
+
+/**
+ * This function drops all entries which are older than
+ * the latest known block. Must be called with the mutex.
+ *
+ * @return
+ * void
+ */
+static void dropOutdatedEntries(void)
+{
+	for(uint8_t entry = 0; entry < READ_CACHE_ENTRY_MAX; ++entry) {
+		if( (true == readCacheTable[entry].lru.valid) && (readCacheTable[entry].block < readCacheHandleVar.block) ) {
+			readCacheTable[entry].lru.valid = false;
+			readCacheStatsVar.invalidationCounter++;
+		}
+	}
+}
+
+/**
+ * This function creates the mutex of the read cache.
+ * Without it all lookups miss and nothing is stored.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T ReadCacheInit(void)
+{
+	if(NULL == readCacheHandleVar.mutex) {
+		readCacheHandleVar.mutex = xSemaphoreCreateMutex();
+	}
+
+	return (NULL != readCacheHandleVar.mutex) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function creates the cache key of a view call
+ *
+ * @param[in] contractAddress_ptr
+ * This string holds the contract address with or without 0x
+ *
+ * @param[in] selector
+ * Function selector of the view function
+ *
+ * @param[in] senderAddress_ptr
+ * This string holds the sender address of the call
+ *
+ * @param[in] args_ptr
+ * This reference holds the arguments of the call. Can be NULL.
+ *
+ * @param[in] iArgsLength
+ * Length of the arguments
+ *
+ * @param[out] oKey_ptr
+ * This reference will hold the key
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T ReadCacheMakeKey(uint8_t const *contractAddress_ptr, uint32_t selector, uint8_t const *senderAddress_ptr, uint8_t const *args_ptr, size_t iArgsLength, ReadCacheKey_T *oKey_ptr)
+{
+	if( (NULL == contractAddress_ptr) || (NULL == senderAddress_ptr) || (NULL == oKey_ptr) ) {
+		return RETCODE_FAILURE;
+	}
+
+	if( ('0' == contractAddress_ptr[0]) && ('x' == contractAddress_ptr[1]) ) {
+		contractAddress_ptr += 2;
+	}
+	if( ((READ_CACHE_ADDRESS_SIZE * 2) != strlen(contractAddress_ptr)) ||
+		(RETCODE_SUCCESS != HexDecode(contractAddress_ptr, READ_CACHE_ADDRESS_SIZE * 2, oKey_ptr->contract)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	oKey_ptr->selector = selector;
+	oKey_ptr->argsHash = hashArguments(READ_CACHE_FNV_OFFSET, senderAddress_ptr, strlen(senderAddress_ptr));
+	if(NULL != args_ptr) {
+		oKey_ptr->argsHash = hashArguments(oKey_ptr->argsHash, args_ptr, iArgsLength);
+	}
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function searches a cached result which is at
+ * least as fresh as the given block
+ *
+ * @param[in] key_ptr
+ * This reference holds the key of the view call
+ *
+ * @param[in] minBlock
+ * Oldest block the result may be read at
+ *
+ * @param[out] oResult_ptr
+ * Output buffer for the hex result - it is not null terminated
+ *
+ * @param[in] iBuffSize
+ * Size of the output buffer
+ *
+ * @param[out] oLength_ptr
+ * This reference will hold the length of the result
+ *
+ * @return
+ * true, if the result was found<br>
+ * false, otherwise.
+ */
+bool ReadCacheLookup(ReadCacheKey_T const *key_ptr, uint64_t minBlock, uint8_t *oResult_ptr, size_t iBuffSize, size_t *oLength_ptr)
+{
+	bool hit = false;
+	readCacheEntry_T *entry_ptr = NULL;
+
+	if( (NULL == key_ptr) || (NULL == oResult_ptr) || (NULL == oLength_ptr) || (NULL == readCacheHandleVar.mutex) ) {
+		return hit;
+	}
+	if(pdTRUE != xSemaphoreTake(readCacheHandleVar.mutex, portMAX_DELAY)) {
+		return hit;
+	}
+
+	for(uint8_t entry = 0; entry < READ_CACHE_ENTRY_MAX; ++entry) {
+		if( (true == readCacheTable[entry].lru.valid) && (0 == memcmp(&readCacheTable[entry].key, key_ptr, sizeof(ReadCacheKey_T))) ) {
+			entry_ptr = &readCacheTable[entry];
+			break;
+		}
+	}
+
+	if( (NULL != entry_ptr) && (entry_ptr->block >= minBlock) && (entry_ptr->length <= iBuffSize) ) {
+		memcpy(oResult_ptr, entry_ptr->result, entry_ptr->length);
+		*oLength_ptr = entry_ptr->length;
+		entry_ptr->lru.lastUseTick = xTaskGetTickCount();
+		readCacheStatsVar.hitCounter++;
+		hit = true;
+	} else {
+		if(NULL != entry_ptr) {
+			readCacheStatsVar.staleCounter++;
+		}
+		readCacheStatsVar.missCounter++;
+	}
+
+	xSemaphoreGive(readCacheHandleVar.mutex);
+
+#ifdef ENABLE_DEBUG
+	printf("Read cache %s at block %lu, hits %lu, misses %lu\n\r", (true == hit) ? "hit" : "miss", (unsigned long) minBlock,
+			(unsigned long) readCacheStatsVar.hitCounter, (unsigned long) readCacheStatsVar.missCounter);
+#endif
+
+	return hit;
+}
+
+/**
+ * This function stores the result of a view call. A result
+ * which was requested before the latest known block or before
+ * an invalidation is not stored. The least recently used
+ * entry is replaced.
+ *
+ * @param[in] key_ptr
+ * This reference holds the key of the view call
+ *
+ * @param[in] block
+ * Latest block which was known when the call was sent
+ *
+ * @param[in] result_ptr
+ * This reference holds the hex result of the call
+ *
+ * @param[in] iLength
+ * Length of the result
+ *
+ * @return
+ * void
+ */
+void ReadCacheStore(ReadCacheKey_T const *key_ptr, uint64_t block, uint8_t const *result_ptr, size_t iLength)
+{
+	readCacheEntry_T *entry_ptr = NULL;
+
+	if( (NULL == key_ptr) || (NULL == result_ptr) || (READ_CACHE_RESULT_SIZE < iLength) || (NULL == readCacheHandleVar.mutex) ) {
+		return;
+	}
+	if(pdTRUE != xSemaphoreTake(readCacheHandleVar.mutex, portMAX_DELAY)) {
+		return;
+	}
+
+	if( (true == readCacheHandleVar.blockValid) && (block >= readCacheHandleVar.block) && (block >= readCacheHandleVar.storeMinBlock) ) {
+		entry_ptr = LruTableSelectEntry(readCacheTable, sizeof(readCacheEntry_T), READ_CACHE_ENTRY_MAX, offsetof(readCacheEntry_T, key), key_ptr, sizeof(ReadCacheKey_T));
+
+		entry_ptr->key = *key_ptr;
+		entry_ptr->block = block;
+		entry_ptr->lru.lastUseTick = xTaskGetTickCount();
+		entry_ptr->length = iLength;
+		memcpy(entry_ptr->result, result_ptr, iLength);
+		entry_ptr->lru.valid = true;
+		readCacheStatsVar.storeCounter++;
+	}
+
+	xSemaphoreGive(readCacheHandleVar.mutex);
+}
+
+/**
+ * This function drops all cached results, e.g. after a
+ * transaction of the device changed the contract state or
+ * the producer announced new data. The block number is read
+ * from the node again. Results which are still in flight are
+ * not stored, only results of a later block are cached again.
+ *
+ * @return
+ * void
+ */
+void ReadCacheInvalidate(void)
+{
+	if( (NULL == readCacheHandleVar.mutex) || (pdTRUE != xSemaphoreTake(readCacheHandleVar.mutex, portMAX_DELAY)) ) {
+		return;
+	}
+
+	for(uint8_t entry = 0; entry < READ_CACHE_ENTRY_MAX; ++entry) {
+		if(true == readCacheTable[entry].lru.valid) {
+			readCacheTable[entry].lru.valid = false;
+			readCacheStatsVar.invalidationCounter++;
+		}
+	}
+	readCacheHandleVar.blockValid = false;
+	readCacheHandleVar.storeMinBlock = readCacheHandleVar.block + 1;
+
+	xSemaphoreGive(readCacheHandleVar.mutex);
+}
+
+/**
+ * This function sets the latest block number e.g. from
+ * an eth_blockNumber result. Results of older blocks are
+ * dropped.
+ *
+ * @param[in] block
+ * Block number reported by the node
+ *
+ * @return
+ * void
+ */
+void ReadCacheSetBlockNumber(uint64_t block)
+{
+	if( (NULL == readCacheHandleVar.mutex) || (pdTRUE != xSemaphoreTake(readCacheHandleVar.mutex, portMAX_DELAY)) ) {
+		return;
+	}
+
+	/* a load balanced node may answer with an older block */
+	if( (false == readCacheHandleVar.blockValid) || (block > readCacheHandleVar.block) ) {
+		readCacheHandleVar.block = block;
+		readCacheHandleVar.blockValid = true;
+		dropOutdatedEntries();
+	}
+	if(block >= readCacheHandleVar.block) {
+		readCacheHandleVar.blockTick = xTaskGetTickCount();
+	}
+	readCacheStatsVar.blockNumberCounter++;
+
+	xSemaphoreGive(readCacheHandleVar.mutex);
+}
+
+/**
+ * This function advances the latest block number by the
+ * blocks a block filter poll reported. A poll without new
+ * blocks confirms that the block number is still current.
+ *
+ * @param[in] newBlocks
+ * Number of blocks since the last filter poll
+ *
+ * @return
+ * void
+ */
+void ReadCacheAddBlocks(uint16_t newBlocks)
+{
+	if( (NULL == readCacheHandleVar.mutex) || (pdTRUE != xSemaphoreTake(readCacheHandleVar.mutex, portMAX_DELAY)) ) {
+		return;
+	}
+
+	if(true == readCacheHandleVar.blockValid) {
+		readCacheHandleVar.block += newBlocks;
+		readCacheHandleVar.blockTick = xTaskGetTickCount();
+		dropOutdatedEntries();
+	}
+
+	xSemaphoreGive(readCacheHandleVar.mutex);
+}
+
+/**
+ * This function returns the latest known block number.
+ * It is only current for READ_CACHE_BLOCK_NUMBER_MAX_AGE_MS
+ * after the node reported it.
+ *
+ * @param[out] oBlock_ptr
+ * This reference will hold the block number
+ *
+ * @return
+ * true, if the block number is current<br>
+ * false, if it has to be read from the node.
+ */
+bool ReadCacheGetBlockNumber(uint64_t *oBlock_ptr)
+{
+	bool current = false;
+
+	taskENTER_CRITICAL();
+	if( (true == readCacheHandleVar.blockValid) && (READ_CACHE_BLOCK_NUMBER_MAX_AGE_MS >= TICKS_TO_MS(xTaskGetTickCount() - readCacheHandleVar.blockTick)) ) {
+		*oBlock_ptr = readCacheHandleVar.block;
+		current = true;
+	}
+	taskEXIT_CRITICAL();
+
+	return current;
+}
+
+/**
+ * This function copies the hit and miss counters
+ * of the read cache
+ *
+ * @param[out] oStats_ptr
+ * This reference will hold the counter values
+ *
+ * @return
+ * void
+ */
+void ReadCacheGetStats(ReadCacheStats_T *oStats_ptr)
+{
+	if(NULL != oStats_ptr) {
+		*oStats_ptr = readCacheStatsVar;
+	}
+}
@@ -0,0 +1,54 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_READCACHE_H_
+#define SOURCE_READCACHE_H_
+
+/* number of cached view call results - one per contract read function */
+#define READ_CACHE_ENTRY_MAX		2
+
+/* size of one cached result in hex characters - ReadPublicKey
+ * returns 770 characters for a 1024 bit key */
+#define READ_CACHE_RESULT_SIZE		800
+
+/* size of the contract address in a cache key */
+#define READ_CACHE_ADDRESS_SIZE		20
+
+/**
+ * key of a cached view call. The sender is part of the
+ * arguments hash because view functions like ReadPublicKey
+ * depend on msg.sender.
+ */
+typedef struct ReadCacheKey_S {
+	uint8_t contract[READ_CACHE_ADDRESS_SIZE];
+	uint32_t selector;
+	uint32_t argsHash;
+} ReadCacheKey_T;
+
+/* hit and miss counters of the read cache */
+typedef struct ReadCacheStats_S {
+	uint32_t hitCounter;
+	uint32_t missCounter;
+	uint32_t staleCounter;			/* misses of entries older than the requested block */
+	uint32_t storeCounter;
+	uint32_t invalidationCounter;	/* entries dropped by new blocks or transactions */
+	uint32_t blockNumberCounter;	/* block numbers read from the node */
+} ReadCacheStats_T;
+
+/* global interface function declarations */
+Retcode_T ReadCacheInit(void);
+Retcode_T ReadCacheMakeKey(uint8_t const *contractAddress_ptr, uint32_t selector, uint8_t const *senderAddress_ptr, uint8_t const *args_ptr, size_t iArgsLength, ReadCacheKey_T *oKey_ptr);
+bool ReadCacheLookup(ReadCacheKey_T const *key_ptr, uint64_t minBlock, uint8_t *oResult_ptr, size_t iBuffSize, size_t *oLength_ptr);
+void ReadCacheStore(ReadCacheKey_T const *key_ptr, uint64_t block, uint8_t const *result_ptr, size_t iLength);
+void ReadCacheInvalidate(void);
+void ReadCacheSetBlockNumber(uint64_t block);
+void ReadCacheAddBlocks(uint16_t newBlocks);
+bool ReadCacheGetBlockNumber(uint64_t *oBlock_ptr);
+void ReadCacheGetStats(ReadCacheStats_T *oStats_ptr);
+
+#endif /* SOURCE_READCACHE_H_ */
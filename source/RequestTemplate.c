@@ -0,0 +1,300 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "BCDS_Basics.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* user includes */
+#include "JSONWriter.h"
+#include "RequestTemplate.h"
+#include "UserConfig.h"
+#include "SystemConfig.h"
+#include "LruTable.h"
+
+/* keys of the patched values in the serialized call */
+#define REQUEST_TEMPLATE_GAS_KEY		"\"gas\":\"0x"
+#define REQUEST_TEMPLATE_ID_KEY			"\"id\":"
+
+/**
+ * This struct holds one serialized json rpc call. The
+ * call is copied in up to three parts, the gas limit and
+ * the id are written between them:
+ * text[0, gasOffset) gas text[gasEnd, idOffset) id text[idEnd, length)
+ * Calls without gas limit have gasOffset 0.
+ */
+typedef struct requestTemplateEntry_S {
+	LruTableEntry_T lru;
+	uint8_t method;
+	uint8_t senderAddress[REQUEST_TEMPLATE_ADDRESS_SIZE];
+	uint8_t receiverAddress[REQUEST_TEMPLATE_ADDRESS_SIZE];
+	uint8_t text[REQUEST_TEMPLATE_TEXT_SIZE];
+	uint16_t length;
+	uint16_t gasOffset;		/* first hex digit of the gas limit */
+	uint16_t gasEnd;		/* closing quote of the gas limit */
+	uint16_t idOffset;		/* first digit of the id */
+	uint16_t idEnd;			/* first character after the id */
+} requestTemplateEntry_T;
+static requestTemplateEntry_T requestTemplateTable[REQUEST_TEMPLATE_ENTRY_MAX];
+
+/* usage counters */
+static RequestTemplateStats_T requestTemplateStatsVar = {0};
+
+/* mutex of the table */
+static SemaphoreHandle_t requestTemplateMutex = NULL;
+
+/**
+ * This function searches a key in a serialized call
+ *
+ * @param[in] json_ptr
+ * This reference holds the serialized call
+ *
+ * @param[in] iLength
+ * Length of the serialized call
+ *
+ * @param[in] key_ptr
+ * This string holds the key including quotes and colon
+ *
+ * @param[in] last
+ * true to return the last occurrence, false for the first
+ *
+ * @return
+ * offset of the character after the key, 0 if it is not found
+ */
+static size_t findKey(uint8_t const *json_ptr, size_t iLength, uint8_t const *key_ptr, bool last)
+{
+	size_t keyLength = strlen(key_ptr);
+	size_t offset = 0;
+
+	for(size_t i = 0; (i + keyLength) <= iLength; ++i) {
+		if(0 == memcmp(&json_ptr[i], key_ptr, keyLength)) {
+			offset = i + keyLength;
+			if(false == last) {
+				break;
+			}
+		}
+	}
+
+	return offset;
+}
+
+/**
+ * This function searches the template of a call. Must be
+ * called with the mutex.
+ *
+ * @param[in] method
+ * Ethereum function of the call
+ *
+ * @param[in] senderAddress_ptr
+ * This string holds the sender address of the call
+ *
+ * @param[in] receiverAddress_ptr
+ * This string holds the contract address of the call
+ *
+ * @return
+ * reference of the entry, NULL if there is no template
+ */
+static requestTemplateEntry_T *findEntry(uint8_t method, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr)
+{
+	requestTemplateEntry_T *entry_ptr = NULL;
+
+	for(uint8_t entry = 0; entry < REQUEST_TEMPLATE_ENTRY_MAX; ++entry) {
+		entry_ptr = &requestTemplateTable[entry];
+		if( (true == entry_ptr->lru.valid) && (method == entry_ptr->method)
+				&& (0 == strncmp(entry_ptr->senderAddress, senderAddress_ptr, REQUEST_TEMPLATE_ADDRESS_SIZE))
+				&& (0 == strncmp(entry_ptr->receiverAddress, receiverAddress_ptr, REQUEST_TEMPLATE_ADDRESS_SIZE)) ) {
+			return entry_ptr;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * This function creates the mutex of the request templates.
+ * Without it every call is serialized with the JSON writer.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T RequestTemplateInit(void)
+{
+	if(NULL == requestTemplateMutex) {
+		requestTemplateMutex = xSemaphoreCreateMutex();
+	}
+
+	return (NULL != requestTemplateMutex) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function stores a serialized json rpc call as
+ * template of the following calls of the same function
+ * and addresses. The id and the gas limit of the call
+ * are replaced when the template is written. The entry
+ * of the same function with other addresses or the
+ * least recently used entry is replaced.
+ *
+ * @param[in] method
+ * Ethereum function (etherFuncCalls) of the call
+ *
+ * @param[in] senderAddress_ptr
+ * This string holds the sender address of the call
+ *
+ * @param[in] receiverAddress_ptr
+ * This string holds the contract address of the call
+ *
+ * @param[in] json_ptr
+ * This reference holds the call object written by the
+ * JSON writer
+ *
+ * @param[in] iLength
+ * Length of the call object
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T RequestTemplateStore(uint8_t method, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *json_ptr, size_t iLength)
+{
+	requestTemplateEntry_T *entry_ptr = NULL;
+	size_t gasOffset = 0;
+	size_t gasEnd = 0;
+	size_t idOffset = 0;
+	size_t idEnd = 0;
+
+	/* the addresses including the terminating zero have to fit into the entry */
+	if( (NULL == senderAddress_ptr) || (NULL == receiverAddress_ptr) || (NULL == json_ptr) || (REQUEST_TEMPLATE_TEXT_SIZE < iLength)
+			|| (NULL == memchr(senderAddress_ptr, '\0', REQUEST_TEMPLATE_ADDRESS_SIZE))
+			|| (NULL == memchr(receiverAddress_ptr, '\0', REQUEST_TEMPLATE_ADDRESS_SIZE)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	/* the id is the last member of the call object */
+	idOffset = findKey(json_ptr, iLength, REQUEST_TEMPLATE_ID_KEY, true);
+	for(idEnd = idOffset; (0 != idOffset) && (idEnd < iLength) && ('0' <= json_ptr[idEnd]) && ('9' >= json_ptr[idEnd]); ++idEnd) {
+	}
+	if( (0 == idOffset) || (idOffset == idEnd) ) {
+		return RETCODE_FAILURE;
+	}
+	/* transactions carry a gas limit */
+	gasOffset = findKey(json_ptr, idOffset, REQUEST_TEMPLATE_GAS_KEY, false);
+	for(gasEnd = gasOffset; (0 != gasOffset) && (gasEnd < idOffset) && ('"' != json_ptr[gasEnd]); ++gasEnd) {
+	}
+	if( (0 != gasOffset) && (gasEnd == idOffset) ) {
+		return RETCODE_FAILURE;
+	}
+
+	if( (NULL == requestTemplateMutex) || (pdTRUE != xSemaphoreTake(requestTemplateMutex, portMAX_DELAY)) ) {
+		return RETCODE_FAILURE;
+	}
+	/* the addresses of a function changed */
+	entry_ptr = LruTableSelectEntry(requestTemplateTable, sizeof(requestTemplateEntry_T), REQUEST_TEMPLATE_ENTRY_MAX, offsetof(requestTemplateEntry_T, method), &method, sizeof(method));
+
+	entry_ptr->method = method;
+	strncpy(entry_ptr->senderAddress, senderAddress_ptr, REQUEST_TEMPLATE_ADDRESS_SIZE);
+	strncpy(entry_ptr->receiverAddress, receiverAddress_ptr, REQUEST_TEMPLATE_ADDRESS_SIZE);
+	memcpy(entry_ptr->text, json_ptr, iLength);
+	entry_ptr->length = (uint16_t) iLength;
+	entry_ptr->gasOffset = (uint16_t) gasOffset;
+	entry_ptr->gasEnd = (uint16_t) gasEnd;
+	entry_ptr->idOffset = (uint16_t) idOffset;
+	entry_ptr->idEnd = (uint16_t) idEnd;
+	entry_ptr->lru.lastUseTick = xTaskGetTickCount();
+	entry_ptr->lru.valid = true;
+	requestTemplateStatsVar.storeCounter++;
+	xSemaphoreGive(requestTemplateMutex);
+
+#ifdef ENABLE_DEBUG
+	printf("Request template of function %u stored (%u bytes)\n\r", (unsigned int) method, (unsigned int) iLength);
+#endif
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function writes a json rpc call from its template.
+ * The call is copied and only the id and the gas limit
+ * are serialized.
+ *
+ * @param[in] writer_ptr
+ * This reference holds the JSON writer context
+ *
+ * @param[in] method
+ * Ethereum function (etherFuncCalls) of the call
+ *
+ * @param[in] senderAddress_ptr
+ * This string holds the sender address of the call
+ *
+ * @param[in] receiverAddress_ptr
+ * This string holds the contract address of the call
+ *
+ * @param[in] messageID
+ * JSON RPC id of the call
+ *
+ * @param[in] gasLimit
+ * Gas limit of a transaction, ignored for other calls
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, if there is no template of the call.
+ */
+Retcode_T RequestTemplateWrite(JSONWriter_T *writer_ptr, uint8_t method, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint32_t messageID, uint32_t gasLimit)
+{
+	requestTemplateEntry_T *entry_ptr = NULL;
+
+	if( (NULL == writer_ptr) || (NULL == senderAddress_ptr) || (NULL == receiverAddress_ptr) || (NULL == requestTemplateMutex)
+			|| (pdTRUE != xSemaphoreTake(requestTemplateMutex, portMAX_DELAY)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	entry_ptr = findEntry(method, senderAddress_ptr, receiverAddress_ptr);
+	if(NULL == entry_ptr) {
+		requestTemplateStatsVar.missCounter++;
+		xSemaphoreGive(requestTemplateMutex);
+		return RETCODE_FAILURE;
+	}
+
+	if(0 != entry_ptr->gasOffset) {
+		JSONWriterRawValue(writer_ptr, entry_ptr->text, entry_ptr->gasOffset);
+		JSONWriterAppendQuantity(writer_ptr, gasLimit);
+		JSONWriterAppendRaw(writer_ptr, &entry_ptr->text[entry_ptr->gasEnd], entry_ptr->idOffset - entry_ptr->gasEnd);
+	} else {
+		JSONWriterRawValue(writer_ptr, entry_ptr->text, entry_ptr->idOffset);
+	}
+	JSONWriterAppendNumber(writer_ptr, messageID);
+	JSONWriterAppendRaw(writer_ptr, &entry_ptr->text[entry_ptr->idEnd], entry_ptr->length - entry_ptr->idEnd);
+
+	entry_ptr->lru.lastUseTick = xTaskGetTickCount();
+	requestTemplateStatsVar.hitCounter++;
+	xSemaphoreGive(requestTemplateMutex);
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function copies the usage counters of the
+ * request templates
+ *
+ * @param[out] oStats_ptr
+ * This reference will hold the counter values
+ *
+ * @return
+ * void
+ */
+void RequestTemplateGetStats(RequestTemplateStats_T *oStats_ptr)
+{
+	if(NULL != oStats_ptr) {
+		*oStats_ptr = requestTemplateStatsVar;
+	}
+}
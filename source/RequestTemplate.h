@@ -0,0 +1,34 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_REQUESTTEMPLATE_H_
+#define SOURCE_REQUESTTEMPLATE_H_
+
+/* number of templates - one per contract function without variable argument */
+#define REQUEST_TEMPLATE_ENTRY_MAX		4
+
+/* size of one serialized call e.g. eth_sendTransaction of rateProducer(bool) */
+#define REQUEST_TEMPLATE_TEXT_SIZE		320
+
+/* size of a stored "0x" prefixed address including null termination */
+#define REQUEST_TEMPLATE_ADDRESS_SIZE	(CONTRACT_ADDRESS_LENGTH + 1)
+
+/* usage counters of the request templates */
+typedef struct RequestTemplateStats_S {
+	uint32_t hitCounter;		/* calls written from a template */
+	uint32_t missCounter;		/* calls serialized with the JSON writer */
+	uint32_t storeCounter;		/* templates created or replaced */
+} RequestTemplateStats_T;
+
+/* global interface function declarations */
+Retcode_T RequestTemplateInit(void);
+Retcode_T RequestTemplateStore(uint8_t method, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint8_t const *json_ptr, size_t iLength);
+Retcode_T RequestTemplateWrite(JSONWriter_T *writer_ptr, uint8_t method, uint8_t const *senderAddress_ptr, uint8_t const *receiverAddress_ptr, uint32_t messageID, uint32_t gasLimit);
+void RequestTemplateGetStats(RequestTemplateStats_T *oStats_ptr);
+
+#endif /* SOURCE_REQUESTTEMPLATE_H_ */
@@ -48,6 +48,14 @@
 #include "SystemConfig.h"
 #include "Encryption.h"
 #include "CoAPServer.h"
+#include "Benchmark.h"
+#include "ConfirmationTracker.h"
+#include "TransactionSigner.h"
+#include "ReadCache.h"
+#include "GasEstimator.h"
+#include "JSONWriter.h"
+#include "RequestTemplate.h"
+#include "NodePool.h"
 
 
 /* constant definitions ***************************************************** */
@@ -103,12 +111,47 @@ void appInitSystem(void * CmdProcessorHandle, uint32_t param2)
     }
 #endif
 #ifdef ENABLE_HTTP
-    ret = HttpClient_initialize();
+    ret = HttpInit();
     if(RETCODE_SUCCESS != ret) {
 		printf("AppInitSystem: Error in HttpInit\n\r");
 		BSP_Board_SoftReset();
 	}
 #endif
+#if defined(ENABLE_HTTP) && defined(ENABLE_READ_CACHE)
+    ret = ReadCacheInit();
+    if(RETCODE_SUCCESS != ret) {
+		printf("AppInitSystem: Error in ReadCacheInit\n\r");
+		BSP_Board_SoftReset();
+	}
+#endif
+#if defined(ENABLE_HTTP) && defined(ENABLE_GAS_ESTIMATION)
+    ret = GasEstimatorInit();
+    if(RETCODE_SUCCESS != ret) {
+		printf("AppInitSystem: Error in GasEstimatorInit\n\r");
+		BSP_Board_SoftReset();
+	}
+#endif
+#if defined(ENABLE_HTTP) && defined(ENABLE_REQUEST_TEMPLATES)
+    ret = RequestTemplateInit();
+    if(RETCODE_SUCCESS != ret) {
+		printf("AppInitSystem: Error in RequestTemplateInit\n\r");
+		BSP_Board_SoftReset();
+	}
+#endif
+#if defined(ENABLE_HTTP) && defined(ENABLE_LOCAL_SIGNING)
+    ret = TransactionSignerInit();
+    if(RETCODE_SUCCESS != ret) {
+		printf("AppInitSystem: Error in TransactionSignerInit\n\r");
+		BSP_Board_SoftReset();
+	}
+#endif
+#if defined(ENABLE_HTTP) && defined(ENABLE_CONFIRMATION_TRACKER)
+    ret = ConfirmationTrackerInit();
+    if(RETCODE_SUCCESS != ret) {
+		printf("AppInitSystem: Error in ConfirmationTrackerInit\n\r");
+		BSP_Board_SoftReset();
+	}
+#endif
 #ifdef ENABLE_SENSOR
     ret = SensorInit();
     if(RETCODE_SUCCESS != ret) {
@@ -137,8 +180,21 @@ void appInitSystem(void * CmdProcessorHandle, uint32_t param2)
 		BSP_Board_SoftReset();
 	}
 #endif
+#ifdef ENABLE_BENCHMARK
+    RunBenchmarks();
+#endif
 
 /* add user tasks here */
+#if defined(ENABLE_HTTP) && defined(ENABLE_BENCHMARK)
+    /* highest priority so it starts before the other tasks send requests -
+     * requests of other tasks during the benchmark are counted, too */
+    if( pdPASS != (xTaskCreate(TransportBenchmarkCyclic, (const char * const) "TransBench", 1024, NULL, 3, &TransportBenchmarkTask)) )
+    {
+    	printf("Error xTaskCreate: TransportBenchmarkTask\n\r");
+    	BSP_Board_SoftReset();
+    	assert(false);
+    }
+#endif
 #ifdef ENABLE_WIFI
     if( pdPASS != (xTaskCreate(wifiCyclic, (const char * const) "WifiCheck", 256, NULL, 1, &WifiCheckTask)) )
     {
@@ -179,6 +235,22 @@ void appInitSystem(void * CmdProcessorHandle, uint32_t param2)
     	assert(false);
     }
 #endif
+#if defined(ENABLE_HTTP) && defined(ENABLE_CONFIRMATION_TRACKER)
+    if( pdPASS != (xTaskCreate(ConfirmationTrackerCyclic, (const char * const) "ConfTrack", 512, NULL, 2, &ConfirmationTrackerTask)) )
+    {
+    	printf("Error xTaskCreate: ConfirmationTrackerTask\n\r");
+    	BSP_Board_SoftReset();
+    	assert(false);
+    }
+#endif
+#if defined(ENABLE_HTTP) && defined(ENABLE_NODE_POOL)
+    if( pdPASS != (xTaskCreate(NodePoolProbeCyclic, (const char * const) "NodeProbe", 512, NULL, 1, &NodePoolProbeTask)) )
+    {
+    	printf("Error xTaskCreate: NodePoolProbeTask\n\r");
+    	BSP_Board_SoftReset();
+    	assert(false);
+    }
+#endif
 }
 /**@} */
 /** ************************************************************************* */
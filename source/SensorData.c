@@ -33,6 +33,11 @@ static bool Button1PressedFlag = false;
 /* variable to store the acceleration value after button pressed */
 static uint8_t AccelSensorValue = 0;
 
+#ifdef ENABLE_HYBRID_ENCRYPTION
+/* acceleration profile of the last recording */
+static uint8_t AccelSensorProfile[ACCELERATION_PROFILE_SIZE] = {0};
+#endif
+
 /**
  * This function is used to read the current button1 status
  *
@@ -266,6 +271,31 @@ uint8_t GetAccelerometerSensorData(void)
 	return AccelSensorValue;
 }
 
+#ifdef ENABLE_HYBRID_ENCRYPTION
+/**
+ * This function is called to read the acceleration profile
+ * of the last recording - the average G value of every window
+ * of ACCELERATION_VALUES / ACCELERATION_PROFILE_SIZE samples.
+ *
+ * @param[out] oProfile_ptr
+ * This buffer will hold the profile
+ *
+ * @param[in] iLength
+ * Size of the buffer
+ *
+ * @return
+ * number of copied profile values
+ */
+size_t GetAccelerometerSensorProfile(uint8_t *oProfile_ptr, size_t iLength)
+{
+	size_t length = (iLength < sizeof(AccelSensorProfile)) ? iLength : sizeof(AccelSensorProfile);
+
+	memcpy(oProfile_ptr, AccelSensorProfile, length);
+
+	return length;
+}
+#endif
+
 /**
  * This function is called to read the accelerometer
  * sensor data for encryption.
@@ -312,6 +342,10 @@ void SensorDataCyclic(void* pvParameters)
 	/* define array to hold x, y and z sensor data */
 	Accelerometer_XyzData_T bma280 = {INT32_C(0), INT32_C(0), INT32_C(0)};
 	uint32_t AccelSensorValueLocal = 0;
+#ifdef ENABLE_HYBRID_ENCRYPTION
+	uint32_t windowValue = 0;
+	uint16_t profileIndex = 0;
+#endif
 
 	for(;;)
 	{
@@ -320,6 +354,10 @@ void SensorDataCyclic(void* pvParameters)
 			/* reset sensor values */
 			AccelSensorValueLocal = 0;
 			AccelSensorValue = 0;
+#ifdef ENABLE_HYBRID_ENCRYPTION
+			windowValue = 0;
+			profileIndex = 0;
+#endif
 
 			/* record accelermoter values within defined time value */
 			for(uint16_t counter = 0; counter < ACCELERATION_VALUES; ++counter) {
@@ -327,6 +365,14 @@ void SensorDataCyclic(void* pvParameters)
 				Accelerometer_readXyzGValue(xdkAccelerometers_BMA280_Handle, &bma280);
 				if(bma280.xAxisData < 0) bma280.xAxisData = bma280.xAxisData * (-1);
 				AccelSensorValueLocal += bma280.xAxisData;
+#ifdef ENABLE_HYBRID_ENCRYPTION
+				/* average of the window converted to G value */
+				windowValue += bma280.xAxisData;
+				if( (0 == ((counter + 1) % (ACCELERATION_VALUES / ACCELERATION_PROFILE_SIZE))) && (profileIndex < ACCELERATION_PROFILE_SIZE) ) {
+					AccelSensorProfile[profileIndex++] = (uint8_t) (windowValue / (ACCELERATION_VALUES / ACCELERATION_PROFILE_SIZE) / 100);
+					windowValue = 0;
+				}
+#endif
 			}
 
 			/* get average accel value */
@@ -9,6 +9,9 @@
 #ifndef SOURCE_SENSORDATA_H_
 #define SOURCE_SENSORDATA_H_
 
+/* the declarations depend on the configuration */
+#include "UserConfig.h"
+
 /* global interface task declarations */
 xTaskHandle SensorDataTask;
 
@@ -19,5 +22,8 @@ bool Button1Pressed(void);
 Retcode_T GetAcceleromterSensorEntropyData(int32_t* data_ptr);
 Retcode_T GetEnvironmentalSensorData(uint32_t *data_ptr);
 uint8_t GetAccelerometerSensorData(void);
+#ifdef ENABLE_HYBRID_ENCRYPTION
+size_t GetAccelerometerSensorProfile(uint8_t *oProfile_ptr, size_t iLength);
+#endif
 
 #endif /* SOURCE_SENSORDATA_H_ */
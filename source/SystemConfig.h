@@ -11,6 +11,11 @@
 
 /* wait macro which waits for x seconds */
 #define SECONDS(x) ((portTickType) (x * 1000) / portTICK_RATE_MS)
+/* convert a tick count into milliseconds */
+#define TICKS_TO_MS(x) ((uint32_t) (x) * portTICK_RATE_MS)
+
+/* path of the json-rpc http posts */
+#define DESTINATION_POST_PATH "/post"
 
 /* queue parameters */
 #define QUEUE_ELEMENT_COUNTER 	1
@@ -0,0 +1,521 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+/* mbedTLS system includes */
+#include "mbedtls/ecp.h"
+#include "mbedtls/bignum.h"
+#include "mbedtls/hmac_drbg.h"
+#include "mbedtls/md.h"
+
+/* user includes */
+#include "UserConfig.h"
+#include "HexCodec.h"
+#include "TransactionSigner.h"
+
+#ifdef ENABLE_LOCAL_SIGNING
+
+/* key of the account which sends the transactions */
+#ifdef ENABLE_PRODUCER
+	#define SIGNER_PRIVATE_KEY		PRODUCER_ACCOUNT_PRIVATE_KEY
+#else /* CONSUMER */
+	#define SIGNER_PRIVATE_KEY		CONSUMER_ACCOUNT_PRIVATE_KEY
+#endif
+
+/* size of the secp256k1 private key and of r and s */
+#define SIGNER_KEY_SIZE				32
+
+/* RLP prefixes - strings up to 55 bytes encode the length in
+ * the prefix, longer ones append the length in big endian */
+#define RLP_STRING_OFFSET			0x80
+#define RLP_LIST_OFFSET				0xC0
+#define RLP_SHORT_LENGTH_MAX		55
+#define RLP_LONG_LENGTH_OFFSET		55
+
+/* maximum size of the RLP header of the transaction list */
+#define RLP_LIST_HEADER_MAX			9
+
+/* maximum size of an RLP encoded uint64_t */
+#define RLP_UINT_MAX				9
+
+/* EIP-155: v = chainId * 2 + 35 + recovery id */
+#define SIGNER_EIP155_V_OFFSET		35
+
+/**
+ * struct to hold the signing key and the local nonce
+ * of the account
+ */
+typedef struct transactionSignerHandler_S {
+	mbedtls_ecp_group grp;
+	mbedtls_mpi d;
+	mbedtls_mpi halfN;
+	SemaphoreHandle_t mutex;
+	uint64_t nonce;
+	bool nonceValid;
+	bool initialized;
+	uint8_t address[TRANSACTION_SIGNER_ADDRESS_LENGTH + 1];
+} transactionSignerHandler_T;
+static transactionSignerHandler_T transactionSignerHandleVar;
+
+/**
+ * This function writes the RLP header of a string or
+ * a list
+ *
+ * @param[in] offset
+ * RLP_STRING_OFFSET or RLP_LIST_OFFSET
+ *
+ * @param[in] length
+ * Length of the payload behind the header
+ *
+ * @param[out] oBuff
+ * Output buffer - holds at most 9 bytes
+ *
+ * @return
+ * size of the header
+ */
+static size_t rlpEncodeHeader(uint8_t offset, size_t length, uint8_t *oBuff)
+{
+	uint8_t lengthSize = 0;
+
+	if(RLP_SHORT_LENGTH_MAX >= length) {
+		oBuff[0] = offset + (uint8_t) length;
+		return 1;
+	}
+
+	for(size_t value = length; 0 != value; value >>= 8) {
+		lengthSize++;
+	}
+	oBuff[0] = offset + RLP_LONG_LENGTH_OFFSET + lengthSize;
+	for(uint8_t i = 0; i < lengthSize; ++i) {
+		oBuff[lengthSize - i] = (uint8_t) (length >> (8 * i));
+	}
+
+	return 1 + lengthSize;
+}
+
+/**
+ * This function writes a RLP string. Single bytes
+ * below 0x80 are their own encoding.
+ *
+ * @param[in] data_ptr
+ * This reference holds the data
+ *
+ * @param[in] length
+ * Length of the data
+ *
+ * @param[out] oBuff
+ * Output buffer
+ *
+ * @return
+ * size of the encoded string
+ */
+static size_t rlpEncodeBytes(uint8_t const *data_ptr, size_t length, uint8_t *oBuff)
+{
+	size_t headerLength = 0;
+
+	if( (1 == length) && (RLP_STRING_OFFSET > data_ptr[0]) ) {
+		oBuff[0] = data_ptr[0];
+		return 1;
+	}
+
+	headerLength = rlpEncodeHeader(RLP_STRING_OFFSET, length, oBuff);
+	memcpy(&oBuff[headerLength], data_ptr, length);
+
+	return headerLength + length;
+}
+
+/**
+ * This function writes a big endian number as RLP
+ * string without leading zeros - zero is the empty string
+ *
+ * @param[in] number_ptr
+ * This reference holds the big endian number
+ *
+ * @param[in] length
+ * Length of the number
+ *
+ * @param[out] oBuff
+ * Output buffer
+ *
+ * @return
+ * size of the encoded number
+ */
+static size_t rlpEncodeInteger(uint8_t const *number_ptr, size_t length, uint8_t *oBuff)
+{
+	while( (0 < length) && (0 == number_ptr[0]) ) {
+		number_ptr++;
+		length--;
+	}
+
+	return rlpEncodeBytes(number_ptr, length, oBuff);
+}
+
+/**
+ * This function writes an unsigned number as RLP string
+ *
+ * @param[in] value
+ * Value to encode
+ *
+ * @param[out] oBuff
+ * Output buffer - holds at most RLP_UINT_MAX bytes
+ *
+ * @return
+ * size of the encoded number
+ */
+static size_t rlpEncodeUint(uint64_t value, uint8_t *oBuff)
+{
+	uint8_t bigEndian[sizeof(value)];
+
+	for(uint8_t i = 0; i < sizeof(bigEndian); ++i) {
+		bigEndian[sizeof(bigEndian) - 1 - i] = (uint8_t) (value >> (8 * i));
+	}
+
+	return rlpEncodeInteger(bigEndian, sizeof(bigEndian), oBuff);
+}
+
+/**
+ * This function signs a hash with the secp256k1 key of the
+ * account. The ephemeral key is derived deterministically
+ * from the key and the hash like mbedtls_ecdsa_sign_det does,
+ * but the point R is kept to get the recovery id which
+ * ethereum needs to restore the sender from the signature.
+ * s is normalized to the lower half of the curve order (EIP-2).
+ *
+ * @param[in] hash_ptr
+ * This reference holds the 32 byte hash
+ *
+ * @param[out] oR
+ * Output buffer for r - holds SIGNER_KEY_SIZE bytes
+ *
+ * @param[out] oS
+ * Output buffer for s - holds SIGNER_KEY_SIZE bytes
+ *
+ * @param[out] oRecoveryID_ptr
+ * This reference will hold the recovery id 0 or 1
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T signHash(uint8_t const *hash_ptr, uint8_t *oR, uint8_t *oS, uint8_t *oRecoveryID_ptr)
+{
+	int ret = 0;
+	uint8_t seed[SIGNER_KEY_SIZE + KECCAK256_HASH_SIZE];
+	uint8_t recoveryID = 0;
+	mbedtls_hmac_drbg_context drbg;
+	mbedtls_ecp_point R;
+	mbedtls_mpi k;
+	mbedtls_mpi e;
+	mbedtls_mpi r;
+	mbedtls_mpi s;
+	mbedtls_ecp_group *grp_ptr = &transactionSignerHandleVar.grp;
+
+	mbedtls_hmac_drbg_init(&drbg);
+	mbedtls_ecp_point_init(&R);
+	mbedtls_mpi_init(&k);
+	mbedtls_mpi_init(&e);
+	mbedtls_mpi_init(&r);
+	mbedtls_mpi_init(&s);
+
+	/* seed the deterministic ephemeral key generation with key and hash */
+	MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(&transactionSignerHandleVar.d, seed, SIGNER_KEY_SIZE));
+	memcpy(&seed[SIGNER_KEY_SIZE], hash_ptr, KECCAK256_HASH_SIZE);
+	MBEDTLS_MPI_CHK(mbedtls_hmac_drbg_seed_buf(&drbg, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), seed, sizeof(seed)));
+
+	/* the curve order has 256 bits, so the hash is used as it is */
+	MBEDTLS_MPI_CHK(mbedtls_mpi_read_binary(&e, hash_ptr, KECCAK256_HASH_SIZE));
+
+	do {
+		/* ephemeral key k and R = k * G */
+		MBEDTLS_MPI_CHK(mbedtls_ecp_gen_keypair(grp_ptr, &k, &R, mbedtls_hmac_drbg_random, &drbg));
+		MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(&r, &R.X, &grp_ptr->N));
+		if(0 == mbedtls_mpi_cmp_int(&r, 0)) {
+			continue;
+		}
+
+		/* s = (e + r * d) / k mod n */
+		MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&s, &r, &transactionSignerHandleVar.d));
+		MBEDTLS_MPI_CHK(mbedtls_mpi_add_mpi(&s, &s, &e));
+		MBEDTLS_MPI_CHK(mbedtls_mpi_inv_mod(&k, &k, &grp_ptr->N));
+		MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&s, &s, &k));
+		MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(&s, &s, &grp_ptr->N));
+	} while( (0 == mbedtls_mpi_cmp_int(&r, 0)) || (0 == mbedtls_mpi_cmp_int(&s, 0)) );
+
+	/* parity of R.y - R.x >= n is practically impossible and
+	 * can not be expressed with EIP-155 */
+	if(0 <= mbedtls_mpi_cmp_mpi(&R.X, &grp_ptr->N)) {
+		ret = MBEDTLS_ERR_ECP_RANDOM_FAILED;
+		goto cleanup;
+	}
+	recoveryID = (uint8_t) mbedtls_mpi_get_bit(&R.Y, 0);
+
+	/* low s - the negated s belongs to -R with the other parity */
+	if(0 < mbedtls_mpi_cmp_mpi(&s, &transactionSignerHandleVar.halfN)) {
+		MBEDTLS_MPI_CHK(mbedtls_mpi_sub_mpi(&s, &grp_ptr->N, &s));
+		recoveryID ^= 1;
+	}
+
+	MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(&r, oR, SIGNER_KEY_SIZE));
+	MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(&s, oS, SIGNER_KEY_SIZE));
+	*oRecoveryID_ptr = recoveryID;
+
+cleanup:
+	memset(seed, 0, sizeof(seed));
+	mbedtls_hmac_drbg_free(&drbg);
+	mbedtls_ecp_point_free(&R);
+	mbedtls_mpi_free(&k);
+	mbedtls_mpi_free(&e);
+	mbedtls_mpi_free(&r);
+	mbedtls_mpi_free(&s);
+
+	return (0 == ret) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function loads the secp256k1 key of the account
+ * from UserConfig.h and derives the account address.
+ * The nonce is unknown until TransactionSignerSetNonce
+ * is called.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T TransactionSignerInit(void)
+{
+	int ret = 0;
+	uint8_t const *keyHex_ptr = SIGNER_PRIVATE_KEY;
+	uint8_t key[SIGNER_KEY_SIZE];
+	uint8_t publicKey[1 + 2 * SIGNER_KEY_SIZE];
+	uint8_t hash[KECCAK256_HASH_SIZE];
+	size_t publicKeyLength = 0;
+	mbedtls_ecp_point Q;
+
+	memset(&transactionSignerHandleVar, 0, sizeof(transactionSignerHandleVar));
+	mbedtls_ecp_group_init(&transactionSignerHandleVar.grp);
+	mbedtls_mpi_init(&transactionSignerHandleVar.d);
+	mbedtls_mpi_init(&transactionSignerHandleVar.halfN);
+	mbedtls_ecp_point_init(&Q);
+
+	if( ('0' == keyHex_ptr[0]) && ('x' == keyHex_ptr[1]) ) {
+		keyHex_ptr += 2;
+	}
+	if( (2 * SIGNER_KEY_SIZE != strlen(keyHex_ptr)) || (RETCODE_SUCCESS != HexDecode(keyHex_ptr, 2 * SIGNER_KEY_SIZE, key)) ) {
+		printf("Invalid signer private key\n\r");
+		return RETCODE_FAILURE;
+	}
+
+	ret = mbedtls_ecp_group_load(&transactionSignerHandleVar.grp, MBEDTLS_ECP_DP_SECP256K1);
+	if(0 != ret) {
+		printf("secp256k1 not available - enable MBEDTLS_ECP_DP_SECP256K1_ENABLED in the mbedtls library\n\r");
+		goto cleanup;
+	}
+	MBEDTLS_MPI_CHK(mbedtls_mpi_read_binary(&transactionSignerHandleVar.d, key, sizeof(key)));
+	MBEDTLS_MPI_CHK(mbedtls_ecp_check_privkey(&transactionSignerHandleVar.grp, &transactionSignerHandleVar.d));
+	MBEDTLS_MPI_CHK(mbedtls_mpi_copy(&transactionSignerHandleVar.halfN, &transactionSignerHandleVar.grp.N));
+	MBEDTLS_MPI_CHK(mbedtls_mpi_shift_r(&transactionSignerHandleVar.halfN, 1));
+
+	/* address - last 20 bytes of keccak256 of the uncompressed public key without prefix */
+	MBEDTLS_MPI_CHK(mbedtls_ecp_mul(&transactionSignerHandleVar.grp, &Q, &transactionSignerHandleVar.d, &transactionSignerHandleVar.grp.G, NULL, NULL));
+	MBEDTLS_MPI_CHK(mbedtls_ecp_point_write_binary(&transactionSignerHandleVar.grp, &Q, MBEDTLS_ECP_PF_UNCOMPRESSED, &publicKeyLength, publicKey, sizeof(publicKey)));
+	Keccak256(&publicKey[1], publicKeyLength - 1, hash);
+	memcpy(transactionSignerHandleVar.address, "0x", 2);
+	HexEncode(&hash[KECCAK256_HASH_SIZE - TRANSACTION_SIGNER_ADDRESS_SIZE], TRANSACTION_SIGNER_ADDRESS_SIZE, &transactionSignerHandleVar.address[2]);
+
+	transactionSignerHandleVar.mutex = xSemaphoreCreateMutex();
+	if(NULL == transactionSignerHandleVar.mutex) {
+		ret = MBEDTLS_ERR_MPI_ALLOC_FAILED;
+		goto cleanup;
+	}
+	transactionSignerHandleVar.initialized = true;
+#ifdef ENABLE_DEBUG
+	printf("Transaction signer address: %s\n\r", transactionSignerHandleVar.address);
+#endif
+
+cleanup:
+	memset(key, 0, sizeof(key));
+	mbedtls_ecp_point_free(&Q);
+
+	return (0 == ret) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+}
+
+/**
+ * This function signs a transaction with the next local
+ * nonce (EIP-155) and returns the raw transaction for
+ * eth_sendRawTransaction. The RLP encoding is built around
+ * the call data in the output buffer, so the call data is
+ * not copied to a separate buffer. The nonce is only
+ * incremented if the transaction was signed.
+ *
+ * @param[in] tx_ptr
+ * This reference holds the transaction fields
+ *
+ * @param[in,out] ioBuff
+ * Holds the call data at TRANSACTION_SIGNER_DATA_OFFSET and
+ * will hold the raw transaction starting at offset 0. Must
+ * hold TRANSACTION_SIGNER_DATA_OFFSET + call data length +
+ * TRANSACTION_SIGNER_SIGNATURE_MAX bytes.
+ *
+ * @param[in] iBuffSize
+ * Size of the buffer
+ *
+ * @param[out] oLength_ptr
+ * This reference will hold the length of the raw transaction
+ *
+ * @param[out] oHash_ptr
+ * Output buffer for the transaction hash - holds
+ * KECCAK256_HASH_SIZE bytes. Can be NULL.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T TransactionSignerSign(TransactionSignerTx_T const *tx_ptr, uint8_t *ioBuff, size_t iBuffSize, size_t *oLength_ptr, uint8_t *oHash_ptr)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	uint8_t fields[TRANSACTION_SIGNER_DATA_OFFSET - RLP_LIST_HEADER_MAX];
+	uint8_t header[RLP_LIST_HEADER_MAX];
+	uint8_t chainID[RLP_UINT_MAX + 2];
+	uint8_t hash[KECCAK256_HASH_SIZE];
+	uint8_t r[SIGNER_KEY_SIZE];
+	uint8_t s[SIGNER_KEY_SIZE];
+	uint8_t recoveryID = 0;
+	size_t fieldsLength = 0;
+	size_t headerLength = 0;
+	size_t chainIDLength = 0;
+	size_t signatureLength = 0;
+	uint8_t *data_ptr = &ioBuff[TRANSACTION_SIGNER_DATA_OFFSET];
+	uint8_t *signature_ptr = NULL;
+	Keccak256Context_T keccak;
+
+	if( (false == transactionSignerHandleVar.initialized) || (NULL == tx_ptr) || (NULL == ioBuff) || (NULL == oLength_ptr) ||
+		(iBuffSize < (TRANSACTION_SIGNER_DATA_OFFSET + tx_ptr->dataLength + TRANSACTION_SIGNER_SIGNATURE_MAX)) ) {
+		return ret;
+	}
+
+	if(pdTRUE != xSemaphoreTake(transactionSignerHandleVar.mutex, portMAX_DELAY)) {
+		return ret;
+	}
+
+	if(true == transactionSignerHandleVar.nonceValid) {
+		/* nonce, gasPrice, gasLimit, to, value and the header of data */
+		fieldsLength = rlpEncodeUint(transactionSignerHandleVar.nonce, fields);
+		fieldsLength += rlpEncodeUint(SIGNER_GAS_PRICE, &fields[fieldsLength]);
+		fieldsLength += rlpEncodeUint(tx_ptr->gasLimit, &fields[fieldsLength]);
+		fieldsLength += rlpEncodeBytes(tx_ptr->to, sizeof(tx_ptr->to), &fields[fieldsLength]);
+		fieldsLength += rlpEncodeUint(tx_ptr->value, &fields[fieldsLength]);
+		if( (1 != tx_ptr->dataLength) || (RLP_STRING_OFFSET <= data_ptr[0]) ) {
+			fieldsLength += rlpEncodeHeader(RLP_STRING_OFFSET, tx_ptr->dataLength, &fields[fieldsLength]);
+		}
+
+		/* EIP-155 signing hash over the fields followed by chainId, 0, 0 */
+		chainIDLength = rlpEncodeUint(SIGNER_CHAIN_ID, chainID);
+		chainID[chainIDLength++] = RLP_STRING_OFFSET;
+		chainID[chainIDLength++] = RLP_STRING_OFFSET;
+		headerLength = rlpEncodeHeader(RLP_LIST_OFFSET, fieldsLength + tx_ptr->dataLength + chainIDLength, header);
+
+		Keccak256Init(&keccak);
+		Keccak256Update(&keccak, header, headerLength);
+		Keccak256Update(&keccak, fields, fieldsLength);
+		Keccak256Update(&keccak, data_ptr, tx_ptr->dataLength);
+		Keccak256Update(&keccak, chainID, chainIDLength);
+		Keccak256Finish(&keccak, hash);
+
+		ret = signHash(hash, r, s, &recoveryID);
+	}
+
+	if(RETCODE_SUCCESS == ret) {
+		/* v, r and s behind the call data */
+		signature_ptr = &data_ptr[tx_ptr->dataLength];
+		signatureLength = rlpEncodeUint(((uint64_t) SIGNER_CHAIN_ID * 2) + SIGNER_EIP155_V_OFFSET + recoveryID, signature_ptr);
+		signatureLength += rlpEncodeInteger(r, sizeof(r), &signature_ptr[signatureLength]);
+		signatureLength += rlpEncodeInteger(s, sizeof(s), &signature_ptr[signatureLength]);
+
+		/* list header and fields in front of the call data, then
+		 * move the transaction to the start of the buffer */
+		headerLength = rlpEncodeHeader(RLP_LIST_OFFSET, fieldsLength + tx_ptr->dataLength + signatureLength, header);
+		memcpy(&data_ptr[-(ptrdiff_t) fieldsLength], fields, fieldsLength);
+		memcpy(&data_ptr[-(ptrdiff_t) (fieldsLength + headerLength)], header, headerLength);
+		*oLength_ptr = headerLength + fieldsLength + tx_ptr->dataLength + signatureLength;
+		memmove(ioBuff, &data_ptr[-(ptrdiff_t) (fieldsLength + headerLength)], *oLength_ptr);
+
+		if(NULL != oHash_ptr) {
+			Keccak256(ioBuff, *oLength_ptr, oHash_ptr);
+		}
+
+		transactionSignerHandleVar.nonce++;
+	}
+
+	xSemaphoreGive(transactionSignerHandleVar.mutex);
+
+	return ret;
+}
+
+/**
+ * This function returns the account address which
+ * belongs to the signing key
+ *
+ * @return
+ * null terminated "0x" prefixed address, NULL if the
+ * signer is not initialized
+ */
+uint8_t const *TransactionSignerGetAddress(void)
+{
+	return (true == transactionSignerHandleVar.initialized) ? transactionSignerHandleVar.address : NULL;
+}
+
+/**
+ * This function checks if the local nonce is known
+ *
+ * @return
+ * true, if transactions can be signed<br>
+ * false, if the nonce has to be read from the node.
+ */
+bool TransactionSignerIsNonceValid(void)
+{
+	return transactionSignerHandleVar.nonceValid;
+}
+
+/**
+ * This function sets the nonce of the next transaction
+ * e.g. the pending transaction count of the node
+ *
+ * @param[in] nonce
+ * nonce of the next transaction
+ *
+ * @return
+ * void
+ */
+void TransactionSignerSetNonce(uint64_t nonce)
+{
+	taskENTER_CRITICAL();
+	transactionSignerHandleVar.nonce = nonce;
+	transactionSignerHandleVar.nonceValid = true;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * This function marks the local nonce as unknown. It is
+ * called if the node did not accept a signed transaction
+ * or did not answer, the nonce is read from the node again
+ * before the next transaction is signed.
+ *
+ * @return
+ * void
+ */
+void TransactionSignerInvalidateNonce(void)
+{
+	transactionSignerHandleVar.nonceValid = false;
+}
+
+#endif /* ENABLE_LOCAL_SIGNING */
@@ -0,0 +1,49 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_TRANSACTIONSIGNER_H_
+#define SOURCE_TRANSACTIONSIGNER_H_
+
+#include "Keccak.h"
+
+/* size of an ethereum address in bytes */
+#define TRANSACTION_SIGNER_ADDRESS_SIZE		20
+
+/* length of the "0x" prefixed hex address of the signer */
+#define TRANSACTION_SIGNER_ADDRESS_LENGTH	(2 + TRANSACTION_SIGNER_ADDRESS_SIZE * 2)
+
+/* offset of the call data in the output buffer of TransactionSignerSign.
+ * The RLP headers of the transaction fields in front of the call data
+ * take at most this many bytes */
+#define TRANSACTION_SIGNER_DATA_OFFSET		75
+
+/* number of bytes behind the call data - v, r and s of the signature */
+#define TRANSACTION_SIGNER_SIGNATURE_MAX	75
+
+/**
+ * fields of an ethereum transaction which are set by the
+ * caller. Nonce, gas price and chain id are added by the signer.
+ * The call data has to be placed at TRANSACTION_SIGNER_DATA_OFFSET
+ * of the output buffer, the transaction is built around it.
+ */
+typedef struct TransactionSignerTx_S {
+	uint8_t to[TRANSACTION_SIGNER_ADDRESS_SIZE];
+	uint64_t value;			/* wei */
+	uint64_t gasLimit;
+	size_t dataLength;		/* length of the call data at TRANSACTION_SIGNER_DATA_OFFSET */
+} TransactionSignerTx_T;
+
+/* global interface function declarations */
+Retcode_T TransactionSignerInit(void);
+Retcode_T TransactionSignerSign(TransactionSignerTx_T const *tx_ptr, uint8_t *ioBuff, size_t iBuffSize, size_t *oLength_ptr, uint8_t *oHash_ptr);
+uint8_t const *TransactionSignerGetAddress(void);
+bool TransactionSignerIsNonceValid(void);
+void TransactionSignerSetNonce(uint64_t nonce);
+void TransactionSignerInvalidateNonce(void);
+
+#endif /* SOURCE_TRANSACTIONSIGNER_H_ */
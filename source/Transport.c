@@ -0,0 +1,96 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include "BCDS_Basics.h"
+#include "simplelink.h"
+
+/* user includes */
+#include "Transport.h"
+
+/**
+ * This function converts a dotted decimal ipv4 address
+ *
+ * @param[in] address_ptr
+ * This string holds the address e.g. "192.168.0.10"
+ *
+ * @param[out] oAddress_ptr
+ * This reference will hold the address in host byte order
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T TransportParseIPv4Address(uint8_t const *address_ptr, uint32_t *oAddress_ptr)
+{
+	uint32_t address = 0;
+	uint32_t octet = 0;
+	uint8_t digits = 0;
+	uint8_t dots = 0;
+
+	for(; 0 != *address_ptr; ++address_ptr) {
+		if( ('0' <= *address_ptr) && ('9' >= *address_ptr) ) {
+			octet = octet * 10 + (*address_ptr - '0');
+			digits++;
+			if(255 < octet) {
+				return RETCODE_FAILURE;
+			}
+		} else if( ('.' == *address_ptr) && (0 < digits) && (3 > dots) ) {
+			address = (address << 8) | octet;
+			octet = 0;
+			digits = 0;
+			dots++;
+		} else {
+			return RETCODE_FAILURE;
+		}
+	}
+	if( (3 != dots) || (0 == digits) ) {
+		return RETCODE_FAILURE;
+	}
+	*oAddress_ptr = (address << 8) | octet;
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function sends a buffer completely on a socket
+ * of a transport
+ *
+ * @param[in] socket
+ * This variable holds the socket of the connection
+ *
+ * @param[in] buff_ptr
+ * This reference holds the data
+ *
+ * @param[in] iLength
+ * This variable holds the number of bytes
+ *
+ * @param[in,out] stats_ptr
+ * This reference holds the counters of the transport - the
+ * sent bytes are added
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+Retcode_T TransportSendAll(int16_t socket, uint8_t const *buff_ptr, size_t iLength, TransportStats_T *stats_ptr)
+{
+	int16_t sent = 0;
+
+	while(0 < iLength) {
+		sent = sl_Send(socket, buff_ptr, (int16_t) iLength, 0);
+		if(0 >= sent) {
+			return RETCODE_FAILURE;
+		}
+		buff_ptr += sent;
+		iLength -= (size_t) sent;
+		stats_ptr->bytesSent += (uint32_t) sent;
+	}
+
+	return RETCODE_SUCCESS;
+}
@@ -0,0 +1,78 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_TRANSPORT_H_
+#define SOURCE_TRANSPORT_H_
+
+/* request id of messages which the node pushes without request */
+#define TRANSPORT_REQUEST_NONE	0
+
+/* connection state of a json rpc transport */
+typedef enum TransportState_E {
+	TRANSPORT_DISCONNECTED = 0,
+	TRANSPORT_CONNECTING,
+	TRANSPORT_CONNECTED
+} TransportState_T;
+
+/* message and byte counters of a transport - the bytes
+ * include the framing of the transport e.g. http headers */
+typedef struct TransportStats_S {
+	uint32_t connectionCounter;
+	uint32_t messageSentCounter;
+	uint32_t messageReceivedCounter;
+	uint32_t bytesSent;
+	uint32_t bytesReceived;
+} TransportStats_T;
+
+/**
+ * Callbacks of the json rpc client which the transport
+ * calls from its own task context. node is the index of
+ * the json-rpc node in the node pool (NodePool.h) the
+ * message was exchanged with.
+ *
+ * sent - the request left the device or could not be sent
+ * received - a json rpc message arrived. The request id is
+ *   TRANSPORT_REQUEST_NONE if the transport can not assign the
+ *   message to a request e.g. pushed notifications. content_ptr
+ *   is NULL if the request failed. Return RETCODE_FAILURE if
+ *   the message could not be handled.
+ * stateChanged - the connection was opened or lost. Requests
+ *   which are still in flight are not answered after a loss.
+ */
+typedef struct TransportCallbacks_S {
+	void (*sent)(uint8_t node, uint32_t requestID, Retcode_T status);
+	Retcode_T (*received)(uint8_t node, uint32_t requestID, uint8_t const *content_ptr, size_t iLength);
+	void (*stateChanged)(uint8_t node, TransportState_T state);
+} TransportCallbacks_T;
+
+/**
+ * Interface of a json rpc transport. The payload passed to
+ * send must stay valid until the request is answered or its
+ * failure is reported - it is the buffer of the request slot.
+ * Transports without nodePool only talk to the primary node
+ * and ignore the node of send, disconnect and cancel. cancel
+ * forgets one request - its payload is not read anymore, a
+ * late answer is not reported and a connection the request
+ * blocks is not used again.
+ */
+typedef struct Transport_S {
+	uint8_t const *name_ptr;
+	bool nodePool;	/* requests can be sent to every node of the node pool */
+	Retcode_T (*init)(TransportCallbacks_T const *callbacks_ptr);
+	Retcode_T (*send)(uint8_t node, uint32_t requestID, uint8_t const *payload_ptr, size_t iLength);
+	TransportState_T (*getState)(void);
+	void (*disconnect)(uint8_t node);
+	void (*cancel)(uint8_t node, uint32_t requestID);
+	void (*getStats)(TransportStats_T *oStats_ptr);
+} Transport_T;
+
+/* socket helpers of the transports which talk to the node directly */
+Retcode_T TransportParseIPv4Address(uint8_t const *address_ptr, uint32_t *oAddress_ptr);
+Retcode_T TransportSendAll(int16_t socket, uint8_t const *buff_ptr, size_t iLength, TransportStats_T *stats_ptr);
+
+#endif /* SOURCE_TRANSPORT_H_ */
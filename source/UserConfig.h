@@ -19,6 +19,8 @@
 #define ENABLE_SENSOR
 #define ENABLE_ENCRYPTION
 #define ENABLE_HTTP
+/* run the on-device benchmarks once during startup */
+//#define ENABLE_BENCHMARK
 /* configure Producer or Consumer build */
 #define ENABLE_CONSUMER
 //#define ENABLE_PRODUCER
@@ -77,19 +79,176 @@
 /* seconds to wait until Http response is received */
 #define HTTPRESPONSE_SECONDSTOWAIT		10
 
+/* deadlines and retries of the json-rpc calls. A read whose response
+ * does not arrive within HTTP_READ_ATTEMPT_TIMEOUT_MS is sent again up to
+ * HTTP_READ_RETRY_MAX times, the wait before a retry starts with
+ * HTTP_RETRY_BACKOFF_MS and doubles. Transactions are never sent twice,
+ * they wait up to HTTP_TRANSACTION_DEADLINE_MS for the transaction hash.
+ * */
+#define HTTP_READ_DEADLINE_MS			10000
+#define HTTP_READ_ATTEMPT_TIMEOUT_MS	2500
+#define HTTP_READ_RETRY_MAX				3
+#define HTTP_RETRY_BACKOFF_MS			250
+#define HTTP_TRANSACTION_DEADLINE_MS	(HTTPRESPONSE_SECONDSTOWAIT * 1000)
+
+/* keep one http/1.1 session to the json-rpc node open and reuse it for
+ * every request instead of opening a new connection per request.
+ * Comment out to close the session after each response.
+ * */
+#define ENABLE_HTTP_KEEP_ALIVE
+
+/* send the json rpc calls over one persistent websocket connection to
+ * HTTP_IP_ADDRESS:WEBSOCKET_PORT instead of one http post per request.
+ * The node can push subscription notifications over it. The frame masks
+ * are taken from the random generator of ENABLE_ENCRYPTION.
+ * Comment out to use http.
+ * */
+//#define ENABLE_WEBSOCKET_TRANSPORT
+/* websocket json-rpc port and path of the node e.g. geth --ws */
+#define WEBSOCKET_PORT	8546
+#define WEBSOCKET_PATH	"/"
+
+/* write several json rpc requests to one persistent http/1.1 connection to
+ * HTTP_IP_ADDRESS:HTTP_PORT without waiting for the responses before, the
+ * node answers them in order. A node which closes a pipelined connection
+ * is sent one request at a time afterwards.
+ * Comment out to wait for every response before the next request is sent.
+ * */
+//#define ENABLE_HTTP_PIPELINING
+/* requests in flight on the connection - at most PIPELINE_QUEUE_SIZE */
+#define HTTP_PIPELINE_DEPTH	HTTP_REQUEST_SLOT_MAX
+
+/* spread the json-rpc requests over several nodes. Reads go to the
+ * node with the lowest latency, a request is moved to the next node
+ * after a timeout or connection error. Filters and eth_sendTransaction
+ * stay on the first node since it holds the unlocked accounts.
+ * Comment out to send every request to HTTP_IP_ADDRESS:HTTP_PORT.
+ * */
+#define ENABLE_NODE_POOL
+/* json-rpc nodes { ipv4 address, host header, port } - the first one is
+ * the primary node, at most NODE_POOL_ENDPOINT_MAX entries */
+#define NODE_POOL_ENDPOINTS		{ { HTTP_IP_ADDRESS, HOST_ADDRESS, HTTP_PORT } }
+/* time a node has to answer before the request is moved to the next node */
+#define NODE_POOL_FAILOVER_TIME_MS	3000
+/* interval of the latency and health probes of idle nodes */
+#define NODE_POOL_PROBE_INTERVAL_MS	10000
+/* failures in a row until a node is not selected anymore */
+#define NODE_POOL_FAILURE_THRESHOLD	2
+
 /* seconds to wait until transaction is confirmed */
 #define CONFIRMATION_TRANSACTION_COUNTER 	5
 #define CONFIRMATION_TIME_TO_WAIT			5
 
+/* track pending transactions with a block filter of the node and check
+ * their receipts once per new block instead of polling every receipt.
+ * Comment out to poll the receipts every CONFIRMATION_TIME_TO_WAIT seconds.
+ * */
+#define ENABLE_CONFIRMATION_TRACKER
+/* milliseconds between two polls of the block filter */
+#define CONFIRMATION_FILTER_POLL_TIME_MS	1000
+/* estimate the block interval of the chain and poll the block filter
+ * shortly after the expected next block instead of every
+ * CONFIRMATION_FILTER_POLL_TIME_MS. The delay is capped to
+ * CONFIRMATION_TIME_TO_WAIT seconds.
+ * */
+#define ENABLE_ADAPTIVE_CONFIRMATION_POLLING
+/* milliseconds to poll after the expected block and lower bound of the delay */
+#define CONFIRMATION_POLL_MARGIN_TIME_MS	200
+#define CONFIRMATION_POLL_MIN_TIME_MS		200
+
+/* cache the results of contract view calls (eth_call) per block. A result
+ * is reused until the node reports a new block, a transaction of the
+ * device is confirmed or the producer sends new data.
+ * Comment out to send every view call to the node.
+ * */
+#define ENABLE_READ_CACHE
+/* milliseconds a block number is used to answer view calls from the
+ * cache. An older block number is read again with eth_blockNumber in the
+ * same batch request as the next view call. The block filter of the
+ * confirmation tracker keeps it current while transactions are pending */
+#define READ_CACHE_BLOCK_NUMBER_MAX_AGE_MS	1000
+
+/* send transactions with the gas limit estimated by the node (eth_estimateGas)
+ * plus a safety margin. Estimates are cached per contract function and
+ * argument size and compared with the gas used in the receipts.
+ * Comment out to send every transaction with the fallback gas limit of its function.
+ * */
+#define ENABLE_GAS_ESTIMATION
+/* percent added to the estimate of the node */
+#define GAS_ESTIMATE_MARGIN_PERCENT		20
+/* milliseconds an estimate is used before the node is asked again - the
+ * gas changes with the contract state e.g. the first write of a value */
+#define GAS_ESTIMATE_MAX_AGE_MS			600000
+
+/* write the calls which only differ in the id and the gas limit e.g. ReadDataHash
+ * or rateProducer from a template. The first call of a function and addresses
+ * is serialized and stored, the following ones are copied and patched.
+ * Comment out to serialize every call with the JSON writer.
+ * */
+#define ENABLE_REQUEST_TEMPLATES
+
+/* copy the private consumer key from source/RSAKeys.h into the RSA
+ * context instead of parsing the PEM string during startup. Generate
+ * the header from PrivateRSAKeyConsumer1024 with "make keys".
+ * Comment out to parse PrivateRSAKeyConsumer1024.
+ * */
+//#define ENABLE_COMPILED_KEYS
+
+/* encrypt the sensor data with AES-CCM and wrap only the AES key with the
+ * RSA key of the consumer, once per session. The producer sends the average
+ * and a profile of the acceleration - the message size grows with the data
+ * instead of one RSA block per value, the consumer decrypts with AES. Producer
+ * and consumer must use the same mode.
+ * Comment out to encrypt the average acceleration with RSA.
+ * */
+//#define ENABLE_HYBRID_ENCRYPTION
+/* messages of one AES session until a new key is wrapped - a consumer
+ * which missed the wrapped key waits for the next session */
+#define HYBRID_SESSION_MESSAGES			16
+/* sessions of the producer the consumer remembers - the wrapped key of such
+ * a session is rejected, so the readings of an older session can not be
+ * replayed */
+#define HYBRID_SESSION_HISTORY			8
+
+/* encrypt with ECIES (ephemeral ECDH, SHA-256 KDF, AES-CCM) for consumers
+ * which published an elliptic curve key - the producer selects the scheme
+ * per consumer, consumers with a PEM key are still served with RSA. The
+ * consumer publishes the public key of CONSUMER_ECIES_PRIVATE_KEY (65 bytes
+ * secp256r1 or 32 bytes Curve25519 instead of the 274 byte PEM key) and
+ * decrypts with it. ENABLE_COMPILED_KEYS has no effect on such a consumer.
+ * Comment out to use RSA for every consumer.
+ * */
+//#define ENABLE_ECIES_ENCRYPTION
+/* curve of the consumer key - ECIES_CURVE_SECP256R1 or ECIES_CURVE_CURVE25519 */
+#define ECIES_CONSUMER_CURVE			ECIES_CURVE_CURVE25519
+/* hex private key of the consumer - 32 bytes, little endian for Curve25519 */
+#define CONSUMER_ECIES_PRIVATE_KEY		""
+
+/* sign transactions on the XDK with the account key and send them with
+ * eth_sendRawTransaction. The nonce is tracked locally, so the node does
+ * not have to manage the account. Needs MBEDTLS_ECP_DP_SECP256K1_ENABLED
+ * in the mbedtls library (see HowToMbedTLS/HowToMbedTLS.txt).
+ * Comment out to let the node sign with eth_sendTransaction.
+ * */
+//#define ENABLE_LOCAL_SIGNING
+/* EIP-155 chain id and gas price in wei of signed transactions */
+#define SIGNER_CHAIN_ID						1337
+#define SIGNER_GAS_PRICE					UINT64_C(20000000000)
+
 /* accel value threshhold */
 #define ACCELEROMETER_VALUE_THRESHHOLD	5
 /* define count of ticks for measuring x accel values after button1 pressed on XDK */
 #define ACCELERATION_VALUES 1000
+/* averages over equal windows of the recorded values - sent with ENABLE_HYBRID_ENCRYPTION */
+#define ACCELERATION_PROFILE_SIZE 31
 
 /* ethereum account information */
 #define CONTRACT_ADDRESS 			"" 			//e.g. "0xc47e575b2cacdc22545da4c0fe7aead9ce90a9f2"
 #define CONSUMER_ACCOUNT_ADDRESS 	"" 	//e.g. "0x275b4EFC07BB4A8eb56fAF050Cf6436C2c06250E"
 #define PRODUCER_ACCOUNT_ADDRESS 	"" 	//e.g. "0x63c3465D4a300d767F0BDDD8d5ce256BbBD6fb41"
+/* hex private keys of the accounts - only used with ENABLE_LOCAL_SIGNING */
+#define CONSUMER_ACCOUNT_PRIVATE_KEY	""
+#define PRODUCER_ACCOUNT_PRIVATE_KEY	""
 
 /* define XDK IPV4 address - Producer */
 #ifdef ENABLE_WIFI_ENTERPRISE
@@ -0,0 +1,644 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+/* system includes */
+#include <stdio.h>
+#include <string.h>
+#include "BCDS_Basics.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "simplelink.h"
+
+/* mbedTLS library includes */
+#include "mbedtls/base64.h"
+
+/* user includes */
+#include "WebSocketTransport.h"
+#include "Http.h"
+#include "Encryption.h"
+#include "NodePool.h"
+#include "UserConfig.h"
+#include "SystemConfig.h"
+
+/* frame header bits and opcodes of RFC 6455 */
+#define WEBSOCKET_FIN					0x80
+#define WEBSOCKET_MASK					0x80
+#define WEBSOCKET_OPCODE_MASK			0x0F
+#define WEBSOCKET_OPCODE_CONTINUATION	0x0
+#define WEBSOCKET_OPCODE_TEXT			0x1
+#define WEBSOCKET_OPCODE_BINARY			0x2
+#define WEBSOCKET_OPCODE_CLOSE			0x8
+#define WEBSOCKET_OPCODE_PING			0x9
+#define WEBSOCKET_OPCODE_PONG			0xA
+#define WEBSOCKET_LENGTH_16BIT			126
+#define WEBSOCKET_LENGTH_64BIT			127
+#define WEBSOCKET_CONTROL_PAYLOAD_MAX	125
+#define WEBSOCKET_MASK_SIZE				4
+
+/* random nonce of the opening handshake */
+#define WEBSOCKET_KEY_NONCE_SIZE		16
+#define WEBSOCKET_KEY_SIZE				25
+#define WEBSOCKET_HANDSHAKE_STATUS		"HTTP/1.1 101"
+
+/* client frames are masked in chunks of this size before they are sent */
+#define WEBSOCKET_SEND_CHUNK_SIZE		256
+
+/* a message of the node must fit into one request payload buffer */
+#define WEBSOCKET_RECEIVE_BUFFER_SIZE	HTTP_REQUEST_PAYLOAD_SIZE
+
+/* the receive task parses the responses like the http client task */
+#define WEBSOCKET_TASK_STACK_SIZE		2048
+#define WEBSOCKET_TASK_PRIORITY			2
+
+/**
+ * This handler struct holds the socket of the websocket
+ * connection, its state and the buffers of the sender and
+ * of the receive task
+ */
+typedef struct webSocketHandler_S {
+	TransportCallbacks_T const *callbacks_ptr;
+	TransportState_T state;
+	int16_t socket;
+	SemaphoreHandle_t sendMutex;
+	SemaphoreHandle_t connectedSemaphore;
+	xTaskHandle receiveTask;
+	uint8_t sendBuff[WEBSOCKET_SEND_CHUNK_SIZE];
+	uint8_t controlBuff[WEBSOCKET_CONTROL_PAYLOAD_MAX];
+	uint8_t receiveBuff[WEBSOCKET_RECEIVE_BUFFER_SIZE];
+	size_t receiveLength;
+	bool dropMessage;
+} webSocketHandler_T;
+static webSocketHandler_T webSocketHandleVar = { .socket = -1 };
+
+/* connection, message and byte counters */
+static TransportStats_T webSocketStatsVar = {0};
+
+/**
+ * This function receives a number of bytes. A receive
+ * timeout before the first byte lets the receive task
+ * check the connection, within a frame it waits as long
+ * as the connection is open.
+ *
+ * @param[in] socket
+ * This variable holds the socket of the connection
+ *
+ * @param[out] oBuff_ptr
+ * This buffer will hold the data
+ *
+ * @param[in] iLength
+ * This variable holds the number of bytes
+ *
+ * @param[out] oIdle_ptr
+ * This reference will be true if no data arrived. NULL
+ * within a frame.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T receiveAll(int16_t socket, uint8_t *oBuff_ptr, size_t iLength, bool *oIdle_ptr)
+{
+	int16_t received = 0;
+	size_t offset = 0;
+
+	while(offset < iLength) {
+		received = sl_Recv(socket, &oBuff_ptr[offset], (int16_t) (iLength - offset), 0);
+		if(0 < received) {
+			offset += (size_t) received;
+			webSocketStatsVar.bytesReceived += (uint32_t) received;
+		} else if( (SL_EAGAIN == received) && (socket == webSocketHandleVar.socket) ) {
+			if( (0 == offset) && (NULL != oIdle_ptr) ) {
+				*oIdle_ptr = true;
+				return RETCODE_FAILURE;
+			}
+		} else {
+			return RETCODE_FAILURE;
+		}
+	}
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function sends one masked frame. Client frames
+ * are masked with a random key - the payload is masked
+ * chunk wise in the send buffer. The caller holds the
+ * send mutex.
+ *
+ * @param[in] socket
+ * This variable holds the socket of the connection
+ *
+ * @param[in] opcode
+ * This variable holds the opcode of the frame
+ *
+ * @param[in] payload_ptr
+ * This reference holds the payload
+ *
+ * @param[in] iLength
+ * This variable holds the length of the payload
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T sendFrame(int16_t socket, uint8_t opcode, uint8_t const *payload_ptr, size_t iLength)
+{
+	uint8_t *buff_ptr = webSocketHandleVar.sendBuff;
+	uint8_t mask[WEBSOCKET_MASK_SIZE];
+	size_t used = 0;
+
+	buff_ptr[used++] = WEBSOCKET_FIN | opcode;
+	if(WEBSOCKET_LENGTH_16BIT > iLength) {
+		buff_ptr[used++] = WEBSOCKET_MASK | (uint8_t) iLength;
+	} else if(UINT16_MAX >= iLength) {
+		buff_ptr[used++] = WEBSOCKET_MASK | WEBSOCKET_LENGTH_16BIT;
+		buff_ptr[used++] = (uint8_t) (iLength >> 8);
+		buff_ptr[used++] = (uint8_t) iLength;
+	} else {
+		return RETCODE_FAILURE;
+	}
+	/* the masks must not be predictable for intermediaries */
+	if(RETCODE_SUCCESS != EncryptionGetRandom(mask, sizeof(mask))) {
+		return RETCODE_FAILURE;
+	}
+	for(uint8_t i = 0; i < WEBSOCKET_MASK_SIZE; ++i) {
+		buff_ptr[used++] = mask[i];
+	}
+
+	for(size_t i = 0; i < iLength; ++i) {
+		buff_ptr[used++] = payload_ptr[i] ^ mask[i % WEBSOCKET_MASK_SIZE];
+		if(sizeof(webSocketHandleVar.sendBuff) == used) {
+			if(RETCODE_SUCCESS != TransportSendAll(socket, buff_ptr, used, &webSocketStatsVar)) {
+				return RETCODE_FAILURE;
+			}
+			used = 0;
+		}
+	}
+
+	return (0 < used) ? TransportSendAll(socket, buff_ptr, used, &webSocketStatsVar) : RETCODE_SUCCESS;
+}
+
+/**
+ * This function closes the connection if it still uses
+ * the given socket and informs the json rpc client. Called
+ * by the sender and by the receive task.
+ *
+ * @param[in] socket
+ * This variable holds the socket which failed
+ *
+ * @return
+ * void
+ */
+static void closeConnection(int16_t socket)
+{
+	bool closed = false;
+
+	taskENTER_CRITICAL();
+	if( (0 <= socket) && (socket == webSocketHandleVar.socket) ) {
+		webSocketHandleVar.socket = -1;
+		webSocketHandleVar.state = TRANSPORT_DISCONNECTED;
+		closed = true;
+	}
+	taskEXIT_CRITICAL();
+
+	if(true == closed) {
+		(void) sl_Close(socket);
+#ifdef ENABLE_DEBUG
+		printf("WebSocket connection closed\n\r");
+#endif
+		webSocketHandleVar.callbacks_ptr->stateChanged(NODE_POOL_PRIMARY, TRANSPORT_DISCONNECTED);
+	}
+}
+
+/**
+ * This function connects to the primary node of the node
+ * pool and sends the opening handshake. The response headers are read byte
+ * wise so no frame data is consumed. The caller holds
+ * the send mutex.
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T openConnection(void)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	SlSockAddrIn_t address;
+	SlTimeval_t timeout = { HTTPRESPONSE_SECONDSTOWAIT, 0 };
+	uint32_t ipAddress = 0;
+	uint8_t nonce[WEBSOCKET_KEY_NONCE_SIZE];
+	uint8_t key[WEBSOCKET_KEY_SIZE];
+	size_t keyLength = 0;
+	uint8_t *response_ptr = webSocketHandleVar.receiveBuff;
+	size_t responseLength = 0;
+	int requestLength = 0;
+	int16_t socket = -1;
+	NodePoolEndpoint_T const *endpoint_ptr = NodePoolGetEndpoint(NODE_POOL_PRIMARY);
+
+	if( (NULL == endpoint_ptr) || (RETCODE_SUCCESS != TransportParseIPv4Address(endpoint_ptr->address_ptr, &ipAddress)) ) {
+		return ret;
+	}
+	webSocketHandleVar.state = TRANSPORT_CONNECTING;
+	webSocketStatsVar.connectionCounter++;
+
+	socket = sl_Socket(SL_AF_INET, SL_SOCK_STREAM, SL_IPPROTO_TCP);
+	if(0 > socket) {
+		webSocketHandleVar.state = TRANSPORT_DISCONNECTED;
+		return ret;
+	}
+
+	address.sin_family = SL_AF_INET;
+	address.sin_port = sl_Htons(WEBSOCKET_PORT);
+	address.sin_addr.s_addr = sl_Htonl(ipAddress);
+
+	/* the receive timeout bounds the handshake and lets the
+	 * receive task notice a closed connection */
+	if( (0 <= sl_SetSockOpt(socket, SL_SOL_SOCKET, SL_SO_RCVTIMEO, &timeout, sizeof(timeout)))
+			&& (0 <= sl_Connect(socket, (SlSockAddr_t *) &address, sizeof(SlSockAddrIn_t)))
+			&& (RETCODE_SUCCESS == EncryptionGetRandom(nonce, sizeof(nonce))) ) {
+		if(0 == mbedtls_base64_encode(key, sizeof(key), &keyLength, nonce, sizeof(nonce))) {
+			requestLength = snprintf((char *) response_ptr, WEBSOCKET_RECEIVE_BUFFER_SIZE,
+					"GET %s HTTP/1.1\r\nHost: %s:%u\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+					"Sec-WebSocket-Key: %s\r\nSec-WebSocket-Version: 13\r\n\r\n",
+					WEBSOCKET_PATH, endpoint_ptr->host_ptr, (unsigned int) WEBSOCKET_PORT, key);
+			ret = TransportSendAll(socket, response_ptr, (size_t) requestLength, &webSocketStatsVar);
+		}
+	}
+
+	/* read the response headers up to the empty line */
+	while( (RETCODE_SUCCESS == ret) && ((4 > responseLength) || (0 != memcmp(&response_ptr[responseLength - 4], "\r\n\r\n", 4))) ) {
+		if( ((WEBSOCKET_RECEIVE_BUFFER_SIZE - 1) <= responseLength) || (1 != sl_Recv(socket, &response_ptr[responseLength], 1, 0)) ) {
+			ret = RETCODE_FAILURE;
+		} else {
+			responseLength++;
+			webSocketStatsVar.bytesReceived++;
+		}
+	}
+
+	/* the node switches the protocol - the accept key is not checked,
+	 * it only protects against servers which do not speak websocket */
+	if( (RETCODE_SUCCESS == ret) && (0 != strncmp((char const *) response_ptr, WEBSOCKET_HANDSHAKE_STATUS, strlen(WEBSOCKET_HANDSHAKE_STATUS))) ) {
+		ret = RETCODE_FAILURE;
+	}
+
+	if(RETCODE_SUCCESS != ret) {
+#ifdef ENABLE_DEBUG
+		printf("WebSocket handshake failed\n\r");
+#endif
+		(void) sl_Close(socket);
+		webSocketHandleVar.state = TRANSPORT_DISCONNECTED;
+		return ret;
+	}
+
+	taskENTER_CRITICAL();
+	webSocketHandleVar.socket = socket;
+	webSocketHandleVar.state = TRANSPORT_CONNECTED;
+	taskEXIT_CRITICAL();
+#ifdef ENABLE_DEBUG
+	printf("WebSocket connected to %s:%u%s\n\r", endpoint_ptr->address_ptr, (unsigned int) WEBSOCKET_PORT, WEBSOCKET_PATH);
+#endif
+	webSocketHandleVar.callbacks_ptr->stateChanged(NODE_POOL_PRIMARY, TRANSPORT_CONNECTED);
+
+	/* wake up the receive task */
+	xSemaphoreGive(webSocketHandleVar.connectedSemaphore);
+
+	return ret;
+}
+
+/**
+ * This function receives one frame. Data messages are
+ * passed to the json rpc client when their last frame
+ * arrived, pings are answered. Messages which do not fit
+ * into the receive buffer are dropped.
+ *
+ * @param[in] socket
+ * This variable holds the socket of the connection
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful or no frame arrived<br>
+ * RETCODE_FAILURE, if the connection has to be closed.
+ */
+static Retcode_T receiveFrame(int16_t socket)
+{
+	webSocketHandler_T *handle_ptr = &webSocketHandleVar;
+	uint8_t header[8];
+	uint8_t mask[WEBSOCKET_MASK_SIZE] = {0};
+	uint8_t *payload_ptr = NULL;
+	uint8_t opcode = 0;
+	bool final = false;
+	bool masked = false;
+	bool idle = false;
+	size_t length = 0;
+	size_t chunk = 0;
+
+	if(RETCODE_SUCCESS != receiveAll(socket, header, 2, &idle)) {
+		return (true == idle) ? RETCODE_SUCCESS : RETCODE_FAILURE;
+	}
+	final = (0 != (header[0] & WEBSOCKET_FIN));
+	opcode = header[0] & WEBSOCKET_OPCODE_MASK;
+	masked = (0 != (header[1] & WEBSOCKET_MASK));
+	length = header[1] & ~WEBSOCKET_MASK;
+
+	if(WEBSOCKET_LENGTH_16BIT == length) {
+		if(RETCODE_SUCCESS != receiveAll(socket, header, 2, NULL)) {
+			return RETCODE_FAILURE;
+		}
+		length = ((size_t) header[0] << 8) | header[1];
+	} else if(WEBSOCKET_LENGTH_64BIT == length) {
+		/* messages of the node never need more than 32 bits */
+		if( (RETCODE_SUCCESS != receiveAll(socket, header, 8, NULL)) || (0 != (header[0] | header[1] | header[2] | header[3])) ) {
+			return RETCODE_FAILURE;
+		}
+		length = ((size_t) header[4] << 24) | ((size_t) header[5] << 16) | ((size_t) header[6] << 8) | header[7];
+	}
+	if( (true == masked) && (RETCODE_SUCCESS != receiveAll(socket, mask, sizeof(mask), NULL)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	if(WEBSOCKET_OPCODE_CLOSE <= opcode) {
+		/* control frame - never fragmented */
+		if( (WEBSOCKET_CONTROL_PAYLOAD_MAX < length) || (RETCODE_SUCCESS != receiveAll(socket, handle_ptr->controlBuff, length, NULL)) ) {
+			return RETCODE_FAILURE;
+		}
+		if(WEBSOCKET_OPCODE_PING == opcode) {
+			for(size_t i = 0; i < length; ++i) {
+				handle_ptr->controlBuff[i] ^= mask[i % WEBSOCKET_MASK_SIZE];
+			}
+			if(pdTRUE == xSemaphoreTake(handle_ptr->sendMutex, portMAX_DELAY)) {
+				(void) sendFrame(socket, WEBSOCKET_OPCODE_PONG, handle_ptr->controlBuff, length);
+				xSemaphoreGive(handle_ptr->sendMutex);
+			}
+		}
+		return (WEBSOCKET_OPCODE_CLOSE == opcode) ? RETCODE_FAILURE : RETCODE_SUCCESS;
+	}
+
+	if(WEBSOCKET_OPCODE_CONTINUATION != opcode) {
+		/* first frame of a new message */
+		handle_ptr->receiveLength = 0;
+		handle_ptr->dropMessage = false;
+	}
+	if( (true == handle_ptr->dropMessage) || (length > (sizeof(handle_ptr->receiveBuff) - handle_ptr->receiveLength)) ) {
+		/* discard the frame in chunks */
+		handle_ptr->dropMessage = true;
+		while(0 < length) {
+			chunk = (length < sizeof(handle_ptr->controlBuff)) ? length : sizeof(handle_ptr->controlBuff);
+			if(RETCODE_SUCCESS != receiveAll(socket, handle_ptr->controlBuff, chunk, NULL)) {
+				return RETCODE_FAILURE;
+			}
+			length -= chunk;
+		}
+	} else {
+		payload_ptr = &handle_ptr->receiveBuff[handle_ptr->receiveLength];
+		if(RETCODE_SUCCESS != receiveAll(socket, payload_ptr, length, NULL)) {
+			return RETCODE_FAILURE;
+		}
+		if(true == masked) {
+			for(size_t i = 0; i < length; ++i) {
+				payload_ptr[i] ^= mask[i % WEBSOCKET_MASK_SIZE];
+			}
+		}
+		handle_ptr->receiveLength += length;
+	}
+
+	if(true == final) {
+		if(false == handle_ptr->dropMessage) {
+			webSocketStatsVar.messageReceivedCounter++;
+#ifdef ENABLE_DEBUG
+			printf("WebSocket message: %.*s\n\r", (int) handle_ptr->receiveLength, handle_ptr->receiveBuff);
+#endif
+			/* responses are assigned by their JSON RPC id */
+			(void) handle_ptr->callbacks_ptr->received(NODE_POOL_PRIMARY, TRANSPORT_REQUEST_NONE, handle_ptr->receiveBuff, handle_ptr->receiveLength);
+		}
+#ifdef ENABLE_DEBUG
+		else {
+			printf("WebSocket message too large - dropped\n\r");
+		}
+#endif
+		handle_ptr->receiveLength = 0;
+		handle_ptr->dropMessage = false;
+	}
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This task receives the messages of the node while the
+ * connection is open. It sleeps until the next connection
+ * is opened by a request.
+ *
+ * @param[in] pvParameters
+ * unused
+ *
+ * @return
+ * void
+ */
+static void webSocketReceiveTask(void *pvParameters)
+{
+	int16_t socket = -1;
+
+	(void) pvParameters;
+
+	for(;;) {
+		if(TRANSPORT_CONNECTED != webSocketHandleVar.state) {
+			(void) xSemaphoreTake(webSocketHandleVar.connectedSemaphore, portMAX_DELAY);
+			continue;
+		}
+		socket = webSocketHandleVar.socket;
+		if(RETCODE_SUCCESS != receiveFrame(socket)) {
+			closeConnection(socket);
+		}
+	}
+}
+
+/**
+ * This function creates the send mutex and the receive
+ * task. The connection is opened with the first request.
+ *
+ * @param[in] callbacks_ptr
+ * This reference holds the callbacks of the json rpc client
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T webSocketTransportInit(TransportCallbacks_T const *callbacks_ptr)
+{
+	if(NULL == callbacks_ptr) {
+		return RETCODE_FAILURE;
+	}
+	webSocketHandleVar.callbacks_ptr = callbacks_ptr;
+
+	if(NULL == webSocketHandleVar.sendMutex) {
+		webSocketHandleVar.sendMutex = xSemaphoreCreateMutex();
+	}
+	if(NULL == webSocketHandleVar.connectedSemaphore) {
+		webSocketHandleVar.connectedSemaphore = xSemaphoreCreateBinary();
+	}
+	if( (NULL == webSocketHandleVar.sendMutex) || (NULL == webSocketHandleVar.connectedSemaphore) ) {
+		return RETCODE_FAILURE;
+	}
+
+	if( (NULL == webSocketHandleVar.receiveTask)
+			&& (pdPASS != xTaskCreate(webSocketReceiveTask, (const char * const) "WebSocket", WEBSOCKET_TASK_STACK_SIZE, NULL, WEBSOCKET_TASK_PRIORITY, &webSocketHandleVar.receiveTask)) ) {
+		return RETCODE_FAILURE;
+	}
+
+	return RETCODE_SUCCESS;
+}
+
+/**
+ * This function sends a json rpc request as one text
+ * frame. The connection is opened if necessary.
+ *
+ * @param[in] node
+ * This variable holds the node - the connection always
+ * goes to the primary node
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request
+ *
+ * @param[in] payload_ptr
+ * This reference holds the json rpc request
+ *
+ * @param[in] iLength
+ * This variable holds the length of the request
+ *
+ * @return
+ * RETCODE_SUCCESS, if successful<br>
+ * RETCODE_FAILURE, otherwise.
+ */
+static Retcode_T webSocketTransportSend(uint8_t node, uint32_t requestID, uint8_t const *payload_ptr, size_t iLength)
+{
+	Retcode_T ret = RETCODE_FAILURE;
+	int16_t socket = -1;
+
+	(void) node;
+
+	if(pdTRUE != xSemaphoreTake(webSocketHandleVar.sendMutex, SECONDS(HTTPRESPONSE_SECONDSTOWAIT))) {
+		return ret;
+	}
+
+	if(TRANSPORT_CONNECTED == webSocketHandleVar.state) {
+		ret = RETCODE_SUCCESS;
+	} else {
+		ret = openConnection();
+	}
+	socket = webSocketHandleVar.socket;
+	if(RETCODE_SUCCESS == ret) {
+		ret = sendFrame(socket, WEBSOCKET_OPCODE_TEXT, payload_ptr, iLength);
+	}
+	if(RETCODE_SUCCESS == ret) {
+		webSocketStatsVar.messageSentCounter++;
+	}
+
+	xSemaphoreGive(webSocketHandleVar.sendMutex);
+
+	if(RETCODE_SUCCESS == ret) {
+		webSocketHandleVar.callbacks_ptr->sent(NODE_POOL_PRIMARY, requestID, RETCODE_SUCCESS);
+	} else {
+		closeConnection(socket);
+	}
+
+	return ret;
+}
+
+/**
+ * This function returns the connection state
+ *
+ * @return
+ * state of the websocket connection
+ */
+static TransportState_T webSocketTransportGetState(void)
+{
+	return webSocketHandleVar.state;
+}
+
+/**
+ * This function closes the connection. Requests in
+ * flight are failed, the next request connects again.
+ *
+ * @param[in] node
+ * This variable holds the node - there is only the
+ * connection to the primary node
+ *
+ * @return
+ * void
+ */
+static void webSocketTransportDisconnect(uint8_t node)
+{
+	(void) node;
+
+	closeConnection(webSocketHandleVar.socket);
+}
+
+/**
+ * This function cancels a request which is not answered.
+ * All requests share one connection and the node answers
+ * in order, so the connection is considered stalled and
+ * closed - the requests in flight on it are failed and
+ * retried on a new connection.
+ *
+ * @param[in] node
+ * This variable holds the node - there is only the
+ * connection to the primary node
+ *
+ * @param[in] requestID
+ * This variable holds the id of the request - not used
+ *
+ * @return
+ * void
+ */
+static void webSocketTransportCancel(uint8_t node, uint32_t requestID)
+{
+	(void) node;
+	(void) requestID;
+
+	closeConnection(webSocketHandleVar.socket);
+}
+
+/**
+ * This function copies the counters of the transport
+ *
+ * @param[out] oStats_ptr
+ * This reference will hold the counter values
+ *
+ * @return
+ * void
+ */
+static void webSocketTransportGetStats(TransportStats_T *oStats_ptr)
+{
+	if(NULL != oStats_ptr) {
+		*oStats_ptr = webSocketStatsVar;
+	}
+}
+
+static const Transport_T WebSocketTransport = {
+	"websocket",
+	false,
+	webSocketTransportInit,
+	webSocketTransportSend,
+	webSocketTransportGetState,
+	webSocketTransportDisconnect,
+	webSocketTransportCancel,
+	webSocketTransportGetStats
+};
+
+/**
+ * This function returns the transport which sends the
+ * json rpc requests over one persistent websocket
+ * connection to the primary node. The node can push
+ * subscription notifications over it.
+ *
+ * @return
+ * reference of the transport
+ */
+Transport_T const *WebSocketTransportGet(void)
+{
+	return &WebSocketTransport;
+}
@@ -0,0 +1,17 @@
+/*
+    Copyright (c) 2019 Robert Bosch GmbH
+    All rights reserved.
+
+    This source code is licensed under the MIT license found in the
+    LICENSE file in the root directory of this source tree.
+*/
+
+#ifndef SOURCE_WEBSOCKETTRANSPORT_H_
+#define SOURCE_WEBSOCKETTRANSPORT_H_
+
+#include "Transport.h"
+
+/* global interface function declarations */
+Transport_T const *WebSocketTransportGet(void);
+
+#endif /* SOURCE_WEBSOCKETTRANSPORT_H_ */
@@ -0,0 +1,298 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2019 Robert Bosch GmbH
+# All rights reserved.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""End-to-end latency harness of the producer and consumer json-rpc flows.
+
+Replays the json-rpc calls the two XDKs send during one communication
+cycle and reports the latency of every stage:
+
+    consumer  estimate and send WritePublicKey, wait for its confirmation
+    producer  ReadPublicKey, estimate and send WriteDataHash, confirmation
+    consumer  ReadDataHash, estimate and send rateProducer, confirmation
+
+The client behaves like Http.c: one keep-alive connection, an attempt
+timeout, reads are retried with exponential backoff, transactions are
+sent once. Confirmations are waited for with a block filter like the
+confirmation tracker or by polling the receipts (--confirm poll).
+
+Without --url a tools/mock_node.py node is started in this process, its
+block time, latency and failure injection options are accepted here:
+
+    python3 tools/e2e_harness.py --rounds 20 --block-time 1 --latency 50 --jitter 30
+    python3 tools/e2e_harness.py --rounds 20 --block-time 1 --fail-rate 0.1 --fail-mode drop
+    python3 tools/e2e_harness.py --url http://192.168.0.10:8545 --contract 0x... --producer 0x... --consumer 0x...
+"""
+
+import argparse
+import http.client
+import json
+import os
+import sys
+import time
+import urllib.parse
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import mock_node  # noqa: E402
+
+# UserConfig.h defaults
+ATTEMPT_TIMEOUT = 2.5
+READ_RETRY_MAX = 3
+RETRY_BACKOFF = 0.25
+TRANSACTION_TIMEOUT = 10.0
+CONFIRMATION_TIMEOUT = 25.0
+FILTER_POLL_TIME = 1.0
+
+PUBLIC_KEY_LENGTH = 272     # PEM of a 1024 bit RSA public key
+DATA_HASH_LENGTH = 32
+DATA_EXCHANGE_PRICE = 2 * 10 ** 18
+
+STAGES = (
+    "consumer.estimate_public_key",
+    "consumer.write_public_key",
+    "consumer.confirm_public_key",
+    "producer.read_public_key",
+    "producer.estimate_data_hash",
+    "producer.write_data_hash",
+    "producer.confirm_data_hash",
+    "consumer.read_data_hash",
+    "consumer.estimate_rating",
+    "consumer.rate_producer",
+    "consumer.confirm_rating",
+)
+
+
+class RpcError(Exception):
+    pass
+
+
+class Client:
+    """json-rpc client with the timeout and retry policy of Http.c."""
+
+    def __init__(self, url, attempt_timeout, retry_max, backoff):
+        parsed = urllib.parse.urlparse(url)
+        self.host = parsed.hostname
+        self.port = parsed.port or 80
+        self.path = parsed.path or "/"
+        self.attempt_timeout = attempt_timeout
+        self.retry_max = retry_max
+        self.backoff = backoff
+        self.connection = None
+        self.next_id = 1
+        self.retries = 0
+        self.lost_polls = 0
+
+    def _post(self, body, timeout):
+        if self.connection is None:
+            self.connection = http.client.HTTPConnection(self.host, self.port, timeout=timeout)
+        self.connection.timeout = timeout
+        if self.connection.sock is not None:
+            self.connection.sock.settimeout(timeout)
+        try:
+            self.connection.request("POST", self.path, body, {"Content-Type": "application/json"})
+            response = self.connection.getresponse()
+            content = response.read()
+        except (OSError, http.client.HTTPException) as error:
+            self.connection.close()
+            self.connection = None
+            raise RpcError("transport: %s" % error)
+        if response.status != 200:
+            raise RpcError("http status %d" % response.status)
+        return json.loads(content)
+
+    def call(self, method, params, read=True):
+        """Send one call, reads are retried until retry_max, return the result."""
+        body = json.dumps({"jsonrpc": "2.0", "method": method, "params": params, "id": self.next_id}, separators=(",", ":"))
+        self.next_id += 1
+        retry_max = self.retry_max if read else 0
+        timeout = self.attempt_timeout if read else TRANSACTION_TIMEOUT
+        for attempt in range(retry_max + 1):
+            try:
+                answer = self._post(body, timeout)
+                if "error" in answer:
+                    raise RpcError("json-rpc: %s" % answer["error"].get("message"))
+                return answer.get("result")
+            except RpcError:
+                if attempt == retry_max:
+                    raise
+                self.retries += 1
+                time.sleep(self.backoff * (1 << attempt))
+        return None
+
+
+class Stats:
+    """Latency samples and failures of every stage."""
+
+    def __init__(self):
+        self.samples = {stage: [] for stage in STAGES}
+        self.failures = {stage: 0 for stage in STAGES}
+        self.rounds = []
+
+    def measure(self, stage, function, *args):
+        start = time.monotonic()
+        try:
+            result = function(*args)
+        except RpcError as error:
+            self.failures[stage] += 1
+            print("%s failed: %s" % (stage, error), flush=True)
+            raise
+        self.samples[stage].append((time.monotonic() - start) * 1000.0)
+        return result
+
+    @staticmethod
+    def percentile(values, share):
+        ordered = sorted(values)
+        return ordered[min(len(ordered) - 1, int(share * len(ordered)))]
+
+    def report(self):
+        print("%-30s %5s %5s %9s %9s %9s %9s %9s" % ("stage [ms]", "n", "fail", "min", "mean", "p50", "p95", "max"))
+        for stage in STAGES + ("round",):
+            values = self.rounds if stage == "round" else self.samples[stage]
+            failures = 0 if stage == "round" else self.failures[stage]
+            if not values:
+                print("%-30s %5d %5d" % (stage, 0, failures))
+                continue
+            print("%-30s %5d %5d %9.1f %9.1f %9.1f %9.1f %9.1f" % (stage, len(values), failures, min(values), sum(values) / len(values),
+                                                                   self.percentile(values, 0.5), self.percentile(values, 0.95), max(values)))
+
+
+def call_object(sender, contract, data, value=0):
+    call = {"from": sender, "to": contract, "data": data}
+    if value:
+        call["value"] = hex(value)
+    return call
+
+
+def bytes_call(selector, payload):
+    """ABI encode function(bytes) like ABIEncodeCall."""
+    return "0x" + selector + mock_node.word(0x20) + mock_node.encode_bytes(payload.hex())
+
+
+def bool_call(selector, value):
+    return "0x" + selector + mock_node.word(1 if value else 0)
+
+
+def replace_filter(client, filter_id):
+    """Uninstall the filter like createBlockFilter and install a new one."""
+    if filter_id is not None:
+        try:
+            client.call("eth_uninstallFilter", [filter_id])
+        except RpcError:
+            pass
+    try:
+        return client.call("eth_newBlockFilter", [])
+    except RpcError:
+        return None
+
+
+def confirm(client, tx_hash, args):
+    """Wait until the receipt of the transaction has status 0x1. Like the
+    confirmation tracker a lost poll is repeated with the next one and a
+    filter the node does not know anymore is replaced, without block
+    filter the receipt is polled."""
+    deadline = time.monotonic() + args.confirm_timeout
+    filter_id = None
+    if args.confirm == "filter":
+        filter_id = replace_filter(client, None)
+    try:
+        while time.monotonic() < deadline:
+            try:
+                if filter_id is None or client.call("eth_getFilterChanges", [filter_id], read=False):
+                    receipt = client.call("eth_getTransactionReceipt", [tx_hash])
+                    if receipt is not None:
+                        if receipt.get("status") != "0x1":
+                            raise RpcError("transaction failed with status %s" % receipt.get("status"))
+                        return receipt
+            except RpcError as error:
+                if str(error).startswith("transaction failed"):
+                    raise
+                if "filter not found" in str(error):
+                    filter_id = replace_filter(client, filter_id)
+                client.lost_polls += 1
+            time.sleep(args.poll_interval)
+    finally:
+        if filter_id is not None:
+            try:
+                client.call("eth_uninstallFilter", [filter_id])
+            except RpcError:
+                pass
+    raise RpcError("transaction not confirmed after %.1f s" % args.confirm_timeout)
+
+
+def send_transaction(client, stats, args, prefix, sender, contract, data, value=0):
+    """Estimate, send and confirm one transaction like HttpRequestSend with ENABLE_GAS_ESTIMATION."""
+    name = {"0ef81269": "data_hash", "2ea8dff5": "public_key", "f18aeab6": "rating"}[data[2:10]]
+    call = call_object(sender, contract, data, value)
+    gas = stats.measure("%s.estimate_%s" % (prefix, name), client.call, "eth_estimateGas", [call])
+    call["gas"] = hex(int(gas, 16) * 120 // 100)
+    write = "rate_producer" if name == "rating" else "write_" + name
+    tx_hash = stats.measure("%s.%s" % (prefix, write), client.call, "eth_sendTransaction", [call], False)
+    stats.measure("%s.confirm_%s" % (prefix, name), confirm, client, tx_hash, args)
+
+
+def run_round(producer, consumer, stats, args, number):
+    public_key = (b"-----BEGIN PUBLIC KEY-----\n" + os.urandom(PUBLIC_KEY_LENGTH).hex().encode())[:PUBLIC_KEY_LENGTH]
+    data_hash = os.urandom(DATA_HASH_LENGTH // 2).hex().encode()
+
+    send_transaction(consumer, stats, args, "consumer", args.consumer, args.contract, bytes_call(mock_node.SELECTOR_WRITE_PUBLIC_KEY, public_key), DATA_EXCHANGE_PRICE)
+    stats.measure("producer.read_public_key", producer.call, "eth_call",
+                  [call_object(args.producer, args.contract, "0x" + mock_node.SELECTOR_READ_PUBLIC_KEY), "latest"])
+    send_transaction(producer, stats, args, "producer", args.producer, args.contract, bytes_call(mock_node.SELECTOR_WRITE_DATA_HASH, data_hash))
+    result = stats.measure("consumer.read_data_hash", consumer.call, "eth_call",
+                           [call_object(args.consumer, args.contract, "0x" + mock_node.SELECTOR_READ_DATA_HASH), "latest"])
+    if mock_node.encode_bytes(data_hash.hex()) not in result:
+        print("round %d: consumer read a stale data hash" % number, flush=True)
+    send_transaction(consumer, stats, args, "consumer", args.consumer, args.contract, bool_call(mock_node.SELECTOR_RATE_PRODUCER, True))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--url", help="json-rpc node, default: start a mock node in this process")
+    parser.add_argument("--contract", default="0x" + "c4" * 20, help="address of the SecureEdgeDevice contract")
+    parser.add_argument("--producer", default="0x" + "63" * 20, help="unlocked account of the producer")
+    parser.add_argument("--consumer", default="0x" + "27" * 20, help="unlocked account of the consumer")
+    parser.add_argument("--rounds", type=int, default=10)
+    parser.add_argument("--confirm", choices=("filter", "poll"), default="filter")
+    parser.add_argument("--poll-interval", type=float, default=FILTER_POLL_TIME, help="seconds between two filter or receipt polls")
+    parser.add_argument("--confirm-timeout", type=float, default=CONFIRMATION_TIMEOUT)
+    parser.add_argument("--attempt-timeout", type=float, default=ATTEMPT_TIMEOUT, help="seconds until a read is retried")
+    parser.add_argument("--retries", type=int, default=READ_RETRY_MAX)
+    parser.add_argument("--backoff", type=float, default=RETRY_BACKOFF, help="seconds before the first retry, doubled per retry")
+    mock_node.add_arguments(parser)
+    args = parser.parse_args()
+
+    server = None
+    url = args.url
+    if url is None:
+        server = mock_node.start("127.0.0.1", 0, args)
+        mock_node.Handler.chain.log = args.verbose
+        url = "http://127.0.0.1:%d/" % server.server_address[1]
+    print("json-rpc node %s, %d rounds" % (url, args.rounds), flush=True)
+
+    stats = Stats()
+    producer = Client(url, args.attempt_timeout, args.retries, args.backoff)
+    consumer = Client(url, args.attempt_timeout, args.retries, args.backoff)
+    for number in range(args.rounds):
+        start = time.monotonic()
+        try:
+            run_round(producer, consumer, stats, args, number)
+        except RpcError:
+            continue
+        stats.rounds.append((time.monotonic() - start) * 1000.0)
+
+    stats.report()
+    print("%d of %d rounds completed, %d retries, %d lost confirmation polls" % (len(stats.rounds), args.rounds, producer.retries + consumer.retries,
+                                                                               producer.lost_polls + consumer.lost_polls))
+    if server is not None:
+        faults = mock_node.Handler.faults
+        print("mock node: %d requests, %d injected failures" % (faults.requests, faults.failures))
+        server.shutdown()
+    return 0 if len(stats.rounds) == args.rounds else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2019 Robert Bosch GmbH
+# All rights reserved.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Generate source/ContractABI.h from the Solidity smart contract.
+
+Every public function of the contract gets a define with its 4 byte
+function selector - the first four bytes of the keccak256 hash of the
+canonical function signature, e.g. WriteDataHash(bytes):
+
+    #define ABI_SELECTOR_WRITE_DATA_HASH    UINT32_C(0x0ef81269)
+
+Run it after changing the contract (or via "make abi"):
+
+    python3 tools/gen_abi.py [SmartContract/SecureEdgeDevice.sol] [source/ContractABI.h]
+"""
+
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_CONTRACT = os.path.join(ROOT, "SmartContract", "SecureEdgeDevice.sol")
+DEFAULT_HEADER = os.path.join(ROOT, "source", "ContractABI.h")
+
+# keccak-f[1600] round constants and rotation offsets
+ROUND_CONSTANTS = [
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000,
+    0x000000000000808B, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+    0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800A, 0x800000008000000A,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+]
+ROTATIONS = [
+    [0, 36, 3, 41, 18],
+    [1, 44, 10, 45, 2],
+    [62, 6, 43, 15, 61],
+    [28, 55, 25, 21, 56],
+    [27, 20, 39, 8, 14],
+]
+MASK = (1 << 64) - 1
+
+
+def rotl(value, shift):
+    return ((value << shift) | (value >> (64 - shift))) & MASK if shift else value
+
+
+def keccak_f(state):
+    for constant in ROUND_CONSTANTS:
+        c = [state[x][0] ^ state[x][1] ^ state[x][2] ^ state[x][3] ^ state[x][4] for x in range(5)]
+        d = [c[(x - 1) % 5] ^ rotl(c[(x + 1) % 5], 1) for x in range(5)]
+        state = [[state[x][y] ^ d[x] for y in range(5)] for x in range(5)]
+        b = [[0] * 5 for _ in range(5)]
+        for x in range(5):
+            for y in range(5):
+                b[y][(2 * x + 3 * y) % 5] = rotl(state[x][y], ROTATIONS[x][y])
+        state = [[b[x][y] ^ ((~b[(x + 1) % 5][y]) & b[(x + 2) % 5][y]) for y in range(5)] for x in range(5)]
+        state[0][0] ^= constant
+    return state
+
+
+def keccak256(data):
+    """Ethereum keccak256 - the original keccak padding, not SHA3-256."""
+    rate = 136
+    # pad10*1 - 0x01 and 0x80 share the last byte if only one byte is left
+    padded = bytearray(data) + b"\x00" * (rate - len(data) % rate)
+    padded[len(data)] ^= 0x01
+    padded[-1] ^= 0x80
+    state = [[0] * 5 for _ in range(5)]
+    for offset in range(0, len(padded), rate):
+        block = padded[offset:offset + rate]
+        for i in range(rate // 8):
+            state[i % 5][i // 5] ^= int.from_bytes(block[8 * i:8 * i + 8], "little")
+        state = keccak_f(state)
+    out = b"".join(state[i % 5][i // 5].to_bytes(8, "little") for i in range(4))
+    return out
+
+
+def canonical_type(solidity_type):
+    solidity_type = solidity_type.strip()
+    for short, full in (("uint", "uint256"), ("int", "int256"), ("byte", "bytes1")):
+        if re.fullmatch(short + r"(\[\d*\])*", solidity_type):
+            return full + solidity_type[len(short):]
+    return solidity_type
+
+
+def parse_functions(source):
+    """Return (name, canonical signature) of every external callable function."""
+    source = re.sub(r"/\*.*?\*/", "", source, flags=re.S)
+    source = re.sub(r"//[^\n]*", "", source)
+    functions = []
+    for name, params, modifiers in re.findall(r"\bfunction\s+(\w+)\s*\(([^)]*)\)([^{;]*)", source):
+        if re.search(r"\b(internal|private)\b", modifiers):
+            continue
+        types = []
+        for param in filter(None, (p.strip() for p in params.split(","))):
+            words = [w for w in param.split() if w not in ("memory", "calldata", "storage")]
+            types.append(canonical_type(words[0]))
+        functions.append((name, "%s(%s)" % (name, ",".join(types))))
+    return functions
+
+
+def define_name(function_name):
+    snake = re.sub(r"(?<=[a-z0-9])(?=[A-Z])", "_", function_name)
+    return "ABI_SELECTOR_" + snake.upper()
+
+
+def generate(contract_path, header_path):
+    with open(contract_path) as contract:
+        functions = parse_functions(contract.read())
+    lines = [
+        "/*",
+        "    Copyright (c) 2019 Robert Bosch GmbH",
+        "    All rights reserved.",
+        "",
+        "    This source code is licensed under the MIT license found in the",
+        "    LICENSE file in the root directory of this source tree.",
+        "*/",
+        "",
+        "/* generated by tools/gen_abi.py from SmartContract/%s - do not edit */" % os.path.basename(contract_path),
+        "",
+        "#ifndef SOURCE_CONTRACTABI_H_",
+        "#define SOURCE_CONTRACTABI_H_",
+        "",
+        "/* function selectors - first four bytes of keccak256 of the function signature */",
+    ]
+    for name, signature in functions:
+        selector = keccak256(signature.encode())[:4].hex()
+        lines.append("#define %-36s UINT32_C(0x%s)\t/* %s */" % (define_name(name), selector, signature))
+    lines += ["", "#endif /* SOURCE_CONTRACTABI_H_ */", ""]
+    with open(header_path, "w", newline="\n") as header:
+        header.write("\n".join(lines))
+
+
+def main():
+    contract_path = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_CONTRACT
+    header_path = sys.argv[2] if len(sys.argv) > 2 else DEFAULT_HEADER
+    if keccak256(b"").hex() != "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470":
+        raise SystemExit("keccak256 self test failed")
+    generate(contract_path, header_path)
+    print("generated %s" % header_path)
+
+
+if __name__ == "__main__":
+    main()
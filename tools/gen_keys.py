@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2019 Robert Bosch GmbH
+# All rights reserved.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Generate source/RSAKeys.h from the PEM private key of the consumer.
+
+The PEM string PrivateRSAKeyConsumer1024 of source/UserConfig.h (or a
+PEM file) is decoded on the host and every RSA parameter is written as
+32 bit little endian limbs, the word order of mbedtls_mpi:
+
+    static const uint32_t RSAKeyConsumerN[] = { 0x..., ... };
+
+With ENABLE_COMPILED_KEYS the XDK copies the limbs into its RSA context
+instead of running the base64, PEM and ASN.1 parsers during startup.
+Run it after changing the key (or via "make keys"):
+
+    python3 tools/gen_keys.py [source/UserConfig.h | consumer.pem] [source/RSAKeys.h]
+"""
+
+import base64
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_INPUT = os.path.join(ROOT, "source", "UserConfig.h")
+DEFAULT_HEADER = os.path.join(ROOT, "source", "RSAKeys.h")
+
+# parameters of the RSA context in the order of the PKCS#1 RSAPrivateKey sequence
+PARAMETERS = ("N", "E", "D", "P", "Q", "DP", "DQ", "QP")
+
+# object identifier 1.2.840.113549.1.1.1 of a PKCS#8 rsaEncryption key
+RSA_ENCRYPTION_OID = bytes.fromhex("2a864886f70d010101")
+
+
+def read_pem(path):
+    """Return the PEM text of a file or of the PrivateRSAKeyConsumer1024 string of a header."""
+    with open(path) as source:
+        text = source.read()
+    if "-----BEGIN" in text and not path.endswith(".h"):
+        return text
+    # drop the commented out examples - only the configured string counts
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"//[^\n]*", "", text)
+    match = re.search(r"\bPrivateRSAKeyConsumer1024\s*=\s*((?:\s*\"(?:[^\"\\]|\\.)*\")+)\s*;", text)
+    if match is None:
+        raise SystemExit("PrivateRSAKeyConsumer1024 not found in %s" % path)
+    literals = re.findall(r"\"((?:[^\"\\]|\\.)*)\"", match.group(1))
+    return "".join(literals).replace("\\n", "\n").replace("\\r", "")
+
+
+def der_read(data, offset):
+    """Return tag, content and the offset behind one DER element."""
+    tag = data[offset]
+    length = data[offset + 1]
+    offset += 2
+    if length & 0x80:
+        count = length & 0x7F
+        length = int.from_bytes(data[offset:offset + count], "big")
+        offset += count
+    return tag, data[offset:offset + length], offset + length
+
+
+def der_sequence(data):
+    """Return the elements of a DER sequence as (tag, content) pairs."""
+    tag, content, _ = der_read(data, 0)
+    if tag != 0x30:
+        raise SystemExit("ASN.1 sequence expected")
+    elements = []
+    offset = 0
+    while offset < len(content):
+        tag, value, offset = der_read(content, offset)
+        elements.append((tag, value))
+    return elements
+
+
+def parse_private_key(pem):
+    """Return the RSA parameters of a PKCS#1 or PKCS#8 PEM private key and its DER length."""
+    match = re.search(r"-----BEGIN (RSA )?PRIVATE KEY-----(.*?)-----END (RSA )?PRIVATE KEY-----", pem, flags=re.S)
+    if match is None:
+        raise SystemExit("no unencrypted RSA private key found")
+    der = base64.b64decode("".join(match.group(2).split()))
+    elements = der_sequence(der)
+    if match.group(1) is None:
+        # PKCS#8 PrivateKeyInfo: version, algorithm, octet string with the PKCS#1 key
+        if RSA_ENCRYPTION_OID not in elements[1][1]:
+            raise SystemExit("not an RSA key")
+        elements = der_sequence(elements[2][1])
+    integers = [int.from_bytes(value, "big") for tag, value in elements if tag == 0x02]
+    if len(integers) < 9 or integers[0] != 0:
+        raise SystemExit("not a two prime RSA private key")
+    key = dict(zip(PARAMETERS, integers[1:9]))
+    if key["P"] * key["Q"] != key["N"] or key["QP"] * key["Q"] % key["P"] != 1:
+        raise SystemExit("inconsistent RSA private key")
+    return key, len(der)
+
+
+def limbs(value):
+    words = []
+    while value:
+        words.append(value & 0xFFFFFFFF)
+        value >>= 32
+    return words or [0]
+
+
+def generate(key, header_path, source_name):
+    lines = [
+        "/*",
+        "    Copyright (c) 2019 Robert Bosch GmbH",
+        "    All rights reserved.",
+        "",
+        "    This source code is licensed under the MIT license found in the",
+        "    LICENSE file in the root directory of this source tree.",
+        "*/",
+        "",
+        "/* generated by tools/gen_keys.py from %s - do not edit */" % source_name,
+        "",
+        "#ifndef SOURCE_RSAKEYS_H_",
+        "#define SOURCE_RSAKEYS_H_",
+        "",
+    ]
+    if key is None:
+        lines += ["/* no private consumer key configured */", "#define RSA_KEY_CONSUMER_AVAILABLE\t0", ""]
+    else:
+        lines += [
+            "#define RSA_KEY_CONSUMER_AVAILABLE\t1",
+            "",
+            "/* private consumer key (%d bit) - 32 bit limbs, least significant first */" % key["N"].bit_length(),
+        ]
+        for name in PARAMETERS:
+            words = limbs(key[name])
+            lines.append("static const uint32_t RSAKeyConsumer%s[%d] = {" % (name, len(words)))
+            for offset in range(0, len(words), 6):
+                lines.append("\t" + ", ".join("0x%08X" % word for word in words[offset:offset + 6]) + ",")
+            lines.append("};")
+        lines.append("")
+    lines += ["#endif /* SOURCE_RSAKEYS_H_ */", ""]
+    with open(header_path, "w", newline="\n") as header:
+        header.write("\n".join(lines))
+
+
+def main():
+    input_path = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_INPUT
+    header_path = sys.argv[2] if len(sys.argv) > 2 else DEFAULT_HEADER
+    pem = read_pem(input_path)
+    key = None
+    if pem.strip():
+        key, der_length = parse_private_key(pem)
+    generate(key, header_path, os.path.relpath(input_path, ROOT).replace(os.sep, "/"))
+    print("generated %s" % header_path)
+    if key is None:
+        print("no private consumer key configured")
+        return
+    limb_bytes = sum(4 * len(limbs(key[name])) for name in PARAMETERS)
+    print("flash: PEM string %d bytes -> limbs %d bytes" % (len(pem) + 1, limb_bytes))
+    print("heap during startup: PEM parser %d bytes DER buffer -> none" % der_length)
+
+
+if __name__ == "__main__":
+    main()
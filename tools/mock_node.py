@@ -0,0 +1,389 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2019 Robert Bosch GmbH
+# All rights reserved.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Minimal Ethereum json-rpc node for offline tests of the XDK application.
+
+Implements the json-rpc calls the XDK sends (single calls and batches):
+eth_call, eth_sendTransaction, eth_sendRawTransaction, eth_estimateGas,
+eth_getTransactionReceipt, eth_getTransactionCount, eth_newBlockFilter,
+eth_getFilterChanges, eth_uninstallFilter and eth_blockNumber. The
+SecureEdgeDevice contract functions WriteDataHash, ReadDataHash,
+WritePublicKey, ReadPublicKey, rateProducer and readProducerRating are
+emulated with in-memory storage. The gas of a transaction is the intrinsic
+gas plus one storage write per 32 byte word of its ABI encoded arguments, a
+transaction with a lower gas limit fails with status 0x0 and uses its whole
+gas. The sender of a raw transaction is not recovered, every account counts
+the raw transactions in its nonce.
+
+Pending transactions are mined into the next block, blocks are produced
+every --block-time seconds. Point HTTP_IP_ADDRESS/HTTP_PORT in UserConfig.h
+to the host running this script.
+
+Every http request is answered after --latency ms plus up to --jitter ms.
+--fail-rate requests fail with --fail-mode:
+
+    error   json-rpc error of every call of the request
+    http    http status 503 without json-rpc response
+    drop    connection closed without response
+    stall   response after --stall-time seconds, e.g. after the XDK timed out
+
+    python3 tools/mock_node.py --port 8545 --block-time 5
+    python3 tools/mock_node.py --latency 80 --jitter 40 --fail-rate 0.05 --fail-mode drop
+
+tools/e2e_harness.py runs the producer and consumer flows against it.
+"""
+
+import argparse
+import hashlib
+import json
+import os
+import random
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+SELECTOR_WRITE_DATA_HASH = "0ef81269"
+SELECTOR_READ_DATA_HASH = "0546bedb"
+SELECTOR_WRITE_PUBLIC_KEY = "2ea8dff5"
+SELECTOR_READ_PUBLIC_KEY = "fcc01d51"
+SELECTOR_RATE_PRODUCER = "f18aeab6"
+SELECTOR_READ_PRODUCER_RATING = "eab7840e"
+
+FAIL_MODES = ("error", "http", "drop", "stall")
+
+WORD = 64
+
+GAS_TRANSACTION = 21000
+GAS_CALLDATA_ZERO_BYTE = 4
+GAS_CALLDATA_BYTE = 68
+GAS_STORAGE_WORD = 20000
+
+
+def word(value):
+    return "%064x" % value
+
+
+def encode_bytes(data_hex):
+    """ABI encode the content of a dynamic bytes value (length + padded data)."""
+    padded = data_hex + "0" * (-len(data_hex) % WORD)
+    return word(len(data_hex) // 2) + padded
+
+
+def decode_bytes_argument(calldata):
+    """Return the bytes argument of a function(bytes) call as hex string."""
+    args = calldata[8:]
+    offset = int(args[:WORD], 16) * 2
+    length = int(args[offset:offset + WORD], 16) * 2
+    return args[offset + WORD:offset + WORD + length]
+
+
+def transaction_gas(data):
+    """Gas of a contract transaction with the call data as hex string."""
+    calldata = bytes.fromhex(data)
+    gas = GAS_TRANSACTION + sum(GAS_CALLDATA_ZERO_BYTE if b == 0 else GAS_CALLDATA_BYTE for b in calldata)
+    return gas + GAS_STORAGE_WORD * max(len(data[8:]) // WORD, 1)
+
+
+def rlp_decode(data, pos=0):
+    """Decode the RLP item at pos, return (item, next position)."""
+    prefix = data[pos]
+    if prefix < 0x80:
+        return data[pos:pos + 1], pos + 1
+    if prefix < 0xb8:
+        length = prefix - 0x80
+        return data[pos + 1:pos + 1 + length], pos + 1 + length
+    if prefix < 0xc0:
+        size = prefix - 0xb7
+        length = int.from_bytes(data[pos + 1:pos + 1 + size], "big")
+        start = pos + 1 + size
+        return data[start:start + length], start + length
+    if prefix < 0xf8:
+        length, start = prefix - 0xc0, pos + 1
+    else:
+        size = prefix - 0xf7
+        length = int.from_bytes(data[pos + 1:pos + 1 + size], "big")
+        start = pos + 1 + size
+    items, item_pos = [], start
+    while item_pos < start + length:
+        item, item_pos = rlp_decode(data, item_pos)
+        items.append(item)
+    return items, start + length
+
+
+class Faults:
+    """Latency and failure injection of the http requests."""
+
+    def __init__(self, latency=0.0, jitter=0.0, fail_rate=0.0, fail_mode="error", stall_time=30.0, seed=None):
+        self.latency = latency / 1000.0
+        self.jitter = jitter / 1000.0
+        self.fail_rate = fail_rate
+        self.fail_mode = fail_mode
+        self.stall_time = stall_time
+        self.random = random.Random(seed)
+        self.lock = threading.Lock()
+        self.requests = 0
+        self.failures = 0
+
+    def next(self):
+        """Return the delay in seconds and the failure mode of the next request (None to answer it)."""
+        with self.lock:
+            self.requests += 1
+            delay = self.latency + self.random.uniform(0.0, self.jitter)
+            if self.random.random() >= self.fail_rate:
+                return delay, None
+            self.failures += 1
+        return delay, self.fail_mode
+
+
+class Chain:
+    def __init__(self, block_time, filter_timeout, filters_enabled):
+        self.lock = threading.Lock()
+        self.block_time = block_time
+        self.filter_timeout = filter_timeout
+        self.filters_enabled = filters_enabled
+        self.blocks = [self._block_hash(0)]
+        self.pending = []
+        self.receipts = {}
+        self.filters = {}
+        self.next_filter = 1
+        self.data_hash = "00" * 32
+        self.public_key = ""
+        self.consumer = "0" * 40
+        self.positive_votes = 0
+        self.total_votes = 0
+        self.sent = {}
+        self.raw_sent = 0
+        self.log = True
+
+    @staticmethod
+    def _block_hash(number):
+        return "0x" + hashlib.sha256(b"block%d" % number).hexdigest()
+
+    def mine(self):
+        with self.lock:
+            number = len(self.blocks)
+            block_hash = self._block_hash(number)
+            self.blocks.append(block_hash)
+            for tx_hash, status, gas_used in self.pending:
+                self.receipts[tx_hash] = {
+                    "transactionHash": tx_hash,
+                    "blockHash": block_hash,
+                    "blockNumber": hex(number),
+                    "gasUsed": hex(gas_used),
+                    "logs": [],
+                    "logsBloom": "0x" + "0" * 512,
+                    "status": status,
+                }
+            mined = len(self.pending)
+            self.pending = []
+            for flt in self.filters.values():
+                flt["changes"].append(block_hash)
+        if self.log:
+            print("block %d mined with %d transaction(s)" % (number, mined), flush=True)
+
+    def expire_filters(self):
+        now = time.monotonic()
+        with self.lock:
+            for filter_id in [f for f, v in self.filters.items() if now - v["polled"] > self.filter_timeout]:
+                del self.filters[filter_id]
+
+    def eth_call(self, params):
+        data = params[0]["data"][2:]
+        selector = data[:8]
+        if selector == SELECTOR_READ_DATA_HASH:
+            return "0x" + word(0x20) + encode_bytes(self.data_hash)
+        if selector == SELECTOR_READ_PUBLIC_KEY:
+            return "0x" + word(0x40) + word(int(self.consumer, 16)) + encode_bytes(self.public_key)
+        if selector == SELECTOR_READ_PRODUCER_RATING:
+            if self.total_votes == 0:
+                raise ValueError("execution reverted: division by zero")
+            return "0x" + word(self.positive_votes * 100 // self.total_votes)
+        raise ValueError("unknown function selector 0x%s" % selector)
+
+    def _execute(self, sender, data, gas_limit):
+        """Apply a contract transaction and queue its receipt for the next block."""
+        selector = data[:8]
+        tx_hash = "0x" + hashlib.sha256(os.urandom(32)).hexdigest()
+        gas_used = transaction_gas(data)
+        if gas_limit and gas_limit < gas_used:
+            self.pending.append((tx_hash, "0x0", gas_limit))
+            return tx_hash
+        if selector == SELECTOR_WRITE_DATA_HASH:
+            self.data_hash = decode_bytes_argument(data)
+        elif selector == SELECTOR_WRITE_PUBLIC_KEY:
+            self.public_key = decode_bytes_argument(data)
+            self.consumer = sender
+        elif selector == SELECTOR_RATE_PRODUCER:
+            self.total_votes += 1
+            self.positive_votes += int(data[8:8 + WORD], 16) & 1
+        self.pending.append((tx_hash, "0x1", gas_used))
+        return tx_hash
+
+    def eth_sendTransaction(self, params):
+        tx = params[0]
+        sender = tx.get("from", "0x" + "0" * 40)[2:].lower().rjust(40, "0")
+        self.sent[sender] = self.sent.get(sender, 0) + 1
+        return self._execute(sender, tx.get("data", "0x")[2:], int(tx.get("gas", "0x0"), 16))
+
+    def eth_sendRawTransaction(self, params):
+        # [nonce, gasPrice, gas, to, value, data, v, r, s]
+        fields, _ = rlp_decode(bytes.fromhex(params[0][2:]))
+        if not isinstance(fields, list) or len(fields) != 9:
+            raise ValueError("invalid raw transaction")
+        self.raw_sent += 1
+        return self._execute("0" * 40, fields[5].hex(), int.from_bytes(fields[2], "big"))
+
+    def eth_getTransactionCount(self, params):
+        sender = params[0][2:].lower().rjust(40, "0")
+        return hex(self.sent.get(sender, 0) + self.raw_sent)
+
+    def eth_estimateGas(self, params):
+        return hex(transaction_gas(params[0].get("data", "0x")[2:]))
+
+    def eth_getTransactionReceipt(self, params):
+        return self.receipts.get(params[0])
+
+    def eth_blockNumber(self, params):
+        return hex(len(self.blocks) - 1)
+
+    def eth_newBlockFilter(self, params):
+        if not self.filters_enabled:
+            raise NotImplementedError("the method eth_newBlockFilter does not exist/is not available")
+        filter_id = hex(self.next_filter)
+        self.next_filter += 1
+        self.filters[filter_id] = {"changes": [], "polled": time.monotonic()}
+        return filter_id
+
+    def eth_getFilterChanges(self, params):
+        flt = self.filters.get(params[0])
+        if flt is None:
+            raise LookupError("filter not found")
+        changes, flt["changes"] = flt["changes"], []
+        flt["polled"] = time.monotonic()
+        return changes
+
+    def eth_uninstallFilter(self, params):
+        return self.filters.pop(params[0], None) is not None
+
+    def handle(self, call):
+        response = {"jsonrpc": "2.0", "id": call.get("id")}
+        method = getattr(self, call.get("method", ""), None)
+        if not call.get("method", "").startswith("eth_") or method is None:
+            response["error"] = {"code": -32601, "message": "method not found"}
+            return response
+        try:
+            with self.lock:
+                response["result"] = method(call.get("params", []))
+        except NotImplementedError as error:
+            response["error"] = {"code": -32601, "message": str(error)}
+        except Exception as error:
+            response["error"] = {"code": -32000, "message": str(error)}
+        return response
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    # headers and body are written separately - without TCP_NODELAY the
+    # delayed ack of the client adds up to 40 ms to every response
+    disable_nagle_algorithm = True
+    chain = None
+    faults = Faults()
+
+    def do_POST(self):
+        body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+        delay, failure = self.faults.next()
+        time.sleep(delay)
+        if failure == "drop":
+            self.close_connection = True
+            return
+        if failure == "http":
+            self.send_error(503, "injected failure")
+            return
+        if failure == "stall":
+            time.sleep(self.faults.stall_time)
+        try:
+            request = json.loads(body)
+        except ValueError:
+            answer = {"jsonrpc": "2.0", "id": None, "error": {"code": -32700, "message": "parse error"}}
+        else:
+            if failure == "error":
+                calls = request if isinstance(request, list) else [request]
+                answer = [{"jsonrpc": "2.0", "id": call.get("id"), "error": {"code": -32603, "message": "injected failure"}} for call in calls]
+                if not isinstance(request, list):
+                    answer = answer[0]
+            elif isinstance(request, list):
+                answer = [self.chain.handle(call) for call in request]
+            else:
+                answer = self.chain.handle(request)
+        payload = json.dumps(answer, separators=(",", ":")).encode()
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(payload)))
+        self.end_headers()
+        try:
+            self.wfile.write(payload)
+        except ConnectionError:
+            # e.g. a stalled response after the client timed out
+            self.close_connection = True
+
+    def log_message(self, fmt, *args):
+        if self.server.verbose:
+            super().log_message(fmt, *args)
+
+
+def miner(chain):
+    while True:
+        time.sleep(chain.block_time)
+        chain.mine()
+        chain.expire_filters()
+
+
+def add_arguments(parser):
+    """Add the options of the node, shared with tools/e2e_harness.py."""
+    parser.add_argument("--block-time", type=float, default=5.0, help="seconds between two blocks")
+    parser.add_argument("--filter-timeout", type=float, default=300.0, help="seconds until an unpolled filter is removed")
+    parser.add_argument("--no-filters", action="store_true", help="reject eth_newBlockFilter like nodes without filter support")
+    parser.add_argument("--latency", type=float, default=0.0, help="ms until a request is answered")
+    parser.add_argument("--jitter", type=float, default=0.0, help="random ms added to the latency")
+    parser.add_argument("--fail-rate", type=float, default=0.0, help="share of the requests which fail (0..1)")
+    parser.add_argument("--fail-mode", choices=FAIL_MODES, default="error", help="how a request fails")
+    parser.add_argument("--stall-time", type=float, default=30.0, help="seconds a stalled request is delayed")
+    parser.add_argument("--seed", type=int, help="seed of the latency and failure injection")
+    parser.add_argument("--verbose", action="store_true", help="log every http request")
+
+
+def start(host, port, args):
+    """Start the node and its miner in background threads, return the server."""
+    Handler.chain = Chain(args.block_time, args.filter_timeout, not args.no_filters)
+    Handler.faults = Faults(args.latency, args.jitter, args.fail_rate, args.fail_mode, args.stall_time, args.seed)
+    server = ThreadingHTTPServer((host, port), Handler)
+    server.daemon_threads = True
+    server.verbose = args.verbose
+    threading.Thread(target=miner, args=(Handler.chain,), daemon=True).start()
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    return server
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8545)
+    add_arguments(parser)
+    args = parser.parse_args()
+
+    server = start(args.host, args.port, args)
+    print("mock json-rpc node listening on %s:%d" % server.server_address[:2], flush=True)
+    try:
+        while True:
+            time.sleep(3600)
+    except KeyboardInterrupt:
+        server.shutdown()
+
+
+if __name__ == "__main__":
+    main()